@@ -71,6 +71,8 @@ void lv_port_disp_init(void)
      *      Set 2 screens sized buffers and set disp_drv.full_refresh = 1.
      *      This way LVGL will always provide the whole rendered screen in `flush_cb`
      *      and you only need to change the frame buffer's address.
+     *      Set disp_drv.direct_mode = 1 instead to redraw only the changed areas.
+     *      LVGL keeps the two buffers in sync by copying the areas changed in the previous frame.
      */
 
     /* Example for 1) */
@@ -112,6 +114,9 @@ void lv_port_disp_init(void)
     /*Required for Example 3)*/
     //disp_drv.full_refresh = 1
 
+    /*Or redraw only the changed areas with Example 3)*/
+    //disp_drv.direct_mode = 1
+
     /* Fill a memory array with a color if you have GPU.
      * Note that, in lv_conf.h you can enable GPUs that has built-in support in LVGL.
      * But if you have a different GPU you can use with this callback.*/
@@ -55,6 +55,14 @@
 //#define LV_MEM_POOL_ALLOC     your_alloc          /* Uncomment if using an external allocator*/
 #endif
 
+/*Size of the memory reserved from `LV_MEM_SIZE` for the pools of small blocks (<= 256 bytes) in bytes.
+ *Small blocks are allocated and freed in constant time without fragmenting the heap. 0: don't use the pools*/
+#  define LV_MEM_SMALL_POOL_SIZE    (LV_MEM_SIZE / 8)
+
+/*1: Enable `lv_mem_free_atomic()` to free memory from other threads without locking. Requires C11 atomics.
+ *The blocks are pushed to a lock-free list and given back to the small pools or the heap in the next `lv_mem_alloc()`*/
+#  define LV_MEM_ATOMIC_FREE        0
+
 #else       /*LV_MEM_CUSTOM*/
 #  define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
 #  define LV_MEM_CUSTOM_ALLOC     malloc
@@ -120,8 +128,6 @@
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE       0
 
-/*Maximum buffer size to allocate for rotation. Only used if software rotation is enabled in the display driver.*/
-#define LV_DISP_ROT_MAX_BUF         (10*1024)
 
 /*-------------
  * GPU
@@ -234,6 +240,23 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 /*1: Enable API to take snapshot for object*/
 #define LV_USE_SNAPSHOT         1
 
+/*1: Enable a queue to update objects from other threads without locking.
+ *The commands are applied at the beginning of `lv_timer_handler()`. Requires C11 atomics.*/
+#define LV_USE_CMD_QUEUE        0
+#if LV_USE_CMD_QUEUE
+#  define LV_CMD_QUEUE_SIZE     64      /*Number of not applied commands. Power of 2*/
+#  define LV_CMD_QUEUE_BUDGET   32      /*Apply at most this many commands in a `lv_timer_handler()` call*/
+#  define LV_CMD_QUEUE_TXT_MAX  32      /*Texts shorter than this can be sent to labels*/
+#endif
+
+/*1: Flatten the styles added by the themes into one constant style per part and state.
+ *The flattened style lists are shared by all the objects which get the same styles from the theme.*/
+#define LV_USE_THEME_COMPILE    0
+
+/*1: Store the identical local styles (e.g. set by `lv_obj_set_style_...()`) only once and share them between the objects.
+ *A shared style is copied when an object modifies it.*/
+#define LV_USE_LOCAL_STYLE_SHARE    0
+
 /*=====================
  *  COMPILER SETTINGS
  *====================*/
@@ -330,6 +353,10 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED  0
 
+/*Enable rendering TrueType (.ttf) fonts at runtime in any size. See lv_font_ttf.h
+ *Requires `LV_DRAW_COMPLEX = 1`*/
+#define LV_USE_FONT_TTF         0
+
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX       0
 #if LV_USE_FONT_SUBPX
@@ -410,15 +437,12 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #define LV_USE_LABEL        1
 #if LV_USE_LABEL
 #  define LV_LABEL_TEXT_SELECTION         1   /*Enable selecting text of the label*/
-#  define LV_LABEL_LONG_TXT_HINT    1   /*Store some extra info in labels to speed up drawing of very long texts*/
+#  define LV_LABEL_LONG_TXT_HINT    1   /*Cache the line breaks of the labels to speed up drawing (especially of very long texts)*/
 #endif
 
 #define LV_USE_LINE         1
 
 #define LV_USE_ROLLER       1   /*Requires: lv_label*/
-#if LV_USE_ROLLER
-#  define LV_ROLLER_INF_PAGES       7   /*Number of extra "pages" when the roller is infinite*/
-#endif
 
 #define LV_USE_SLIDER       1   /*Requires: lv_bar*/
 
@@ -37,9 +37,11 @@ extern "C" {
 #include "src/core/lv_refr.h"
 #include "src/core/lv_disp.h"
 #include "src/core/lv_theme.h"
+#include "src/core/lv_cmd_queue.h"
 
 #include "src/font/lv_font.h"
 #include "src/font/lv_font_loader.h"
+#include "src/font/lv_font_ttf.h"
 #include "src/font/lv_font_fmt_txt.h"
 #include "src/misc/lv_printf.h"
 
@@ -0,0 +1,277 @@
+/**
+ * @file lv_cmd_queue.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_cmd_queue.h"
+#if LV_USE_CMD_QUEUE
+
+#include "../widgets/lv_label.h"
+#include "../widgets/lv_bar.h"
+#include "../widgets/lv_arc.h"
+#include "../misc/lv_timer.h"
+
+#if defined(__STDC_NO_ATOMICS__) || !defined(__STDC_VERSION__) || __STDC_VERSION__ < 201112L
+    #error "LV_USE_CMD_QUEUE requires C11 atomics"
+#endif
+#include <stdatomic.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define QUEUE_MASK  (LV_CMD_QUEUE_SIZE - 1)
+
+#if (LV_CMD_QUEUE_SIZE & QUEUE_MASK) != 0
+    #error "LV_CMD_QUEUE_SIZE needs to be a power of 2"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    lv_obj_t * obj;
+    lv_cmd_exec_cb_t exec_cb;
+    void * param;
+    bool coalesce;
+    lv_cmd_value_t value;
+} lv_cmd_t;
+
+/*A slot of the ring buffer. `seq` tells whether it can be written or read in the current round.*/
+typedef struct {
+    atomic_size_t seq;
+    lv_cmd_t cmd;
+} lv_cmd_cell_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool ring_pop(lv_cmd_t * cmd);
+static bool pending_add(const lv_cmd_t * cmd);
+#if LV_USE_LABEL
+    static void set_text_cb(lv_obj_t * obj, void * param, const lv_cmd_value_t * value);
+#endif
+static void set_value_cb(lv_obj_t * obj, void * param, const lv_cmd_value_t * value);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+/*Bounded multi-producer single-consumer ring. The producers reserve a cell by incrementing `enqueue_pos`.*/
+static lv_cmd_cell_t ring[LV_CMD_QUEUE_SIZE];
+static atomic_size_t enqueue_pos;
+static size_t dequeue_pos;
+
+/*Commands already taken from the ring but not applied yet, in the order of sending.
+ *Only the thread of LVGL uses them so they don't need to be atomic.*/
+static lv_cmd_t pending[LV_CMD_QUEUE_SIZE];
+static uint32_t pending_cnt;
+
+static uint32_t budget = LV_CMD_QUEUE_BUDGET;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_cmd_queue_init(void)
+{
+    size_t i;
+    for(i = 0; i < LV_CMD_QUEUE_SIZE; i++) {
+        atomic_init(&ring[i].seq, i);
+    }
+    atomic_init(&enqueue_pos, 0);
+    dequeue_pos = 0;
+    pending_cnt = 0;
+    budget = LV_CMD_QUEUE_BUDGET;
+
+    /*Apply the updates of the other threads before the timers (e.g. refreshing) run*/
+    _lv_timer_set_handler_start_cb(_lv_cmd_queue_handler);
+}
+
+lv_res_t lv_cmd_queue_send(lv_obj_t * obj, lv_cmd_exec_cb_t exec_cb, void * param, const lv_cmd_value_t * value,
+                           bool coalesce)
+{
+    /*Reserve a cell which was read in the previous round*/
+    lv_cmd_cell_t * cell;
+    size_t pos = atomic_load_explicit(&enqueue_pos, memory_order_relaxed);
+    while(1) {
+        cell = &ring[pos & QUEUE_MASK];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if(diff == 0) {
+            if(atomic_compare_exchange_weak_explicit(&enqueue_pos, &pos, pos + 1, memory_order_relaxed,
+                                                     memory_order_relaxed)) break;
+        }
+        else if(diff < 0) {
+            return LV_RES_INV;  /*Full*/
+        }
+        else {
+            pos = atomic_load_explicit(&enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    cell->cmd.obj = obj;
+    cell->cmd.exec_cb = exec_cb;
+    cell->cmd.param = param;
+    cell->cmd.coalesce = coalesce;
+    if(value) cell->cmd.value = *value;
+
+    /*Publish the command to the reader*/
+    atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+    return LV_RES_OK;
+}
+
+lv_res_t lv_cmd_queue_set_text(lv_obj_t * obj, const char * txt)
+{
+#if LV_USE_LABEL
+    lv_cmd_value_t value;
+    size_t len = strlen(txt);
+    if(len >= sizeof(value.txt)) return LV_RES_INV;
+    lv_memcpy(value.txt, txt, len + 1);
+    return lv_cmd_queue_send(obj, set_text_cb, NULL, &value, true);
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(txt);
+    return LV_RES_INV;
+#endif
+}
+
+lv_res_t lv_cmd_queue_set_value(lv_obj_t * obj, int32_t value)
+{
+    lv_cmd_value_t v;
+    v.num = value;
+    return lv_cmd_queue_send(obj, set_value_cb, NULL, &v, true);
+}
+
+uint32_t lv_cmd_queue_process(uint32_t max_cnt)
+{
+    /*Collect the new commands and coalesce them with the not applied ones*/
+    lv_cmd_t cmd;
+    while(pending_cnt < LV_CMD_QUEUE_SIZE && ring_pop(&cmd)) {
+        if(cmd.obj == NULL) continue;   /*Removed because the object was deleted*/
+        pending_add(&cmd);
+    }
+
+    uint32_t applied = 0;
+    uint32_t i;
+    for(i = 0; i < pending_cnt && applied < max_cnt; i++) {
+        /*The object was deleted (maybe by a previous command)*/
+        if(pending[i].obj == NULL) continue;
+        pending[i].exec_cb(pending[i].obj, pending[i].param, &pending[i].value);
+        applied++;
+    }
+
+    /*Keep the rest for the next time*/
+    pending_cnt -= i;
+    if(pending_cnt) memmove(&pending[0], &pending[i], pending_cnt * sizeof(lv_cmd_t));
+
+    return applied;
+}
+
+void lv_cmd_queue_set_budget(uint32_t max_cnt)
+{
+    budget = max_cnt;
+}
+
+void _lv_cmd_queue_remove_obj(lv_obj_t * obj)
+{
+    uint32_t i;
+    for(i = 0; i < pending_cnt; i++) {
+        if(pending[i].obj == obj) pending[i].obj = NULL;
+    }
+
+    /*The published cells belong to the reader until they are popped*/
+    size_t pos;
+    for(pos = dequeue_pos; pos < dequeue_pos + LV_CMD_QUEUE_SIZE; pos++) {
+        lv_cmd_cell_t * cell = &ring[pos & QUEUE_MASK];
+        if(atomic_load_explicit(&cell->seq, memory_order_acquire) != pos + 1) break;
+        if(cell->cmd.obj == obj) cell->cmd.obj = NULL;
+    }
+}
+
+void _lv_cmd_queue_handler(void)
+{
+    lv_cmd_queue_process(budget);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Take the oldest published command from the ring
+ * @param cmd store the command here
+ * @return true: there was a command; false: the ring is empty
+ */
+static bool ring_pop(lv_cmd_t * cmd)
+{
+    lv_cmd_cell_t * cell = &ring[dequeue_pos & QUEUE_MASK];
+    size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+    if(seq != dequeue_pos + 1) return false;
+
+    *cmd = cell->cmd;
+
+    /*Let the writers use the cell in the next round*/
+    atomic_store_explicit(&cell->seq, dequeue_pos + LV_CMD_QUEUE_SIZE, memory_order_release);
+    dequeue_pos++;
+    return true;
+}
+
+/**
+ * Add a command to the pending ones or update the value of a not applied command with the same target
+ * @param cmd the command to add
+ * @return true: added or coalesced; false: there is no space
+ */
+static bool pending_add(const lv_cmd_t * cmd)
+{
+    if(cmd->coalesce) {
+        uint32_t i;
+        for(i = 0; i < pending_cnt; i++) {
+            lv_cmd_t * p = &pending[i];
+            if(p->obj == cmd->obj && p->exec_cb == cmd->exec_cb && p->param == cmd->param && p->coalesce) {
+                p->value = cmd->value;
+                return true;
+            }
+        }
+    }
+
+    if(pending_cnt >= LV_CMD_QUEUE_SIZE) return false;
+    pending[pending_cnt] = *cmd;
+    pending_cnt++;
+    return true;
+}
+
+#if LV_USE_LABEL
+static void set_text_cb(lv_obj_t * obj, void * param, const lv_cmd_value_t * value)
+{
+    LV_UNUSED(param);
+    lv_label_set_text(obj, value->txt);
+}
+#endif
+
+static void set_value_cb(lv_obj_t * obj, void * param, const lv_cmd_value_t * value)
+{
+    LV_UNUSED(param);
+    LV_UNUSED(value);
+#if LV_USE_ARC
+    if(lv_obj_has_class(obj, &lv_arc_class)) {
+        lv_arc_set_value(obj, value->num);
+        return;
+    }
+#endif
+#if LV_USE_BAR
+    /*The slider is a bar too*/
+    if(lv_obj_has_class(obj, &lv_bar_class)) {
+        lv_bar_set_value(obj, value->num, LV_ANIM_OFF);
+        return;
+    }
+#endif
+    LV_LOG_WARN("the object has no value");
+}
+
+#endif /*LV_USE_CMD_QUEUE*/
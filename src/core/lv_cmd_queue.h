@@ -0,0 +1,125 @@
+/**
+ * @file lv_cmd_queue.h
+ * Queue to update objects from other threads.
+ * The commands are sent without locking and applied at the beginning of `lv_timer_handler()`.
+ */
+
+#ifndef LV_CMD_QUEUE_H
+#define LV_CMD_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj.h"
+
+#if LV_USE_CMD_QUEUE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * The value of a command. It's copied to the queue so the sender can reuse its variables.
+ */
+typedef union {
+    int32_t num;
+    lv_point_t point;
+    void * ptr;
+    char txt[LV_CMD_QUEUE_TXT_MAX];
+} lv_cmd_value_t;
+
+/**
+ * Apply a command on an object. Called in the context of `lv_timer_handler()`.
+ * @param obj       the target object of the command
+ * @param param     the parameter given when the command was sent
+ * @param value     the value of the command
+ */
+typedef void (*lv_cmd_exec_cb_t)(lv_obj_t * obj, void * param, const lv_cmd_value_t * value);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the command queue. Called by `lv_init()`.
+ */
+void _lv_cmd_queue_init(void);
+
+/**
+ * Send a command to an object. Can be called from any thread (also from interrupts) without locking.
+ * The commands with the same object, callback and parameter can be coalesced: only the last value is applied.
+ * The not applied commands of an object are removed when it's deleted, but the object must not be deleted
+ * while the command is being sent: sending to an object which might be deleted concurrently is undefined.
+ * Other threads shouldn't read LVGL (e.g. `lv_scr_act()`) to find the object: get it in the thread of LVGL.
+ * @param obj       the target object
+ * @param exec_cb   function to apply the command
+ * @param param     custom parameter for `exec_cb`. Also identifies the command with `obj` and `exec_cb`.
+ * @param value     the value to copy to the queue
+ * @param coalesce  true: only the last value of not applied commands with the same target is needed;
+ *                  false: every command needs to be applied (e.g. to add points to a chart)
+ * @return          LV_RES_OK: the command is queued; LV_RES_INV: the queue is full
+ */
+lv_res_t lv_cmd_queue_send(lv_obj_t * obj, lv_cmd_exec_cb_t exec_cb, void * param, const lv_cmd_value_t * value,
+                           bool coalesce);
+
+/**
+ * Set the text of a label from any thread. See `lv_cmd_queue_send()`.
+ * @param obj       pointer to a label
+ * @param txt       the new text. It's copied so it needs to be shorter than `LV_CMD_QUEUE_TXT_MAX`.
+ * @return          LV_RES_OK: the command is queued; LV_RES_INV: the text is too long or the queue is full
+ */
+lv_res_t lv_cmd_queue_set_text(lv_obj_t * obj, const char * txt);
+
+/**
+ * Set the value of a bar, slider or arc from any thread. See `lv_cmd_queue_send()`.
+ * @param obj       pointer to a bar, slider or arc
+ * @param value     the new value
+ * @return          LV_RES_OK: the command is queued; LV_RES_INV: the queue is full
+ */
+lv_res_t lv_cmd_queue_set_value(lv_obj_t * obj, int32_t value);
+
+/**
+ * Apply the queued commands. Called by `lv_timer_handler()` with the budget set by `lv_cmd_queue_set_budget()`.
+ * Must be called from the thread of LVGL.
+ * @param max_cnt   apply at most this many commands. The others remain in the queue.
+ * @return          number of applied commands
+ */
+uint32_t lv_cmd_queue_process(uint32_t max_cnt);
+
+/**
+ * Apply the queued commands with the budget. Called at the beginning of `lv_timer_handler()`.
+ */
+void _lv_cmd_queue_handler(void);
+
+/**
+ * Set how many commands `lv_timer_handler()` can apply at once.
+ * It limits the time spent with the commands when the other threads send them faster than they can be shown.
+ * @param max_cnt   number of commands (`LV_CMD_QUEUE_BUDGET` by default)
+ */
+void lv_cmd_queue_set_budget(uint32_t max_cnt);
+
+/**
+ * Remove the not applied commands of an object. Called when an object is deleted.
+ * @param obj       pointer to an object
+ */
+void _lv_cmd_queue_remove_obj(lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_CMD_QUEUE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_CMD_QUEUE_H*/
@@ -1,3 +1,4 @@
+CSRCS += lv_cmd_queue.c
 CSRCS += lv_disp.c
 CSRCS += lv_group.c
 CSRCS += lv_indev.c
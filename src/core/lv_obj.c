@@ -12,6 +12,7 @@
 #include "lv_group.h"
 #include "lv_disp.h"
 #include "lv_theme.h"
+#include "lv_cmd_queue.h"
 #include "../misc/lv_assert.h"
 #include "../draw/lv_draw.h"
 #include "../misc/lv_anim.h"
@@ -110,6 +111,10 @@ void lv_init(void)
 
     _lv_group_init();
 
+#if LV_USE_CMD_QUEUE
+    _lv_cmd_queue_init();
+#endif
+
 #if LV_USE_GPU_STM32_DMA2D
     /*Initialize DMA2D GPU*/
     lv_gpu_stm32_dma2d_init();
@@ -123,6 +128,9 @@ void lv_init(void)
 #endif
 
     _lv_obj_style_init();
+#if LV_USE_THEME_COMPILE
+    _lv_theme_init();
+#endif
     _lv_ll_init(&LV_GC_ROOT(_lv_disp_ll), sizeof(lv_disp_t));
     _lv_ll_init(&LV_GC_ROOT(_lv_indev_ll), sizeof(lv_indev_t));
 
@@ -412,6 +420,7 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_obj_enable_style_refresh(false); /*No need to refresh the style because the object will be deleted*/
     lv_obj_remove_style_all(obj);
     lv_obj_enable_style_refresh(true);
+    _lv_obj_style_batch_remove(obj);
 
     /*Remove the animations from this object*/
     lv_anim_del(obj, NULL);
@@ -179,6 +179,8 @@ typedef struct _lv_obj_t {
     uint16_t scr_layout_inv :1;
     uint16_t skip_trans :1;
     uint16_t style_cnt  :6;
+    uint16_t styles_shared :1;  /*`styles` is a compiled style list of a theme shared with other objects*/
+    uint16_t style_batched :1;  /*A style refresh is recorded by a style batch*/
     uint16_t h_layout   :1;
     uint16_t w_layout   :1;
 }lv_obj_t;
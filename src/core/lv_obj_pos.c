@@ -778,7 +778,7 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
     lv_area_copy(&area_tmp, area);
     bool visible = lv_obj_area_is_visible(obj, &area_tmp);
 
-    if(visible) _lv_inv_area(lv_obj_get_disp(obj), &area_tmp);
+    if(visible) _lv_inv_obj_area(lv_obj_get_disp(obj), obj, &area_tmp);
 }
 
 void lv_obj_invalidate(const lv_obj_t * obj)
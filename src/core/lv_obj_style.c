@@ -9,11 +9,13 @@
 #include "lv_obj.h"
 #include "lv_disp.h"
 #include "../misc/lv_gc.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS &lv_obj_class
+#define SHARE_BUCKET_CNT    128
 
 /**********************
  *      TYPEDEFS
@@ -35,6 +37,23 @@ typedef enum {
     CACHE_NEED_CHECK = 4,
 }cache_t;
 
+#if LV_USE_LOCAL_STYLE_SHARE
+/*A local style stored only once for all the objects having an identical local style*/
+typedef struct _shared_style_t {
+    lv_style_t style;                   /*Must be the first to use it as `lv_style_t *`*/
+    struct _shared_style_t * next;      /*Next style in the same hash bucket*/
+    uint32_t hash;
+    uint32_t ref_cnt;                   /*Number of objects using the style*/
+} shared_style_t;
+#endif
+
+/*A style refresh of an object deferred by a style batch*/
+typedef struct {
+    lv_obj_t * obj;
+    lv_part_t part;
+    lv_style_prop_t prop;
+} batch_refr_t;
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -42,11 +61,24 @@ typedef enum {
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector);
+static _lv_obj_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector);
+static lv_style_t * local_style_create(void);
+static void local_style_free(lv_style_t * style);
+#if LV_USE_LOCAL_STYLE_SHARE
+static void local_style_share(_lv_obj_style_t * obj_style);
+static void local_style_unshare(_lv_obj_style_t * obj_style);
+static void share_remove(shared_style_t * s);
+static uint32_t style_hash(const lv_style_t * style);
+static bool style_is_equal(const lv_style_t * style1, const lv_style_t * style2);
+static uint32_t style_get_size(const lv_style_t * style);
+static lv_style_value_t style_value_normalize(lv_style_prop_t prop, lv_style_value_t value);
+#endif
 static _lv_obj_style_t * get_trans_style(lv_obj_t * obj, uint32_t part);
 static bool get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
 static lv_style_value_t apply_color_filter(const lv_obj_t * obj, uint32_t part, lv_style_value_t v);
 static void report_style_change_core(void * style, lv_obj_t * obj);
+static void refresh_style_core(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
+static bool batch_record(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
 static void refresh_children_style(lv_obj_t * obj);
 static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
 static void trans_anim_cb(void * _tr, int32_t v);
@@ -59,6 +91,7 @@ static void fade_in_anim_ready(lv_anim_t * a);
  *  STATIC VARIABLES
  **********************/
 static bool style_refr = true;
+static uint32_t batch_cnt;
 
 /**********************
  *      MACROS
@@ -71,12 +104,30 @@ static bool style_refr = true;
 void _lv_obj_style_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_obj_style_trans_ll), sizeof(trans_t));
+    _lv_ll_init(&LV_GC_ROOT(_lv_obj_style_batch_ll), sizeof(batch_refr_t));
+
+#if LV_USE_LOCAL_STYLE_SHARE
+    LV_GC_ROOT(_lv_obj_style_share_buckets) = lv_mem_alloc(SHARE_BUCKET_CNT * sizeof(void *));
+    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_obj_style_share_buckets));
+    if(LV_GC_ROOT(_lv_obj_style_share_buckets)) {
+        lv_memset_00(LV_GC_ROOT(_lv_obj_style_share_buckets), SHARE_BUCKET_CNT * sizeof(void *));
+    }
+#endif
 }
 
 void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t selector)
 {
+#if LV_USE_THEME_COMPILE
+    /*Collected if added by a theme to compile and share it with other objects*/
+    if(_lv_theme_collect_style(obj, style, selector)) return;
+#endif
+
     trans_del(obj, selector, LV_STYLE_PROP_ANY, NULL);
 
+#if LV_USE_THEME_COMPILE
+    _lv_theme_unshare_styles(obj, true);
+#endif
+
     uint32_t i;
     /*Go after the transition and local styles*/
     for(i = 0; i < obj->style_cnt; i++) {
@@ -110,6 +161,18 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
     lv_style_prop_t prop = LV_STYLE_PROP_ANY;
     if(style && style->prop_cnt == 0) prop = LV_STYLE_PROP_INV;
 
+#if LV_USE_THEME_COMPILE
+    if(obj->styles_shared) {
+        /*Just release the shared list if all the styles are removed*/
+        if(style == NULL && state == LV_STATE_ANY && part == LV_PART_ANY) {
+            _lv_theme_unshare_styles(obj, false);
+            lv_obj_refresh_style(obj, part, prop);
+            return;
+        }
+        _lv_theme_unshare_styles(obj, true);
+    }
+#endif
+
     uint32_t i = 0;
     bool deleted = false;
     while(i <  obj->style_cnt) {
@@ -127,7 +190,11 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
             trans_del(obj, part, LV_STYLE_PROP_ANY, NULL);
         }
 
-        if(obj->styles[i].is_local || obj->styles[i].is_trans) {
+        if(obj->styles[i].is_local) {
+            local_style_free(obj->styles[i].style);
+            obj->styles[i].style = NULL;
+        }
+        else if(obj->styles[i].is_trans) {
             lv_style_reset(obj->styles[i].style);
             lv_mem_free(obj->styles[i].style);
             obj->styles[i].style = NULL;
@@ -153,6 +220,11 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+#if LV_USE_THEME_COMPILE
+    /*The objects use the compiled copy of the style so refresh all of them*/
+    if(_lv_theme_update_compiled(style)) style = NULL;
+#endif
+
     if(!style_refr) return;
     lv_disp_t * d = lv_disp_get_next(NULL);
 
@@ -171,42 +243,65 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 
     if(!style_refr) return;
 
-    lv_obj_invalidate(obj);
-
     lv_part_t part = lv_obj_style_get_selector_part(selector);
 
-    if(prop & LV_STYLE_PROP_LAYOUT_REFR) {
-        if(part == LV_PART_ANY ||
-           part == LV_PART_MAIN ||
-           lv_obj_get_style_height(obj, 0) == LV_SIZE_CONTENT ||
-           lv_obj_get_style_width(obj, 0) == LV_SIZE_CONTENT)
-        {
-            lv_event_send(obj, LV_EVENT_STYLE_CHANGED, NULL);
-            lv_obj_mark_layout_as_dirty(obj);
-        }
-    }
-    if((part == LV_PART_ANY || part == LV_PART_MAIN) && (prop == LV_STYLE_PROP_ANY || (prop & LV_STYLE_PROP_PARENT_LAYOUT_REFR))) {
-        lv_obj_t * parent = lv_obj_get_parent(obj);
-        if(parent) lv_obj_mark_layout_as_dirty(parent);
-    }
+    if(batch_cnt > 0 && batch_record(obj, part, prop)) return;
 
-    if(prop == LV_STYLE_PROP_ANY || (prop & LV_STYLE_PROP_EXT_DRAW)) {
-        lv_obj_refresh_ext_draw_size(obj);
+    refresh_style_core(obj, part, prop);
+}
+
+void lv_obj_enable_style_refresh(bool en)
+{
+    style_refr = en;
+}
+
+void lv_obj_style_batch_begin(void)
+{
+    batch_cnt++;
+}
+
+void lv_obj_style_batch_end(void)
+{
+    if(batch_cnt == 0) {
+        LV_LOG_WARN("no style batch was started");
+        return;
     }
-    lv_obj_invalidate(obj);
 
-    if(prop == LV_STYLE_PROP_ANY ||
-      ((prop & LV_STYLE_PROP_INHERIT) && ((prop & LV_STYLE_PROP_EXT_DRAW) || (prop & LV_STYLE_PROP_LAYOUT_REFR))))
-    {
-        if(part != LV_PART_SCROLLBAR) {
-            refresh_children_style(obj);
-        }
+    batch_cnt--;
+    if(batch_cnt == 0) _lv_obj_style_batch_refresh();
+}
+
+void _lv_obj_style_batch_refresh(void)
+{
+    /*Refreshing can record new refreshes if a batch is still open so always take the first*/
+    batch_refr_t * r = _lv_ll_get_head(&LV_GC_ROOT(_lv_obj_style_batch_ll));
+    while(r) {
+        lv_obj_t * obj = r->obj;
+        lv_part_t part = r->part;
+        lv_style_prop_t prop = r->prop;
+        obj->style_batched = 0;
+        _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_batch_ll), r);
+        lv_mem_free(r);
+
+        refresh_style_core(obj, part, prop);
+
+        r = _lv_ll_get_head(&LV_GC_ROOT(_lv_obj_style_batch_ll));
     }
 }
 
-void lv_obj_enable_style_refresh(bool en)
+void _lv_obj_style_batch_remove(lv_obj_t * obj)
 {
-    style_refr = en;
+    if(obj->style_batched == 0) return;
+
+    batch_refr_t * r;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_obj_style_batch_ll), r) {
+        if(r->obj == obj) {
+            _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_batch_ll), r);
+            lv_mem_free(r);
+            break;
+        }
+    }
+    obj->style_batched = 0;
 }
 
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
@@ -256,8 +351,14 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
 
 void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_value_t value, lv_style_selector_t selector)
 {
-    lv_style_t * style = get_local_style(obj, selector);
-    lv_style_set_prop(style, prop, value);
+    _lv_obj_style_t * obj_style = get_local_style(obj, selector);
+#if LV_USE_LOCAL_STYLE_SHARE
+    local_style_unshare(obj_style);
+    lv_style_set_prop(obj_style->style, prop, style_value_normalize(prop, value));
+    local_style_share(obj_style);
+#else
+    lv_style_set_prop(obj_style->style, prop, value);
+#endif
     lv_obj_refresh_style(obj, selector, prop);
 }
 
@@ -292,9 +393,42 @@ bool lv_obj_remove_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_sty
     /*The style is not found*/
     if(i == obj->style_cnt) return false;
 
+#if LV_USE_LOCAL_STYLE_SHARE
+    /*Don't copy a shared style if it doesn't have the property*/
+    lv_style_value_t v;
+    if(lv_style_get_prop(obj->styles[i].style, prop, &v) != LV_RES_OK) return false;
+
+    local_style_unshare(&obj->styles[i]);
+    bool res = lv_style_remove_prop(obj->styles[i].style, prop);
+    local_style_share(&obj->styles[i]);
+    return res;
+#else
     return lv_style_remove_prop(obj->styles[i].style, prop);
+#endif
 }
 
+#if LV_USE_LOCAL_STYLE_SHARE
+void lv_obj_local_style_monitor(lv_obj_local_style_monitor_t * mon_p)
+{
+    lv_memset_00(mon_p, sizeof(lv_obj_local_style_monitor_t));
+
+    shared_style_t ** buckets = (shared_style_t **)LV_GC_ROOT(_lv_obj_style_share_buckets);
+    if(buckets == NULL) return;
+
+    uint32_t b;
+    for(b = 0; b < SHARE_BUCKET_CNT; b++) {
+        shared_style_t * s;
+        for(s = buckets[b]; s; s = s->next) {
+            uint32_t size = style_get_size(&s->style);
+            mon_p->unique_cnt++;
+            mon_p->unique_size += size + sizeof(shared_style_t) - sizeof(lv_style_t);
+            mon_p->total_cnt += s->ref_cnt;
+            mon_p->total_size += size * s->ref_cnt;
+        }
+    }
+}
+#endif
+
 void _lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t prev_state, lv_state_t new_state, const _lv_obj_style_transition_dsc_t * tr_dsc)
 {
     trans_t * tr;
@@ -476,19 +610,23 @@ lv_text_align_t lv_obj_calculate_style_text_align(const struct _lv_obj_t * obj,
  * @param obj   pointer to an object
  * @param part  the part in whose local style to get
  * @param state the state in whose local style to get
- * @return pointer to the local style
+ * @return pointer to the local style's entry in the style list
  */
-static lv_style_t * get_local_style(lv_obj_t * obj,  lv_style_selector_t selector)
+static _lv_obj_style_t * get_local_style(lv_obj_t * obj,  lv_style_selector_t selector)
 {
     uint32_t i;
     for(i = 0; i < obj->style_cnt; i++) {
         if(obj->styles[i].is_local &&
            obj->styles[i].selector == selector)
         {
-            return obj->styles[i].style;
+            return &obj->styles[i];
         }
     }
 
+#if LV_USE_THEME_COMPILE
+    _lv_theme_unshare_styles(obj, true);
+#endif
+
     obj->style_cnt++;
     obj->styles = lv_mem_realloc(obj->styles, obj->style_cnt * sizeof(_lv_obj_style_t));
     LV_ASSERT_MALLOC(obj->styles);
@@ -501,13 +639,237 @@ static lv_style_t * get_local_style(lv_obj_t * obj,  lv_style_selector_t selecto
     }
 
     lv_memset_00(&obj->styles[i], sizeof(_lv_obj_style_t));
-    obj->styles[i].style = lv_mem_alloc(sizeof(lv_style_t));
-    lv_style_init(obj->styles[i].style);
+    obj->styles[i].style = local_style_create();
     obj->styles[i].is_local = 1;
     obj->styles[i].selector = selector;
-    return obj->styles[i].style;
+    return &obj->styles[i];
 }
 
+/**
+ * Allocate and initialize a new local style
+ * @return pointer to the new style
+ */
+static lv_style_t * local_style_create(void)
+{
+#if LV_USE_LOCAL_STYLE_SHARE
+    shared_style_t * s = lv_mem_alloc(sizeof(shared_style_t));
+    LV_ASSERT_MALLOC(s);
+    lv_memset_00(s, sizeof(shared_style_t));
+    lv_style_init(&s->style);
+    s->ref_cnt = 1;
+    return &s->style;
+#else
+    lv_style_t * style = lv_mem_alloc(sizeof(lv_style_t));
+    lv_style_init(style);
+    return style;
+#endif
+}
+
+/**
+ * Free a local style when an object doesn't use it anymore.
+ * A shared local style is freed only when its last object releases it.
+ * @param style pointer to a local style
+ */
+static void local_style_free(lv_style_t * style)
+{
+#if LV_USE_LOCAL_STYLE_SHARE
+    shared_style_t * s = (shared_style_t *)style;
+    if(s->ref_cnt > 1) {
+        s->ref_cnt--;
+        return;
+    }
+    share_remove(s);
+#endif
+    lv_style_reset(style);
+    lv_mem_free(style);
+}
+
+#if LV_USE_LOCAL_STYLE_SHARE
+
+/**
+ * Replace a local style with an identical stored one or store it to share it later.
+ * The style needs to be used only by this object (called after `local_style_unshare()`).
+ * @param obj_style pointer to a local style's entry in a style list
+ */
+static void local_style_share(_lv_obj_style_t * obj_style)
+{
+    shared_style_t ** buckets = (shared_style_t **)LV_GC_ROOT(_lv_obj_style_share_buckets);
+    if(buckets == NULL) return;
+
+    shared_style_t * s = (shared_style_t *)obj_style->style;
+    s->hash = style_hash(&s->style);
+
+    uint32_t b = s->hash % SHARE_BUCKET_CNT;
+    shared_style_t * act;
+    for(act = buckets[b]; act; act = act->next) {
+        if(act->hash != s->hash || !style_is_equal(&act->style, &s->style)) continue;
+
+        act->ref_cnt++;
+        lv_style_reset(&s->style);
+        lv_mem_free(s);
+        obj_style->style = &act->style;
+        return;
+    }
+
+    s->next = buckets[b];
+    buckets[b] = s;
+}
+
+/**
+ * Prepare a local style for modification.
+ * If it's used by other objects too, copy it (copy on write), else remove it from the stored styles
+ * as its hash will be changed.
+ * @param obj_style pointer to a local style's entry in a style list
+ */
+static void local_style_unshare(_lv_obj_style_t * obj_style)
+{
+    shared_style_t * s = (shared_style_t *)obj_style->style;
+    if(s->ref_cnt == 1) {
+        share_remove(s);
+        return;
+    }
+
+    s->ref_cnt--;
+
+    lv_style_t * copy = local_style_create();
+    uint32_t prop_cnt = _lv_style_get_prop_cnt(&s->style);
+    uint32_t i;
+    for(i = 0; i < prop_cnt; i++) {
+        lv_style_const_prop_t p;
+        _lv_style_get_prop_at(&s->style, i, &p);
+        lv_style_set_prop(copy, p.prop, p.value);
+    }
+    obj_style->style = copy;
+}
+
+/**
+ * Remove a style from the stored styles if it's stored
+ * @param s pointer to a shared style
+ */
+static void share_remove(shared_style_t * s)
+{
+    shared_style_t ** buckets = (shared_style_t **)LV_GC_ROOT(_lv_obj_style_share_buckets);
+    if(buckets == NULL) return;
+
+    shared_style_t ** act_p = &buckets[s->hash % SHARE_BUCKET_CNT];
+    while(*act_p) {
+        if(*act_p == s) {
+            *act_p = s->next;
+            break;
+        }
+        act_p = &(*act_p)->next;
+    }
+    s->next = NULL;
+}
+
+/**
+ * Calculate a hash from the properties of a style. It doesn't depend on the order of the properties.
+ * @param style pointer to a style
+ * @return the hash
+ */
+static uint32_t style_hash(const lv_style_t * style)
+{
+    uint32_t hash = 0;
+    uint32_t prop_cnt = _lv_style_get_prop_cnt(style);
+    uint32_t i;
+    for(i = 0; i < prop_cnt; i++) {
+        lv_style_const_prop_t p;
+        _lv_style_get_prop_at(style, i, &p);
+
+        /*FNV-1a of the property and its value*/
+        uint32_t h = 2166136261u ^ p.prop;
+        const uint8_t * v = (const uint8_t *)&p.value;
+        uint32_t j;
+        for(j = 0; j < sizeof(lv_style_value_t); j++) {
+            h = (h ^ v[j]) * 16777619u;
+        }
+        hash += h;
+    }
+
+    return hash;
+}
+
+/**
+ * Check if 2 styles have the same properties with the same values.
+ * The values are compared byte by byte so different values are never considered equal.
+ * @param style1 pointer to a style
+ * @param style2 pointer to an other style
+ * @return true: the styles are identical
+ */
+static bool style_is_equal(const lv_style_t * style1, const lv_style_t * style2)
+{
+    if(style1->prop_cnt != style2->prop_cnt || style1->has_group != style2->has_group) return false;
+
+    uint32_t prop_cnt = _lv_style_get_prop_cnt(style1);
+    uint32_t i;
+    for(i = 0; i < prop_cnt; i++) {
+        lv_style_const_prop_t p;
+        _lv_style_get_prop_at(style1, i, &p);
+
+        lv_style_value_t v;
+        if(lv_style_get_prop((lv_style_t *)style2, p.prop, &v) != LV_RES_OK) return false;
+        if(memcmp(&v, &p.value, sizeof(lv_style_value_t)) != 0) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Get the memory used by a style
+ * @param style pointer to a style
+ * @return the size in bytes
+ */
+static uint32_t style_get_size(const lv_style_t * style)
+{
+    uint32_t size = sizeof(lv_style_t);
+    if(style->prop_cnt > 1) size += style->prop_cnt * (sizeof(lv_style_value_t) + sizeof(uint16_t));
+    return size;
+}
+
+/**
+ * Zero the bytes of a value which are not used by the type of the property.
+ * E.g. after `{ .num = v }` the rest of the union is unspecified but the styles are compared byte by byte.
+ * The type of the custom properties is not known, their setters need to zero the value.
+ * @param prop      a style property
+ * @param value     the value to set
+ * @return          the value with only the used bytes kept
+ */
+static lv_style_value_t style_value_normalize(lv_style_prop_t prop, lv_style_value_t value)
+{
+    if((prop & 0x3FF) >= _LV_STYLE_LAST_BUILT_IN_PROP) return value;
+
+    lv_style_value_t v;
+    lv_memset_00(&v, sizeof(v));
+    switch(prop) {
+        case LV_STYLE_BG_COLOR:
+        case LV_STYLE_BG_GRAD_COLOR:
+        case LV_STYLE_BG_IMG_RECOLOR:
+        case LV_STYLE_BORDER_COLOR:
+        case LV_STYLE_OUTLINE_COLOR:
+        case LV_STYLE_SHADOW_COLOR:
+        case LV_STYLE_IMG_RECOLOR:
+        case LV_STYLE_LINE_COLOR:
+        case LV_STYLE_ARC_COLOR:
+        case LV_STYLE_TEXT_COLOR:
+            v.color = value.color;
+            break;
+        case LV_STYLE_BG_IMG_SRC:
+        case LV_STYLE_ARC_IMG_SRC:
+        case LV_STYLE_TEXT_FONT:
+        case LV_STYLE_COLOR_FILTER_DSC:
+        case LV_STYLE_TRANSITION:
+            v.ptr = value.ptr;
+            break;
+        default:
+            v.num = value.num;
+            break;
+    }
+
+    return v;
+}
+
+#endif /*LV_USE_LOCAL_STYLE_SHARE*/
+
 /**
  * Get the transition style of an object for a given part and for a given state.
  * If the transition style for the part-state pair doesn't exist allocate and return it.
@@ -526,6 +888,10 @@ static _lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t se
     /*Already have a transition style for it*/
     if(i != obj->style_cnt) return &obj->styles[i];
 
+#if LV_USE_THEME_COMPILE
+    _lv_theme_unshare_styles(obj, true);
+#endif
+
     obj->style_cnt++;
     obj->styles = lv_mem_realloc(obj->styles, obj->style_cnt * sizeof(_lv_obj_style_t));
 
@@ -636,6 +1002,89 @@ static void report_style_change_core(void * style, lv_obj_t * obj)
     }
 }
 
+/**
+ * Refresh an object and its children after its style was changed.
+ * @param obj   pointer to an object
+ * @param part  the part whose style was changed or `LV_PART_ANY`
+ * @param prop  `LV_STYLE_PROP_ANY` or the property (or flags of the properties) which was changed
+ */
+static void refresh_style_core(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    lv_obj_invalidate(obj);
+
+    if(prop & LV_STYLE_PROP_LAYOUT_REFR) {
+        if(part == LV_PART_ANY ||
+           part == LV_PART_MAIN ||
+           lv_obj_get_style_height(obj, 0) == LV_SIZE_CONTENT ||
+           lv_obj_get_style_width(obj, 0) == LV_SIZE_CONTENT)
+        {
+            lv_event_send(obj, LV_EVENT_STYLE_CHANGED, NULL);
+            lv_obj_mark_layout_as_dirty(obj);
+        }
+    }
+    if((part == LV_PART_ANY || part == LV_PART_MAIN) && (prop == LV_STYLE_PROP_ANY || (prop & LV_STYLE_PROP_PARENT_LAYOUT_REFR))) {
+        lv_obj_t * parent = lv_obj_get_parent(obj);
+        if(parent) lv_obj_mark_layout_as_dirty(parent);
+    }
+
+    if(prop == LV_STYLE_PROP_ANY || (prop & LV_STYLE_PROP_EXT_DRAW)) {
+        lv_obj_refresh_ext_draw_size(obj);
+    }
+    lv_obj_invalidate(obj);
+
+    if(prop == LV_STYLE_PROP_ANY ||
+      ((prop & LV_STYLE_PROP_INHERIT) && ((prop & LV_STYLE_PROP_EXT_DRAW) || (prop & LV_STYLE_PROP_LAYOUT_REFR))))
+    {
+        if(part != LV_PART_SCROLLBAR) {
+            refresh_children_style(obj);
+        }
+    }
+}
+
+
+/**
+ * Record a style refresh of an object to do it at the end of the style batch.
+ * The refreshes of the same object are merged.
+ * @param obj   pointer to an object
+ * @param part  the part whose style was changed or `LV_PART_ANY`
+ * @param prop  `LV_STYLE_PROP_ANY` or the property which was changed
+ * @return      true: recorded; false: out of memory, refresh the object now
+ */
+static bool batch_record(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    /*Only the flags of the properties matter when refreshing*/
+    if(prop != LV_STYLE_PROP_ANY) {
+        prop &= LV_STYLE_PROP_INHERIT | LV_STYLE_PROP_EXT_DRAW | LV_STYLE_PROP_LAYOUT_REFR | LV_STYLE_PROP_PARENT_LAYOUT_REFR;
+    }
+
+    batch_refr_t * r;
+    if(obj->style_batched) {
+        _LV_LL_READ(&LV_GC_ROOT(_lv_obj_style_batch_ll), r) {
+            if(r->obj != obj) continue;
+
+            if(r->part != part) r->part = LV_PART_ANY;
+            if(prop == LV_STYLE_PROP_ANY) r->prop = LV_STYLE_PROP_ANY;
+            else if(r->prop != LV_STYLE_PROP_ANY) r->prop |= prop;
+            return true;
+        }
+    }
+
+    r = _lv_ll_ins_tail(&LV_GC_ROOT(_lv_obj_style_batch_ll));
+    LV_ASSERT_MALLOC(r);
+    if(r == NULL) return false;
+
+    r->obj = obj;
+    r->part = part;
+    r->prop = prop;
+    obj->style_batched = 1;
+
+    /*Be sure the display is refreshed to apply the batch at the latest before the next frame*/
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(disp && disp->refr_timer) lv_timer_resume(disp->refr_timer);
+
+    return true;
+}
+
 /**
  * Recursively refresh the style of the children. Go deeper until a not NULL style is found
  * because the NULL styles are inherited from the parent
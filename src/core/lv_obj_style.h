@@ -54,6 +54,15 @@ typedef struct {
 #endif
 }_lv_obj_style_transition_dsc_t;
 
+#if LV_USE_LOCAL_STYLE_SHARE
+typedef struct {
+    uint32_t total_cnt;     /**< Number of local styles used by the objects*/
+    uint32_t unique_cnt;    /**< Number of different local styles stored*/
+    uint32_t total_size;    /**< Memory the local styles would need without sharing [bytes]*/
+    uint32_t unique_size;   /**< Memory used by the local styles [bytes]*/
+} lv_obj_local_style_monitor_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -118,6 +127,33 @@ void lv_obj_refresh_style(struct _lv_obj_t * obj, lv_part_t part, lv_style_prop_
  */
 void lv_obj_enable_style_refresh(bool en);
 
+/**
+ * Start a style batch. Until `lv_obj_style_batch_end()` the style refreshes of the objects
+ * (e.g. by `lv_obj_set_style_...()` or `lv_obj_add_style()`) are only recorded
+ * and every object is refreshed only once with the merged properties.
+ * The recorded refreshes are applied before rendering the next frame even if the batch is still open.
+ * Batches can be nested.
+ */
+void lv_obj_style_batch_begin(void);
+
+/**
+ * End a style batch. If it was the outermost batch, refresh the objects whose style was changed.
+ */
+void lv_obj_style_batch_end(void);
+
+/**
+ * Apply the style refreshes recorded by style batches.
+ * Called by LVGL before rendering a frame.
+ */
+void _lv_obj_style_batch_refresh(void);
+
+/**
+ * Drop the style refresh of an object recorded by a style batch.
+ * Called when the object is deleted.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_style_batch_remove(struct _lv_obj_t * obj);
+
 /**
  * Get the value of a style property. The current state of the object will be considered.
  * Inherited properties will be inherited.
@@ -152,6 +188,14 @@ lv_res_t lv_obj_get_local_style_prop(struct _lv_obj_t * obj, lv_style_prop_t pro
  */
 bool lv_obj_remove_local_style_prop(struct _lv_obj_t * obj, lv_style_prop_t prop, lv_style_selector_t selector);
 
+#if LV_USE_LOCAL_STYLE_SHARE
+/**
+ * Tell how many local styles are used and stored. The identical local styles are stored only once.
+ * @param mon_p     pointer to a `lv_obj_local_style_monitor_t` variable to store the result
+ */
+void lv_obj_local_style_monitor(lv_obj_local_style_monitor_t * mon_p);
+#endif
+
 /**
  * Used internally to create a style tarnsition
  * @param obj
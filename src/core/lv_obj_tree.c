@@ -11,6 +11,7 @@
 #include "../misc/lv_anim.h"
 #include "../misc/lv_gc.h"
 #include "../misc/lv_async.h"
+#include "lv_cmd_queue.h"
 
 /*********************
  *      DEFINES
@@ -433,6 +434,11 @@ static void obj_del_core(lv_obj_t * obj)
         indev = lv_indev_get_next(indev);
     }
 
+#if LV_USE_CMD_QUEUE
+    /*Don't apply the queued commands on the deleted object*/
+    _lv_cmd_queue_remove_obj(obj);
+#endif
+
     /*All children deleted. Now clean up the object specific data*/
     _lv_obj_destruct(obj);
 
@@ -25,6 +25,7 @@
 /*********************
  *      DEFINES
  *********************/
+#define MY_CLASS &lv_obj_class
 
 /**********************
  *      TYPEDEFS
@@ -33,6 +34,7 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void inv_area(lv_disp_t * disp, const lv_area_t * area_p, const void * owner);
 static void lv_refr_join_area(void);
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
@@ -40,7 +42,17 @@ static void lv_refr_area_part(const lv_area_t * area_p);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p);
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p);
+static void refr_sync_direct_mode(void);
 static void draw_buf_flush(void);
+static bool swap_chain_is_used(void);
+static void swap_chain_push(void);
+static void swap_chain_flush_next(void);
+static void flush_wait(uint32_t max_busy);
+static bool vsync_is_due(lv_disp_t * disp);
+static void frame_time_add(lv_disp_t * disp, uint32_t time);
+static void get_flush_area(const lv_area_t * area, lv_area_t * flush_area);
+static lv_disp_color_format_t get_color_format(void);
+static void convert_color_format(lv_color_t * buf, uint32_t px_cnt);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
 
 /**********************
@@ -48,6 +60,7 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
  **********************/
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
+static bool refr_forced;      /*In `lv_refr_now()` so don't wait for the vsync*/
 #if LV_USE_PERF_MONITOR
     static uint32_t fps_sum_cnt;
     static uint32_t fps_sum_all;
@@ -85,6 +98,7 @@ void lv_refr_now(lv_disp_t * disp)
 {
     lv_anim_refr_now();
 
+    refr_forced = true;
     if(disp) {
         _lv_disp_refr_timer(disp->refr_timer);
     }
@@ -96,6 +110,7 @@ void lv_refr_now(lv_disp_t * disp)
             d = lv_disp_get_next(d);
         }
     }
+    refr_forced = false;
 }
 
 /**
@@ -106,53 +121,20 @@ void lv_refr_now(lv_disp_t * disp)
  */
 void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
 {
-    if(!disp) disp = lv_disp_get_default();
-    if(!disp) return;
-
-    /*Clear the invalidate buffer if the parameter is NULL*/
-    if(area_p == NULL) {
-        disp->inv_p = 0;
-        return;
-    }
-
-    lv_area_t scr_area;
-    scr_area.x1 = 0;
-    scr_area.y1 = 0;
-    scr_area.x2 = lv_disp_get_hor_res(disp) - 1;
-    scr_area.y2 = lv_disp_get_ver_res(disp) - 1;
-
-    lv_area_t com_area;
-    bool suc;
-
-    suc = _lv_area_intersect(&com_area, area_p, &scr_area);
-    if(suc == false)  return; /*Out of the screen*/
-
-    /*If there were at least 1 invalid area in full refresh mode, redraw the whole screen*/
-    if(disp->driver->full_refresh) {
-        disp->inv_areas[0] = scr_area;
-        disp->inv_p = 1;
-        lv_timer_resume(disp->refr_timer);
-        return;
-    }
-
-    if(disp->driver->rounder_cb) disp->driver->rounder_cb(disp->driver, &com_area);
-
-    /*Save only if this area is not in one of the saved areas*/
-    uint16_t i;
-    for(i = 0; i < disp->inv_p; i++) {
-        if(_lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
-    }
+    inv_area(disp, area_p, NULL);
+}
 
-    /*Save the area*/
-    if(disp->inv_p < LV_INV_BUF_SIZE) {
-        lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
-    }
-    else {   /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
-    }
-    disp->inv_p++;
-    lv_timer_resume(disp->refr_timer);
+/**
+ * Invalidate an area of an object. The areas of the same object are merged until the next refresh
+ * so an object updated many times in a frame takes only one place in the invalidated areas.
+ * @param disp pointer to the display of the object
+ * @param obj pointer to the object which invalidates
+ * @param area_p pointer to the area to invalidate
+ */
+void _lv_inv_obj_area(lv_disp_t * disp, const lv_obj_t * obj, const lv_area_t * area_p)
+{
+    if(area_p == NULL) return;
+    inv_area(disp, area_p, obj);
 }
 
 /**
@@ -188,6 +170,20 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 
     disp_refr = tmr->user_data;
 
+    /*Start the frame only after a new vsync. Until that the timer keeps running to check it.*/
+    bool vsync = disp_refr->driver->vsync;
+    if(vsync && !refr_forced && !vsync_is_due(disp_refr)) {
+        TRACE_REFR("waiting for vsync");
+        return;
+    }
+    uint32_t vsync_start = disp_refr->driver->vsync_cnt;
+
+    /*Update the animations right before the frame so they are in sync with the rendering*/
+    if(vsync && !refr_forced) lv_anim_refr_now();
+
+    /*Apply the style changes of the open style batches*/
+    _lv_obj_style_batch_refresh();
+
 #if LV_USE_PERF_MONITOR == 0 && LV_USE_MEM_MONITOR == 0
     /**
      * Ensure the timer does not run again automatically.
@@ -213,20 +209,60 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 
     lv_refr_join_area();
 
+    if(disp_refr->driver->direct_mode && disp_refr->inv_p != 0) {
+        refr_sync_direct_mode();
+    }
+
     lv_refr_areas();
 
+    /*Pass all the rendered parts to the driver. The last one can be flushed in the background.*/
+    if(swap_chain_is_used()) flush_wait(1);
+
     /*If refresh happened ...*/
     if(disp_refr->inv_p != 0) {
         if(disp_refr->driver->full_refresh) {
             draw_buf_flush();
         }
+        else if(disp_refr->driver->direct_mode) {
+            /*Flush once with the bounding box of the redrawn areas and save the areas
+             *to copy them into the other buffer before the next frame*/
+            lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
+            uint32_t i;
+            disp_refr->inv_p_prev = 0;
+            for(i = 0; i < disp_refr->inv_p; i++) {
+                if(disp_refr->inv_area_joined[i]) continue;
+                if(disp_refr->inv_p_prev == 0) lv_area_copy(&draw_buf->area, &disp_refr->inv_areas[i]);
+                else _lv_area_join(&draw_buf->area, &draw_buf->area, &disp_refr->inv_areas[i]);
+                lv_area_copy(&disp_refr->inv_areas_prev[disp_refr->inv_p_prev], &disp_refr->inv_areas[i]);
+                disp_refr->inv_p_prev++;
+            }
+            draw_buf_flush();
+        }
 
         /*Clean up*/
         lv_memset_00(disp_refr->inv_areas, sizeof(disp_refr->inv_areas));
         lv_memset_00(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
+        lv_memset_00(disp_refr->inv_area_owners, sizeof(disp_refr->inv_area_owners));
         disp_refr->inv_p = 0;
+        disp_refr->inv_stat.frame_cnt++;
 
         elaps = lv_tick_elaps(start);
+
+        /*Missed the deadline if the next vsync came (or the refresh period passed) during the frame.
+         *The missed vsyncs are dropped and the next frame waits for a new one.*/
+        disp_refr->frame_stat.frame_cnt++;
+        frame_time_add(disp_refr, elaps);
+        if(vsync) {
+            uint32_t late_cnt = disp_refr->driver->vsync_cnt - vsync_start;
+            if(late_cnt) {
+                disp_refr->frame_stat.missed_cnt++;
+                disp_refr->frame_stat.dropped_cnt += late_cnt;
+            }
+        }
+        else if(elaps > tmr->period) {
+            disp_refr->frame_stat.missed_cnt++;
+        }
+
         /*Call monitor cb if present*/
         if(disp_refr->driver->monitor_cb) {
             disp_refr->driver->monitor_cb(disp_refr->driver, elaps, px_num);
@@ -314,6 +350,197 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     TRACE_REFR("finished");
 }
 
+lv_res_t lv_refr_target_init(lv_refr_target_t * target, void * buf, const lv_area_t * buf_area, lv_img_cf_t cf)
+{
+    LV_ASSERT_NULL(target);
+    LV_ASSERT_NULL(buf);
+    LV_ASSERT_NULL(buf_area);
+
+    lv_memset_00(target, sizeof(lv_refr_target_t));
+
+    lv_disp_drv_init(&target->driver);
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+            break;
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+#if LV_COLOR_SCREEN_TRANSP
+            /*The alpha channel of lv_color32_t is the alpha of the image so the normal blend functions can be used*/
+            target->driver.screen_transp = 1;
+#else
+            lv_disp_drv_use_generic_set_px_cb(&target->driver, cf);
+#endif
+            break;
+        case LV_IMG_CF_ALPHA_1BIT:
+        case LV_IMG_CF_ALPHA_2BIT:
+        case LV_IMG_CF_ALPHA_4BIT:
+        case LV_IMG_CF_ALPHA_8BIT:
+            lv_disp_drv_use_generic_set_px_cb(&target->driver, cf);
+            break;
+        default:
+            LV_LOG_WARN("unsupported color format: %d", cf);
+            return LV_RES_INV;
+    }
+
+    lv_coord_t w = lv_area_get_width(buf_area);
+    lv_coord_t h = lv_area_get_height(buf_area);
+    lv_disp_draw_buf_init(&target->draw_buf, buf, NULL, (uint32_t)w * h);
+    lv_area_copy(&target->draw_buf.area, buf_area);
+
+    /*Some draw functions limit their temporary buffers to the horizontal resolution.
+     *Use at least the size of the default display to keep them working the same way.*/
+    target->driver.draw_buf = &target->draw_buf;
+    target->driver.hor_res = LV_MAX(w, lv_disp_get_hor_res(NULL));
+    target->driver.ver_res = LV_MAX(h, lv_disp_get_ver_res(NULL));
+    target->driver.antialiasing = lv_disp_get_antialiasing(NULL);
+    target->driver.dpi = lv_disp_get_dpi(NULL);
+    target->disp.driver = &target->driver;
+
+    return LV_RES_OK;
+}
+
+void lv_refr_target_begin(lv_refr_target_t * target)
+{
+    target->disp_ori = disp_refr;
+    disp_refr = &target->disp;
+}
+
+void lv_refr_target_end(lv_refr_target_t * target)
+{
+    disp_refr = target->disp_ori;
+    target->disp_ori = NULL;
+}
+
+void lv_refr_target_draw_obj(lv_refr_target_t * target, lv_obj_t * obj, const lv_area_t * clip)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_area_t clip_area;
+    if(clip) {
+        if(!_lv_area_intersect(&clip_area, clip, &target->draw_buf.area)) return;
+    }
+    else {
+        lv_area_copy(&clip_area, &target->draw_buf.area);
+    }
+
+    lv_refr_obj(obj, &clip_area);
+}
+
+lv_res_t lv_refr_obj_to_buf(lv_obj_t * obj, const lv_area_t * area, lv_img_cf_t cf, void * buf)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_obj_update_layout(obj);
+
+    lv_area_t buf_area;
+    if(area) lv_area_copy(&buf_area, area);
+    else lv_obj_get_coords(obj, &buf_area);
+
+    lv_refr_target_t target;
+    lv_res_t res = lv_refr_target_init(&target, buf, &buf_area, cf);
+    if(res != LV_RES_OK) return res;
+
+    /*Use the settings of the object's display*/
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(disp) {
+        target.driver.antialiasing = disp->driver->antialiasing;
+        target.driver.dpi = disp->driver->dpi;
+    }
+
+    lv_refr_target_begin(&target);
+    lv_refr_target_draw_obj(&target, obj, NULL);
+    lv_refr_target_end(&target);
+
+    return LV_RES_OK;
+}
+
+void lv_refr_get_inv_stat(lv_disp_t * disp, lv_disp_inv_stat_t * stat)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) {
+        lv_memset_00(stat, sizeof(lv_disp_inv_stat_t));
+        return;
+    }
+
+    *stat = disp->inv_stat;
+}
+
+void lv_refr_reset_inv_stat(lv_disp_t * disp)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) return;
+
+    lv_memset_00(&disp->inv_stat, sizeof(lv_disp_inv_stat_t));
+}
+
+void lv_refr_get_flush_stat(lv_disp_t * disp, lv_disp_flush_stat_t * stat)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) {
+        lv_memset_00(stat, sizeof(lv_disp_flush_stat_t));
+        return;
+    }
+
+    *stat = disp->flush_stat;
+}
+
+void lv_refr_reset_flush_stat(lv_disp_t * disp)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) return;
+
+    lv_memset_00(&disp->flush_stat, sizeof(lv_disp_flush_stat_t));
+}
+
+void lv_refr_get_frame_stat(lv_disp_t * disp, lv_disp_frame_stat_t * stat)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) {
+        lv_memset_00(stat, sizeof(lv_disp_frame_stat_t));
+        return;
+    }
+
+    *stat = disp->frame_stat;
+
+    /*Sort the recent frame times to get the percentiles*/
+    uint16_t times[LV_DISP_FRAME_TIME_CNT];
+    uint32_t cnt = disp->frame_time_cnt;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        uint16_t t = disp->frame_times[i];
+        uint32_t j = i;
+        while(j > 0 && times[j - 1] > t) {
+            times[j] = times[j - 1];
+            j--;
+        }
+        times[j] = t;
+    }
+
+    if(cnt == 0) {
+        stat->time_p50 = 0;
+        stat->time_p90 = 0;
+        stat->time_p99 = 0;
+        stat->time_max = 0;
+        return;
+    }
+
+    /*Nearest rank: the smallest time which is not less than the given percent of the times*/
+    stat->time_p50 = times[(cnt * 50 + 99) / 100 - 1];
+    stat->time_p90 = times[(cnt * 90 + 99) / 100 - 1];
+    stat->time_p99 = times[(cnt * 99 + 99) / 100 - 1];
+    stat->time_max = times[cnt - 1];
+}
+
+void lv_refr_reset_frame_stat(lv_disp_t * disp)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) return;
+
+    lv_memset_00(&disp->frame_stat, sizeof(lv_disp_frame_stat_t));
+    disp->frame_time_p = 0;
+    disp->frame_time_cnt = 0;
+}
+
 #if LV_USE_PERF_MONITOR
 uint32_t lv_refr_get_fps_avg(void)
 {
@@ -325,6 +552,90 @@ uint32_t lv_refr_get_fps_avg(void)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Save an invalidated area
+ * @param disp pointer to a display. NULL to use the default display.
+ * @param area_p pointer to the area. NULL to delete the invalidated areas.
+ * @param owner the object which invalidates or NULL
+ */
+static void inv_area(lv_disp_t * disp, const lv_area_t * area_p, const void * owner)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) return;
+
+    /*Clear the invalidate buffer if the parameter is NULL*/
+    if(area_p == NULL) {
+        disp->inv_p = 0;
+        return;
+    }
+
+    lv_area_t scr_area;
+    scr_area.x1 = 0;
+    scr_area.y1 = 0;
+    scr_area.x2 = lv_disp_get_hor_res(disp) - 1;
+    scr_area.y2 = lv_disp_get_ver_res(disp) - 1;
+
+    lv_area_t com_area;
+    bool suc;
+
+    suc = _lv_area_intersect(&com_area, area_p, &scr_area);
+    if(suc == false)  return; /*Out of the screen*/
+
+    disp->inv_stat.raw_cnt++;
+
+    /*If there were at least 1 invalid area in full refresh mode, redraw the whole screen*/
+    if(disp->driver->full_refresh) {
+        if(disp->inv_p) disp->inv_stat.coalesced_cnt++;
+        disp->inv_areas[0] = scr_area;
+        disp->inv_area_owners[0] = NULL;
+        disp->inv_p = 1;
+        lv_timer_resume(disp->refr_timer);
+        return;
+    }
+
+    if(disp->driver->rounder_cb) disp->driver->rounder_cb(disp->driver, &com_area);
+
+    uint16_t i;
+
+    /*Merge the area into the previous area of the same object if it doesn't make the redrawn area larger.
+     *The object's areas are close to each other so usually they can be merged.*/
+    if(owner) {
+        for(i = 0; i < disp->inv_p; i++) {
+            if(disp->inv_area_owners[i] != owner) continue;
+
+            lv_area_t joined_area;
+            _lv_area_join(&joined_area, &disp->inv_areas[i], &com_area);
+            if(lv_area_get_size(&joined_area) <= lv_area_get_size(&disp->inv_areas[i]) + lv_area_get_size(&com_area)) {
+                lv_area_copy(&disp->inv_areas[i], &joined_area);
+                disp->inv_stat.coalesced_cnt++;
+                return;
+            }
+            break;
+        }
+    }
+
+    /*Save only if this area is not in one of the saved areas*/
+    for(i = 0; i < disp->inv_p; i++) {
+        if(_lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) {
+            disp->inv_stat.coalesced_cnt++;
+            return;
+        }
+    }
+
+    /*Save the area*/
+    if(disp->inv_p < LV_INV_BUF_SIZE) {
+        lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+        disp->inv_area_owners[disp->inv_p] = owner;
+    }
+    else {   /*If no place for the area add the screen*/
+        disp->inv_p = 0;
+        lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+        disp->inv_area_owners[disp->inv_p] = NULL;
+    }
+    disp->inv_p++;
+    lv_timer_resume(disp->refr_timer);
+}
+
 /**
  * Join the areas which has got common parts
  */
@@ -393,6 +704,7 @@ static void lv_refr_areas(void)
             lv_refr_area(&disp_refr->inv_areas[i]);
 
             px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
+            disp_refr->inv_stat.refr_area_cnt++;
         }
     }
 }
@@ -403,8 +715,8 @@ static void lv_refr_areas(void)
  */
 static void lv_refr_area(const lv_area_t * area_p)
 {
-    /*With full refresh just redraw directly into the buffer*/
-    if(disp_refr->driver->full_refresh) {
+    /*With full refresh or direct mode just redraw directly into the buffer*/
+    if(disp_refr->driver->full_refresh || disp_refr->driver->direct_mode) {
         lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
         draw_buf->area.x1        = 0;
         draw_buf->area.x2        = lv_disp_get_hor_res(disp_refr) - 1;
@@ -423,10 +735,23 @@ static void lv_refr_area(const lv_area_t * area_p)
     lv_coord_t y2 = area_p->y2 >= lv_disp_get_ver_res(disp_refr) ?
                         lv_disp_get_ver_res(disp_refr) - 1 : area_p->y2;
 
-    int32_t max_row = (uint32_t)draw_buf->size / w;
+    /*With a color format larger than `lv_color_t` the converted pixels need to fit into the buffer too*/
+    uint32_t buf_px_cnt = draw_buf->size;
+    uint8_t px_size = lv_disp_color_format_get_size(get_color_format());
+    if(px_size > sizeof(lv_color_t)) buf_px_cnt = (draw_buf->size * sizeof(lv_color_t)) / px_size;
+
+    int32_t max_row = buf_px_cnt / w;
 
     if(max_row > h) max_row = h;
 
+    /*With 90 or 270 degree software rotation the rows of the draw_buf are the lines of the native buffer.
+     *Keep the native lines word aligned for the driver (e.g. DMA)*/
+    if(disp_refr->driver->sw_rotate && sizeof(lv_color_t) < 4 &&
+       (disp_refr->driver->rotated == LV_DISP_ROT_90 || disp_refr->driver->rotated == LV_DISP_ROT_270)) {
+        int32_t align = 4 / sizeof(lv_color_t);
+        if(max_row > align) max_row = (max_row / align) * align;
+    }
+
     /*Round down the lines of draw_buf if rounding is added*/
     if(disp_refr->driver->rounder_cb) {
         lv_area_t tmp;
@@ -494,11 +819,9 @@ static void lv_refr_area_part(const lv_area_t * area_p)
 
     /* Below the `area_p` area will be redrawn into the draw buffer.
      * In single buffered mode wait here until the buffer is freed.*/
-    if(draw_buf->buf1 && !draw_buf->buf2) {
-		while(draw_buf->flushing) {
-			if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
-		}
-    }
+    if(draw_buf->buf1 && !draw_buf->buf2) flush_wait(0);
+    /*Keep the driver busy with the rendered parts of a swap chain*/
+    else swap_chain_flush_next();
 
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
@@ -508,6 +831,21 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     lv_area_t start_mask;
     _lv_area_intersect(&start_mask, area_p, &draw_buf->area);
 
+#if LV_COLOR_SCREEN_TRANSP
+    /*In direct mode the buffer is not cleared on flush ready so clear the area to redraw here*/
+    if(disp_refr->driver->direct_mode && disp_refr->driver->screen_transp) {
+        lv_coord_t buf_w = lv_area_get_width(&draw_buf->area);
+        lv_coord_t w = lv_area_get_width(&start_mask);
+        lv_color_t * buf = draw_buf->buf_act;
+        buf += (start_mask.y1 - draw_buf->area.y1) * buf_w + (start_mask.x1 - draw_buf->area.x1);
+        lv_coord_t y;
+        for(y = start_mask.y1; y <= start_mask.y2; y++) {
+            lv_memset_00(buf, w * sizeof(lv_color_t));
+            buf += buf_w;
+        }
+    }
+#endif
+
     /*Get the most top object which is not covered by others*/
     top_act_scr = lv_refr_get_top_obj(&start_mask, lv_disp_get_scr_act(disp_refr));
     if(disp_refr->prev_scr) {
@@ -562,9 +900,9 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), &start_mask);
     lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), &start_mask);
 
-    /*In true double buffered mode flush only once when all areas were rendered.
+    /*In true double buffered and direct mode flush only once when all areas were rendered.
      *In normal mode flush after every area*/
-    if(disp_refr->driver->full_refresh == false) {
+    if(disp_refr->driver->full_refresh == false && disp_refr->driver->direct_mode == false) {
         draw_buf_flush();
     }
 }
@@ -737,163 +1075,48 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
     }
 }
 
-static void draw_buf_rotate_180(lv_disp_drv_t *drv, lv_area_t *area, lv_color_t *color_p) {
-    lv_coord_t area_w = lv_area_get_width(area);
-    lv_coord_t area_h = lv_area_get_height(area);
-    uint32_t total = area_w * area_h;
-    /*Swap the beginning and end values*/
-    lv_color_t tmp;
-    uint32_t i = total - 1, j = 0;
-    while(i > j) {
-        tmp = color_p[i];
-        color_p[i] = color_p[j];
-        color_p[j] = tmp;
-        i--;
-        j++;
-    }
-    lv_coord_t tmp_coord;
-    tmp_coord = area->y2;
-    area->y2 = drv->ver_res - area->y1 - 1;
-    area->y1 = drv->ver_res - tmp_coord - 1;
-    tmp_coord = area->x2;
-    area->x2 = drv->hor_res - area->x1 - 1;
-    area->x1 = drv->hor_res - tmp_coord - 1;
-}
-
-static LV_ATTRIBUTE_FAST_MEM void draw_buf_rotate_90(bool invert_i, lv_coord_t area_w, lv_coord_t area_h, lv_color_t *orig_color_p, lv_color_t *rot_buf) {
-
-    uint32_t invert = (area_w * area_h) - 1;
-    uint32_t initial_i = ((area_w - 1) * area_h);
-    for(lv_coord_t y = 0; y < area_h; y++) {
-        uint32_t i = initial_i + y;
-        if(invert_i)
-            i = invert - i;
-        for(lv_coord_t x = 0; x < area_w; x++) {
-            rot_buf[i] = *(orig_color_p++);
-            if(invert_i)
-                i += area_h;
-            else
-                i -= area_h;
-        }
-    }
-}
-
 /**
- * Helper function for draw_buf_rotate_90_sqr. Given a list of four numbers, rotate the entire list to the left.
+ * In double buffered direct mode the buffer to draw into doesn't contain the areas redrawn in the last frame.
+ * Copy these areas from the other buffer unless they will be fully redrawn anyway.
  */
-static inline void draw_buf_rotate4(lv_color_t *a, lv_color_t *b, lv_color_t * c, lv_color_t * d) {
-    lv_color_t tmp;
-    tmp = *a;
-    *a = *b;
-    *b = *c;
-    *c = *d;
-    *d = tmp;
-}
-
-/**
- * Rotate a square image 90/270 degrees in place.
- * @note inspired by https://stackoverflow.com/a/43694906
- */
-static void draw_buf_rotate_90_sqr(bool is_270, lv_coord_t w, lv_color_t * color_p) {
-    for(lv_coord_t i = 0; i < w/2; i++) {
-        for(lv_coord_t j = 0; j < (w + 1)/2; j++) {
-            lv_coord_t inv_i = (w - 1) - i;
-            lv_coord_t inv_j = (w - 1) - j;
-            if(is_270) {
-                draw_buf_rotate4(
-                    &color_p[i * w + j],
-                    &color_p[inv_j * w + i],
-                    &color_p[inv_i * w + inv_j],
-                    &color_p[j * w + inv_i]
-                );
-            } else {
-                draw_buf_rotate4(
-                    &color_p[i * w + j],
-                    &color_p[j * w + inv_i],
-                    &color_p[inv_i * w + inv_j],
-                    &color_p[inv_j * w + i]
-                );
+static void refr_sync_direct_mode(void)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
+    if(draw_buf->buf1 == NULL || draw_buf->buf2 == NULL) return;
+
+    /*The buffer to draw into is shown on the display until the last flush is ready*/
+    flush_wait(0);
+
+    lv_color_t * buf_act = draw_buf->buf_act;
+    lv_color_t * buf_front = draw_buf->buf_act == draw_buf->buf1 ? draw_buf->buf2 : draw_buf->buf1;
+    lv_coord_t hor_res = lv_disp_get_hor_res(disp_refr);
+
+    uint32_t i;
+    for(i = 0; i < disp_refr->inv_p_prev; i++) {
+        const lv_area_t * a = &disp_refr->inv_areas_prev[i];
+
+        /*Skip the area if it will be redrawn in this frame*/
+        bool redraw = false;
+        uint32_t j;
+        for(j = 0; j < disp_refr->inv_p; j++) {
+            if(disp_refr->inv_area_joined[j]) continue;
+            if(_lv_area_is_in(a, &disp_refr->inv_areas[j], 0)) {
+                redraw = true;
+                break;
             }
-
-        }
-    }
-}
-
-/**
- * Rotate the draw_buf to the display's native orientation.
- */
-static void draw_buf_rotate(lv_area_t *area, lv_color_t *color_p) {
-    lv_disp_drv_t * drv = disp_refr->driver;
-    if(disp_refr->driver->full_refresh && drv->sw_rotate) {
-        LV_LOG_ERROR("cannot rotate a full refreshed display!");
-        return;
-    }
-    if(drv->rotated == LV_DISP_ROT_180) {
-        draw_buf_rotate_180(drv, area, color_p);
-        call_flush_cb(drv, area, color_p);
-    } else if(drv->rotated == LV_DISP_ROT_90 || drv->rotated == LV_DISP_ROT_270) {
-        /*Allocate a temporary buffer to store rotated image*/
-        lv_color_t * rot_buf = NULL;
-        lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
-        lv_coord_t area_w = lv_area_get_width(area);
-        lv_coord_t area_h = lv_area_get_height(area);
-        /*Determine the maximum number of rows that can be rotated at a time*/
-        lv_coord_t max_row = LV_MIN((lv_coord_t)((LV_DISP_ROT_MAX_BUF/sizeof(lv_color_t)) / area_w), area_h);
-        lv_coord_t init_y_off;
-        init_y_off = area->y1;
-        if(drv->rotated == LV_DISP_ROT_90) {
-            area->y2 = drv->ver_res - area->x1 - 1;
-            area->y1 = area->y2 - area_w + 1;
         }
-        else {
-            area->y1 = area->x1;
-            area->y2 = area->y1 + area_w - 1;
-        }
-        draw_buf->flushing = 0;
-        /*Rotate the screen in chunks, flushing after each one*/
-        lv_coord_t row = 0;
-        while(row < area_h) {
-            lv_coord_t height = LV_MIN(max_row, area_h-row);
-            draw_buf->flushing = 1;
-            if((row == 0) && (area_h >= area_w)) {
-                /*Rotate the initial area as a square*/
-                height = area_w;
-                draw_buf_rotate_90_sqr(drv->rotated == LV_DISP_ROT_270, area_w, color_p);
-                if(drv->rotated == LV_DISP_ROT_90) {
-                    area->x1 = init_y_off;
-                    area->x2 = init_y_off + area_w - 1;
-                }
-                else {
-                    area->x2 = drv->hor_res - 1 - init_y_off;
-                    area->x1 = area->x2 - area_w + 1;
-                }
-            }
-            else {
-                /*Rotate other areas using a maximum buffer size*/
-                if(rot_buf == NULL) rot_buf = lv_mem_buf_get(LV_DISP_ROT_MAX_BUF);
-                draw_buf_rotate_90(drv->rotated == LV_DISP_ROT_270, area_w, height, color_p, rot_buf);
-
-                if(drv->rotated == LV_DISP_ROT_90) {
-                    area->x1 = init_y_off + row;
-                    area->x2 = init_y_off + row + height - 1;
-                }
-                else {
-                    area->x2 = drv->hor_res - 1 - init_y_off - row;
-                    area->x1 = area->x2 - height + 1;
-                }
-            }
-            /*Flush the completed area to the display*/
-            call_flush_cb(drv, area, rot_buf == NULL ? color_p : rot_buf);
-            /*FIXME: Rotation forces legacy behavior where rendering and flushing are done serially*/
-            while(draw_buf->flushing) {
-                if(drv->wait_cb) drv->wait_cb(drv);
-            }
-            color_p += area_w * height;
-            row += height;
+        if(redraw) continue;
+
+        uint32_t w_byte = lv_area_get_width(a) * sizeof(lv_color_t);
+        uint32_t ofs = (uint32_t)a->y1 * hor_res + a->x1;
+        lv_coord_t y;
+        for(y = a->y1; y <= a->y2; y++) {
+            lv_memcpy(buf_act + ofs, buf_front + ofs, w_byte);
+            ofs += hor_res;
         }
-        /*Free the allocated buffer at the end if necessary*/
-        if(rot_buf != NULL) lv_mem_buf_release(rot_buf);
     }
+
+    disp_refr->inv_p_prev = 0;
 }
 
 /**
@@ -908,13 +1131,21 @@ static void draw_buf_flush(void)
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
     if(disp->driver->gpu_wait_cb) disp->driver->gpu_wait_cb(disp->driver);
 
+    convert_color_format(color_p, lv_area_get_size(&draw_buf->area));
+
+    if(disp->driver->direct_mode && disp->driver->sw_rotate && disp->driver->rotated != LV_DISP_ROT_NONE) {
+        LV_LOG_ERROR("cannot rotate a direct mode display!");
+        return;
+    }
+
+    if(swap_chain_is_used()) {
+        swap_chain_push();
+        return;
+    }
+
      /* In double buffered mode wait until the other buffer is freed
 	  * and driver is ready to receive the new buffer */
-	 if(draw_buf->buf1 && draw_buf->buf2) {
-		 while(draw_buf->flushing) {
-			 if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
-		 }
-	 }
+	 if(draw_buf->buf1 && draw_buf->buf2) flush_wait(0);
 
 	 draw_buf->flushing = 1;
 
@@ -922,12 +1153,9 @@ static void draw_buf_flush(void)
 	else draw_buf->flushing_last = 0;
 
     if(disp->driver->flush_cb) {
-        /*Rotate the buffer to the display's native orientation if necessary*/
-        if(disp->driver->rotated != LV_DISP_ROT_NONE && disp->driver->sw_rotate) {
-            draw_buf_rotate(&draw_buf->area, draw_buf->buf_act);
-        } else {
-            call_flush_cb(disp->driver, &draw_buf->area, color_p);
-        }
+        lv_area_t flush_area;
+        get_flush_area(&draw_buf->area, &flush_area);
+        call_flush_cb(disp->driver, &flush_area, color_p);
     }
     if(draw_buf->buf1 && draw_buf->buf2) {
         if(draw_buf->buf_act == draw_buf->buf1)
@@ -937,8 +1165,256 @@ static void draw_buf_flush(void)
     }
 }
 
+/**
+ * Tell whether the rendered parts are queued in a swap chain of more than 2 buffers
+ * @return true: swap chain is used
+ */
+static bool swap_chain_is_used(void)
+{
+    lv_disp_drv_t * drv = disp_refr->driver;
+    if(drv->draw_buf->buf_cnt <= 2) return false;
+    if(drv->full_refresh || drv->direct_mode) return false;
+    return true;
+}
+
+/**
+ * Queue the rendered buffer for flushing and continue rendering in the next buffer of the swap chain.
+ * Wait only if the next buffer is not flushed yet.
+ */
+static void swap_chain_push(void)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
+
+    uint32_t id = draw_buf->buf_act_id;
+    get_flush_area(&draw_buf->area, &draw_buf->queue_areas[id]);
+    draw_buf->queue_last[id] = draw_buf->last_area && draw_buf->last_part ? 1 : 0;
+    draw_buf->queue_cnt++;
+
+    /*Start flushing it now if the driver is idle*/
+    swap_chain_flush_next();
+    if(draw_buf->queue_cnt > disp_refr->flush_stat.queue_max) disp_refr->flush_stat.queue_max = draw_buf->queue_cnt;
+
+    /*The buffers are used in order so the next one is free if not all of them are queued or being flushed*/
+    flush_wait(draw_buf->buf_cnt - 1);
+
+    draw_buf->buf_act_id = id + 1 < draw_buf->buf_cnt ? id + 1 : 0;
+    draw_buf->buf_act = draw_buf->bufs[draw_buf->buf_act_id];
+}
+
+/**
+ * Pass the oldest rendered buffer of the swap chain to `flush_cb` if the previous flush is ready
+ */
+static void swap_chain_flush_next(void)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
+    if(draw_buf->queue_cnt == 0 || draw_buf->flushing) return;
+
+    uint32_t id = draw_buf->flush_id;
+    draw_buf->flush_id = id + 1 < draw_buf->buf_cnt ? id + 1 : 0;
+    draw_buf->queue_cnt--;
+
+    /*Set them before calling `flush_cb` because `lv_disp_flush_ready()` might be called from it*/
+    draw_buf->flushing = 1;
+    draw_buf->flushing_last = draw_buf->queue_last[id];
+
+    if(disp_refr->driver->flush_cb) call_flush_cb(disp_refr->driver, &draw_buf->queue_areas[id], draw_buf->bufs[id]);
+}
+
+/**
+ * Wait until the driver finishes flushing enough buffers.
+ * Meanwhile the rendered buffers of a swap chain are passed to the driver as the previous flushes are ready.
+ * @param max_busy wait while more buffers than this are being flushed or waiting to be flushed
+ */
+static void flush_wait(uint32_t max_busy)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
+
+    swap_chain_flush_next();
+    if((draw_buf->flushing ? 1 : 0) + draw_buf->queue_cnt <= max_busy) return;
+
+    uint32_t start = lv_tick_get();
+    disp_refr->flush_stat.wait_cnt++;
+    while((draw_buf->flushing ? 1 : 0) + draw_buf->queue_cnt > max_busy) {
+        if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
+        swap_chain_flush_next();
+    }
+    disp_refr->flush_stat.wait_time += lv_tick_elaps(start);
+}
+
+/**
+ * Tell whether a frame can be started on a display driven by vsync.
+ * The first call after a frame only saves the vsync counter and the frame is started on the next vsync.
+ * This way the vsyncs passed while the display was idle or rendering the previous frame are skipped.
+ * @param disp pointer to a display
+ * @return true: a new vsync came, start the frame
+ */
+static bool vsync_is_due(lv_disp_t * disp)
+{
+    uint32_t cnt = disp->driver->vsync_cnt;
+    if(!disp->vsync_armed) {
+        disp->vsync_seen = cnt;
+        disp->vsync_armed = 1;
+        return false;
+    }
+
+    if(cnt == disp->vsync_seen) return false;
+
+    /*The timer couldn't run on time for every vsync*/
+    disp->frame_stat.dropped_cnt += cnt - disp->vsync_seen - 1;
+    disp->vsync_armed = 0;
+    return true;
+}
+
+/**
+ * Save the time of a frame among the recent ones
+ * @param disp pointer to a display
+ * @param time duration of the frame in milliseconds
+ */
+static void frame_time_add(lv_disp_t * disp, uint32_t time)
+{
+    disp->frame_times[disp->frame_time_p] = time > UINT16_MAX ? UINT16_MAX : time;
+    disp->frame_time_p++;
+    if(disp->frame_time_p >= LV_DISP_FRAME_TIME_CNT) disp->frame_time_p = 0;
+    if(disp->frame_time_cnt < LV_DISP_FRAME_TIME_CNT) disp->frame_time_cnt++;
+}
+
+/**
+ * Get the area to flush in the display's native orientation.
+ * With software rotation the draw buffer is rendered directly in the native orientation
+ * so only the coordinates need to be rotated.
+ * @param area the area of the draw buffer in the rotated orientation
+ * @param flush_area store the area to pass to `flush_cb` here
+ */
+static void get_flush_area(const lv_area_t * area, lv_area_t * flush_area)
+{
+    lv_disp_drv_t * drv = disp_refr->driver;
+    if(!drv->sw_rotate) {
+        lv_area_copy(flush_area, area);
+        return;
+    }
+
+    switch(drv->rotated) {
+        case LV_DISP_ROT_90:
+            flush_area->x1 = area->y1;
+            flush_area->x2 = area->y2;
+            flush_area->y1 = drv->ver_res - area->x2 - 1;
+            flush_area->y2 = drv->ver_res - area->x1 - 1;
+            break;
+        case LV_DISP_ROT_180:
+            flush_area->x1 = drv->hor_res - area->x2 - 1;
+            flush_area->x2 = drv->hor_res - area->x1 - 1;
+            flush_area->y1 = drv->ver_res - area->y2 - 1;
+            flush_area->y2 = drv->ver_res - area->y1 - 1;
+            break;
+        case LV_DISP_ROT_270:
+            flush_area->x1 = drv->hor_res - area->y2 - 1;
+            flush_area->x2 = drv->hor_res - area->y1 - 1;
+            flush_area->y1 = area->x1;
+            flush_area->y2 = area->x2;
+            break;
+        default:
+            lv_area_copy(flush_area, area);
+            break;
+    }
+}
+
+/**
+ * Get the color format to convert the rendered pixels to
+ * @return the color format of the display or `LV_DISP_COLOR_FORMAT_NATIVE` if no conversion is required
+ */
+static lv_disp_color_format_t get_color_format(void)
+{
+    lv_disp_drv_t * drv = disp_refr->driver;
+    if(drv->set_px_cb) return LV_DISP_COLOR_FORMAT_NATIVE;
+
+    lv_disp_color_format_t cf = drv->color_format;
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+    if(cf == LV_DISP_COLOR_FORMAT_RGB565) return LV_DISP_COLOR_FORMAT_NATIVE;
+#elif LV_COLOR_DEPTH == 16
+    if(cf == LV_DISP_COLOR_FORMAT_RGB565_SWAP) return LV_DISP_COLOR_FORMAT_NATIVE;
+#elif LV_COLOR_DEPTH == 32
+    if(cf == LV_DISP_COLOR_FORMAT_ARGB8888) return LV_DISP_COLOR_FORMAT_NATIVE;
+#endif
+    return cf;
+}
+
+/**
+ * Convert the rendered pixels in place to the color format of the display
+ * @param buf the rendered pixels
+ * @param px_cnt number of pixels in `buf`
+ */
+static void convert_color_format(lv_color_t * buf, uint32_t px_cnt)
+{
+    lv_disp_color_format_t cf = get_color_format();
+    if(cf == LV_DISP_COLOR_FORMAT_NATIVE) return;
+
+    lv_disp_drv_t * drv = disp_refr->driver;
+    uint8_t px_size = lv_disp_color_format_get_size(cf);
+    if(drv->direct_mode) {
+        LV_LOG_ERROR("cannot convert the color format of a direct mode display!");
+        return;
+    }
+    if(px_cnt * px_size > drv->draw_buf->size * sizeof(lv_color_t)) {
+        LV_LOG_ERROR("the draw buffer is too small for the color format");
+        return;
+    }
+
+    uint32_t i;
+#if LV_COLOR_DEPTH == 16
+    /*RGB565 and RGB565_SWAP differ only in the byte order*/
+    if(cf == LV_DISP_COLOR_FORMAT_RGB565 || cf == LV_DISP_COLOR_FORMAT_RGB565_SWAP) {
+        uint16_t * buf16 = (uint16_t *)buf;
+        for(i = 0; i < px_cnt; i++) buf16[i] = (uint16_t)((buf16[i] >> 8) | (buf16[i] << 8));
+        return;
+    }
+#endif
+
+    /*Go forward if the pixels shrink and backward if they grow
+     *so that a converted pixel never overwrites a pixel which is not converted yet*/
+    bool backward = px_size > sizeof(lv_color_t);
+    uint8_t * dest = (uint8_t *)buf;
+    uint32_t n;
+    for(n = 0; n < px_cnt; n++) {
+        i = backward ? px_cnt - 1 - n : n;
+        lv_color32_t c32;
+        c32.full = lv_color_to32(buf[i]);
+        uint8_t r = LV_COLOR_GET_R32(c32);
+        uint8_t g = LV_COLOR_GET_G32(c32);
+        uint8_t b = LV_COLOR_GET_B32(c32);
+        uint8_t * d = dest + i * px_size;
+        switch(cf) {
+            case LV_DISP_COLOR_FORMAT_RGB565:
+                d[0] = (uint8_t)(((g & 0x1C) << 3) | (b >> 3));
+                d[1] = (uint8_t)((r & 0xF8) | (g >> 5));
+                break;
+            case LV_DISP_COLOR_FORMAT_RGB565_SWAP:
+                d[0] = (uint8_t)((r & 0xF8) | (g >> 5));
+                d[1] = (uint8_t)(((g & 0x1C) << 3) | (b >> 3));
+                break;
+            case LV_DISP_COLOR_FORMAT_RGB888:
+                d[0] = b;
+                d[1] = g;
+                d[2] = r;
+                break;
+            case LV_DISP_COLOR_FORMAT_ARGB8888:
+                d[0] = b;
+                d[1] = g;
+                d[2] = r;
+                d[3] = 0xFF;
+                break;
+            case LV_DISP_COLOR_FORMAT_L8:
+                /*The same as `lv_color_brightness()`*/
+                d[0] = (uint8_t)((3u * r + b + 4u * g) >> 3);
+                break;
+            default:
+                return;
+        }
+    }
+}
+
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
 {
+    disp_refr->flush_stat.flush_cnt++;
     TRACE_REFR("Calling flush_cb on (%d;%d)(%d;%d) area with %p image pointer", area->x1, area->y1, area->x2, area->y2, color_p);
     drv->flush_cb(drv, area, color_p);
 }
@@ -26,6 +26,18 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/**
+ * An off-screen render target.
+ * The drawing functions render into the caller's buffer through it
+ * without registering a display or touching the screens.
+ */
+typedef struct {
+    lv_disp_t disp;                 /**< Display seen by the draw functions. Not registered.*/
+    lv_disp_drv_t driver;           /**< Driver of `disp`*/
+    lv_disp_draw_buf_t draw_buf;    /**< Describes the caller's buffer*/
+    lv_disp_t * disp_ori;           /**< The display being refreshed before `lv_refr_target_begin`*/
+} lv_refr_target_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -64,6 +76,15 @@ void lv_refr_now(lv_disp_t * disp);
  */
 void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p);
 
+/**
+ * Invalidate an area of an object. The areas of the same object are merged until the next refresh
+ * so an object updated many times in a frame takes only one place in the invalidated areas.
+ * @param disp pointer to the display of the object
+ * @param obj pointer to the object which invalidates
+ * @param area_p pointer to the area to invalidate
+ */
+void _lv_inv_obj_area(lv_disp_t * disp, const lv_obj_t * obj, const lv_area_t * area_p);
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -78,6 +99,48 @@ lv_disp_t * _lv_refr_get_disp_refreshing(void);
  */
 void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 
+/**
+ * Get the statistics about the invalidations of a display.
+ * Comparing `raw_cnt` and `coalesced_cnt` shows how many areas were merged instead of saved separately.
+ * @param disp pointer to a display. NULL to use the default display.
+ * @param stat store the statistics here
+ */
+void lv_refr_get_inv_stat(lv_disp_t * disp, lv_disp_inv_stat_t * stat);
+
+/**
+ * Reset the statistics about the invalidations of a display
+ * @param disp pointer to a display. NULL to use the default display.
+ */
+void lv_refr_reset_inv_stat(lv_disp_t * disp);
+
+/**
+ * Get the statistics about waiting for the display driver.
+ * A large `wait_time` means rendering is faster than flushing and more buffers might help.
+ * @param disp pointer to a display. NULL to use the default display.
+ * @param stat store the statistics here
+ */
+void lv_refr_get_flush_stat(lv_disp_t * disp, lv_disp_flush_stat_t * stat);
+
+/**
+ * Reset the statistics about waiting for the display driver
+ * @param disp pointer to a display. NULL to use the default display.
+ */
+void lv_refr_reset_flush_stat(lv_disp_t * disp);
+
+/**
+ * Get the statistics about the timing of the frames.
+ * The percentiles are calculated from the last `LV_DISP_FRAME_TIME_CNT` frames.
+ * @param disp pointer to a display. NULL to use the default display.
+ * @param stat store the statistics here
+ */
+void lv_refr_get_frame_stat(lv_disp_t * disp, lv_disp_frame_stat_t * stat);
+
+/**
+ * Reset the statistics about the timing of the frames
+ * @param disp pointer to a display. NULL to use the default display.
+ */
+void lv_refr_reset_frame_stat(lv_disp_t * disp);
+
 #if LV_USE_PERF_MONITOR
 /**
  * Get the average FPS since start up
@@ -86,6 +149,52 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 uint32_t lv_refr_get_fps_avg(void);
 #endif
 
+/**
+ * Initialize a render target on a buffer.
+ * `LV_IMG_CF_TRUE_COLOR` and `LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED` are rendered with the normal blend functions.
+ * `LV_IMG_CF_TRUE_COLOR_ALPHA` also uses them if `LV_COLOR_SCREEN_TRANSP` is enabled, else (and for the
+ * `LV_IMG_CF_ALPHA_...` formats) the slower generic `set_px_cb` is used.
+ * @param target    pointer to a render target to initialize
+ * @param buf       the buffer to render into. Its stride is the width of `buf_area`.
+ * @param buf_area  the area covered by `buf` in absolute coordinates
+ * @param cf        color format of `buf`
+ * @return          LV_RES_OK: initialized; LV_RES_INV: `cf` is not supported
+ */
+lv_res_t lv_refr_target_init(lv_refr_target_t * target, void * buf, const lv_area_t * buf_area, lv_img_cf_t cf);
+
+/**
+ * Redirect the drawing functions to a render target.
+ * Every `lv_draw_...` call renders into the target's buffer until `lv_refr_target_end` is called.
+ * @param target pointer to an initialized render target
+ */
+void lv_refr_target_begin(lv_refr_target_t * target);
+
+/**
+ * Stop rendering into a render target and restore the display which was being refreshed before.
+ * @param target pointer to render target passed to `lv_refr_target_begin`
+ */
+void lv_refr_target_end(lv_refr_target_t * target);
+
+/**
+ * Render an object and its children into a render target.
+ * Should be called between `lv_refr_target_begin` and `lv_refr_target_end`.
+ * @param target pointer to an active render target
+ * @param obj    pointer to an object to render
+ * @param clip   render only this area (absolute coordinates). NULL to render the whole target area.
+ */
+void lv_refr_target_draw_obj(lv_refr_target_t * target, lv_obj_t * obj, const lv_area_t * clip);
+
+/**
+ * Render an object and its children into a buffer.
+ * The buffer is not cleared: the object is blended on its current content.
+ * @param obj   pointer to an object to render
+ * @param area  the area to render in absolute coordinates. NULL to render the object's coordinates.
+ * @param cf    color format of `buf`. See `lv_refr_target_init`
+ * @param buf   the buffer to render into. Its size is `area`'s size and its stride is `area`'s width
+ * @return      LV_RES_OK: rendered; LV_RES_INV: `cf` is not supported
+ */
+lv_res_t lv_refr_obj_to_buf(lv_obj_t * obj, const lv_area_t * area, lv_img_cf_t cf, void * buf);
+
 /**
  * Called periodically to handle the refreshing
  * @param timer pointer to the timer itself
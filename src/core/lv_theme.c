@@ -7,27 +7,71 @@
  *      INCLUDES
  *********************/
 #include "../../lvgl.h"
+#include "../misc/lv_gc.h"
 
 /*********************
  *      DEFINES
  *********************/
+#if LV_USE_THEME_COMPILE
+#define SHEET_BUCKET_CNT    64
+#define SHEET_DROPPED       SHEET_BUCKET_CNT    /*Index of the list of the sheets removed from the lookup*/
+#define COLLECT_MAX         63                  /*Max. number of styles of an object*/
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_THEME_COMPILE
+/*Styles added by the theme(s) to an object and their compiled version.
+ *Allocated in one block, the shared style list follows the header.*/
+typedef struct _theme_sheet_t {
+    struct _theme_sheet_t * next;   /*Next sheet in the same hash bucket*/
+    _lv_obj_style_t * src;          /*The styles added by the theme(s) in the order of `obj->styles`*/
+    lv_style_t * compiled;          /*The styles referenced from the shared list*/
+    uint32_t hash;                  /*Hash of `src`*/
+    uint32_t ref_cnt;               /*Number of objects using the shared list*/
+    uint16_t src_cnt;
+    uint16_t style_cnt;
+    uint8_t dropped;                /*Removed from the lookup as a style of `src` was reset*/
+} theme_sheet_t;
+
+/*Styles added by the theme(s) while they are applied on an object*/
+typedef struct {
+    lv_obj_t * obj;                 /*NULL if the styles are added to the object normally*/
+    _lv_obj_style_t * buf;          /*Filled from the end to get the order of `obj->styles`*/
+    uint32_t cnt;
+} collect_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void apply_theme(lv_theme_t * th, lv_obj_t * obj);
+#if LV_USE_THEME_COMPILE
+static void collect_flush(collect_t * c);
+static void apply_compiled(collect_t * c);
+static uint32_t sheet_hash(const _lv_obj_style_t * src, uint32_t src_cnt);
+static theme_sheet_t * sheet_find(const _lv_obj_style_t * src, uint32_t src_cnt, uint32_t hash);
+static theme_sheet_t * sheet_create(const _lv_obj_style_t * src, uint32_t src_cnt, uint32_t hash);
+static void sheet_free(theme_sheet_t * sheet);
+static bool sheet_has_style(const theme_sheet_t * sheet, const lv_style_t * style);
+static bool sheet_compile(theme_sheet_t * sheet);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_THEME_COMPILE
+static collect_t * collect_act;
+#endif
 
 /**********************
  *      MACROS
  **********************/
+#if LV_USE_THEME_COMPILE
+#define SHEET_STYLES(sheet) ((_lv_obj_style_t *)((sheet) + 1))
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -51,7 +95,23 @@ void lv_theme_apply(lv_obj_t * obj)
 
     lv_obj_remove_style_all(obj);
 
+#if LV_USE_THEME_COMPILE
+    /*Collect the added styles into a scratch buffer instead of adding them one by one*/
+    collect_t c;
+    c.buf = lv_mem_buf_get(COLLECT_MAX * sizeof(_lv_obj_style_t));
+    c.obj = c.buf ? obj : NULL;
+    c.cnt = 0;
+    collect_t * collect_prev = collect_act;
+    collect_act = &c;
+#endif
+
     apply_theme(th, obj);    /*Apply the theme including the base theme(s)*/
+
+#if LV_USE_THEME_COMPILE
+    collect_act = collect_prev;
+    apply_compiled(&c);
+    if(c.buf) lv_mem_buf_release(c.buf);
+#endif
 }
 
 /**
@@ -107,6 +167,107 @@ lv_color_t lv_theme_get_color_secondary(lv_obj_t * obj)
     return th ? th->color_secondary : lv_palette_main(LV_PALETTE_BLUE);
 }
 
+#if LV_USE_THEME_COMPILE
+
+void _lv_theme_init(void)
+{
+    collect_act = NULL;
+    LV_GC_ROOT(_lv_theme_sheet_buckets) = lv_mem_alloc((SHEET_BUCKET_CNT + 1) * sizeof(void *));
+    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_theme_sheet_buckets));
+    if(LV_GC_ROOT(_lv_theme_sheet_buckets)) {
+        lv_memset_00(LV_GC_ROOT(_lv_theme_sheet_buckets), (SHEET_BUCKET_CNT + 1) * sizeof(void *));
+    }
+}
+
+bool _lv_theme_collect_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t selector)
+{
+    collect_t * c = collect_act;
+    if(c == NULL || c->obj != obj) return false;
+
+    if(c->cnt == COLLECT_MAX) {
+        collect_flush(c);
+        return false;
+    }
+
+    c->cnt++;
+    _lv_obj_style_t * obj_style = &c->buf[COLLECT_MAX - c->cnt];
+    lv_memset_00(obj_style, sizeof(_lv_obj_style_t));
+    obj_style->style = style;
+    obj_style->selector = selector;
+    return true;
+}
+
+void _lv_theme_unshare_styles(lv_obj_t * obj, bool keep)
+{
+    if(obj->styles_shared == 0) return;
+
+    theme_sheet_t * sheet = (theme_sheet_t *)obj->styles - 1;
+    obj->styles = NULL;
+    obj->style_cnt = 0;
+    obj->styles_shared = 0;
+
+    /*Go back to the not compiled styles*/
+    if(keep) {
+        obj->styles = lv_mem_alloc(sheet->src_cnt * sizeof(_lv_obj_style_t));
+        LV_ASSERT_MALLOC(obj->styles);
+        if(obj->styles) {
+            lv_memcpy(obj->styles, sheet->src, sheet->src_cnt * sizeof(_lv_obj_style_t));
+            obj->style_cnt = sheet->src_cnt;
+        }
+    }
+
+    sheet->ref_cnt--;
+    if(sheet->ref_cnt == 0) sheet_free(sheet);
+}
+
+bool _lv_theme_update_compiled(lv_style_t * style)
+{
+    theme_sheet_t ** buckets = (theme_sheet_t **)LV_GC_ROOT(_lv_theme_sheet_buckets);
+    if(buckets == NULL) return false;
+
+    bool updated = false;
+    uint32_t b;
+    for(b = 0; b <= SHEET_DROPPED; b++) {
+        theme_sheet_t * sheet;
+        for(sheet = buckets[b]; sheet; sheet = sheet->next) {
+            if(style && !sheet_has_style(sheet, style)) continue;
+
+            /*The styles keep their address so the objects using them remain valid*/
+            sheet_compile(sheet);
+            updated = true;
+        }
+    }
+
+    return updated;
+}
+
+void _lv_theme_style_reset(const lv_style_t * style)
+{
+    theme_sheet_t ** buckets = (theme_sheet_t **)LV_GC_ROOT(_lv_theme_sheet_buckets);
+    if(buckets == NULL) return;
+
+    uint32_t b;
+    for(b = 0; b < SHEET_BUCKET_CNT; b++) {
+        theme_sheet_t ** act_p = &buckets[b];
+        while(*act_p) {
+            theme_sheet_t * sheet = *act_p;
+            if(!sheet_has_style(sheet, style)) {
+                act_p = &sheet->next;
+                continue;
+            }
+
+            /*The style's address might be reused by an other style so don't find the sheet by it anymore.
+             *The sheet is still updated and used by the objects having it.*/
+            *act_p = sheet->next;
+            sheet->next = buckets[SHEET_DROPPED];
+            buckets[SHEET_DROPPED] = sheet;
+            sheet->dropped = 1;
+        }
+    }
+}
+
+#endif /*LV_USE_THEME_COMPILE*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -116,3 +277,274 @@ static void apply_theme(lv_theme_t * th, lv_obj_t * obj)
     if(th->parent) apply_theme(th->parent, obj);
     if(th->apply_cb) th->apply_cb(th, obj);
 }
+
+#if LV_USE_THEME_COMPILE
+
+/**
+ * Stop collecting the styles of an object and add the collected ones normally
+ * @param c pointer to the collected styles
+ */
+static void collect_flush(collect_t * c)
+{
+    lv_obj_t * obj = c->obj;
+    c->obj = NULL;
+
+    /*In the order the theme(s) added them*/
+    uint32_t i;
+    for(i = 0; i < c->cnt; i++) {
+        const _lv_obj_style_t * obj_style = &c->buf[COLLECT_MAX - 1 - i];
+        lv_obj_add_style(obj, obj_style->style, obj_style->selector);
+    }
+    c->cnt = 0;
+}
+
+/**
+ * Give the compiled version of the collected styles to the object.
+ * If the same styles were added to an other object the compiled list is shared.
+ * @param c pointer to the collected styles
+ */
+static void apply_compiled(collect_t * c)
+{
+    lv_obj_t * obj = c->obj;
+    if(obj == NULL || c->cnt == 0) return;
+
+    /*Share the list only if the theme(s) added no local styles*/
+    theme_sheet_t * sheet = NULL;
+    if(obj->style_cnt == 0) {
+        const _lv_obj_style_t * src = &c->buf[COLLECT_MAX - c->cnt];
+        uint32_t hash = sheet_hash(src, c->cnt);
+        sheet = sheet_find(src, c->cnt, hash);
+        if(sheet == NULL) sheet = sheet_create(src, c->cnt, hash);
+    }
+
+    if(sheet == NULL) {
+        collect_flush(c);   /*Keep the not compiled styles*/
+        return;
+    }
+
+    c->obj = NULL;
+    sheet->ref_cnt++;
+    lv_mem_free(obj->styles);
+    obj->styles = SHEET_STYLES(sheet);
+    obj->style_cnt = sheet->style_cnt;
+    obj->styles_shared = 1;
+
+    lv_obj_refresh_style(obj, LV_PART_ANY, LV_STYLE_PROP_ANY);
+}
+
+/**
+ * Calculate a hash from the styles and selectors added by the theme(s). It depends on their order.
+ * @param src the styles added by the theme(s)
+ * @param src_cnt number of styles in `src`
+ * @return the hash
+ */
+static uint32_t sheet_hash(const _lv_obj_style_t * src, uint32_t src_cnt)
+{
+    /*FNV-1a of the style pointers and selectors*/
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < src_cnt; i++) {
+        const uint8_t * p = (const uint8_t *)&src[i].style;
+        uint32_t j;
+        for(j = 0; j < sizeof(lv_style_t *); j++) {
+            hash = (hash ^ p[j]) * 16777619u;
+        }
+        hash = (hash ^ src[i].selector) * 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * Find the compiled version of a style list
+ * @param src the styles added by the theme(s)
+ * @param src_cnt number of styles in `src`
+ * @param hash hash of `src`
+ * @return the compiled style list or NULL if not found
+ */
+static theme_sheet_t * sheet_find(const _lv_obj_style_t * src, uint32_t src_cnt, uint32_t hash)
+{
+    theme_sheet_t ** buckets = (theme_sheet_t **)LV_GC_ROOT(_lv_theme_sheet_buckets);
+    if(buckets == NULL) return NULL;
+
+    theme_sheet_t * sheet;
+    for(sheet = buckets[hash % SHEET_BUCKET_CNT]; sheet; sheet = sheet->next) {
+        if(sheet->hash != hash || sheet->src_cnt != src_cnt) continue;
+
+        uint32_t i;
+        for(i = 0; i < src_cnt; i++) {
+            if(sheet->src[i].style != src[i].style || sheet->src[i].selector != src[i].selector) break;
+        }
+        if(i == src_cnt) return sheet;
+    }
+
+    return NULL;
+}
+
+/**
+ * Create a compiled style list with one style for each selector
+ * @param src the styles added by the theme(s)
+ * @param src_cnt number of styles in `src`
+ * @param hash hash of `src`
+ * @return the new compiled style list or NULL on error
+ */
+static theme_sheet_t * sheet_create(const _lv_obj_style_t * src, uint32_t src_cnt, uint32_t hash)
+{
+    theme_sheet_t ** buckets = (theme_sheet_t **)LV_GC_ROOT(_lv_theme_sheet_buckets);
+    if(buckets == NULL) return NULL;
+
+    /*Count the different selectors*/
+    uint32_t style_cnt = 0;
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < src_cnt; i++) {
+        for(j = 0; j < i; j++) {
+            if(src[j].selector == src[i].selector) break;
+        }
+        if(j == i) style_cnt++;
+    }
+
+    /*The header, the shared list, the compiled styles and the source styles in one block*/
+    theme_sheet_t * sheet = lv_mem_alloc(sizeof(theme_sheet_t) + style_cnt * sizeof(_lv_obj_style_t) +
+                                         style_cnt * sizeof(lv_style_t) + src_cnt * sizeof(_lv_obj_style_t));
+    LV_ASSERT_MALLOC(sheet);
+    if(sheet == NULL) return NULL;
+
+    lv_memset_00(sheet, sizeof(theme_sheet_t));
+    _lv_obj_style_t * styles = SHEET_STYLES(sheet);
+    sheet->compiled = (lv_style_t *)(styles + style_cnt);
+    sheet->src = (_lv_obj_style_t *)(sheet->compiled + style_cnt);
+    lv_memcpy(sheet->src, src, src_cnt * sizeof(_lv_obj_style_t));
+    sheet->src_cnt = src_cnt;
+    sheet->hash = hash;
+
+    /*Keep the order of the first occurrence of the selectors*/
+    for(i = 0; i < src_cnt; i++) {
+        for(j = 0; j < sheet->style_cnt; j++) {
+            if(styles[j].selector == src[i].selector) break;
+        }
+        if(j < sheet->style_cnt) continue;
+
+        lv_style_init(&sheet->compiled[j]);
+        lv_memset_00(&styles[j], sizeof(_lv_obj_style_t));
+        styles[j].style = &sheet->compiled[j];
+        styles[j].selector = src[i].selector;
+        sheet->style_cnt++;
+    }
+
+    sheet_compile(sheet);
+
+    uint32_t b = hash % SHEET_BUCKET_CNT;
+    sheet->next = buckets[b];
+    buckets[b] = sheet;
+
+    return sheet;
+}
+
+/**
+ * Remove a compiled style list from its list and free it
+ * @param sheet pointer to a compiled style list not used by any objects
+ */
+static void sheet_free(theme_sheet_t * sheet)
+{
+    theme_sheet_t ** buckets = (theme_sheet_t **)LV_GC_ROOT(_lv_theme_sheet_buckets);
+    theme_sheet_t ** act_p = &buckets[sheet->dropped ? SHEET_DROPPED : sheet->hash % SHEET_BUCKET_CNT];
+    while(*act_p) {
+        if(*act_p == sheet) {
+            *act_p = sheet->next;
+            break;
+        }
+        act_p = &(*act_p)->next;
+    }
+
+    uint32_t i;
+    for(i = 0; i < sheet->style_cnt; i++) {
+        if(sheet->compiled[i].is_const) lv_mem_free((void *)sheet->compiled[i].v_p.const_props);
+    }
+    lv_mem_free(sheet);
+}
+
+/**
+ * Check if a style was added by the theme(s) to the objects using a compiled style list
+ * @param sheet pointer to a compiled style list
+ * @param style pointer to a style
+ * @return true: `style` is a source style of `sheet`
+ */
+static bool sheet_has_style(const theme_sheet_t * sheet, const lv_style_t * style)
+{
+    uint32_t i;
+    for(i = 0; i < sheet->src_cnt; i++) {
+        if(sheet->src[i].style == style) return true;
+    }
+    return false;
+}
+
+/**
+ * Merge the properties of the source styles with the same selector into constant styles.
+ * The styles are searched in `obj->styles` order and the first one having a property wins,
+ * so the property set in the first source style having it is used.
+ * @param sheet pointer to a compiled style list
+ * @return true: compiled successfully; false: out of memory
+ */
+static bool sheet_compile(theme_sheet_t * sheet)
+{
+    bool ok = true;
+    uint32_t s;
+    for(s = 0; s < sheet->style_cnt; s++) {
+        lv_style_t * style = &sheet->compiled[s];
+        lv_style_selector_t selector = SHEET_STYLES(sheet)[s].selector;
+
+        /*Free the properties of the previous compilation*/
+        if(style->is_const) lv_mem_free((void *)style->v_p.const_props);
+
+        uint32_t prop_max = 0;
+        uint32_t i;
+        for(i = 0; i < sheet->src_cnt; i++) {
+            if(sheet->src[i].selector == selector) prop_max += _lv_style_get_prop_cnt(sheet->src[i].style);
+        }
+
+        lv_style_const_prop_t * props = lv_mem_alloc((prop_max + 1) * sizeof(lv_style_const_prop_t));
+        LV_ASSERT_MALLOC(props);
+        if(props == NULL) {
+            /*Leave an empty style*/
+            lv_style_init(style);
+            ok = false;
+            continue;
+        }
+
+        uint32_t prop_cnt = 0;
+        uint8_t has_group = 0;
+        for(i = 0; i < sheet->src_cnt; i++) {
+            if(sheet->src[i].selector != selector) continue;
+
+            const lv_style_t * src_style = sheet->src[i].style;
+            uint32_t src_prop_cnt = _lv_style_get_prop_cnt(src_style);
+            uint32_t p;
+            for(p = 0; p < src_prop_cnt; p++) {
+                lv_style_const_prop_t prop;
+                _lv_style_get_prop_at(src_style, p, &prop);
+
+                /*Skip if already set by a style with higher precedence*/
+                uint32_t k;
+                for(k = 0; k < prop_cnt; k++) {
+                    if(props[k].prop == prop.prop) break;
+                }
+                if(k < prop_cnt) continue;
+
+                props[prop_cnt] = prop;
+                prop_cnt++;
+                has_group |= 1 << _lv_style_get_prop_group(prop.prop);
+            }
+        }
+        props[prop_cnt].prop = LV_STYLE_PROP_INV;
+
+        style->v_p.const_props = props;
+        style->is_const = 1;
+        style->has_group = has_group;
+        style->prop_cnt = prop_cnt > UINT8_MAX ? UINT8_MAX : prop_cnt;
+    }
+
+    return ok;
+}
+
+#endif /*LV_USE_THEME_COMPILE*/
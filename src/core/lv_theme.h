@@ -104,6 +104,52 @@ lv_color_t lv_theme_get_color_primary(lv_obj_t * obj);
  */
 lv_color_t lv_theme_get_color_secondary(lv_obj_t * obj);
 
+#if LV_USE_THEME_COMPILE
+
+//! @cond Doxygen_Suppress
+
+/**
+ * Initialize the compiled style lists of the themes.
+ * Called by LVGL in `lv_init()`
+ */
+void _lv_theme_init(void);
+
+/**
+ * Collect a style added by the theme(s) while `lv_theme_apply()` runs instead of adding it to the object.
+ * Called by `lv_obj_add_style()`
+ * @param obj       pointer to an object
+ * @param style     pointer to the added style
+ * @param selector  the selector of the style
+ * @return          true: the style was collected; false: add the style normally
+ */
+bool _lv_theme_collect_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t selector);
+
+/**
+ * Release the shared compiled style list of an object. The list is freed if no other object uses it.
+ * @param obj       pointer to an object
+ * @param keep      true: give the styles added by the theme(s) back to the object; false: leave no styles
+ */
+void _lv_theme_unshare_styles(lv_obj_t * obj, bool keep);
+
+/**
+ * Compile the styles again from which the shared style lists were compiled
+ * Called by `lv_obj_report_style_change()`
+ * @param style     the changed style or NULL to compile all style lists again
+ * @return          true: at least one compiled style list was updated
+ */
+bool _lv_theme_update_compiled(lv_style_t * style);
+
+/**
+ * Don't find the compiled style lists by a style anymore as it might be freed and its address reused.
+ * Called by `lv_style_reset()`
+ * @param style     the reset style
+ */
+void _lv_theme_style_reset(const lv_style_t * style);
+
+//! @endcond
+
+#endif /*LV_USE_THEME_COMPILE*/
+
 /**********************
  *    MACROS
  **********************/
@@ -19,6 +19,7 @@ extern "C" {
 #include "../misc/lv_txt.h"
 #include "lv_img_decoder.h"
 #include "lv_img_cache.h"
+#include "lv_img_filter.h"
 
 #include "lv_draw_rect.h"
 #include "lv_draw_label.h"
@@ -28,6 +29,7 @@ extern "C" {
 #include "lv_draw_arc.h"
 #include "lv_draw_blend.h"
 #include "lv_draw_mask.h"
+#include "lv_draw_raster.h"
 
 /*********************
  *      DEFINES
@@ -4,11 +4,13 @@ CSRCS += lv_draw_img.c
 CSRCS += lv_draw_label.c
 CSRCS += lv_draw_line.c
 CSRCS += lv_draw_mask.c
+CSRCS += lv_draw_raster.c
 CSRCS += lv_draw_rect.c
 CSRCS += lv_draw_triangle.c
 CSRCS += lv_img_buf.c
 CSRCS += lv_img_cache.c
 CSRCS += lv_img_decoder.c
+CSRCS += lv_img_filter.c
 
 DEPPATH += --dep-path $(LVGL_DIR)/$(LVGL_DIR_NAME)/src/draw
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/draw
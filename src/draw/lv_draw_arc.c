@@ -9,6 +9,7 @@
 #include "lv_draw_arc.h"
 #include "lv_draw_rect.h"
 #include "lv_draw_mask.h"
+#include "lv_draw_raster.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_mem.h"
@@ -40,6 +41,9 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 #if LV_DRAW_COMPLEX
+static void draw_arc_raster(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius, uint16_t start_angle,
+                            uint16_t end_angle, lv_coord_t width, const lv_area_t * clip_area,
+                            const lv_draw_arc_dsc_t * dsc);
 static void draw_quarter_0(quarter_draw_dsc_t * q);
 static void draw_quarter_1(quarter_draw_dsc_t * q);
 static void draw_quarter_2(quarter_draw_dsc_t * q);
@@ -78,17 +82,18 @@ void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uin
     lv_coord_t width = dsc->width;
     if(width > radius) width = radius;
 
+    /*Arcs with color are rasterized directly, only the image filled arcs need the masks*/
+    if(dsc->img_src == NULL) {
+        draw_arc_raster(center_x, center_y, radius, start_angle, end_angle, width, clip_area, dsc);
+        return;
+    }
+
     lv_draw_rect_dsc_t cir_dsc;
     lv_draw_rect_dsc_init(&cir_dsc);
     cir_dsc.blend_mode = dsc->blend_mode;
-    if(dsc->img_src) {
-        cir_dsc.bg_opa = LV_OPA_TRANSP;
-        cir_dsc.bg_img_src = dsc->img_src;
-        cir_dsc.bg_img_opa = dsc->opa;
-    } else {
-        cir_dsc.bg_opa = dsc->opa;
-        cir_dsc.bg_color = dsc->color;
-    }
+    cir_dsc.bg_opa = LV_OPA_TRANSP;
+    cir_dsc.bg_img_src = dsc->img_src;
+    cir_dsc.bg_img_opa = dsc->opa;
 
     lv_area_t area_out;
     area_out.x1 = center_x - radius;
@@ -314,6 +319,47 @@ void lv_draw_arc_get_area(lv_coord_t x, lv_coord_t y, uint16_t radius,  uint16_t
  **********************/
 
 #if LV_DRAW_COMPLEX
+/**
+ * Draw an arc with the rasterizer. Only the edges of the arc are anti-aliased
+ * and the fully covered parts of the rows are filled without mask.
+ */
+static void draw_arc_raster(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius, uint16_t start_angle,
+                            uint16_t end_angle, lv_coord_t width, const lv_area_t * clip_area,
+                            const lv_draw_arc_dsc_t * dsc)
+{
+    lv_area_t area_out;
+    area_out.x1 = center_x - radius;
+    area_out.y1 = center_y - radius;
+    area_out.x2 = center_x + radius - 1;  /*-1 because the center already belongs to the left/bottom part*/
+    area_out.y2 = center_y + radius - 1;
+    if(!_lv_area_is_on(&area_out, clip_area)) return;
+
+    bool full = start_angle + 360 == end_angle || start_angle == end_angle + 360;
+    int32_t start = start_angle;
+    int32_t end = end_angle;
+    if(full) {
+        start = 0;
+        end = 360;
+    }
+    else {
+        while(start >= 360) start -= 360;
+        while(end >= 360) end -= 360;
+        if(start == end) return;
+        if(end < start) end += 360;
+    }
+
+    lv_draw_raster_point_t center;
+    center.x = center_x << LV_DRAW_RASTER_SHIFT;
+    center.y = center_y << LV_DRAW_RASTER_SHIFT;
+
+    lv_draw_raster_t raster;
+    lv_draw_raster_init(&raster);
+    lv_draw_raster_add_arc(&raster, &center, radius << LV_DRAW_RASTER_SHIFT, width << LV_DRAW_RASTER_SHIFT,
+                           start, end, dsc->rounded);
+    lv_draw_raster_draw(&raster, clip_area, dsc->color, dsc->opa, dsc->blend_mode);
+    lv_draw_raster_free(&raster);
+}
+
 static void draw_quarter_0(quarter_draw_dsc_t * q)
 {
     lv_area_t quarter_area;
@@ -66,6 +66,23 @@ static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color
 static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
 #endif
 
+static void fill_rotated(const lv_area_t * disp_area, lv_color_t * disp_buf,  const lv_area_t * draw_area,
+                         lv_color_t color, lv_opa_t opa,
+                         const lv_opa_t * mask, lv_draw_mask_res_t mask_res, lv_blend_mode_t mode, lv_disp_rot_t rot);
+
+static void map_rotated(const lv_area_t * disp_area, lv_color_t * disp_buf,  const lv_area_t * draw_area,
+                        const lv_area_t * map_area, const lv_color_t * map_buf, lv_opa_t opa,
+                        const lv_opa_t * mask, lv_draw_mask_res_t mask_res, lv_blend_mode_t mode, lv_disp_rot_t rot);
+
+static inline void blend_px(lv_disp_t * disp, lv_color_t * px, lv_color_t color, lv_opa_t opa, lv_blend_mode_t mode);
+static inline lv_opa_t rot_opa(lv_opa_t opa, lv_opa_t mask);
+static lv_color_t * rot_px(const lv_area_t * disp_area, lv_color_t * disp_buf, int32_t x, int32_t y, lv_disp_rot_t rot,
+                           int32_t * x_step, int32_t * y_step);
+static void rot_area(const lv_area_t * disp_area, const lv_area_t * area, lv_disp_rot_t rot,
+                     lv_area_t * rot_disp_area, lv_area_t * res_area);
+static void set_px(lv_disp_t * disp, const lv_area_t * disp_area, lv_color_t * disp_buf, int32_t x, int32_t y,
+                   lv_color_t color, lv_opa_t opa);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -153,9 +170,24 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
         for(i = 0; i < mask_w; i++)  mask[i] = mask[i] > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
     }
 
+    /*With software rotation the buffer is in the display's native orientation.
+     *Without mask the area is a rectangle there too so it can be filled normally.*/
+    lv_disp_rot_t rot = disp->driver->sw_rotate ? disp->driver->rotated : LV_DISP_ROT_NONE;
+    lv_area_t rot_disp_area;
+    if(rot != LV_DISP_ROT_NONE && mask_res == LV_DRAW_MASK_RES_FULL_COVER && !disp->driver->set_px_cb) {
+        lv_area_t rot_draw_area;
+        rot_area(disp_area, &draw_area, rot, &rot_disp_area, &rot_draw_area);
+        disp_area = &rot_disp_area;
+        draw_area = rot_draw_area;
+        rot = LV_DISP_ROT_NONE;
+    }
+
     if(disp->driver->set_px_cb) {
         fill_set_px(disp_area, disp_buf, &draw_area, color, opa, mask, mask_res);
     }
+    else if(rot != LV_DISP_ROT_NONE) {
+        fill_rotated(disp_area, disp_buf, &draw_area, color, opa, mask, mask_res, mode, rot);
+    }
     else if(mode == LV_BLEND_MODE_NORMAL) {
         fill_normal(disp_area, disp_buf, &draw_area, color, opa, mask, mask_res);
     }
@@ -216,9 +248,13 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
         int32_t i;
         for(i = 0; i < mask_w; i++)  mask[i] = mask[i] > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
     }
+    lv_disp_rot_t rot = disp->driver->sw_rotate ? disp->driver->rotated : LV_DISP_ROT_NONE;
     if(disp->driver->set_px_cb) {
         map_set_px(disp_area, disp_buf, &draw_area, map_area, map_buf, opa, mask, mask_res);
     }
+    else if(rot != LV_DISP_ROT_NONE) {
+        map_rotated(disp_area, disp_buf, &draw_area, map_area, map_buf, opa, mask, mask_res, mode, rot);
+    }
     else if(mode == LV_BLEND_MODE_NORMAL) {
         map_normal(disp_area, disp_buf, &draw_area, map_area, map_buf, opa, mask, mask_res);
     }
@@ -229,6 +265,16 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
 #endif
 }
 
+lv_color_t * _lv_blend_get_buf_px(lv_coord_t x, lv_coord_t y, int32_t * x_step, int32_t * y_step)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp);
+    lv_disp_rot_t rot = disp->driver->sw_rotate ? disp->driver->rotated : LV_DISP_ROT_NONE;
+
+    return rot_px(&draw_buf->area, draw_buf->buf_act, x - draw_buf->area.x1, y - draw_buf->area.y1, rot,
+                  x_step, y_step);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -240,16 +286,13 @@ static void fill_set_px(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
 
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
 
-    /*Get the width of the `disp_area` it will be used to go to the next line*/
-    int32_t disp_w = lv_area_get_width(disp_area);
-
     int32_t x;
     int32_t y;
 
     if(mask_res == LV_DRAW_MASK_RES_FULL_COVER) {
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
             for(x = draw_area->x1; x <= draw_area->x2; x++) {
-                disp->driver->set_px_cb(disp->driver, (void *)disp_buf, disp_w, x, y, color, opa);
+                set_px(disp, disp_area, disp_buf, x, y, color, opa);
             }
         }
     }
@@ -265,8 +308,7 @@ static void fill_set_px(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
             for(x = draw_area->x1; x <= draw_area->x2; x++) {
                 if(mask_tmp[x]) {
-                    disp->driver->set_px_cb(disp->driver, (void *)disp_buf, disp_w, x, y, color,
-                                           (uint32_t)((uint32_t)opa * mask_tmp[x]) >> 8);
+                    set_px(disp, disp_area, disp_buf, x, y, color, (uint32_t)((uint32_t)opa * mask_tmp[x]) >> 8);
                 }
             }
             mask_tmp += draw_area_w;
@@ -579,9 +621,6 @@ static void map_set_px(const lv_area_t * disp_area, lv_color_t * disp_buf,  cons
 {
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
 
-    /*Get the width of the `disp_area` it will be used to go to the next line*/
-    int32_t disp_w = lv_area_get_width(disp_area);
-
     /*Get the width of the `draw_area` it will be used to go to the next line of the mask*/
     int32_t draw_area_w = lv_area_get_width(draw_area);
 
@@ -599,7 +638,7 @@ static void map_set_px(const lv_area_t * disp_area, lv_color_t * disp_buf,  cons
     if(mask_res == LV_DRAW_MASK_RES_FULL_COVER) {
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
             for(x = draw_area->x1; x <= draw_area->x2; x++) {
-                disp->driver->set_px_cb(disp->driver, (void *)disp_buf, disp_w, x, y, map_buf_tmp[x], opa);
+                set_px(disp, disp_area, disp_buf, x, y, map_buf_tmp[x], opa);
             }
             map_buf_tmp += map_w;
         }
@@ -613,8 +652,7 @@ static void map_set_px(const lv_area_t * disp_area, lv_color_t * disp_buf,  cons
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
             for(x = draw_area->x1; x <= draw_area->x2; x++) {
                 if(mask_tmp[x]) {
-                    disp->driver->set_px_cb(disp->driver, (void *)disp_buf, disp_w, x, y, map_buf_tmp[x],
-                                           (uint32_t)((uint32_t)opa * mask_tmp[x]) >> 8);
+                    set_px(disp, disp_area, disp_buf, x, y, map_buf_tmp[x], (uint32_t)((uint32_t)opa * mask_tmp[x]) >> 8);
                 }
             }
             mask_tmp += draw_area_w;
@@ -1021,3 +1059,256 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
     return lv_color_mix(fg, bg, opa);
 }
 #endif
+
+/**
+ * Fill an area of a draw buffer which is in the display's native orientation (software rotation)
+ * @param disp_area the current display area (destination area)
+ * @param disp_buf destination buffer
+ * @param draw_area fill this area (relative to `disp_area`, in the rotated orientation)
+ * @param color fill color
+ * @param opa overall opacity in 0x00..0xff range
+ * @param mask a mask to apply on every pixel (uint8_t array with 0x00..0xff values).
+ *                It fits into draw_area.
+ * @param mask_res LV_MASK_RES_COVER: the mask has only 0xff values (no mask),
+ *                 LV_MASK_RES_TRANSP: the mask has only 0x00 values (full transparent),
+ *                 LV_MASK_RES_CHANGED: the mask has mixed values
+ * @param mode blend mode from `lv_blend_mode_t`
+ * @param rot rotation of the display
+ */
+static void fill_rotated(const lv_area_t * disp_area, lv_color_t * disp_buf,  const lv_area_t * draw_area,
+                         lv_color_t color, lv_opa_t opa,
+                         const lv_opa_t * mask, lv_draw_mask_res_t mask_res, lv_blend_mode_t mode, lv_disp_rot_t rot)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+
+    /*Go along the rotated rows and columns with the steps of the native buffer*/
+    int32_t x_step;
+    int32_t y_step;
+    lv_color_t * disp_buf_row = rot_px(disp_area, disp_buf, draw_area->x1, draw_area->y1, rot, &x_step, &y_step);
+    int32_t draw_area_w = lv_area_get_width(draw_area);
+
+    int32_t x;
+    int32_t y;
+    for(y = draw_area->y1; y <= draw_area->y2; y++) {
+        lv_color_t * disp_buf_tmp = disp_buf_row;
+        for(x = 0; x < draw_area_w; x++) {
+            lv_opa_t opa_tmp = rot_opa(opa, mask_res == LV_DRAW_MASK_RES_FULL_COVER ? LV_OPA_COVER : mask[x]);
+            blend_px(disp, disp_buf_tmp, color, opa_tmp, mode);
+            disp_buf_tmp += x_step;
+        }
+        disp_buf_row += y_step;
+        if(mask_res != LV_DRAW_MASK_RES_FULL_COVER) mask += draw_area_w;
+    }
+}
+
+/**
+ * Copy an image to a draw buffer which is in the display's native orientation (software rotation)
+ * @param disp_area the current display area (destination area)
+ * @param disp_buf destination buffer
+ * @param draw_area draw this area (relative to `disp_area`, in the rotated orientation)
+ * @param map_area coordinates of the map (image) to copy. (absolute coordinates)
+ * @param map_buf the pixel of the image
+ * @param opa overall opacity in 0x00..0xff range
+ * @param mask a mask to apply on every pixel (uint8_t array with 0x00..0xff values).
+ *                It fits into draw_area.
+ * @param mask_res LV_MASK_RES_COVER: the mask has only 0xff values (no mask),
+ *                 LV_MASK_RES_TRANSP: the mask has only 0x00 values (full transparent),
+ *                 LV_MASK_RES_CHANGED: the mask has mixed values
+ * @param mode blend mode from `lv_blend_mode_t`
+ * @param rot rotation of the display
+ */
+static void map_rotated(const lv_area_t * disp_area, lv_color_t * disp_buf,  const lv_area_t * draw_area,
+                        const lv_area_t * map_area, const lv_color_t * map_buf, lv_opa_t opa,
+                        const lv_opa_t * mask, lv_draw_mask_res_t mask_res, lv_blend_mode_t mode, lv_disp_rot_t rot)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+
+    int32_t x_step;
+    int32_t y_step;
+    lv_color_t * disp_buf_row = rot_px(disp_area, disp_buf, draw_area->x1, draw_area->y1, rot, &x_step, &y_step);
+    int32_t draw_area_w = lv_area_get_width(draw_area);
+
+    /*Create a temp. map_buf which always point to the first pixel to draw in the current line*/
+    int32_t map_w = lv_area_get_width(map_area);
+    const lv_color_t * map_buf_tmp = map_buf + map_w * (draw_area->y1 - (map_area->y1 - disp_area->y1));
+    map_buf_tmp += (draw_area->x1 - (map_area->x1 - disp_area->x1));
+
+    int32_t x;
+    int32_t y;
+    for(y = draw_area->y1; y <= draw_area->y2; y++) {
+        lv_color_t * disp_buf_tmp = disp_buf_row;
+        for(x = 0; x < draw_area_w; x++) {
+            lv_opa_t opa_tmp = rot_opa(opa, mask_res == LV_DRAW_MASK_RES_FULL_COVER ? LV_OPA_COVER : mask[x]);
+            blend_px(disp, disp_buf_tmp, map_buf_tmp[x], opa_tmp, mode);
+            disp_buf_tmp += x_step;
+        }
+        disp_buf_row += y_step;
+        map_buf_tmp += map_w;
+        if(mask_res != LV_DRAW_MASK_RES_FULL_COVER) mask += draw_area_w;
+    }
+}
+
+/**
+ * Blend a color into a pixel of the draw buffer
+ * @param disp the display being refreshed
+ * @param px pointer to the pixel
+ * @param color the color to blend
+ * @param opa opacity of `color`
+ * @param mode blend mode from `lv_blend_mode_t`
+ */
+static inline void blend_px(lv_disp_t * disp, lv_color_t * px, lv_color_t color, lv_opa_t opa, lv_blend_mode_t mode)
+{
+    LV_UNUSED(disp);
+    if(opa == LV_OPA_TRANSP) return;
+
+#if LV_DRAW_COMPLEX
+    if(mode == LV_BLEND_MODE_ADDITIVE) {
+        *px = color_blend_true_color_additive(color, *px, opa);
+        return;
+    }
+    else if(mode == LV_BLEND_MODE_SUBTRACTIVE) {
+        *px = color_blend_true_color_subtractive(color, *px, opa);
+        return;
+    }
+#else
+    LV_UNUSED(mode);
+#endif
+
+    if(opa == LV_OPA_COVER) {
+        *px = color;
+    }
+#if LV_COLOR_SCREEN_TRANSP
+    else if(disp->driver->screen_transp) {
+        lv_color_mix_with_alpha(*px, px->ch.alpha, color, opa, px, &px->ch.alpha);
+    }
+#endif
+    else {
+        *px = lv_color_mix(color, *px, opa);
+    }
+}
+
+/**
+ * Get the opacity of a pixel the same way as `fill_normal` and `map_normal` do
+ * @param opa overall opacity
+ * @param mask the mask value of the pixel
+ * @return the opacity to blend the pixel with
+ */
+static inline lv_opa_t rot_opa(lv_opa_t opa, lv_opa_t mask)
+{
+    if(opa > LV_OPA_MAX) return mask;
+    else if(mask == LV_OPA_COVER) return opa;
+    else return (uint32_t)((uint32_t)mask * opa) >> 8;
+}
+
+/**
+ * Get a pixel of a draw buffer which might be in the display's native orientation (software rotation)
+ * @param disp_area the current display area (destination area)
+ * @param disp_buf destination buffer
+ * @param x X coordinate relative to `disp_area` in the rotated orientation
+ * @param y Y coordinate relative to `disp_area` in the rotated orientation
+ * @param rot rotation of the display
+ * @param x_step store here how many pixels to step in `disp_buf` to go to `x + 1`
+ * @param y_step store here how many pixels to step in `disp_buf` to go to `y + 1`
+ * @return pointer to the pixel
+ */
+static lv_color_t * rot_px(const lv_area_t * disp_area, lv_color_t * disp_buf, int32_t x, int32_t y, lv_disp_rot_t rot,
+                           int32_t * x_step, int32_t * y_step)
+{
+    int32_t w = lv_area_get_width(disp_area);
+    int32_t h = lv_area_get_height(disp_area);
+
+    /*With 90 and 270 degree the native buffer is `h` wide*/
+    switch(rot) {
+        case LV_DISP_ROT_90:
+            *x_step = -h;
+            *y_step = 1;
+            return disp_buf + (w - 1 - x) * h + y;
+        case LV_DISP_ROT_180:
+            *x_step = -1;
+            *y_step = -w;
+            return disp_buf + (h - 1 - y) * w + (w - 1 - x);
+        case LV_DISP_ROT_270:
+            *x_step = h;
+            *y_step = -1;
+            return disp_buf + x * h + (h - 1 - y);
+        default:
+            *x_step = 1;
+            *y_step = w;
+            return disp_buf + y * w + x;
+    }
+}
+
+/**
+ * Convert an area to the display's native orientation (software rotation)
+ * @param disp_area the current display area (destination area)
+ * @param area an area relative to `disp_area` in the rotated orientation
+ * @param rot rotation of the display
+ * @param rot_disp_area store the area of the draw buffer in the native orientation here (with 0;0 origo)
+ * @param res_area store `area` in the native orientation here, relative to `rot_disp_area`
+ */
+static void rot_area(const lv_area_t * disp_area, const lv_area_t * area, lv_disp_rot_t rot,
+                     lv_area_t * rot_disp_area, lv_area_t * res_area)
+{
+    lv_coord_t w = lv_area_get_width(disp_area);
+    lv_coord_t h = lv_area_get_height(disp_area);
+
+    rot_disp_area->x1 = 0;
+    rot_disp_area->y1 = 0;
+    if(rot == LV_DISP_ROT_180) {
+        rot_disp_area->x2 = w - 1;
+        rot_disp_area->y2 = h - 1;
+        res_area->x1 = w - 1 - area->x2;
+        res_area->x2 = w - 1 - area->x1;
+        res_area->y1 = h - 1 - area->y2;
+        res_area->y2 = h - 1 - area->y1;
+    }
+    else {
+        rot_disp_area->x2 = h - 1;
+        rot_disp_area->y2 = w - 1;
+        if(rot == LV_DISP_ROT_90) {
+            res_area->x1 = area->y1;
+            res_area->x2 = area->y2;
+            res_area->y1 = w - 1 - area->x2;
+            res_area->y2 = w - 1 - area->x1;
+        }
+        else {
+            res_area->x1 = h - 1 - area->y2;
+            res_area->x2 = h - 1 - area->y1;
+            res_area->y1 = area->x1;
+            res_area->y2 = area->x2;
+        }
+    }
+}
+
+/**
+ * Call the display driver's `set_px_cb` with coordinates in the draw buffer's native orientation
+ * @param disp the display being refreshed
+ * @param disp_area the current display area (destination area)
+ * @param disp_buf destination buffer
+ * @param x X coordinate relative to `disp_area` in the rotated orientation
+ * @param y Y coordinate relative to `disp_area` in the rotated orientation
+ * @param color the color of the pixel
+ * @param opa opacity of the pixel
+ */
+static void set_px(lv_disp_t * disp, const lv_area_t * disp_area, lv_color_t * disp_buf, int32_t x, int32_t y,
+                   lv_color_t color, lv_opa_t opa)
+{
+    lv_disp_rot_t rot = disp->driver->sw_rotate ? disp->driver->rotated : LV_DISP_ROT_NONE;
+    lv_coord_t w = lv_area_get_width(disp_area);
+    lv_coord_t h = lv_area_get_height(disp_area);
+
+    switch(rot) {
+        case LV_DISP_ROT_90:
+            disp->driver->set_px_cb(disp->driver, (void *)disp_buf, h, y, w - 1 - x, color, opa);
+            break;
+        case LV_DISP_ROT_180:
+            disp->driver->set_px_cb(disp->driver, (void *)disp_buf, w, w - 1 - x, h - 1 - y, color, opa);
+            break;
+        case LV_DISP_ROT_270:
+            disp->driver->set_px_cb(disp->driver, (void *)disp_buf, h, h - 1 - y, x, color, opa);
+            break;
+        default:
+            disp->driver->set_px_cb(disp->driver, (void *)disp_buf, w, x, y, color, opa);
+            break;
+    }
+}
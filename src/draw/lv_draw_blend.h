@@ -38,6 +38,18 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
                                          const lv_color_t * map_buf,
                                          lv_opa_t * mask, lv_draw_mask_res_t mask_res, lv_opa_t opa, lv_blend_mode_t mode);
 
+/**
+ * Get a pixel of the current draw buffer and the steps to its neighbors.
+ * With software rotation the draw buffer is in the display's native orientation
+ * so the steps are not simply 1 and the width of the buffer.
+ * @param x         absolute X coordinate in the rotated orientation
+ * @param y         absolute Y coordinate in the rotated orientation
+ * @param x_step    store here how many pixels to step in the buffer to go to `x + 1`
+ * @param y_step    store here how many pixels to step in the buffer to go to `y + 1`
+ * @return          pointer to the pixel in the draw buffer
+ */
+lv_color_t * _lv_blend_get_buf_px(lv_coord_t x, lv_coord_t y, int32_t * x_step, int32_t * y_step);
+
 //! @endcond
 /**********************
  *      MACROS
@@ -19,6 +19,9 @@
 #define LABEL_RECOLOR_PAR_LENGTH 6
 #define LV_LABEL_HINT_UPDATE_TH 1024 /*Update the "hint" if the label's y coordinates have changed more then this*/
 
+/*The glyphs of a line are collected into a buffer of `hor_res * GLYPH_RUN_BUF_LINES` coverage values*/
+#define GLYPH_RUN_BUF_LINES     4
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -29,6 +32,19 @@ enum {
 };
 typedef uint8_t cmd_state_t;
 
+/*The glyphs of a line rendered into one coverage buffer and blended together*/
+typedef struct {
+    lv_opa_t * buf;             /*Coverage of the glyphs. Its stride is `max_w` until flushing.*/
+    uint32_t buf_size;
+    lv_area_t band;             /*The part of the line which can be drawn (the line clipped to the clip area)*/
+    lv_coord_t x1;              /*Left edge of the collected glyphs*/
+    lv_coord_t x2;              /*Right edge of the collected glyphs. `x2 < x1` means the run is empty.*/
+    lv_coord_t max_w;           /*The widest run which fits into `buf`*/
+    lv_color_t color;
+    lv_opa_t opa;
+    lv_blend_mode_t blend_mode;
+} glyph_run_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -39,11 +55,35 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
 static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g, const lv_area_t * clip_area,
                               const uint8_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
 #endif
+LV_ATTRIBUTE_FAST_MEM static void unpack_row(lv_opa_t * dst, const uint8_t * map_p, uint32_t bit_ofs, int32_t px_cnt,
+                                             uint32_t bpp);
+static void glyph_run_start(glyph_run_t * run, lv_opa_t * buf, uint32_t buf_size, const lv_area_t * band);
+LV_ATTRIBUTE_FAST_MEM static void glyph_run_add(glyph_run_t * run, const lv_point_t * pos, const lv_area_t * clip_area,
+                                                const lv_font_t * font, uint32_t letter, lv_color_t color,
+                                                lv_opa_t opa, lv_blend_mode_t blend_mode);
+LV_ATTRIBUTE_FAST_MEM static void glyph_run_flush(glyph_run_t * run, const lv_area_t * clip_area);
 static uint8_t hex_char_to_num(char hex);
+static const lv_draw_label_line_t * layout_get(lv_draw_label_hint_t * hint, const char * txt,
+                                               const lv_draw_label_dsc_t * dsc, lv_base_dir_t base_dir, int32_t max_w);
+static bool is_paragraph_start(const char * txt, uint32_t pos);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*Opacity of the pixels of a nibble (half byte) with 1 and 2 bpp*/
+#define BPP1_NIBBLE(n) {((n) >> 3 & 1) * 255, ((n) >> 2 & 1) * 255, ((n) >> 1 & 1) * 255, ((n) & 1) * 255}
+#define BPP2_NIBBLE(n) {((n) >> 2) * 85, ((n) & 3) * 85}
+static const uint8_t bpp1_nibble_opa[16][4] = {
+    BPP1_NIBBLE(0), BPP1_NIBBLE(1), BPP1_NIBBLE(2), BPP1_NIBBLE(3), BPP1_NIBBLE(4), BPP1_NIBBLE(5),
+    BPP1_NIBBLE(6), BPP1_NIBBLE(7), BPP1_NIBBLE(8), BPP1_NIBBLE(9), BPP1_NIBBLE(10), BPP1_NIBBLE(11),
+    BPP1_NIBBLE(12), BPP1_NIBBLE(13), BPP1_NIBBLE(14), BPP1_NIBBLE(15)
+};
+
+static const uint8_t bpp2_nibble_opa[16][2] = {
+    BPP2_NIBBLE(0), BPP2_NIBBLE(1), BPP2_NIBBLE(2), BPP2_NIBBLE(3), BPP2_NIBBLE(4), BPP2_NIBBLE(5),
+    BPP2_NIBBLE(6), BPP2_NIBBLE(7), BPP2_NIBBLE(8), BPP2_NIBBLE(9), BPP2_NIBBLE(10), BPP2_NIBBLE(11),
+    BPP2_NIBBLE(12), BPP2_NIBBLE(13), BPP2_NIBBLE(14), BPP2_NIBBLE(15)
+};
 
 /**********************
  *  GLOBAL VARIABLES
@@ -108,7 +148,7 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label_dsc_init(lv_draw_label_dsc_t * dsc)
  * @param dsc pointer to draw descriptor
  * @param txt `\0` terminated text to write
  * @param hint pointer to a `lv_draw_label_hint_t` variable.
- * It is managed by the draw to speed up the drawing of very long texts (thousands of lines).
+ * It is managed by the draw to cache the layout of the lines and speed up the drawing of long texts.
  */
 LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask,
                                          const lv_draw_label_dsc_t * dsc,
@@ -118,7 +158,7 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 
     if(dsc->opa <= LV_OPA_MIN) return;
     const lv_font_t * font = dsc->font;
-    int32_t w;
+    int32_t w = 0;
 
     /*No need to waste processor time if string is empty*/
     if (txt == NULL || txt[0] == '\0')
@@ -133,11 +173,19 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 
     lv_bidi_calculate_align(&align, &base_dir, txt);
 
-    if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
+    /*Use the cached line breaks and widths if a hint is available*/
+    const lv_draw_label_line_t * lines = NULL;
+    if(hint) {
+        int32_t max_w = (dsc->flag & LV_TEXT_FLAG_EXPAND) ? LV_COORD_MAX : lv_area_get_width(coords);
+        lines = layout_get(hint, txt, dsc, base_dir, max_w);
+    }
+
+    /*The width is needed only to find the line breaks if they are not cached*/
+    if(lines == NULL && (dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
     }
-    else {
+    else if(lines == NULL) {
         /*If EXAPND is enabled then not limit the text's width to the object's width*/
         lv_point_t p;
         lv_txt_get_size(&p, txt, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX,
@@ -161,10 +209,24 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     pos.y += y_ofs;
 
     uint32_t line_start     = 0;
+    uint32_t line_end       = 0;
+    uint32_t line_id        = 0;
     int32_t last_line_start = -1;
 
+    if(lines) {
+        /*Jump directly to the first visible line*/
+        if(pos.y + line_height_font < mask->y1) {
+            if(line_height <= 0) return;
+            line_id = (mask->y1 - line_height_font - pos.y + line_height - 1) / line_height;
+            if(line_id >= hint->line_cnt) return;
+            pos.y += line_id * line_height;
+        }
+        line_start = lines[line_id].start;
+        line_end = lines[line_id + 1].start;
+        if(txt[line_start] == '\0') return;
+    }
     /*Check the hint to use the cached info*/
-    if(hint && y_ofs == 0 && coords->y1 < 0) {
+    else if(hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_ABS(hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
             hint->line_start = -1;
@@ -173,15 +235,17 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     }
 
     /*Use the hint if it's valid*/
-    if(hint && last_line_start >= 0) {
+    if(lines == NULL && hint && last_line_start >= 0) {
         line_start = last_line_start;
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+    if(lines == NULL) {
+        line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+    }
 
     /*Go the first visible line*/
-    while(pos.y + line_height_font < mask->y1) {
+    while(lines == NULL && pos.y + line_height_font < mask->y1) {
         /*Go to next line*/
         line_start = line_end;
         line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
@@ -199,14 +263,16 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(lines) line_width = lines[line_id].width;
+        else line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(lines) line_width = lines[line_id].width;
+        else line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -240,16 +306,35 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     draw_dsc_sel.bg_color = dsc->sel_bg_color;
 
     int32_t pos_x_start = pos.x;
+
+    /*Collect the glyphs of a line and blend them at once*/
+    glyph_run_t run;
+    uint32_t run_buf_size = lv_disp_get_hor_res(_lv_refr_get_disp_refreshing()) * GLYPH_RUN_BUF_LINES;
+    lv_opa_t * run_buf = lv_mem_buf_get(run_buf_size);
+
     /*Write out all lines*/
     while(txt[line_start] != '\0') {
         pos.x += x_ofs;
 
+        lv_area_t band;
+        band.x1 = mask->x1;
+        band.x2 = mask->x2;
+        band.y1 = LV_MAX(pos.y, mask->y1);
+        band.y2 = LV_MIN(pos.y + line_height_font - 1, mask->y2);
+        glyph_run_start(&run, run_buf, run_buf_size, &band);
+
         /*Write all letter of a line*/
         cmd_state = CMD_STATE_WAIT;
         i         = 0;
 #if LV_USE_BIDI
-        char * bidi_txt = lv_mem_buf_get(line_end - line_start + 1);
-        _lv_bidi_process_paragraph(txt + line_start, bidi_txt, line_end - line_start, base_dir, NULL, 0);
+        char * bidi_txt;
+        if(lines) {
+            bidi_txt = hint->bidi_txt + line_start;
+        }
+        else {
+            bidi_txt = lv_mem_buf_get(line_end - line_start + 1);
+            _lv_bidi_process_paragraph(txt + line_start, bidi_txt, line_end - line_start, base_dir, NULL, 0);
+        }
 #else
         const char * bidi_txt = txt + line_start;
 #endif
@@ -327,13 +412,15 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
                 }
             }
 
-            lv_draw_letter(&pos, mask, font, letter, color, opa, dsc->blend_mode);
+            glyph_run_add(&run, &pos, mask, font, letter, color, opa, dsc->blend_mode);
 
             if(letter_w > 0) {
                 pos.x += letter_w + dsc->letter_space;
             }
         }
 
+        glyph_run_flush(&run, mask);
+
         if(dsc->decor & LV_TEXT_DECOR_STRIKETHROUGH) {
             lv_point_t p1;
             lv_point_t p2;
@@ -355,42 +442,288 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
         }
 
 #if LV_USE_BIDI
-        lv_mem_buf_release(bidi_txt);
+        if(lines == NULL) lv_mem_buf_release(bidi_txt);
         bidi_txt = NULL;
 #endif
         /*Go to next line*/
-        line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        if(lines) {
+            if(line_id < hint->line_cnt) line_id++;
+            line_start = lines[line_id].start;
+            line_end = line_id < hint->line_cnt ? lines[line_id + 1].start : line_start;
+        }
+        else {
+            line_start = line_end;
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(lines) line_width = lines[line_id].width;
+            else line_width =
+                     lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(lines) line_width = lines[line_id].width;
+            else line_width =
+                     lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
         /*Go the next line position*/
         pos.y += line_height;
 
-        if(pos.y > mask->y2) return;
+        if(pos.y > mask->y2) break;
     }
 
+    lv_mem_buf_release(run_buf);
+
     LV_ASSERT_MEM_INTEGRITY();
 }
 
+void lv_draw_label_hint_reset(lv_draw_label_hint_t * hint)
+{
+    if(hint->lines) lv_mem_free(hint->lines);
+#if LV_USE_BIDI
+    if(hint->bidi_txt) lv_mem_free(hint->bidi_txt);
+    hint->bidi_txt = NULL;
+#endif
+    hint->lines = NULL;
+    hint->line_cnt = 0;
+    hint->line_start = -1;
+}
+
+const lv_draw_label_line_t * lv_draw_label_hint_get_layout(lv_draw_label_hint_t * hint, const char * txt,
+                                                           const lv_draw_label_dsc_t * dsc, lv_coord_t max_w)
+{
+    /*Use the same parameters as `lv_draw_label` to share the cached layout*/
+    lv_text_align_t align = dsc->align;
+    lv_base_dir_t base_dir = dsc->bidi_dir;
+    lv_bidi_calculate_align(&align, &base_dir, txt);
+
+    if(dsc->flag & LV_TEXT_FLAG_EXPAND) max_w = LV_COORD_MAX;
+    return layout_get(hint, txt, dsc, base_dir, max_w);
+}
+
+void lv_draw_label_hint_edit(lv_draw_label_hint_t * hint, const char * txt, uint32_t pos, uint32_t del_len,
+                             uint32_t ins_len)
+{
+    hint->line_start = -1;
+    if(hint->lines == NULL) return;
+
+    /*With expand the longest line gives the width so it's simpler to calculate everything again*/
+    if(hint->flag & LV_TEXT_FLAG_EXPAND) {
+        lv_draw_label_hint_reset(hint);
+        return;
+    }
+
+    lv_draw_label_line_t * lines = hint->lines;
+    uint32_t line_cnt = hint->line_cnt;
+
+    /*Find the last line starting before the change and go back to the start of its paragraph
+     *because the words of the changed line might fit to the previous line now.*/
+    uint32_t first = 0;
+    uint32_t max = line_cnt;
+    while(first + 1 < max) {
+        uint32_t mid = (first + max) / 2;
+        if(lines[mid].start <= pos) first = mid;
+        else max = mid;
+    }
+    while(first > 0 && !is_paragraph_start(txt, lines[first].start)) first--;
+
+    /*Calculate the new lines until the end of the paragraph of the change.
+     *The next paragraphs are only moved.*/
+    int32_t diff = (int32_t)ins_len - (int32_t)del_len;
+    uint32_t new_cap = 8;
+    lv_draw_label_line_t * new_lines = lv_mem_buf_get(new_cap * sizeof(lv_draw_label_line_t));
+    if(new_lines == NULL) {
+        lv_draw_label_hint_reset(hint);
+        return;
+    }
+
+    uint32_t new_cnt = 0;
+    uint32_t line_start = first < line_cnt ? lines[first].start : 0;
+    while(txt[line_start] != '\0' && (line_start <= pos + ins_len || !is_paragraph_start(txt, line_start))) {
+        uint32_t len = _lv_txt_get_next_line(&txt[line_start], hint->font, hint->letter_space, hint->max_w, hint->flag);
+        if(len == 0) break;
+
+        if(new_cnt == new_cap) {
+            lv_draw_label_line_t * tmp = lv_mem_buf_get(new_cap * 2 * sizeof(lv_draw_label_line_t));
+            if(tmp == NULL) {
+                lv_mem_buf_release(new_lines);
+                lv_draw_label_hint_reset(hint);
+                return;
+            }
+            lv_memcpy(tmp, new_lines, new_cap * sizeof(lv_draw_label_line_t));
+            lv_mem_buf_release(new_lines);
+            new_lines = tmp;
+            new_cap *= 2;
+        }
+
+        new_lines[new_cnt].start = line_start;
+        new_lines[new_cnt].width = lv_txt_get_width(&txt[line_start], len, hint->font, hint->letter_space, hint->flag);
+        new_cnt++;
+        line_start += len;
+    }
+
+    /*Find the first not changed line (or the closing item at the end of the text) in the old layout*/
+    uint32_t old_start = line_start - diff;
+    uint32_t last = first;
+    while(last < line_cnt && lines[last].start < old_start) last++;
+
+    if(lines[last].start != old_start) {
+        /*The old layout doesn't match the text. It shouldn't happen.*/
+        lv_mem_buf_release(new_lines);
+        lv_draw_label_hint_reset(hint);
+        return;
+    }
+
+    uint32_t line_cnt_act = line_cnt - (last - first) + new_cnt;
+    if(line_cnt_act > line_cnt) {
+        lv_draw_label_line_t * tmp = lv_mem_realloc(lines, (line_cnt_act + 1) * sizeof(lv_draw_label_line_t));
+        if(tmp == NULL) {
+            lv_mem_buf_release(new_lines);
+            lv_draw_label_hint_reset(hint);
+            return;
+        }
+        lines = tmp;
+        hint->lines = lines;
+    }
+
+    /*Move the not changed lines with the closing item and update their start*/
+    memmove(&lines[first + new_cnt], &lines[last], (line_cnt - last + 1) * sizeof(lv_draw_label_line_t));
+    uint32_t i;
+    for(i = first + new_cnt; i <= line_cnt_act; i++) {
+        lines[i].start += diff;
+    }
+    lv_memcpy(&lines[first], new_lines, new_cnt * sizeof(lv_draw_label_line_t));
+    lv_mem_buf_release(new_lines);
+
+#if LV_USE_BIDI
+    /*Move the visual text of the next paragraphs and process the changed lines*/
+    uint32_t txt_len = lines[line_cnt_act].start;
+    if(diff > 0) {
+        char * tmp = lv_mem_realloc(hint->bidi_txt, txt_len + 1);
+        if(tmp == NULL) {
+            lv_draw_label_hint_reset(hint);
+            return;
+        }
+        hint->bidi_txt = tmp;
+    }
+    uint32_t changed_end = lines[first + new_cnt].start;
+    memmove(hint->bidi_txt + changed_end, hint->bidi_txt + changed_end - diff, txt_len - changed_end + 1);
+    for(i = first; i < first + new_cnt; i++) {
+        uint32_t len = lines[i + 1].start - lines[i].start;
+        _lv_bidi_process_paragraph(txt + lines[i].start, hint->bidi_txt + lines[i].start, len, hint->base_dir, NULL, 0);
+    }
+#endif
+
+    hint->line_cnt = line_cnt_act;
+    hint->txt = txt;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the cached layout of a text or calculate it if any parameter has changed
+ * @param hint pointer to a hint where the layout is cached
+ * @param txt the text to draw
+ * @param dsc pointer to draw descriptor
+ * @param base_dir the base direction of the text
+ * @param max_w the available width or `LV_COORD_MAX` with `LV_TEXT_FLAG_EXPAND`
+ * @return the lines of the text with a closing item or NULL on error
+ */
+static const lv_draw_label_line_t * layout_get(lv_draw_label_hint_t * hint, const char * txt,
+                                               const lv_draw_label_dsc_t * dsc, lv_base_dir_t base_dir, int32_t max_w)
+{
+    if(hint->lines && hint->txt == txt && hint->font == dsc->font && hint->max_w == max_w &&
+       hint->letter_space == dsc->letter_space && hint->flag == dsc->flag && hint->base_dir == base_dir) {
+        return hint->lines;
+    }
+
+    lv_draw_label_hint_reset(hint);
+
+    int32_t w = max_w;
+    if(dsc->flag & LV_TEXT_FLAG_EXPAND) {
+        lv_point_t p;
+        lv_txt_get_size(&p, txt, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX, dsc->flag);
+        w = p.x;
+    }
+
+    uint32_t cap = 8;
+    lv_draw_label_line_t * lines = lv_mem_alloc(cap * sizeof(lv_draw_label_line_t));
+    if(lines == NULL) return NULL;
+
+    uint32_t line_cnt = 0;
+    uint32_t line_start = 0;
+    while(txt[line_start] != '\0') {
+        uint32_t len = _lv_txt_get_next_line(&txt[line_start], dsc->font, dsc->letter_space, w, dsc->flag);
+        if(len == 0) break;
+
+        /*Keep space for the closing item too*/
+        if(line_cnt + 2 > cap) {
+            cap *= 2;
+            lv_draw_label_line_t * tmp = lv_mem_realloc(lines, cap * sizeof(lv_draw_label_line_t));
+            if(tmp == NULL) {
+                lv_mem_free(lines);
+                return NULL;
+            }
+            lines = tmp;
+        }
+
+        lines[line_cnt].start = line_start;
+        lines[line_cnt].width = lv_txt_get_width(&txt[line_start], len, dsc->font, dsc->letter_space, dsc->flag);
+        line_cnt++;
+        line_start += len;
+    }
+
+    lines[line_cnt].start = line_start;
+    lines[line_cnt].width = 0;
+
+#if LV_USE_BIDI
+    hint->bidi_txt = lv_mem_alloc(line_start + 1);
+    if(hint->bidi_txt == NULL) {
+        lv_mem_free(lines);
+        return NULL;
+    }
+
+    uint32_t i;
+    for(i = 0; i < line_cnt; i++) {
+        uint32_t len = lines[i + 1].start - lines[i].start;
+        _lv_bidi_process_paragraph(txt + lines[i].start, hint->bidi_txt + lines[i].start, len, base_dir, NULL, 0);
+    }
+    hint->bidi_txt[line_start] = '\0';
+#endif
+
+    hint->lines = lines;
+    hint->line_cnt = line_cnt;
+    hint->txt = txt;
+    hint->font = dsc->font;
+    hint->max_w = max_w;
+    hint->letter_space = dsc->letter_space;
+    hint->flag = dsc->flag;
+    hint->base_dir = base_dir;
+
+    return lines;
+}
+
+/**
+ * Tell whether a new paragraph starts at a position, i.e. the beginning of the text or after a line break
+ * @param txt a text
+ * @param pos byte index in `txt`
+ * @return true: a paragraph starts at `pos`
+ */
+static bool is_paragraph_start(const char * txt, uint32_t pos)
+{
+    return pos == 0 || txt[pos - 1] == '\n' || txt[pos - 1] == '\r';
+}
+
 /**
  * Draw a letter in the Virtual Display Buffer
  * @param pos_p left-top coordinate of the latter
@@ -461,72 +794,23 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
                                                      const lv_area_t * clip_area,
                                                      const uint8_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
 {
-    const uint8_t * bpp_opa_table_p;
-    uint32_t bitmask_init;
-    uint32_t bitmask;
     uint32_t bpp = g->bpp;
-    uint32_t shades;
     if(bpp == 3) bpp = 4;
-
-    switch(bpp) {
-        case 1:
-            bpp_opa_table_p = _lv_bpp1_opa_table;
-            bitmask_init  = 0x80;
-            shades = 2;
-            break;
-        case 2:
-            bpp_opa_table_p = _lv_bpp2_opa_table;
-            bitmask_init  = 0xC0;
-            shades = 4;
-            break;
-        case 4:
-            bpp_opa_table_p = _lv_bpp4_opa_table;
-            bitmask_init  = 0xF0;
-            shades = 16;
-            break;
-        case 8:
-            bpp_opa_table_p = _lv_bpp8_opa_table;
-            bitmask_init  = 0xFF;
-            shades = 256;
-            break;       /*No opa table, pixel value will be used directly*/
-        default:
-            LV_LOG_WARN("lv_draw_letter: invalid bpp");
-            return; /*Invalid bpp. Can't render the letter*/
-    }
-
-    static lv_opa_t opa_table[256];
-    static lv_opa_t prev_opa = LV_OPA_TRANSP;
-    static uint32_t prev_bpp = 0;
-    if(opa < LV_OPA_MAX) {
-        if(prev_opa != opa || prev_bpp != bpp) {
-            uint32_t i;
-            for(i = 0; i < shades; i++) {
-                opa_table[i] = bpp_opa_table_p[i] == LV_OPA_COVER ? opa : ((bpp_opa_table_p[i] * opa) >> 8);
-            }
-        }
-        bpp_opa_table_p = opa_table;
-        prev_opa = opa;
-        prev_bpp = bpp;
+    if(bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8) {
+        LV_LOG_WARN("lv_draw_letter: invalid bpp");
+        return; /*Invalid bpp. Can't render the letter*/
     }
 
-    int32_t col, row;
+    int32_t row;
     int32_t box_w = g->box_w;
     int32_t box_h = g->box_h;
-    int32_t width_bit = box_w * bpp; /*Letter width in bits*/
 
     /*Calculate the col/row start/end on the map*/
     int32_t col_start = pos_x >= clip_area->x1 ? 0 : clip_area->x1 - pos_x;
     int32_t col_end   = pos_x + box_w <= clip_area->x2 ? box_w : clip_area->x2 - pos_x + 1;
     int32_t row_start = pos_y >= clip_area->y1 ? 0 : clip_area->y1 - pos_y;
     int32_t row_end   = pos_y + box_h <= clip_area->y2 ? box_h : clip_area->y2 - pos_y + 1;
-
-    /*Move on the map too*/
-    uint32_t bit_ofs = (row_start * width_bit) + (col_start * bpp);
-    map_p += bit_ofs >> 3;
-
-    uint8_t letter_px;
-    uint32_t col_bit;
-    col_bit = bit_ofs & 0x7; /*"& 0x7" equals to "% 8" just faster*/
+    int32_t fill_w = col_end - col_start;
 
     lv_coord_t hor_res = lv_disp_get_hor_res(_lv_refr_get_disp_refreshing());
     uint32_t mask_buf_size = box_w * box_h > hor_res ? hor_res : box_w * box_h;
@@ -542,73 +826,41 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
     bool mask_any = lv_draw_mask_is_any(&fill_area);
 #endif
 
-    uint32_t col_bit_max = 8 - bpp;
-    uint32_t col_bit_row_ofs = (box_w + col_start - col_end) * bpp;
-
     for(row = row_start ; row < row_end; row++) {
-#if LV_DRAW_COMPLEX
-        int32_t mask_p_start = mask_p;
-#endif
-        bitmask = bitmask_init >> col_bit;
-        for(col = col_start; col < col_end; col++) {
-            /*Load the pixel's opacity into the mask*/
-            letter_px = (*map_p & bitmask) >> (col_bit_max - col_bit);
-            if(letter_px) {
-                mask_buf[mask_p] = bpp_opa_table_p[letter_px];
-            }
-            else {
-                mask_buf[mask_p] = 0;
-            }
-
-            /*Go to the next column*/
-            if(col_bit < col_bit_max) {
-                col_bit += bpp;
-                bitmask = bitmask >> bpp;
-            }
-            else {
-                col_bit = 0;
-                bitmask = bitmask_init;
-                map_p++;
-            }
-
-            /*Next mask byte*/
-            mask_p++;
-        }
+        /*Load the pixels' opacity into the mask*/
+        lv_memset_00(mask_buf + mask_p, fill_w);
+        unpack_row(mask_buf + mask_p, map_p, (row * box_w + col_start) * bpp, fill_w, bpp);
 
 #if LV_DRAW_COMPLEX
         /*Apply masks if any*/
         if(mask_any) {
-            lv_draw_mask_res_t mask_res = lv_draw_mask_apply(mask_buf + mask_p_start, fill_area.x1, fill_area.y2,
-                                                             lv_area_get_width(&fill_area));
+            lv_draw_mask_res_t mask_res = lv_draw_mask_apply(mask_buf + mask_p, fill_area.x1, fill_area.y2, fill_w);
             if(mask_res == LV_DRAW_MASK_RES_TRANSP) {
-                lv_memset_00(mask_buf + mask_p_start, lv_area_get_width(&fill_area));
+                lv_memset_00(mask_buf + mask_p, fill_w);
             }
         }
 #endif
+        mask_p += fill_w;
 
-        if((uint32_t) mask_p + (col_end - col_start) < mask_buf_size) {
+        if((uint32_t) mask_p + fill_w < mask_buf_size) {
             fill_area.y2 ++;
         }
         else {
             _lv_blend_fill(clip_area, &fill_area,
-                           color, mask_buf, LV_DRAW_MASK_RES_CHANGED, LV_OPA_COVER,
+                           color, mask_buf, LV_DRAW_MASK_RES_CHANGED, opa,
                            blend_mode);
 
             fill_area.y1 = fill_area.y2 + 1;
             fill_area.y2 = fill_area.y1;
             mask_p = 0;
         }
-
-        col_bit += col_bit_row_ofs;
-        map_p += (col_bit >> 3);
-        col_bit = col_bit & 0x7;
     }
 
     /*Flush the last part*/
     if(fill_area.y1 != fill_area.y2) {
         fill_area.y2--;
         _lv_blend_fill(clip_area, &fill_area,
-                       color, mask_buf, LV_DRAW_MASK_RES_CHANGED, LV_OPA_COVER,
+                       color, mask_buf, LV_DRAW_MASK_RES_CHANGED, opa,
                        blend_mode);
         mask_p = 0;
     }
@@ -616,6 +868,223 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
     lv_mem_buf_release(mask_buf);
 }
 
+/**
+ * Convert a row of a glyph's bitmap to opacity values.
+ * The pixels are decoded with table look ups on every half byte instead of shifting and masking every pixel.
+ * The values are merged with the content of `dst` by keeping the larger one so overlapping glyphs can be collected.
+ * @param dst       the opacity of the first pixel goes here
+ * @param map_p     pointer to the glyph's bitmap
+ * @param bit_ofs   index of the first bit of the first pixel in `map_p`
+ * @param px_cnt    number of pixels to convert
+ * @param bpp       bit-per-pixel of the bitmap: 1, 2, 4 or 8
+ */
+LV_ATTRIBUTE_FAST_MEM static void unpack_row(lv_opa_t * dst, const uint8_t * map_p, uint32_t bit_ofs, int32_t px_cnt,
+                                             uint32_t bpp)
+{
+    if(bpp == 8) {
+        map_p += bit_ofs >> 3;
+        while(px_cnt > 0) {
+            lv_opa_t v = _lv_bpp8_opa_table[*map_p];
+            if(v > *dst) *dst = v;
+            dst++;
+            map_p++;
+            px_cnt--;
+        }
+        return;
+    }
+
+    const uint8_t * table;
+    if(bpp == 1) table = bpp1_nibble_opa[0];
+    else if(bpp == 2) table = bpp2_nibble_opa[0];
+    else table = _lv_bpp4_opa_table;
+
+    uint32_t nibble_px = 4 / bpp;
+    uint32_t nibble_id = bit_ofs >> 2;
+    uint32_t skip = (bit_ofs & 0x3) / bpp;  /*Pixels of the first nibble before the first pixel*/
+    while(px_cnt > 0) {
+        uint8_t byte = map_p[nibble_id >> 1];
+        uint8_t nibble = (nibble_id & 1) ? byte & 0xF : byte >> 4;
+        if(nibble) {
+            const lv_opa_t * px = &table[nibble * nibble_px];
+            uint32_t k;
+            for(k = skip; k < nibble_px && px_cnt > 0; k++) {
+                if(px[k] > *dst) *dst = px[k];
+                dst++;
+                px_cnt--;
+            }
+        }
+        else {
+            /*Empty pixels are common and don't change `dst`*/
+            uint32_t n = LV_MIN(nibble_px - skip, (uint32_t)px_cnt);
+            dst += n;
+            px_cnt -= n;
+        }
+        skip = 0;
+        nibble_id++;
+    }
+}
+
+/**
+ * Start to collect the glyphs of a line
+ * @param run       pointer to a glyph run to initialize
+ * @param buf       a buffer for the coverage of the glyphs
+ * @param buf_size  size of `buf` in bytes
+ * @param band      the part of the line which needs to be drawn
+ */
+static void glyph_run_start(glyph_run_t * run, lv_opa_t * buf, uint32_t buf_size, const lv_area_t * band)
+{
+    run->buf = buf;
+    run->buf_size = buf_size;
+    run->band = *band;
+    run->x1 = 0;
+    run->x2 = -1;
+
+    lv_coord_t band_h = lv_area_get_height(band);
+    run->max_w = band_h > 0 ? buf_size / band_h : 0;
+    if(run->max_w > lv_area_get_width(band)) run->max_w = lv_area_get_width(band);
+}
+
+/**
+ * Add a glyph to a run. The glyphs which can't be collected (e.g. sub-pixel rendered glyphs, or glyphs
+ * which are out of the line) are drawn immediately.
+ * @param run       pointer to a glyph run
+ * @param pos       the top left corner of the letter's line position
+ * @param clip_area the letter will be drawn only on this area
+ * @param font      pointer to the font
+ * @param letter    the letter to draw
+ * @param color     color of the letter
+ * @param opa       opacity of the letter
+ * @param blend_mode blend mode of the letter
+ */
+LV_ATTRIBUTE_FAST_MEM static void glyph_run_add(glyph_run_t * run, const lv_point_t * pos, const lv_area_t * clip_area,
+                                                const lv_font_t * font, uint32_t letter, lv_color_t color,
+                                                lv_opa_t opa, lv_blend_mode_t blend_mode)
+{
+    if(opa < LV_OPA_MIN) return;
+    if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
+
+    if(run->max_w <= 0 || font->subpx) {
+        lv_draw_letter(pos, clip_area, font, letter, color, opa, blend_mode);
+        return;
+    }
+
+    lv_font_glyph_dsc_t g;
+    if(lv_font_get_glyph_dsc(font, &g, letter, '\0') == false) {
+        /*Let `lv_draw_letter` log the warning if required*/
+        lv_draw_letter(pos, clip_area, font, letter, color, opa, blend_mode);
+        return;
+    }
+
+    /*Don't draw anything if the character is empty. E.g. space*/
+    if((g.box_h == 0) || (g.box_w == 0)) return;
+
+    lv_area_t glyph_area;
+    glyph_area.x1 = pos->x + g.ofs_x;
+    glyph_area.y1 = pos->y + (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+    glyph_area.x2 = glyph_area.x1 + g.box_w - 1;
+    glyph_area.y2 = glyph_area.y1 + g.box_h - 1;
+
+    /*Draw the glyphs out of the line directly*/
+    if(glyph_area.y1 < pos->y || glyph_area.y2 >= pos->y + font->line_height) {
+        lv_draw_letter(pos, clip_area, font, letter, color, opa, blend_mode);
+        return;
+    }
+
+    lv_area_t draw_area;
+    if(_lv_area_intersect(&draw_area, &glyph_area, &run->band) == false) return;
+
+    uint32_t bpp = g.bpp;
+    if(bpp == 3) bpp = 4;
+    if(bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8) {
+        LV_LOG_WARN("lv_draw_letter: invalid bpp");
+        return;
+    }
+
+    const uint8_t * map_p = lv_font_get_glyph_bitmap(font, letter);
+    if(map_p == NULL) {
+        LV_LOG_WARN("lv_draw_letter: character's bitmap not found");
+        return;
+    }
+
+    /*Start a new run if the glyph can't be added to the current*/
+    if(run->x2 >= run->x1) {
+        if(color.full != run->color.full || opa != run->opa || blend_mode != run->blend_mode ||
+           draw_area.x1 < run->x1 || draw_area.x2 >= run->x1 + run->max_w) {
+            glyph_run_flush(run, clip_area);
+        }
+    }
+
+    if(run->x2 < run->x1) {
+        run->x1 = draw_area.x1;
+        run->x2 = draw_area.x1 - 1;
+        run->color = color;
+        run->opa = opa;
+        run->blend_mode = blend_mode;
+        lv_memset_00(run->buf, run->max_w * lv_area_get_height(&run->band));
+    }
+
+    /*Too wide glyph*/
+    if(draw_area.x2 >= run->x1 + run->max_w) {
+        lv_draw_letter(pos, clip_area, font, letter, color, opa, blend_mode);
+        return;
+    }
+
+    int32_t col_start = draw_area.x1 - glyph_area.x1;
+    int32_t row_start = draw_area.y1 - glyph_area.y1;
+    int32_t px_cnt = lv_area_get_width(&draw_area);
+    int32_t row_cnt = lv_area_get_height(&draw_area);
+    lv_opa_t * dst = run->buf + (draw_area.y1 - run->band.y1) * run->max_w + draw_area.x1 - run->x1;
+    int32_t row;
+    for(row = 0; row < row_cnt; row++) {
+        unpack_row(dst, map_p, ((row_start + row) * g.box_w + col_start) * bpp, px_cnt, bpp);
+        dst += run->max_w;
+    }
+
+    if(draw_area.x2 > run->x2) run->x2 = draw_area.x2;
+}
+
+/**
+ * Blend the collected glyphs and make the run empty
+ * @param run       pointer to a glyph run
+ * @param clip_area the glyphs will be drawn only on this area
+ */
+LV_ATTRIBUTE_FAST_MEM static void glyph_run_flush(glyph_run_t * run, const lv_area_t * clip_area)
+{
+    if(run->x2 < run->x1) return;
+
+    lv_area_t fill_area;
+    fill_area.x1 = run->x1;
+    fill_area.x2 = run->x2;
+    fill_area.y1 = run->band.y1;
+    fill_area.y2 = run->band.y2;
+
+    /*The blending needs the rows next to each other*/
+    int32_t w = lv_area_get_width(&fill_area);
+    int32_t h = lv_area_get_height(&fill_area);
+    int32_t row;
+    if(w != run->max_w) {
+        for(row = 1; row < h; row++) {
+            memmove(run->buf + row * w, run->buf + row * run->max_w, w);
+        }
+    }
+
+#if LV_DRAW_COMPLEX
+    /*Apply the masks once per row of the run*/
+    if(lv_draw_mask_is_any(&fill_area)) {
+        lv_opa_t * mask_buf = run->buf;
+        for(row = fill_area.y1; row <= fill_area.y2; row++) {
+            lv_draw_mask_res_t mask_res = lv_draw_mask_apply(mask_buf, fill_area.x1, row, w);
+            if(mask_res == LV_DRAW_MASK_RES_TRANSP) lv_memset_00(mask_buf, w);
+            mask_buf += w;
+        }
+    }
+#endif
+
+    _lv_blend_fill(clip_area, &fill_area, run->color, run->buf, LV_DRAW_MASK_RES_CHANGED, run->opa, run->blend_mode);
+
+    run->x2 = run->x1 - 1;
+}
+
 #if LV_DRAW_COMPLEX && LV_USE_FONT_SUBPX
 static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g, const lv_area_t * clip_area,
                               const uint8_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
@@ -683,17 +1152,13 @@ static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_
 
     lv_color_t * color_buf = lv_mem_buf_get(mask_buf_size * sizeof(lv_color_t));
 
-    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
-    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp);
-
-    int32_t disp_buf_width = lv_area_get_width(&draw_buf->area);
-    lv_color_t * disp_buf_buf_tmp = draw_buf->buf_act;
-
-    /*Set a pointer on draw_buf to the first pixel of the letter*/
-    disp_buf_buf_tmp += ((pos_y - draw_buf->area.y1) * disp_buf_width) + pos_x - draw_buf->area.x1;
-
-    /*If the letter is partially out of mask the move there on draw_buf*/
-    disp_buf_buf_tmp += (row_start * disp_buf_width) + col_start / 3;
+    /*Set a pointer on draw_buf to the first pixel of the letter.
+     *If the letter is partially out of mask the move there on draw_buf.
+     *With software rotation the next pixel and row are not simply after each other in draw_buf.*/
+    int32_t disp_buf_x_step;
+    int32_t disp_buf_y_step;
+    lv_color_t * disp_buf_buf_tmp = _lv_blend_get_buf_px(pos_x + col_start / 3, pos_y + row_start,
+                                                         &disp_buf_x_step, &disp_buf_y_step);
 
     bool mask_any = lv_draw_mask_is_any(&map_area);
     uint8_t font_rgb[3];
@@ -767,7 +1232,7 @@ static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_
 
                 /*Next mask byte*/
                 mask_p++;
-                disp_buf_buf_tmp++;
+                disp_buf_buf_tmp += disp_buf_x_step;
             }
 
             /*Go to the next column*/
@@ -808,7 +1273,7 @@ static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_
         col_bit = col_bit & 0x7;
 
         /*Next row in draw_buf*/
-        disp_buf_buf_tmp += disp_buf_width - (col_end - col_start) / 3;
+        disp_buf_buf_tmp += disp_buf_y_step - ((col_end - col_start) / 3) * disp_buf_x_step;
     }
 
     /*Flush the last part*/
@@ -46,6 +46,12 @@ typedef struct {
     lv_blend_mode_t blend_mode: 3;
 } lv_draw_label_dsc_t;
 
+/** A line of the cached text layout*/
+typedef struct {
+    uint32_t start;         /**< Byte index of the first letter of the line*/
+    lv_coord_t width;       /**< Width of the line in pixels*/
+} lv_draw_label_line_t;
+
 /** Store some info to speed up drawing of very large texts
  * It takes a lot of time to get the first visible character because
  * all the previous characters needs to be checked to calculate the positions.
@@ -61,6 +67,23 @@ typedef struct _lv_draw_label_hint_t {
     /** The 'y1' coordinate of the label when the hint was saved.
      * Used to invalidate the hint if the label has moved too much.*/
     int32_t coord_y;
+
+    /** The cached layout: start and width of every line and a closing item with the length of the text.
+     * NULL if not calculated yet. Rebuilt if any of the parameters below change.*/
+    lv_draw_label_line_t * lines;
+    uint32_t line_cnt;
+#if LV_USE_BIDI
+    /** The text in visual order, processed line by line*/
+    char * bidi_txt;
+#endif
+
+    /** The parameters the layout was calculated with*/
+    const char * txt;
+    const lv_font_t * font;
+    int32_t max_w;
+    lv_coord_t letter_space;
+    lv_text_flag_t flag;
+    lv_base_dir_t base_dir;
 } lv_draw_label_hint_t;
 
 /**********************
@@ -78,12 +101,43 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label_dsc_init(lv_draw_label_dsc_t * dsc);
  * @param dsc pointer to draw descriptor
  * @param txt `\0` terminated text to write
  * @param hint pointer to a `lv_draw_label_hint_t` variable.
- * It is managed by the draw to speed up the drawing of very long texts (thousands of lines).
+ * It is managed by the draw to cache the layout of the lines and speed up the drawing of long texts.
  */
 LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask,
                                          const lv_draw_label_dsc_t * dsc,
                                          const char * txt, lv_draw_label_hint_t * hint);
 
+/**
+ * Invalidate a hint and free its cached layout. Needs to be called if the text changes in place
+ * or the hint is not used anymore.
+ * @param hint pointer to a `lv_draw_label_hint_t` variable
+ */
+void lv_draw_label_hint_reset(lv_draw_label_hint_t * hint);
+
+/**
+ * Get the layout of the lines as `lv_draw_label` caches it in a hint.
+ * It's calculated only if it's not cached yet or any parameter has changed.
+ * @param hint pointer to a `lv_draw_label_hint_t` variable
+ * @param txt `\0` terminated text
+ * @param dsc pointer to draw descriptor
+ * @param max_w wrap the lines to this width. Ignored with `LV_TEXT_FLAG_EXPAND`.
+ * @return the start and width of `hint->line_cnt` lines and a closing item, or NULL on error
+ */
+const lv_draw_label_line_t * lv_draw_label_hint_get_layout(lv_draw_label_hint_t * hint, const char * txt,
+                                                           const lv_draw_label_dsc_t * dsc, lv_coord_t max_w);
+
+/**
+ * Update the cached layout of a hint after a part of its text has been replaced.
+ * Only the lines of the changed paragraphs are calculated again, the others are just moved.
+ * @param hint pointer to a `lv_draw_label_hint_t` variable
+ * @param txt the changed text (might be reallocated)
+ * @param pos byte index of the change
+ * @param del_len number of bytes removed from `pos`
+ * @param ins_len number of bytes inserted to `pos`
+ */
+void lv_draw_label_hint_edit(lv_draw_label_hint_t * hint, const char * txt, uint32_t pos, uint32_t del_len,
+                             uint32_t ins_len);
+
 LV_ATTRIBUTE_FAST_MEM void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * clip_area,
                                           const lv_font_t * font_p,
                                           uint32_t letter, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
@@ -9,6 +9,7 @@
 #include <stdbool.h>
 #include "lv_draw_mask.h"
 #include "lv_draw_blend.h"
+#include "lv_draw_raster.h"
 #include "../core/lv_refr.h"
 #include "../misc/lv_math.h"
 
@@ -34,6 +35,10 @@ LV_ATTRIBUTE_FAST_MEM static void draw_line_hor(const lv_point_t * point1, const
 LV_ATTRIBUTE_FAST_MEM static void draw_line_ver(const lv_point_t * point1, const lv_point_t * point2,
                                                 const lv_area_t * clip,
                                                 const lv_draw_line_dsc_t * dsc);
+#if LV_DRAW_COMPLEX
+static void raster_add_line(lv_draw_raster_t * raster, const lv_point_t * point1, const lv_point_t * point2,
+                            const lv_draw_line_dsc_t * dsc, bool round_start, bool round_end);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -82,7 +87,11 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_line(const lv_point_t * point1, const lv_poin
 
     if(point1->y == point2->y) draw_line_hor(point1, point2, &clip_line, dsc);
     else if(point1->x == point2->x) draw_line_ver(point1, point2, &clip_line, dsc);
-    else draw_line_skew(point1, point2, &clip_line, dsc);
+    else {
+        /*The round endings are drawn together with the line*/
+        draw_line_skew(point1, point2, &clip_line, dsc);
+        return;
+    }
 
     if(dsc->round_end || dsc->round_start) {
         lv_draw_rect_dsc_t cir_dsc;
@@ -113,6 +122,57 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_line(const lv_point_t * point1, const lv_poin
     }
 }
 
+/**
+ * Draw connected lines. The overlapping parts (e.g. the joints) are drawn only once
+ * so semi-transparent lines look correct too.
+ * @param points an array of points
+ * @param point_cnt number of points
+ * @param clip the lines will be drawn only in this area
+ * @param dsc pointer to an initialized `lv_draw_line_dsc_t` variable.
+ *            `round_start` rounds the first point, `round_end` all the others.
+ */
+void lv_draw_polyline(const lv_point_t points[], uint16_t point_cnt, const lv_area_t * clip,
+                      const lv_draw_line_dsc_t * dsc)
+{
+    if(point_cnt < 2) return;
+    if(dsc->width == 0) return;
+    if(dsc->opa <= LV_OPA_MIN) return;
+
+#if LV_DRAW_COMPLEX
+    bool dashed = dsc->dash_gap && dsc->dash_width ? true : false;
+    if(!dashed) {
+        lv_draw_raster_t raster;
+        lv_draw_raster_init(&raster);
+        uint16_t i;
+        for(i = 0; i < point_cnt - 1; i++) {
+            if(points[i].x == points[i + 1].x && points[i].y == points[i + 1].y) continue;
+
+            /*Skip the lines which are not visible*/
+            lv_area_t line_area;
+            line_area.x1 = LV_MIN(points[i].x, points[i + 1].x) - dsc->width;
+            line_area.x2 = LV_MAX(points[i].x, points[i + 1].x) + dsc->width;
+            line_area.y1 = LV_MIN(points[i].y, points[i + 1].y) - dsc->width;
+            line_area.y2 = LV_MAX(points[i].y, points[i + 1].y) + dsc->width;
+            if(!_lv_area_is_on(&line_area, clip)) continue;
+
+            /*All the lines are drawn at once, else the joints between the parts would be blended twice*/
+            raster_add_line(&raster, &points[i], &points[i + 1], dsc, i == 0 ? dsc->round_start : false, dsc->round_end);
+        }
+        lv_draw_raster_draw(&raster, clip, dsc->color, dsc->opa, dsc->blend_mode);
+        lv_draw_raster_free(&raster);
+        return;
+    }
+#endif /*LV_DRAW_COMPLEX*/
+
+    lv_draw_line_dsc_t line_dsc;
+    lv_memcpy_small(&line_dsc, dsc, sizeof(lv_draw_line_dsc_t));
+    uint16_t i;
+    for(i = 0; i < point_cnt - 1; i++) {
+        lv_draw_line(&points[i], &points[i + 1], clip, &line_dsc);
+        line_dsc.round_start = 0;   /*Draw the rounding only on the end points after the first line*/
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -317,171 +377,12 @@ LV_ATTRIBUTE_FAST_MEM static void draw_line_skew(const lv_point_t * point1, cons
                                                  const lv_draw_line_dsc_t * dsc)
 {
 #if LV_DRAW_COMPLEX
-    /*Keep the great y in p1*/
-    lv_point_t p1;
-    lv_point_t p2;
-    if(point1->y < point2->y) {
-        p1.y = point1->y;
-        p2.y = point2->y;
-        p1.x = point1->x;
-        p2.x = point2->x;
-    }
-    else {
-        p1.y = point2->y;
-        p2.y = point1->y;
-        p1.x = point2->x;
-        p2.x = point1->x;
-    }
-
-    int32_t xdiff = p2.x - p1.x;
-    int32_t ydiff = p2.y - p1.y;
-    bool flat = LV_ABS(xdiff) > LV_ABS(ydiff) ? true : false;
-
-    static const uint8_t wcorr[] = {
-        128, 128, 128, 129, 129, 130, 130, 131,
-        132, 133, 134, 135, 137, 138, 140, 141,
-        143, 145, 147, 149, 151, 153, 155, 158,
-        160, 162, 165, 167, 170, 173, 175, 178,
-        181,
-    };
-
-    int32_t w = dsc->width;
-    int32_t wcorr_i = 0;
-    if(flat) wcorr_i = (LV_ABS(ydiff) << 5) / LV_ABS(xdiff);
-    else wcorr_i = (LV_ABS(xdiff) << 5) / LV_ABS(ydiff);
-
-    w = (w * wcorr[wcorr_i] + 63) >> 7;     /*+ 63 for rounding*/
-    int32_t w_half0 = w >> 1;
-    int32_t w_half1 = w_half0 + (w & 0x1); /*Compensate rounding error*/
-
-    lv_area_t draw_area;
-    draw_area.x1 = LV_MIN(p1.x, p2.x) - w;
-    draw_area.x2 = LV_MAX(p1.x, p2.x) + w;
-    draw_area.y1 = LV_MIN(p1.y, p2.y) - w;
-    draw_area.y2 = LV_MAX(p1.y, p2.y) + w;
-
-    /*Get the union of `coords` and `clip`*/
-    /*`clip` is already truncated to the `draw_buf` size
-     *in 'lv_refr_area' function*/
-    bool is_common = _lv_area_intersect(&draw_area, &draw_area, clip);
-    if(is_common == false) return;
-
-    lv_draw_mask_line_param_t mask_left_param;
-    lv_draw_mask_line_param_t mask_right_param;
-    lv_draw_mask_line_param_t mask_top_param;
-    lv_draw_mask_line_param_t mask_bottom_param;
-
-    if(flat) {
-        if(xdiff > 0) {
-            lv_draw_mask_line_points_init(&mask_left_param, p1.x, p1.y - w_half0, p2.x, p2.y - w_half0,
-                                          LV_DRAW_MASK_LINE_SIDE_LEFT);
-            lv_draw_mask_line_points_init(&mask_right_param, p1.x, p1.y + w_half1, p2.x, p2.y + w_half1,
-                                          LV_DRAW_MASK_LINE_SIDE_RIGHT);
-        }
-        else {
-            lv_draw_mask_line_points_init(&mask_left_param, p1.x, p1.y + w_half1, p2.x, p2.y + w_half1,
-                                          LV_DRAW_MASK_LINE_SIDE_LEFT);
-            lv_draw_mask_line_points_init(&mask_right_param, p1.x, p1.y - w_half0, p2.x, p2.y - w_half0,
-                                          LV_DRAW_MASK_LINE_SIDE_RIGHT);
-        }
-    }
-    else {
-        lv_draw_mask_line_points_init(&mask_left_param, p1.x + w_half1, p1.y, p2.x + w_half1, p2.y,
-                                      LV_DRAW_MASK_LINE_SIDE_LEFT);
-        lv_draw_mask_line_points_init(&mask_right_param, p1.x - w_half0, p1.y, p2.x - w_half0, p2.y,
-                                      LV_DRAW_MASK_LINE_SIDE_RIGHT);
-    }
-
-    /*Use the normal vector for the endings*/
-
-    int16_t mask_left_id = lv_draw_mask_add(&mask_left_param, NULL);
-    int16_t mask_right_id = lv_draw_mask_add(&mask_right_param, NULL);
-    int16_t mask_top_id = LV_MASK_ID_INV;
-    int16_t mask_bottom_id = LV_MASK_ID_INV;
-
-    if(!dsc->raw_end) {
-        lv_draw_mask_line_points_init(&mask_top_param, p1.x, p1.y, p1.x - ydiff, p1.y + xdiff, LV_DRAW_MASK_LINE_SIDE_BOTTOM);
-        lv_draw_mask_line_points_init(&mask_bottom_param, p2.x, p2.y, p2.x - ydiff, p2.y + xdiff,  LV_DRAW_MASK_LINE_SIDE_TOP);
-        mask_top_id = lv_draw_mask_add(&mask_top_param, NULL);
-        mask_bottom_id = lv_draw_mask_add(&mask_bottom_param, NULL);
-    }
-
-    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
-    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp);
-
-    const lv_area_t * disp_area = &draw_buf->area;
-
-    /*Store the coordinates of the `draw_a` relative to the draw_buf*/
-    draw_area.x1 -= disp_area->x1;
-    draw_area.y1 -= disp_area->y1;
-    draw_area.x2 -= disp_area->x1;
-    draw_area.y2 -= disp_area->y1;
-
-    /*The real draw area is around the line.
-     *It's easy to calculate with steep lines, but the area can be very wide with very flat lines.
-     *So deal with it only with steep lines.*/
-    int32_t draw_area_w = lv_area_get_width(&draw_area);
-
-    /*Draw the background line by line*/
-    int32_t h;
-    uint32_t hor_res = (uint32_t)lv_disp_get_hor_res(disp);
-    size_t mask_buf_size = LV_MIN(lv_area_get_size(&draw_area), hor_res);
-    lv_opa_t * mask_buf = lv_mem_buf_get(mask_buf_size);
-
-    lv_area_t fill_area;
-    fill_area.x1 = draw_area.x1 + disp_area->x1;
-    fill_area.x2 = draw_area.x2 + disp_area->x1;
-    fill_area.y1 = draw_area.y1 + disp_area->y1;
-    fill_area.y2 = fill_area.y1;
-
-    int32_t x = draw_buf->area.x1 + draw_area.x1;
-
-    uint32_t mask_p = 0;
-
-    lv_memset_ff(mask_buf, mask_buf_size);
-    /*Fill the first row with 'color'*/
-    for(h = draw_area.y1 + disp_area->y1; h <= draw_area.y2 + disp_area->y1; h++) {
-
-        lv_draw_mask_res_t mask_res = lv_draw_mask_apply(&mask_buf[mask_p], x, h, draw_area_w);
-        if(mask_res == LV_DRAW_MASK_RES_TRANSP) {
-            lv_memset_00(&mask_buf[mask_p], draw_area_w);
-        }
-
-        mask_p += draw_area_w;
-        if((uint32_t) mask_p + draw_area_w < mask_buf_size) {
-            fill_area.y2 ++;
-        }
-        else {
-            _lv_blend_fill(&fill_area, clip,
-                           dsc->color, mask_buf, LV_DRAW_MASK_RES_CHANGED, dsc->opa,
-                           dsc->blend_mode);
-
-            fill_area.y1 = fill_area.y2 + 1;
-            fill_area.y2 = fill_area.y1;
-            mask_p = 0;
-            lv_memset_ff(mask_buf, mask_buf_size);
-        }
-    }
-
-    /*Flush the last part*/
-    if(fill_area.y1 != fill_area.y2) {
-        fill_area.y2--;
-        _lv_blend_fill(&fill_area, clip,
-                       dsc->color, mask_buf, LV_DRAW_MASK_RES_CHANGED, dsc->opa,
-                       dsc->blend_mode);
-
-    }
-
-    lv_mem_buf_release(mask_buf);
-
-    lv_draw_mask_free_param(&mask_left_param);
-    lv_draw_mask_free_param(&mask_right_param);
-    if(mask_top_id != LV_MASK_ID_INV) lv_draw_mask_free_param(&mask_top_param);
-    if(mask_bottom_id != LV_MASK_ID_INV) lv_draw_mask_free_param(&mask_bottom_param);
-    lv_draw_mask_remove_id(mask_left_id);
-    lv_draw_mask_remove_id(mask_right_id);
-    lv_draw_mask_remove_id(mask_top_id);
-    lv_draw_mask_remove_id(mask_bottom_id);
+    /*Only the pixels around the line are touched, independently of the size of its bounding box*/
+    lv_draw_raster_t raster;
+    lv_draw_raster_init(&raster);
+    raster_add_line(&raster, point1, point2, dsc, dsc->round_start, dsc->round_end);
+    lv_draw_raster_draw(&raster, clip, dsc->color, dsc->opa, dsc->blend_mode);
+    lv_draw_raster_free(&raster);
 #else
     LV_UNUSED(point1);
     LV_UNUSED(point2);
@@ -491,3 +392,47 @@ LV_ATTRIBUTE_FAST_MEM static void draw_line_skew(const lv_point_t * point1, cons
 #endif /*LV_DRAW_COMPLEX*/
 }
 
+#if LV_DRAW_COMPLEX
+/**
+ * Add a line and its round endings to a rasterizer
+ * @param raster pointer to a rasterizer
+ * @param point1 first point of the line
+ * @param point2 second point of the line
+ * @param dsc the width and `raw_end` are used from it
+ * @param round_start add round ending to `point1`
+ * @param round_end add round ending to `point2`
+ */
+static void raster_add_line(lv_draw_raster_t * raster, const lv_point_t * point1, const lv_point_t * point2,
+                            const lv_draw_line_dsc_t * dsc, bool round_start, bool round_end)
+{
+    /*Odd wide lines are on the middle of the pixels, even wide lines are on the pixel borders.
+     *Horizontal and vertical lines start and end on the pixel borders like in `draw_line_hor/ver`.*/
+    int32_t ofs = (dsc->width & 1) ? LV_DRAW_RASTER_ONE / 2 : 0;
+    int32_t ofs_x = point1->y == point2->y ? 0 : ofs;
+    int32_t ofs_y = point1->x == point2->x ? 0 : ofs;
+
+    lv_draw_raster_point_t p1;
+    lv_draw_raster_point_t p2;
+    p1.x = (point1->x << LV_DRAW_RASTER_SHIFT) + ofs_x;
+    p1.y = (point1->y << LV_DRAW_RASTER_SHIFT) + ofs_y;
+    p2.x = (point2->x << LV_DRAW_RASTER_SHIFT) + ofs_x;
+    p2.y = (point2->y << LV_DRAW_RASTER_SHIFT) + ofs_y;
+
+    int32_t width = dsc->width << LV_DRAW_RASTER_SHIFT;
+    lv_draw_raster_add_line(raster, &p1, &p2, width, dsc->raw_end);
+
+    if(round_start || round_end) {
+        lv_draw_raster_point_t center;
+        if(round_start) {
+            center.x = (point1->x << LV_DRAW_RASTER_SHIFT) + ofs;
+            center.y = (point1->y << LV_DRAW_RASTER_SHIFT) + ofs;
+            lv_draw_raster_add_circle(raster, &center, width / 2);
+        }
+        if(round_end) {
+            center.x = (point2->x << LV_DRAW_RASTER_SHIFT) + ofs;
+            center.y = (point2->y << LV_DRAW_RASTER_SHIFT) + ofs;
+            lv_draw_raster_add_circle(raster, &center, width / 2);
+        }
+    }
+}
+#endif /*LV_DRAW_COMPLEX*/
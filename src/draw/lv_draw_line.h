@@ -51,6 +51,18 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_line(const lv_point_t * point1, const lv_poin
 
 LV_ATTRIBUTE_FAST_MEM void lv_draw_line_dsc_init(lv_draw_line_dsc_t * dsc);
 
+/**
+ * Draw connected lines. The overlapping parts (e.g. the joints) are drawn only once
+ * so semi-transparent lines look correct too.
+ * @param points an array of points
+ * @param point_cnt number of points
+ * @param clip the lines will be drawn only in this area
+ * @param dsc pointer to an initialized `lv_draw_line_dsc_t` variable.
+ *            `round_start` rounds the first point, `round_end` all the others.
+ */
+void lv_draw_polyline(const lv_point_t points[], uint16_t point_cnt, const lv_area_t * clip,
+                      const lv_draw_line_dsc_t * dsc);
+
 //! @endcond
 
 /**********************
@@ -0,0 +1,664 @@
+/**
+ * @file lv_draw_raster.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_raster.h"
+#if LV_DRAW_COMPLEX
+#include "../misc/lv_math.h"
+#include "../misc/lv_mem.h"
+#include "../misc/lv_assert.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Fully covered parts of a row with at least this length are blended without mask
+ *and transparent parts with at least this length are skipped*/
+#define RUN_MIN     16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*Cells of a row touched by an edge*/
+typedef struct {
+    int32_t start;
+    int32_t end;        /*Exclusive*/
+} cell_span_t;
+
+/*Coverage accumulation of a row*/
+typedef struct {
+    int32_t * acc;          /*Difference of the coverage to the left neighbor*/
+    cell_span_t * spans;    /*The touched cells*/
+    uint32_t span_cnt;
+    int32_t w;
+    int32_t ox;             /*x coordinate of the left side of the draw area*/
+    uint32_t * act;         /*Indices of the edges crossing the current row*/
+    uint32_t act_cnt;
+    uint32_t next;          /*Index of the first edge below the current row*/
+} row_acc_t;
+
+/*Blending the coverage of a row*/
+typedef struct {
+    const lv_area_t * clip_area;
+    lv_area_t fill_area;
+    lv_coord_t x_ofs;
+    lv_opa_t * mask_buf;
+    lv_color_t color;
+    lv_opa_t opa;
+    lv_blend_mode_t blend_mode;
+    bool other_mask;
+} row_blend_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void add_edge(lv_draw_raster_t * raster, const lv_draw_raster_point_t * p1,
+                     const lv_draw_raster_point_t * p2, int32_t dir);
+static void add_circle(lv_draw_raster_t * raster, const lv_draw_raster_point_t * center, int32_t radius,
+                       int32_t dir);
+static int32_t get_circle_step(int32_t radius);
+static void get_circle_point(const lv_draw_raster_point_t * center, int32_t radius, int32_t angle,
+                             lv_draw_raster_point_t * point);
+static void sort_edges(lv_draw_raster_t * raster);
+LV_ATTRIBUTE_FAST_MEM static void acc_row(const lv_draw_raster_t * raster, row_acc_t * row, int32_t y);
+LV_ATTRIBUTE_FAST_MEM static void acc_segment(row_acc_t * row, int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                                              int32_t dir);
+LV_ATTRIBUTE_FAST_MEM static void acc_cells(row_acc_t * row, int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                                            int32_t dir);
+LV_ATTRIBUTE_FAST_MEM static void blend_row(row_acc_t * row, row_blend_t * blend);
+LV_ATTRIBUTE_FAST_MEM static void blend_masked(row_blend_t * blend, int32_t start, int32_t end);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_raster_init(lv_draw_raster_t * raster)
+{
+    lv_memset_00(raster, sizeof(lv_draw_raster_t));
+    raster->x_min = INT32_MAX;
+    raster->y_min = INT32_MAX;
+    raster->x_max = INT32_MIN;
+    raster->y_max = INT32_MIN;
+}
+
+void lv_draw_raster_add_polygon(lv_draw_raster_t * raster, const lv_draw_raster_point_t points[], uint32_t point_cnt)
+{
+    if(point_cnt < 3) return;
+
+    /*Add all the contours with the same orientation to merge the overlapping shapes*/
+    int64_t area = 0;
+    uint32_t i;
+    for(i = 0; i < point_cnt; i++) {
+        const lv_draw_raster_point_t * p2 = &points[i + 1 < point_cnt ? i + 1 : 0];
+        area += (int64_t)points[i].x * p2->y - (int64_t)p2->x * points[i].y;
+    }
+    int32_t dir = area < 0 ? -1 : 1;
+
+    for(i = 0; i < point_cnt; i++) {
+        add_edge(raster, &points[i], &points[i + 1 < point_cnt ? i + 1 : 0], dir);
+    }
+}
+
+void lv_draw_raster_add_contour(lv_draw_raster_t * raster, const lv_draw_raster_point_t points[], uint32_t point_cnt)
+{
+    if(point_cnt < 3) return;
+
+    uint32_t i;
+    for(i = 0; i < point_cnt; i++) {
+        add_edge(raster, &points[i], &points[i + 1 < point_cnt ? i + 1 : 0], 1);
+    }
+}
+
+void lv_draw_raster_add_line(lv_draw_raster_t * raster, const lv_draw_raster_point_t * p1,
+                             const lv_draw_raster_point_t * p2, int32_t width, bool raw_end)
+{
+    int32_t dx = p2->x - p1->x;
+    int32_t dy = p2->y - p1->y;
+    if(dx == 0 && dy == 0) return;
+
+    /*Scale the direction vector to [1024..2048) to calculate its length precisely enough with `lv_sqrt`*/
+    while(LV_MAX(LV_ABS(dx), LV_ABS(dy)) >= 2048) {
+        dx /= 2;
+        dy /= 2;
+    }
+    while(LV_MAX(LV_ABS(dx), LV_ABS(dy)) < 1024) {
+        dx *= 2;
+        dy *= 2;
+    }
+
+    lv_sqrt_res_t res;
+    lv_sqrt((uint32_t)(dx * dx + dy * dy), &res, 0x8000);
+    int32_t len = (res.i << 4) + (res.f >> 4);   /*In 1/16 units*/
+    int32_t hw = width / 2;
+
+    lv_draw_raster_point_t p[4];
+    if(raw_end) {
+        /*Cut the ending along the axis the line is closer to*/
+        if(LV_ABS(dx) >= LV_ABS(dy)) {
+            int32_t v = (int32_t)(((int64_t)hw * len) / (LV_ABS(dx) * 16));
+            p[0].x = p1->x;
+            p[0].y = p1->y - v;
+            p[1].x = p2->x;
+            p[1].y = p2->y - v;
+            p[2].x = p2->x;
+            p[2].y = p2->y + v;
+            p[3].x = p1->x;
+            p[3].y = p1->y + v;
+        }
+        else {
+            int32_t v = (int32_t)(((int64_t)hw * len) / (LV_ABS(dy) * 16));
+            p[0].x = p1->x - v;
+            p[0].y = p1->y;
+            p[1].x = p2->x - v;
+            p[1].y = p2->y;
+            p[2].x = p2->x + v;
+            p[2].y = p2->y;
+            p[3].x = p1->x + v;
+            p[3].y = p1->y;
+        }
+    }
+    else {
+        /*Normal vector with the length of the half width*/
+        int32_t nx = (int32_t)((-(int64_t)dy * hw * 16) / len);
+        int32_t ny = (int32_t)(((int64_t)dx * hw * 16) / len);
+        p[0].x = p1->x + nx;
+        p[0].y = p1->y + ny;
+        p[1].x = p2->x + nx;
+        p[1].y = p2->y + ny;
+        p[2].x = p2->x - nx;
+        p[2].y = p2->y - ny;
+        p[3].x = p1->x - nx;
+        p[3].y = p1->y - ny;
+    }
+
+    lv_draw_raster_add_polygon(raster, p, 4);
+}
+
+void lv_draw_raster_add_circle(lv_draw_raster_t * raster, const lv_draw_raster_point_t * center, int32_t radius)
+{
+    add_circle(raster, center, radius, 1);
+}
+
+void lv_draw_raster_add_arc(lv_draw_raster_t * raster, const lv_draw_raster_point_t * center, int32_t radius,
+                            int32_t width, int32_t start_angle, int32_t end_angle, bool rounded)
+{
+    if(radius <= 0 || width <= 0) return;
+    if(end_angle <= start_angle) return;
+    if(width > radius) width = radius;
+
+    /*Full ring: the inner circle is added with opposite direction to make a hole*/
+    if(end_angle - start_angle >= 360) {
+        add_circle(raster, center, radius, 1);
+        add_circle(raster, center, radius - width, -1);
+        return;
+    }
+
+    /*Go along the outer arc and back on the inner arc*/
+    int32_t step = get_circle_step(radius);
+    uint32_t point_max = 2 * ((end_angle - start_angle) / step + 2);
+    lv_draw_raster_point_t * points = lv_mem_buf_get(point_max * sizeof(lv_draw_raster_point_t));
+    uint32_t point_cnt = 0;
+    int32_t angle;
+    for(angle = start_angle; angle < end_angle; angle += step) {
+        get_circle_point(center, radius, angle, &points[point_cnt++]);
+    }
+    get_circle_point(center, radius, end_angle, &points[point_cnt++]);
+
+    get_circle_point(center, radius - width, end_angle, &points[point_cnt++]);
+    for(angle = start_angle + ((end_angle - start_angle - 1) / step) * step; angle >= start_angle; angle -= step) {
+        get_circle_point(center, radius - width, angle, &points[point_cnt++]);
+    }
+
+    lv_draw_raster_add_polygon(raster, points, point_cnt);
+    lv_mem_buf_release(points);
+
+    if(rounded) {
+        lv_draw_raster_point_t end_center;
+        get_circle_point(center, radius - width / 2, start_angle, &end_center);
+        add_circle(raster, &end_center, width / 2, 1);
+        get_circle_point(center, radius - width / 2, end_angle, &end_center);
+        add_circle(raster, &end_center, width / 2, 1);
+    }
+}
+
+void lv_draw_raster_draw(lv_draw_raster_t * raster, const lv_area_t * clip_area, lv_color_t color, lv_opa_t opa,
+                         lv_blend_mode_t blend_mode)
+{
+    if(raster->edge_cnt == 0) return;
+    if(opa <= LV_OPA_MIN) return;
+
+    lv_area_t draw_area;
+    draw_area.x1 = raster->x_min >> LV_DRAW_RASTER_SHIFT;
+    draw_area.y1 = raster->y_min >> LV_DRAW_RASTER_SHIFT;
+    draw_area.x2 = (raster->x_max - 1) >> LV_DRAW_RASTER_SHIFT;
+    draw_area.y2 = (raster->y_max - 1) >> LV_DRAW_RASTER_SHIFT;
+    if(!_lv_area_intersect(&draw_area, &draw_area, clip_area)) return;
+
+    sort_edges(raster);
+
+    /*The coverage of the pixels is accumulated as the difference to the left neighbor.
+     *The edges outside of the draw area are moved to its left or right side.*/
+    row_acc_t row;
+    row.w = lv_area_get_width(&draw_area);
+    row.acc = lv_mem_buf_get((row.w + 2) * sizeof(int32_t));
+    lv_memset_00(row.acc, (row.w + 2) * sizeof(int32_t));
+    row.spans = lv_mem_buf_get(raster->edge_cnt * 3 * sizeof(cell_span_t));
+
+    row_blend_t blend;
+    blend.clip_area = clip_area;
+    blend.x_ofs = draw_area.x1;
+    blend.mask_buf = lv_mem_buf_get(row.w);
+    blend.color = color;
+    blend.opa = opa;
+    blend.blend_mode = blend_mode;
+    blend.other_mask = lv_draw_mask_is_any(&draw_area);
+
+    row.act = lv_mem_buf_get(raster->edge_cnt * sizeof(uint32_t));
+    row.act_cnt = 0;
+    row.next = 0;
+    row.ox = draw_area.x1 << LV_DRAW_RASTER_SHIFT;
+    int32_t y;
+    for(y = draw_area.y1; y <= draw_area.y2; y++) {
+        acc_row(raster, &row, y);
+        if(row.span_cnt == 0) continue;
+
+        blend.fill_area.y1 = y;
+        blend.fill_area.y2 = y;
+        blend_row(&row, &blend);
+    }
+
+    lv_mem_buf_release(row.act);
+    lv_mem_buf_release(blend.mask_buf);
+    lv_mem_buf_release(row.spans);
+    lv_mem_buf_release(row.acc);
+}
+
+void lv_draw_raster_render(lv_draw_raster_t * raster, const lv_area_t * area, lv_opa_t * buf)
+{
+    lv_memset_00(buf, lv_area_get_size(area));
+    if(raster->edge_cnt == 0) return;
+
+    sort_edges(raster);
+
+    row_acc_t row;
+    row.w = lv_area_get_width(area);
+    row.acc = lv_mem_buf_get((row.w + 2) * sizeof(int32_t));
+    lv_memset_00(row.acc, (row.w + 2) * sizeof(int32_t));
+    row.spans = lv_mem_buf_get(raster->edge_cnt * 3 * sizeof(cell_span_t));
+    row.act = lv_mem_buf_get(raster->edge_cnt * sizeof(uint32_t));
+    row.act_cnt = 0;
+    row.next = 0;
+    row.ox = area->x1 << LV_DRAW_RASTER_SHIFT;
+
+    int32_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        acc_row(raster, &row, y);
+        if(row.span_cnt == 0) continue;
+
+        lv_opa_t * buf_row = &buf[(y - area->y1) * row.w];
+        int32_t sum = 0;
+        int32_t c;
+        for(c = 0; c < row.w; c++) {
+            sum += row.acc[c];
+            row.acc[c] = 0;
+            int32_t a = LV_ABS(sum);
+            buf_row[c] = a >= LV_DRAW_RASTER_ONE ? LV_OPA_COVER : a;
+        }
+        /*The edges on the right side of the area*/
+        row.acc[row.w] = 0;
+        row.acc[row.w + 1] = 0;
+    }
+
+    lv_mem_buf_release(row.act);
+    lv_mem_buf_release(row.spans);
+    lv_mem_buf_release(row.acc);
+}
+
+void lv_draw_raster_free(lv_draw_raster_t * raster)
+{
+    lv_mem_free(raster->edges);
+    raster->edges = NULL;
+    raster->edge_cnt = 0;
+    raster->edge_max = 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void add_edge(lv_draw_raster_t * raster, const lv_draw_raster_point_t * p1,
+                     const lv_draw_raster_point_t * p2, int32_t dir)
+{
+    /*Horizontal edges don't change the coverage*/
+    if(p1->y == p2->y) return;
+
+    if(raster->edge_cnt == raster->edge_max) {
+        uint32_t new_max = raster->edge_max ? raster->edge_max * 2 : 16;
+        _lv_draw_raster_edge_t * edges = lv_mem_realloc(raster->edges, new_max * sizeof(_lv_draw_raster_edge_t));
+        LV_ASSERT_MALLOC(edges);
+        if(edges == NULL) return;
+        raster->edges = edges;
+        raster->edge_max = new_max;
+    }
+
+    _lv_draw_raster_edge_t * e = &raster->edges[raster->edge_cnt];
+    raster->edge_cnt++;
+
+    if(p1->y < p2->y) {
+        e->x0 = p1->x;
+        e->y0 = p1->y;
+        e->x1 = p2->x;
+        e->y1 = p2->y;
+        e->dir = dir;
+    }
+    else {
+        e->x0 = p2->x;
+        e->y0 = p2->y;
+        e->x1 = p1->x;
+        e->y1 = p1->y;
+        e->dir = -dir;
+    }
+
+    e->dxdy = (((int64_t)(e->x1 - e->x0)) << 16) / (e->y1 - e->y0);
+
+    raster->x_min = LV_MIN3(raster->x_min, e->x0, e->x1);
+    raster->x_max = LV_MAX3(raster->x_max, e->x0, e->x1);
+    raster->y_min = LV_MIN(raster->y_min, e->y0);
+    raster->y_max = LV_MAX(raster->y_max, e->y1);
+}
+
+static void add_circle(lv_draw_raster_t * raster, const lv_draw_raster_point_t * center, int32_t radius,
+                       int32_t dir)
+{
+    if(radius <= 0) return;
+
+    int32_t step = get_circle_step(radius);
+    lv_draw_raster_point_t p_start;
+    lv_draw_raster_point_t p_prev;
+    p_start.x = center->x + radius;
+    p_start.y = center->y;
+    p_prev = p_start;
+
+    int32_t angle;
+    for(angle = step; angle < 360; angle += step) {
+        lv_draw_raster_point_t p;
+        get_circle_point(center, radius, angle, &p);
+        add_edge(raster, &p_prev, &p, dir);
+        p_prev = p;
+    }
+    add_edge(raster, &p_prev, &p_start, dir);
+}
+
+/**
+ * Get the angle step to approximate a circle with so many vertices that the error is less then ~1/8 pixel
+ * @param radius radius in 1/256 pixel units
+ * @return the step in degrees
+ */
+static int32_t get_circle_step(int32_t radius)
+{
+    int32_t r_px = radius >> LV_DRAW_RASTER_SHIFT;
+    if(r_px <= 3) return 30;
+    else if(r_px <= 14) return 15;
+    else if(r_px <= 32) return 10;
+    else if(r_px <= 128) return 5;
+    else return 2;
+}
+
+static void get_circle_point(const lv_draw_raster_point_t * center, int32_t radius, int32_t angle,
+                             lv_draw_raster_point_t * point)
+{
+    point->x = center->x + (int32_t)(((int64_t)radius * lv_trigo_cos(angle)) >> LV_TRIGO_SHIFT);
+    point->y = center->y + (int32_t)(((int64_t)radius * lv_trigo_sin(angle)) >> LV_TRIGO_SHIFT);
+}
+
+/**
+ * Sort the edges by their top coordinate (Shell sort)
+ */
+static void sort_edges(lv_draw_raster_t * raster)
+{
+    _lv_draw_raster_edge_t * edges = raster->edges;
+    uint32_t n = raster->edge_cnt;
+    uint32_t gap;
+    for(gap = n / 2; gap > 0; gap /= 2) {
+        uint32_t i;
+        for(i = gap; i < n; i++) {
+            _lv_draw_raster_edge_t tmp = edges[i];
+            uint32_t j;
+            for(j = i; j >= gap && edges[j - gap].y0 > tmp.y0; j -= gap) {
+                edges[j] = edges[j - gap];
+            }
+            edges[j] = tmp;
+        }
+    }
+}
+
+/**
+ * Accumulate the coverage of the edges crossing a row and update the list of the active edges
+ * @param raster pointer to a rasterizer with sorted edges
+ * @param row the accumulation data of the row
+ * @param y the row
+ */
+LV_ATTRIBUTE_FAST_MEM static void acc_row(const lv_draw_raster_t * raster, row_acc_t * row, int32_t y)
+{
+    int32_t ytop = y << LV_DRAW_RASTER_SHIFT;
+    int32_t ybottom = ytop + LV_DRAW_RASTER_ONE;
+
+    /*Update the list of the edges crossing this row*/
+    while(row->next < raster->edge_cnt && raster->edges[row->next].y0 < ybottom) {
+        if(raster->edges[row->next].y1 > ytop) row->act[row->act_cnt++] = row->next;
+        row->next++;
+    }
+
+    row->span_cnt = 0;
+    uint32_t i;
+    uint32_t act_cnt_new = 0;
+    for(i = 0; i < row->act_cnt; i++) {
+        const _lv_draw_raster_edge_t * e = &raster->edges[row->act[i]];
+        int32_t y0 = LV_MAX(e->y0, ytop);
+        int32_t y1 = LV_MIN(e->y1, ybottom);
+        int32_t x0 = e->x0 + (int32_t)(((y0 - e->y0) * e->dxdy) >> 16);
+        int32_t x1 = y1 == e->y1 ? e->x1 : e->x0 + (int32_t)(((y1 - e->y0) * e->dxdy) >> 16);
+        acc_segment(row, x0 - row->ox, y0 - ytop, x1 - row->ox, y1 - ytop, e->dir);
+
+        /*Keep the edge if it continues in the next row*/
+        if(e->y1 > ybottom) row->act[act_cnt_new++] = row->act[i];
+    }
+    row->act_cnt = act_cnt_new;
+}
+
+/**
+ * Accumulate the coverage of a part of an edge in a row.
+ * The parts on the left and right of the draw area are moved to its sides.
+ * It doesn't change the coverage of the pixels inside the draw area.
+ * @param row the accumulation data of the row
+ * @param x0 x coordinate of the start point relative to the draw area
+ * @param y0 y coordinate of the start point relative to the row [0..256]
+ * @param x1 x coordinate of the end point relative to the draw area
+ * @param y1 y coordinate of the end point relative to the row [0..256], greater or equal to `y0`
+ * @param dir direction of the edge
+ */
+LV_ATTRIBUTE_FAST_MEM static void acc_segment(row_acc_t * row, int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                                              int32_t dir)
+{
+    int32_t x_right = row->w << LV_DRAW_RASTER_SHIFT;
+    int32_t border;
+    if((x0 < 0) != (x1 < 0)) border = 0;
+    else if((x0 > x_right) != (x1 > x_right)) border = x_right;
+    else {
+        x0 = LV_CLAMP(0, x0, x_right);
+        x1 = LV_CLAMP(0, x1, x_right);
+        acc_cells(row, x0, y0, x1, y1, dir);
+        return;
+    }
+
+    /*Split the segment on the border*/
+    int32_t y_border = y0 + (int32_t)(((int64_t)(y1 - y0) * (border - x0)) / (x1 - x0));
+    acc_segment(row, x0, y0, border, y_border, dir);
+    acc_segment(row, border, y_border, x1, y1, dir);
+}
+
+/**
+ * Accumulate the coverage of a part of an edge which is inside the draw area
+ */
+LV_ATTRIBUTE_FAST_MEM static void acc_cells(row_acc_t * row, int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                                            int32_t dir)
+{
+    int32_t dy = y1 - y0;
+    if(dy == 0) return;
+
+    if(x0 > x1) {
+        int32_t tmp = x0;
+        x0 = x1;
+        x1 = tmp;
+    }
+
+    int32_t * acc = row->acc;
+    int32_t c = x0 >> LV_DRAW_RASTER_SHIFT;
+    int32_t c_last = x1 > x0 ? (x1 - 1) >> LV_DRAW_RASTER_SHIFT : c;
+    row->spans[row->span_cnt].start = c;
+    row->spans[row->span_cnt].end = c_last + 2;
+    row->span_cnt++;
+
+    /*In one cell: the covered area is on the right of the segment in the cell, the rest goes to the next cell*/
+    if(c == c_last) {
+        int32_t fx = ((x0 + x1) >> 1) - (c << LV_DRAW_RASTER_SHIFT);
+        int32_t area = (dy * (LV_DRAW_RASTER_ONE - fx)) >> LV_DRAW_RASTER_SHIFT;
+        acc[c] += dir * area;
+        acc[c + 1] += dir * (dy - area);
+        return;
+    }
+
+    /*Split the segment on the cell borders*/
+    int32_t dydx = (dy << 16) / (x1 - x0);
+    int32_t xa = x0;
+    int32_t y_sum_prev = 0;
+    for(; c <= c_last; c++) {
+        int32_t xb = LV_MIN((c + 1) << LV_DRAW_RASTER_SHIFT, x1);
+        int32_t y_sum = c == c_last ? dy : (int32_t)(((int64_t)(xb - x0) * dydx) >> 16);
+        int32_t dyc = y_sum - y_sum_prev;
+        y_sum_prev = y_sum;
+
+        int32_t fx = ((xa + xb) >> 1) - (c << LV_DRAW_RASTER_SHIFT);
+        int32_t area = (dyc * (LV_DRAW_RASTER_ONE - fx)) >> LV_DRAW_RASTER_SHIFT;
+        acc[c] += dir * area;
+        acc[c + 1] += dir * (dyc - area);
+        xa = xb;
+    }
+}
+
+/**
+ * Calculate the coverage only in the cells touched by the edges and blend it.
+ * Between them the coverage is constant: the transparent parts are skipped
+ * and the long fully covered parts are blended without mask.
+ */
+LV_ATTRIBUTE_FAST_MEM static void blend_row(row_acc_t * row, row_blend_t * blend)
+{
+    cell_span_t * spans = row->spans;
+    int32_t * acc = row->acc;
+    lv_opa_t * mask_buf = blend->mask_buf;
+    int32_t w = row->w;
+
+    /*Sort the spans by their start (insertion sort as there are only a few of them) and merge them*/
+    uint32_t i;
+    for(i = 1; i < row->span_cnt; i++) {
+        cell_span_t tmp = spans[i];
+        uint32_t j;
+        for(j = i; j > 0 && spans[j - 1].start > tmp.start; j--) spans[j] = spans[j - 1];
+        spans[j] = tmp;
+    }
+
+    uint32_t span_cnt = 1;
+    for(i = 1; i < row->span_cnt; i++) {
+        if(spans[i].start <= spans[span_cnt - 1].end) {
+            spans[span_cnt - 1].end = LV_MAX(spans[span_cnt - 1].end, spans[i].end);
+        }
+        else {
+            spans[span_cnt] = spans[i];
+            span_cnt++;
+        }
+    }
+
+    int32_t sum = 0;
+    int32_t seg_start = -1;     /*Start of the part to blend with mask*/
+    int32_t x = spans[0].start;
+    for(i = 0; i <= span_cnt; i++) {
+        /*The gap before the span or the rest of the row after the last span*/
+        int32_t gap_end = i < span_cnt ? LV_MIN(spans[i].start, w) : w;
+        if(x < gap_end) {
+            int32_t a = LV_ABS(sum);
+            lv_opa_t cov = a >= LV_DRAW_RASTER_ONE ? LV_OPA_COVER : a;
+            if(cov == LV_OPA_TRANSP) {
+                if(seg_start >= 0) blend_masked(blend, seg_start, x);
+                seg_start = -1;
+            }
+            else if(cov == LV_OPA_COVER && gap_end - x >= RUN_MIN && !blend->other_mask) {
+                if(seg_start >= 0) blend_masked(blend, seg_start, x);
+                seg_start = -1;
+                blend->fill_area.x1 = blend->x_ofs + x;
+                blend->fill_area.x2 = blend->x_ofs + gap_end - 1;
+                _lv_blend_fill(blend->clip_area, &blend->fill_area, blend->color, NULL, LV_DRAW_MASK_RES_FULL_COVER,
+                               blend->opa, blend->blend_mode);
+            }
+            else {
+                lv_memset(&mask_buf[x], cov, gap_end - x);
+                if(seg_start < 0) seg_start = x;
+            }
+        }
+        if(i == span_cnt) break;
+
+        /*Sum up the differences in the touched cells*/
+        int32_t c;
+        int32_t end = LV_MIN(spans[i].end, w);
+        if(seg_start < 0) seg_start = spans[i].start;
+        for(c = spans[i].start; c < end; c++) {
+            sum += acc[c];
+            acc[c] = 0;
+            int32_t a = LV_ABS(sum);
+            mask_buf[c] = a >= LV_DRAW_RASTER_ONE ? LV_OPA_COVER : a;
+        }
+        /*The edges on the right side of the draw area*/
+        for(; c < spans[i].end; c++) {
+            sum += acc[c];
+            acc[c] = 0;
+        }
+        x = end;
+    }
+
+    if(seg_start >= 0) blend_masked(blend, seg_start, x);
+}
+
+/**
+ * Blend a part of a row with the coverage in the mask buffer
+ */
+LV_ATTRIBUTE_FAST_MEM static void blend_masked(row_blend_t * blend, int32_t start, int32_t end)
+{
+    lv_opa_t * mask_buf = blend->mask_buf;
+    while(start < end && mask_buf[start] == LV_OPA_TRANSP) start++;
+    while(end > start && mask_buf[end - 1] == LV_OPA_TRANSP) end--;
+    if(start >= end) return;
+
+    blend->fill_area.x1 = blend->x_ofs + start;
+    blend->fill_area.x2 = blend->x_ofs + end - 1;
+
+    if(blend->other_mask) {
+        lv_draw_mask_res_t mask_res = lv_draw_mask_apply(&mask_buf[start], blend->fill_area.x1, blend->fill_area.y1,
+                                                         end - start);
+        if(mask_res == LV_DRAW_MASK_RES_TRANSP) return;
+    }
+
+    _lv_blend_fill(blend->clip_area, &blend->fill_area, blend->color, &mask_buf[start], LV_DRAW_MASK_RES_CHANGED,
+                   blend->opa, blend->blend_mode);
+}
+
+#endif /*LV_DRAW_COMPLEX*/
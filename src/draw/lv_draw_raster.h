@@ -0,0 +1,158 @@
+/**
+ * @file lv_draw_raster.h
+ *
+ */
+
+#ifndef LV_DRAW_RASTER_H
+#define LV_DRAW_RASTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_blend.h"
+
+#if LV_DRAW_COMPLEX
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The coordinates of the rasterizer are in 1/256 pixel units*/
+#define LV_DRAW_RASTER_SHIFT    8
+#define LV_DRAW_RASTER_ONE      (1 << LV_DRAW_RASTER_SHIFT)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A point in 1/256 pixel units. The top left corner of the pixel (x;y) is (x * 256; y * 256).
+ */
+typedef struct {
+    int32_t x;
+    int32_t y;
+} lv_draw_raster_point_t;
+
+typedef struct {
+    int32_t x0;
+    int32_t y0;
+    int32_t x1;
+    int32_t y1;     /*Always greater than y0*/
+    int32_t dir;    /*1: the original edge goes downward, -1: upward*/
+    int64_t dxdy;   /*Change of x for 1/256 pixel change of y in 1/65536 units*/
+} _lv_draw_raster_edge_t;
+
+/**
+ * Collects the edges of polygons and draws them with anti-aliasing.
+ * The coverage of the pixels is calculated from the signed area of the edges
+ * so only the pixels around the edges and inside the shapes are touched.
+ * The added shapes are merged, i.e. the overlapping parts are drawn only once.
+ */
+typedef struct {
+    _lv_draw_raster_edge_t * edges;
+    uint32_t edge_cnt;
+    uint32_t edge_max;
+    int32_t x_min;  /*Bounding box of the edges*/
+    int32_t y_min;
+    int32_t x_max;
+    int32_t y_max;
+} lv_draw_raster_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a rasterizer
+ * @param raster pointer to a rasterizer
+ */
+void lv_draw_raster_init(lv_draw_raster_t * raster);
+
+/**
+ * Add a closed polygon. It can be concave or self-intersecting too.
+ * @param raster pointer to an initialized rasterizer
+ * @param points the vertices of the polygon
+ * @param point_cnt number of vertices
+ */
+void lv_draw_raster_add_polygon(lv_draw_raster_t * raster, const lv_draw_raster_point_t points[], uint32_t point_cnt);
+
+/**
+ * Add a closed contour keeping its orientation.
+ * The contours with opposite orientation cut holes into each other (non-zero fill rule), e.g. in the outlines of fonts.
+ * @param raster pointer to an initialized rasterizer
+ * @param points the vertices of the contour
+ * @param point_cnt number of vertices
+ */
+void lv_draw_raster_add_contour(lv_draw_raster_t * raster, const lv_draw_raster_point_t points[], uint32_t point_cnt);
+
+/**
+ * Add a thick line without endings
+ * @param raster pointer to an initialized rasterizer
+ * @param p1 start point of the line
+ * @param p2 end point of the line
+ * @param width width of the line in 1/256 pixel units
+ * @param raw_end true: cut the endings horizontally or vertically instead of perpendicularly
+ */
+void lv_draw_raster_add_line(lv_draw_raster_t * raster, const lv_draw_raster_point_t * p1,
+                             const lv_draw_raster_point_t * p2, int32_t width, bool raw_end);
+
+/**
+ * Add a circle, e.g. for the round endings of lines
+ * @param raster pointer to an initialized rasterizer
+ * @param center center of the circle
+ * @param radius radius in 1/256 pixel units
+ */
+void lv_draw_raster_add_circle(lv_draw_raster_t * raster, const lv_draw_raster_point_t * center, int32_t radius);
+
+/**
+ * Add an arc, i.e. a part of a ring
+ * @param raster pointer to an initialized rasterizer
+ * @param center center of the arc
+ * @param radius outer radius in 1/256 pixel units
+ * @param width width of the arc in 1/256 pixel units
+ * @param start_angle start angle in degrees. 0 is on the right and the angles grow clockwise.
+ * @param end_angle end angle in degrees. Greater than `start_angle`, `start_angle + 360` means a full ring.
+ * @param rounded true: add round endings
+ */
+void lv_draw_raster_add_arc(lv_draw_raster_t * raster, const lv_draw_raster_point_t * center, int32_t radius,
+                            int32_t width, int32_t start_angle, int32_t end_angle, bool rounded);
+
+/**
+ * Draw the added shapes. The masks added with `lv_draw_mask_add` are applied too.
+ * @param raster pointer to a rasterizer
+ * @param clip_area the shapes will be drawn only in this area
+ * @param color color of the shapes
+ * @param opa opacity of the shapes
+ * @param blend_mode blend mode
+ */
+void lv_draw_raster_draw(lv_draw_raster_t * raster, const lv_area_t * clip_area, lv_color_t color, lv_opa_t opa,
+                         lv_blend_mode_t blend_mode);
+
+/**
+ * Write the coverage of the added shapes into a buffer instead of drawing them. The masks are not applied.
+ * @param raster pointer to a rasterizer
+ * @param area the area to render
+ * @param buf buffer with `lv_area_get_size(area)` bytes. The coverage is written row by row.
+ */
+void lv_draw_raster_render(lv_draw_raster_t * raster, const lv_area_t * area, lv_opa_t * buf);
+
+/**
+ * Free the edges of a rasterizer. It can be reused after `lv_draw_raster_init`.
+ * @param raster pointer to a rasterizer
+ */
+void lv_draw_raster_free(lv_draw_raster_t * raster);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_DRAW_COMPLEX*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_RASTER_H*/
@@ -53,6 +53,13 @@ static void draw_border_simple(const lv_area_t * clip, const lv_area_t * outer_a
 
 #if LV_DRAW_COMPLEX
 LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t * dsc, lv_coord_t s, lv_coord_t i);
+LV_ATTRIBUTE_FAST_MEM static void draw_bg_span(const lv_area_t * clip_area, const lv_area_t * blend_area,
+                                               const lv_draw_rect_dsc_t * dsc, lv_grad_dir_t grad_dir, const lv_color_t * grad_map,
+                                               lv_coord_t grad_h, lv_coord_t grad_y,
+                                               lv_opa_t * mask_buf, lv_draw_mask_res_t mask_res, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t mask_radius_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
+                                                                  lv_coord_t len, lv_draw_mask_radius_param_t * rout_param,
+                                                                  lv_draw_mask_radius_param_t * rin_param);
 #endif
 
 /**********************
@@ -168,7 +175,8 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
     if(rout > 0 || mask_any) {
         mask_buf = lv_mem_buf_get(draw_area_w);
         lv_draw_mask_radius_init(&mask_rout_param, &coords_bg, rout, false);
-        mask_rout_id = lv_draw_mask_add(&mask_rout_param, NULL);
+        /*Only the other masks need the mask stack. Else the corners are masked directly.*/
+        if(mask_any) mask_rout_id = lv_draw_mask_add(&mask_rout_param, NULL);
     }
 
     /*In case of horizontal gradient pre-compute a line with a gradient*/
@@ -215,9 +223,27 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
 
 
     /* Draw the top of the rectangle line by line and mirror it to the bottom.
+     * Only the corners are masked, the part between them is a solid span.
      * If there is no radius this cycle won't run because `h` is always `>= h_end`*/
-    blend_area.x1 = draw_area.x1;
-    blend_area.x2 = draw_area.x2;
+    lv_area_t left_area;
+    left_area.x1 = draw_area.x1;
+    left_area.x2 = LV_MIN(draw_area.x2, coords_bg.x1 + rout - 1);
+    lv_area_t mid_area;
+    mid_area.x1 = LV_MAX(draw_area.x1, coords_bg.x1 + rout);
+    mid_area.x2 = LV_MIN(draw_area.x2, coords_bg.x2 - rout);
+    lv_area_t right_area;
+    right_area.x1 = LV_MAX(draw_area.x1, coords_bg.x2 - rout + 1);
+    right_area.x2 = draw_area.x2;
+
+    int32_t left_w = LV_MAX(lv_area_get_width(&left_area), 0);
+    int32_t mid_w = lv_area_get_width(&mid_area);
+    int32_t right_w = lv_area_get_width(&right_area);
+    lv_opa_t * left_mask = mask_buf;
+    lv_opa_t * right_mask = mask_buf ? mask_buf + left_w : NULL;
+    const lv_color_t * left_map = grad_map;
+    const lv_color_t * mid_map = grad_map ? grad_map + (mid_area.x1 - draw_area.x1) : NULL;
+    const lv_color_t * right_map = grad_map ? grad_map + (right_area.x1 - draw_area.x1) : NULL;
+
     for(h = 0; h < rout; h++) {
         lv_coord_t top_y = coords_bg.y1 + h;
         lv_coord_t bottom_y = coords_bg.y2 - h;
@@ -225,38 +251,45 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
 
         /* Initialize the mask to opa instead of 0xFF and blend with LV_OPA_COVER.
          * It saves calculating the final opa in _lv_blend_fill*/
-        lv_memset(mask_buf, opa, draw_area_w);
-        mask_res = lv_draw_mask_apply(mask_buf, blend_area.x1, top_y, draw_area_w);
-
-        if(top_y >= draw_area.y1) {
-            blend_area.y1 = top_y;
-            blend_area.y2 = top_y;
-
-            if(grad_dir == LV_GRAD_DIR_NONE) {
-                _lv_blend_fill(clip_area, &blend_area, dsc->bg_color, mask_buf, mask_res, LV_OPA_COVER, dsc->blend_mode);
-            }
-            else if(grad_dir == LV_GRAD_DIR_HOR) {
-                _lv_blend_map(clip_area, &blend_area, grad_map, mask_buf, mask_res, LV_OPA_COVER, dsc->blend_mode);
-            }
-            else if(grad_dir == LV_GRAD_DIR_VER) {
-                lv_color_t c = grad_get(dsc, coords_h, top_y - coords_bg.y1);
-                _lv_blend_fill(clip_area, &blend_area, c, mask_buf, mask_res, LV_OPA_COVER, dsc->blend_mode);
-            }
+        lv_draw_mask_res_t left_res = LV_DRAW_MASK_RES_TRANSP;
+        if(left_w > 0) {
+            lv_memset(left_mask, opa, left_w);
+            left_res = mask_radius_apply(left_mask, left_area.x1, top_y, left_w, &mask_rout_param, NULL);
+            if(left_res == LV_DRAW_MASK_RES_FULL_COVER) left_res = LV_DRAW_MASK_RES_CHANGED;
         }
 
-        if(bottom_y <= draw_area.y2) {
-            blend_area.y1 = bottom_y;
-            blend_area.y2 = bottom_y;
+        lv_draw_mask_res_t right_res = LV_DRAW_MASK_RES_TRANSP;
+        if(right_w > 0) {
+            lv_memset(right_mask, opa, right_w);
+            right_res = mask_radius_apply(right_mask, right_area.x1, top_y, right_w, &mask_rout_param, NULL);
+            if(right_res == LV_DRAW_MASK_RES_FULL_COVER) right_res = LV_DRAW_MASK_RES_CHANGED;
+        }
 
-            if(grad_dir == LV_GRAD_DIR_NONE) {
-                _lv_blend_fill(clip_area, &blend_area, dsc->bg_color, mask_buf, mask_res, LV_OPA_COVER, dsc->blend_mode);
+        /*The bottom line is the mirror of the top line*/
+        lv_coord_t ys[2] = {top_y, bottom_y};
+        uint32_t i;
+        for(i = 0; i < 2; i++) {
+            lv_coord_t y = ys[i];
+            if(y < draw_area.y1 || y > draw_area.y2) continue;
+
+            lv_coord_t grad_y = y - coords_bg.y1;
+            left_area.y1 = y;
+            left_area.y2 = y;
+            mid_area.y1 = y;
+            mid_area.y2 = y;
+            right_area.y1 = y;
+            right_area.y2 = y;
+            if(left_w > 0) {
+                draw_bg_span(clip_area, &left_area, dsc, grad_dir, left_map, coords_h, grad_y,
+                             left_mask, left_res, LV_OPA_COVER);
             }
-            else if(grad_dir == LV_GRAD_DIR_HOR) {
-                _lv_blend_map(clip_area, &blend_area, grad_map, mask_buf, mask_res, LV_OPA_COVER, dsc->blend_mode);
+            if(mid_w > 0) {
+                draw_bg_span(clip_area, &mid_area, dsc, grad_dir, mid_map, coords_h, grad_y,
+                             NULL, LV_DRAW_MASK_RES_FULL_COVER, opa);
             }
-            else if(grad_dir == LV_GRAD_DIR_VER) {
-                lv_color_t c = grad_get(dsc, coords_h, bottom_y - coords_bg.y1);
-                _lv_blend_fill(clip_area, &blend_area, c, mask_buf, mask_res, LV_OPA_COVER, dsc->blend_mode);
+            if(right_w > 0) {
+                draw_bg_span(clip_area, &right_area, dsc, grad_dir, right_map, coords_h, grad_y,
+                             right_mask, right_res, LV_OPA_COVER);
             }
         }
     }
@@ -298,10 +331,12 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
 
 bg_clean_up:
     if(grad_map) lv_mem_buf_release(grad_map);
-    if(mask_buf) lv_mem_buf_release(mask_buf);
     if(mask_rout_id != LV_MASK_ID_INV) {
         lv_draw_mask_remove_id(mask_rout_id);
+    }
+    if(mask_buf) {
         lv_draw_mask_free_param(&mask_rout_param);
+        lv_mem_buf_release(mask_buf);
     }
 
 #endif
@@ -417,6 +452,61 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t
     return lv_color_mix(dsc->bg_grad_color, dsc->bg_color, mix);
 }
 
+/**
+ * Blend a horizontal span of the background
+ * @param clip_area the span will be drawn only in this area
+ * @param blend_area the span to draw (one line)
+ * @param dsc pointer to the draw descriptor
+ * @param grad_dir the real direction of the gradient
+ * @param grad_map the colors of the span in case of horizontal gradient
+ * @param grad_h height of the background for vertical gradient
+ * @param grad_y y coordinate of the line relative to the background for vertical gradient
+ * @param mask_buf mask of the span or NULL
+ * @param mask_res the type of the mask
+ * @param opa opacity of the span
+ */
+LV_ATTRIBUTE_FAST_MEM static void draw_bg_span(const lv_area_t * clip_area, const lv_area_t * blend_area,
+                                               const lv_draw_rect_dsc_t * dsc, lv_grad_dir_t grad_dir, const lv_color_t * grad_map,
+                                               lv_coord_t grad_h, lv_coord_t grad_y,
+                                               lv_opa_t * mask_buf, lv_draw_mask_res_t mask_res, lv_opa_t opa)
+{
+    if(grad_dir == LV_GRAD_DIR_NONE) {
+        _lv_blend_fill(clip_area, blend_area, dsc->bg_color, mask_buf, mask_res, opa, dsc->blend_mode);
+    }
+    else if(grad_dir == LV_GRAD_DIR_HOR) {
+        _lv_blend_map(clip_area, blend_area, grad_map, mask_buf, mask_res, opa, dsc->blend_mode);
+    }
+    else if(grad_dir == LV_GRAD_DIR_VER) {
+        lv_color_t c = grad_get(dsc, grad_h, grad_y);
+        _lv_blend_fill(clip_area, blend_area, c, mask_buf, mask_res, opa, dsc->blend_mode);
+    }
+}
+
+/**
+ * Apply radius masks on a line without adding them to the mask stack.
+ * The circle of the masks is taken from the circle cache so only the corners are calculated.
+ * @param mask_buf buffer to modify
+ * @param abs_x absolute X coordinate where the line starts
+ * @param abs_y absolute Y coordinate of the line
+ * @param len length of the line
+ * @param rout_param an initialized radius mask keeping the inside
+ * @param rin_param an initialized inverted radius mask or NULL if unused
+ * @return the result of the masks like `lv_draw_mask_apply`
+ */
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t mask_radius_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
+                                                                  lv_coord_t len, lv_draw_mask_radius_param_t * rout_param,
+                                                                  lv_draw_mask_radius_param_t * rin_param)
+{
+    lv_draw_mask_res_t res = rout_param->dsc.cb(mask_buf, abs_x, abs_y, len, rout_param);
+    if(res == LV_DRAW_MASK_RES_TRANSP || rin_param == NULL) return res;
+
+    lv_draw_mask_res_t res_in = rin_param->dsc.cb(mask_buf, abs_x, abs_y, len, rin_param);
+    if(res_in == LV_DRAW_MASK_RES_TRANSP) return LV_DRAW_MASK_RES_TRANSP;
+
+    if(res == LV_DRAW_MASK_RES_CHANGED || res_in == LV_DRAW_MASK_RES_CHANGED) return LV_DRAW_MASK_RES_CHANGED;
+    else return LV_DRAW_MASK_RES_FULL_COVER;
+}
+
 LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv_area_t * clip,
                                               const lv_draw_rect_dsc_t * dsc)
 {
@@ -1089,17 +1179,12 @@ void draw_border_generic(const lv_area_t * clip_area, const lv_area_t * outer_ar
     lv_opa_t * mask_buf = lv_mem_buf_get(draw_area_w);
 
     /*Create mask for the outer area*/
-    int16_t mask_rout_id = LV_MASK_ID_INV;
     lv_draw_mask_radius_param_t mask_rout_param;
-    if(rout > 0) {
-        lv_draw_mask_radius_init(&mask_rout_param, outer_area, rout, false);
-        mask_rout_id = lv_draw_mask_add(&mask_rout_param, NULL);
-    }
+    lv_draw_mask_radius_init(&mask_rout_param, outer_area, rout, false);
 
     /*Create mask for the inner mask*/
     lv_draw_mask_radius_param_t mask_rin_param;
     lv_draw_mask_radius_init(&mask_rin_param, inner_area, rin, true);
-    int16_t mask_rin_id = lv_draw_mask_add(&mask_rin_param, NULL);
 
     int32_t h;
     lv_draw_mask_res_t mask_res;
@@ -1116,11 +1201,14 @@ void draw_border_generic(const lv_area_t * clip_area, const lv_area_t * outer_ar
     bool top_side = outer_area->y1 <= inner_area->y1 ? true : false;
     bool bottom_side = outer_area->y2 >= inner_area->y2 ? true : false;
 
-    /*If there is other masks, need to draw line by line*/
+    /*If there is other masks, need to draw line by line with the mask stack*/
     if(mask_any) {
+        int16_t mask_rout_id = lv_draw_mask_add(&mask_rout_param, NULL);
+        int16_t mask_rin_id = lv_draw_mask_add(&mask_rin_param, NULL);
+
         blend_area.x1 = draw_area.x1;
         blend_area.x2 = draw_area.x2;
-        for(h = draw_area.y1; h < draw_area.y2; h++) {
+        for(h = draw_area.y1; h <= draw_area.y2; h++) {
             if(!top_side && h < core_area.y1) continue;
             if(!bottom_side && h > core_area.y2) break;
 
@@ -1132,15 +1220,15 @@ void draw_border_generic(const lv_area_t * clip_area, const lv_area_t * outer_ar
             _lv_blend_fill(clip_area, &blend_area, color, mask_buf, mask_res, opa, blend_mode);
         }
 
-        lv_draw_mask_free_param(&mask_rin_param);
         lv_draw_mask_remove_id(mask_rin_id);
-        lv_draw_mask_free_param(&mask_rout_param);
+        lv_draw_mask_free_param(&mask_rin_param);
         lv_draw_mask_remove_id(mask_rout_id);
+        lv_draw_mask_free_param(&mask_rout_param);
         lv_mem_buf_release(mask_buf);
         return;
     }
 
-    /*No masks*/
+    /*No other masks: only the corners are masked directly, without the mask stack*/
     bool left_side = outer_area->x1 <= inner_area->x1 ? true : false;
     bool right_side = outer_area->x2 >= inner_area->x2 ? true : false;
 
@@ -1189,28 +1277,60 @@ void draw_border_generic(const lv_area_t * clip_area, const lv_area_t * outer_ar
 
     /*Left and right corner together is they close to eachother*/
     if(!split_hor) {
-        /*Calculate the top corner and mirror it to the bottom*/
-        blend_area.x1 = draw_area.x1;
-        blend_area.x2 = draw_area.x2;
+        /*Calculate the top corner and mirror it to the bottom.
+         *Between the corners there is a solid span or the inner area.*/
+        lv_area_t left_area;
+        left_area.x1 = draw_area.x1;
+        left_area.x2 = LV_MIN(draw_area.x2, core_area.x1 - 1);
+        lv_area_t mid_area;
+        mid_area.x1 = LV_MAX(draw_area.x1, core_area.x1);
+        mid_area.x2 = LV_MIN(draw_area.x2, core_area.x2);
+        lv_area_t right_area;
+        right_area.x1 = LV_MAX(draw_area.x1, core_area.x2 + 1);
+        right_area.x2 = draw_area.x2;
+
+        int32_t left_w = LV_MAX(lv_area_get_width(&left_area), 0);
+        int32_t mid_w = lv_area_get_width(&mid_area);
+        int32_t right_w = lv_area_get_width(&right_area);
+        lv_opa_t * left_mask = mask_buf;
+        lv_opa_t * right_mask = mask_buf + left_w;
+
         lv_coord_t max_h = LV_MAX(rout, outer_area->y1 - inner_area->y1);
         for(h = 0; h < max_h; h++) {
             lv_coord_t top_y = outer_area->y1 + h;
             lv_coord_t bottom_y = outer_area->y2 - h;
             if(top_y < draw_area.y1 && bottom_y > draw_area.y2) continue;   /*This line is clipped now*/
 
-            lv_memset_ff(mask_buf, draw_area_w);
-            mask_res = lv_draw_mask_apply(mask_buf, blend_area.x1, top_y, draw_area_w);
+            lv_draw_mask_res_t left_res = LV_DRAW_MASK_RES_TRANSP;
+            if(left_w > 0) {
+                lv_memset_ff(left_mask, left_w);
+                left_res = mask_radius_apply(left_mask, left_area.x1, top_y, left_w, &mask_rout_param, &mask_rin_param);
+            }
 
-            if(top_y >= draw_area.y1) {
-                blend_area.y1 = top_y;
-                blend_area.y2 = top_y;
-                _lv_blend_fill(clip_area, &blend_area, color, mask_buf, mask_res, opa, blend_mode);
+            lv_draw_mask_res_t right_res = LV_DRAW_MASK_RES_TRANSP;
+            if(right_w > 0) {
+                lv_memset_ff(right_mask, right_w);
+                right_res = mask_radius_apply(right_mask, right_area.x1, top_y, right_w, &mask_rout_param, &mask_rin_param);
             }
 
-            if(bottom_y <= draw_area.y2) {
-                blend_area.y1 = bottom_y;
-                blend_area.y2 = bottom_y;
-                _lv_blend_fill(clip_area, &blend_area, color, mask_buf, mask_res, opa, blend_mode);
+            /*The middle is either fully covered or it's in the inner area*/
+            bool mid_cover = mid_w > 0 && (top_y < inner_area->y1 || top_y > inner_area->y2);
+
+            lv_coord_t ys[2] = {top_y, bottom_y};
+            uint32_t i;
+            for(i = 0; i < 2; i++) {
+                lv_coord_t y = ys[i];
+                if(y < draw_area.y1 || y > draw_area.y2) continue;
+
+                left_area.y1 = y;
+                left_area.y2 = y;
+                mid_area.y1 = y;
+                mid_area.y2 = y;
+                right_area.y1 = y;
+                right_area.y2 = y;
+                if(left_w > 0) _lv_blend_fill(clip_area, &left_area, color, left_mask, left_res, opa, blend_mode);
+                if(mid_cover) _lv_blend_fill(clip_area, &mid_area, color, NULL, LV_DRAW_MASK_RES_FULL_COVER, opa, blend_mode);
+                if(right_w > 0) _lv_blend_fill(clip_area, &right_area, color, right_mask, right_res, opa, blend_mode);
             }
         }
     } else {
@@ -1225,7 +1345,7 @@ void draw_border_generic(const lv_area_t * clip_area, const lv_area_t * outer_ar
                     blend_area.y2 = h;
 
                     lv_memset_ff(mask_buf, blend_w);
-                    mask_res = lv_draw_mask_apply(mask_buf, blend_area.x1, h, blend_w);
+                    mask_res = mask_radius_apply(mask_buf, blend_area.x1, h, blend_w, &mask_rout_param, &mask_rin_param);
                     _lv_blend_fill(clip_area, &blend_area, color, mask_buf, mask_res, opa, blend_mode);
                 }
             }
@@ -1236,7 +1356,7 @@ void draw_border_generic(const lv_area_t * clip_area, const lv_area_t * outer_ar
                     blend_area.y2 = h;
 
                     lv_memset_ff(mask_buf, blend_w);
-                    mask_res = lv_draw_mask_apply(mask_buf, blend_area.x1, h, blend_w);
+                    mask_res = mask_radius_apply(mask_buf, blend_area.x1, h, blend_w, &mask_rout_param, &mask_rin_param);
                     _lv_blend_fill(clip_area, &blend_area, color, mask_buf, mask_res, opa, blend_mode);
                 }
             }
@@ -1254,7 +1374,7 @@ void draw_border_generic(const lv_area_t * clip_area, const lv_area_t * outer_ar
                     blend_area.y2 = h;
 
                     lv_memset_ff(mask_buf, blend_w);
-                    mask_res = lv_draw_mask_apply(mask_buf, blend_area.x1, h, blend_w);
+                    mask_res = mask_radius_apply(mask_buf, blend_area.x1, h, blend_w, &mask_rout_param, &mask_rin_param);
                     _lv_blend_fill(clip_area, &blend_area, color, mask_buf, mask_res, opa, blend_mode);
                 }
             }
@@ -1265,7 +1385,7 @@ void draw_border_generic(const lv_area_t * clip_area, const lv_area_t * outer_ar
                     blend_area.y2 = h;
 
                     lv_memset_ff(mask_buf, blend_w);
-                    mask_res = lv_draw_mask_apply(mask_buf, blend_area.x1, h, blend_w);
+                    mask_res = mask_radius_apply(mask_buf, blend_area.x1, h, blend_w, &mask_rout_param, &mask_rin_param);
                     _lv_blend_fill(clip_area, &blend_area, color, mask_buf, mask_res, opa, blend_mode);
                 }
             }
@@ -1273,9 +1393,7 @@ void draw_border_generic(const lv_area_t * clip_area, const lv_area_t * outer_ar
     }
 
     lv_draw_mask_free_param(&mask_rin_param);
-    lv_draw_mask_remove_id(mask_rin_id);
     lv_draw_mask_free_param(&mask_rout_param);
-    lv_draw_mask_remove_id(mask_rout_id);
     lv_mem_buf_release(mask_buf);
 
 #else /*LV_DRAW_COMPLEX*/
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_triangle.h"
+#include "lv_draw_raster.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_mem.h"
 
@@ -21,6 +22,11 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_DRAW_COMPLEX
+static bool is_simple_fill(const lv_draw_rect_dsc_t * draw_dsc);
+static void draw_polygon_raster(const lv_point_t points[], uint16_t point_cnt, const lv_area_t * clip_area,
+                                const lv_draw_rect_dsc_t * draw_dsc);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -53,7 +59,8 @@ void lv_draw_triangle(const lv_point_t points[], const lv_area_t * clip_area, co
 }
 
 /**
- * Draw a polygon. Only convex polygons are supported
+ * Draw a polygon. If only a background color is used any polygon can be drawn,
+ * else only convex polygons are supported.
  * @param points an array of points
  * @param point_cnt number of points
  * @param clip_area polygon will be drawn only in this area
@@ -90,6 +97,13 @@ void lv_draw_polygon(const lv_point_t points[], uint16_t point_cnt, const lv_are
         return;
     }
 
+    /*Rasterize the polygon directly instead of adding a mask for each edge*/
+    if(is_simple_fill(draw_dsc)) {
+        draw_polygon_raster(p, point_cnt, clip_area, draw_dsc);
+        lv_mem_buf_release(p);
+        return;
+    }
+
     lv_area_t poly_coords = {.x1 = LV_COORD_MAX, .y1 = LV_COORD_MAX, .x2 = LV_COORD_MIN, .y2 = LV_COORD_MIN};
 
     for(i = 0; i < point_cnt; i++) {
@@ -214,3 +228,41 @@ void lv_draw_polygon(const lv_point_t points[], uint16_t point_cnt, const lv_are
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_DRAW_COMPLEX
+/**
+ * Tell if only a plain background color needs to be drawn
+ * @param draw_dsc pointer to a draw descriptor
+ * @return true: the polygon can be drawn by the rasterizer
+ */
+static bool is_simple_fill(const lv_draw_rect_dsc_t * draw_dsc)
+{
+    if(draw_dsc->radius != 0) return false;
+    if(draw_dsc->bg_grad_dir != LV_GRAD_DIR_NONE) return false;
+    if(draw_dsc->bg_img_src && draw_dsc->bg_img_opa > LV_OPA_MIN) return false;
+    if(draw_dsc->border_width && draw_dsc->border_opa > LV_OPA_MIN) return false;
+    if(draw_dsc->outline_width && draw_dsc->outline_opa > LV_OPA_MIN) return false;
+    if(draw_dsc->shadow_width && draw_dsc->shadow_opa > LV_OPA_MIN) return false;
+
+    return true;
+}
+
+static void draw_polygon_raster(const lv_point_t points[], uint16_t point_cnt, const lv_area_t * clip_area,
+                                const lv_draw_rect_dsc_t * draw_dsc)
+{
+    lv_draw_raster_point_t * rp = lv_mem_buf_get(point_cnt * sizeof(lv_draw_raster_point_t));
+    uint16_t i;
+    for(i = 0; i < point_cnt; i++) {
+        rp[i].x = points[i].x << LV_DRAW_RASTER_SHIFT;
+        rp[i].y = points[i].y << LV_DRAW_RASTER_SHIFT;
+    }
+
+    lv_draw_raster_t raster;
+    lv_draw_raster_init(&raster);
+    lv_draw_raster_add_polygon(&raster, rp, point_cnt);
+    lv_draw_raster_draw(&raster, clip_area, draw_dsc->bg_color, draw_dsc->bg_opa, draw_dsc->blend_mode);
+    lv_draw_raster_free(&raster);
+
+    lv_mem_buf_release(rp);
+}
+#endif /*LV_DRAW_COMPLEX*/
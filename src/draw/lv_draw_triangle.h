@@ -36,7 +36,8 @@ extern "C" {
 void lv_draw_triangle(const lv_point_t points[], const lv_area_t * clip, const lv_draw_rect_dsc_t * draw_dsc);
 
 /**
- * Draw a polygon. Only convex polygons are supported.
+ * Draw a polygon. If only a background color is used any polygon can be drawn,
+ * else only convex polygons are supported.
  * @param points an array of points
  * @param point_cnt number of points
  * @param clip_area polygon will be drawn only in this area
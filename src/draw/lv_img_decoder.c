@@ -369,7 +369,16 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             return LV_RES_OK;
         }
         else {
-            /*If it's a file it need to be read line by line later*/
+            /*If the file is mapped to the memory use it directly after the header*/
+            lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+            uint32_t file_size;
+            const uint8_t * mapped = lv_fs_map(&user_data->f, &file_size);
+            uint32_t data_size = (uint32_t)dsc->header.w * dsc->header.h * lv_img_cf_get_px_size(cf) / 8;
+            if(mapped && file_size >= sizeof(lv_img_header_t) + data_size) {
+                dsc->img_data = mapped + sizeof(lv_img_header_t);
+            }
+
+            /*Else it need to be read line by line later*/
             return LV_RES_OK;
         }
     }
@@ -0,0 +1,484 @@
+/**
+ * @file lv_img_filter.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_img_filter.h"
+#include "../misc/lv_math.h"
+#include "../misc/lv_mem.h"
+#include "../misc/lv_assert.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The vertical passes process the columns in strips of this width to read the memory row by row*/
+#define STRIP_W     32
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool get_area(const lv_img_dsc_t * img, const lv_area_t * area, lv_area_t * res);
+static bool is_cf_supported(lv_img_cf_t cf);
+LV_ATTRIBUTE_FAST_MEM static void row_read(lv_img_dsc_t * img, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                           lv_color32_t * buf);
+LV_ATTRIBUTE_FAST_MEM static void row_read_ext(lv_img_dsc_t * img, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                               lv_coord_t ext_left, lv_coord_t ext_right, lv_color32_t * buf);
+LV_ATTRIBUTE_FAST_MEM static void row_write(lv_img_dsc_t * img, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                            const lv_color32_t * buf);
+static lv_res_t box_blur(lv_img_dsc_t * img, const lv_area_t * area, uint32_t size_hor, uint32_t size_ver);
+static lv_res_t box_blur_hor(lv_img_dsc_t * img, const lv_area_t * area, uint16_t r_back, uint16_t r_front);
+static lv_res_t box_blur_ver(lv_img_dsc_t * img, const lv_area_t * area, uint16_t r_back, uint16_t r_front);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_res_t lv_img_filter_box_blur(lv_img_dsc_t * img, const lv_area_t * area, uint16_t r_hor, uint16_t r_ver)
+{
+    LV_ASSERT_NULL(img);
+
+    return box_blur(img, area, 2 * r_hor + 1, 2 * r_ver + 1);
+}
+
+lv_res_t _lv_img_filter_box_blur_size(lv_img_dsc_t * img, const lv_area_t * area, uint16_t size_hor,
+                                      uint16_t size_ver)
+{
+    LV_ASSERT_NULL(img);
+
+    return box_blur(img, area, size_hor, size_ver);
+}
+
+lv_res_t lv_img_filter_gauss_blur(lv_img_dsc_t * img, const lv_area_t * area, uint16_t r)
+{
+    LV_ASSERT_NULL(img);
+
+    if(r == 0) return LV_RES_OK;
+
+    /*3 box blurs with radius `r / 3` are close to a Gaussian blur with `r / 3` sigma
+     *and reach `r` pixels in total*/
+    uint16_t r_box = (r + 2) / 3;
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_res_t res = lv_img_filter_box_blur(img, area, r_box, r_box);
+        if(res != LV_RES_OK) return res;
+    }
+
+    return LV_RES_OK;
+}
+
+lv_res_t lv_img_filter_color_matrix(lv_img_dsc_t * img, const lv_area_t * area, const int16_t matrix[20])
+{
+    LV_ASSERT_NULL(img);
+    LV_ASSERT_NULL(matrix);
+
+    if(!is_cf_supported(img->header.cf)) return LV_RES_INV;
+
+    lv_area_t a;
+    if(!get_area(img, area, &a)) return LV_RES_OK;
+
+    lv_coord_t w = lv_area_get_width(&a);
+    lv_color32_t * buf = lv_mem_buf_get(w * sizeof(lv_color32_t));
+    if(buf == NULL) return LV_RES_INV;
+
+    lv_coord_t y;
+    for(y = a.y1; y <= a.y2; y++) {
+        row_read(img, a.x1, y, w, buf);
+        lv_coord_t i;
+        for(i = 0; i < w; i++) {
+            int32_t c[4] = {buf[i].ch.red, buf[i].ch.green, buf[i].ch.blue, buf[i].ch.alpha};
+            int32_t res[4];
+            uint32_t k;
+            for(k = 0; k < 4; k++) {
+                const int16_t * m = &matrix[k * 5];
+                int32_t v = m[0] * c[0] + m[1] * c[1] + m[2] * c[2] + m[3] * c[3];
+                v = v / LV_IMG_FILTER_MATRIX_ONE + m[4];
+                res[k] = LV_CLAMP(0, v, 255);
+            }
+            buf[i].ch.red = res[0];
+            buf[i].ch.green = res[1];
+            buf[i].ch.blue = res[2];
+            buf[i].ch.alpha = res[3];
+        }
+        row_write(img, a.x1, y, w, buf);
+    }
+
+    lv_mem_buf_release(buf);
+    return LV_RES_OK;
+}
+
+lv_res_t lv_img_filter_convolve(lv_img_dsc_t * img, const lv_area_t * area, const int16_t * kernel, uint8_t size,
+                                int32_t div)
+{
+    LV_ASSERT_NULL(img);
+    LV_ASSERT_NULL(kernel);
+
+    if((size & 1) == 0 || size > LV_IMG_FILTER_KERNEL_MAX) {
+        LV_LOG_WARN("lv_img_filter_convolve: invalid kernel size: %d", size);
+        return LV_RES_INV;
+    }
+    if(!is_cf_supported(img->header.cf)) return LV_RES_INV;
+
+    lv_area_t a;
+    if(!get_area(img, area, &a)) return LV_RES_OK;
+
+    if(div == 0) {
+        uint32_t i;
+        for(i = 0; i < (uint32_t)size * size; i++) div += kernel[i];
+        if(div == 0) div = 1;
+    }
+
+    /*Keep the original of the last `size` rows as the rows are overwritten in place*/
+    int32_t half = size / 2;
+    lv_coord_t w = lv_area_get_width(&a);
+    lv_coord_t w_ext = w + 2 * half;
+    lv_color32_t * ring = lv_mem_buf_get(w_ext * size * sizeof(lv_color32_t));
+    lv_color32_t * out = lv_mem_buf_get(w * sizeof(lv_color32_t));
+    if(ring == NULL || out == NULL) {
+        if(ring) lv_mem_buf_release(ring);
+        if(out) lv_mem_buf_release(out);
+        return LV_RES_INV;
+    }
+
+    lv_coord_t y_max = img->header.h - 1;
+    lv_coord_t y_loaded = a.y1 - half - 1;
+    lv_coord_t y;
+    for(y = a.y1; y <= a.y2; y++) {
+        /*Load the rows which are not overwritten yet*/
+        for(; y_loaded < y + half; y_loaded++) {
+            lv_coord_t yl = y_loaded + 1;
+            row_read_ext(img, a.x1, LV_CLAMP(0, yl, y_max), w, half, half, &ring[((yl + size) % size) * w_ext]);
+        }
+
+        lv_coord_t i;
+        for(i = 0; i < w; i++) {
+            int32_t sum_r = 0;
+            int32_t sum_g = 0;
+            int32_t sum_b = 0;
+            const int16_t * k = kernel;
+            int32_t ky;
+            for(ky = -half; ky <= half; ky++) {
+                const lv_color32_t * row = &ring[((y + ky + size) % size) * w_ext + i];
+                int32_t kx;
+                for(kx = 0; kx < size; kx++) {
+                    sum_r += *k * row[kx].ch.red;
+                    sum_g += *k * row[kx].ch.green;
+                    sum_b += *k * row[kx].ch.blue;
+                    k++;
+                }
+            }
+            sum_r /= div;
+            sum_g /= div;
+            sum_b /= div;
+            out[i].ch.red = LV_CLAMP(0, sum_r, 255);
+            out[i].ch.green = LV_CLAMP(0, sum_g, 255);
+            out[i].ch.blue = LV_CLAMP(0, sum_b, 255);
+            out[i].ch.alpha = ring[((y + size) % size) * w_ext + i + half].ch.alpha;
+        }
+        row_write(img, a.x1, y, w, out);
+    }
+
+    lv_mem_buf_release(out);
+    lv_mem_buf_release(ring);
+    return LV_RES_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool get_area(const lv_img_dsc_t * img, const lv_area_t * area, lv_area_t * res)
+{
+    lv_area_t img_area;
+    lv_area_set(&img_area, 0, 0, img->header.w - 1, img->header.h - 1);
+    if(area == NULL) {
+        lv_area_copy(res, &img_area);
+        return img->header.w > 0 && img->header.h > 0;
+    }
+
+    return _lv_area_intersect(res, area, &img_area);
+}
+
+static bool is_cf_supported(lv_img_cf_t cf)
+{
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+        case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        case LV_IMG_CF_ALPHA_1BIT:
+        case LV_IMG_CF_ALPHA_2BIT:
+        case LV_IMG_CF_ALPHA_4BIT:
+        case LV_IMG_CF_ALPHA_8BIT:
+            return true;
+        default:
+            LV_LOG_WARN("unsupported color format: %d", cf);
+            return false;
+    }
+}
+
+/**
+ * Read a part of a row into 8 bit channels.
+ * The color format is checked once for the whole row and the true color formats are read directly.
+ * @param img pointer to an image
+ * @param x start x coordinate
+ * @param y y coordinate
+ * @param len number of pixels to read
+ * @param buf store the pixels here
+ */
+LV_ATTRIBUTE_FAST_MEM static void row_read(lv_img_dsc_t * img, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                           lv_color32_t * buf)
+{
+    uint32_t px = (uint32_t)y * img->header.w + x;
+    lv_coord_t i;
+    if(img->header.cf == LV_IMG_CF_TRUE_COLOR || img->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+        const lv_color_t * src = (const lv_color_t *)img->data + px;
+        for(i = 0; i < len; i++) {
+            buf[i].full = lv_color_to32(src[i]);
+        }
+    }
+    else if(img->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+        const uint8_t * src = img->data + px * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        for(i = 0; i < len; i++) {
+            lv_color_t c;
+            lv_memcpy_small(&c, src, sizeof(lv_color_t));
+            buf[i].full = lv_color_to32(c);
+            buf[i].ch.alpha = src[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            src += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+    }
+    else {
+        for(i = 0; i < len; i++) {
+            buf[i].full = 0;
+            buf[i].ch.alpha = lv_img_buf_get_px_alpha(img, x + i, y);
+        }
+    }
+}
+
+/**
+ * Read a part of a row and `ext_left` and `ext_right` pixels on its sides.
+ * The pixels out of the image are the same as the nearest pixel in the row.
+ */
+LV_ATTRIBUTE_FAST_MEM static void row_read_ext(lv_img_dsc_t * img, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                               lv_coord_t ext_left, lv_coord_t ext_right, lv_color32_t * buf)
+{
+    lv_coord_t x1 = LV_MAX(x - ext_left, 0);
+    lv_coord_t x2 = LV_MIN(x + len - 1 + ext_right, (lv_coord_t)img->header.w - 1);
+    lv_color32_t * start = &buf[x1 - (x - ext_left)];
+    row_read(img, x1, y, x2 - x1 + 1, start);
+
+    lv_color32_t * end = &buf[x2 - (x - ext_left)];
+    lv_color32_t * p;
+    for(p = buf; p < start; p++) *p = *start;
+    for(p = end + 1; p < &buf[len + ext_left + ext_right]; p++) *p = *end;
+}
+
+/**
+ * Write 8 bit channels to a part of a row
+ * @param img pointer to an image
+ * @param x start x coordinate
+ * @param y y coordinate
+ * @param len number of pixels to write
+ * @param buf the pixels to write
+ */
+LV_ATTRIBUTE_FAST_MEM static void row_write(lv_img_dsc_t * img, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                            const lv_color32_t * buf)
+{
+    uint32_t px = (uint32_t)y * img->header.w + x;
+    lv_coord_t i;
+    if(img->header.cf == LV_IMG_CF_TRUE_COLOR || img->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+        lv_color_t * dest = (lv_color_t *)img->data + px;
+        for(i = 0; i < len; i++) {
+            dest[i] = lv_color_make(buf[i].ch.red, buf[i].ch.green, buf[i].ch.blue);
+        }
+    }
+    else if(img->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+        uint8_t * dest = (uint8_t *)img->data + px * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        for(i = 0; i < len; i++) {
+            lv_color_t c = lv_color_make(buf[i].ch.red, buf[i].ch.green, buf[i].ch.blue);
+            lv_memcpy_small(dest, &c, sizeof(lv_color_t));
+            dest[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = buf[i].ch.alpha;
+            dest += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+    }
+    else {
+        for(i = 0; i < len; i++) {
+            lv_img_buf_set_px_alpha(img, x + i, y, buf[i].ch.alpha);
+        }
+    }
+}
+
+/**
+ * Blur an area with a box of `size_hor` x `size_ver` pixels.
+ * If a size is even the box has one more pixel after the pixel than before it. 0 or 1: no blur.
+ */
+static lv_res_t box_blur(lv_img_dsc_t * img, const lv_area_t * area, uint32_t size_hor, uint32_t size_ver)
+{
+    if(!is_cf_supported(img->header.cf)) return LV_RES_INV;
+
+    lv_area_t a;
+    if(!get_area(img, area, &a)) return LV_RES_OK;
+
+    if(size_hor > 1 && box_blur_hor(img, &a, (size_hor - 1) / 2, size_hor / 2) != LV_RES_OK) return LV_RES_INV;
+    if(size_ver > 1 && box_blur_ver(img, &a, (size_ver - 1) / 2, size_ver / 2) != LV_RES_OK) return LV_RES_INV;
+
+    return LV_RES_OK;
+}
+
+/**
+ * Blur the rows of an area with running sums.
+ * The window of a pixel is `r_back` pixels on its left, the pixel and `r_front` pixels on its right.
+ */
+static lv_res_t box_blur_hor(lv_img_dsc_t * img, const lv_area_t * area, uint16_t r_back, uint16_t r_front)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_color32_t * buf = lv_mem_buf_get((w + r_back + r_front) * sizeof(lv_color32_t));
+    if(buf == NULL) return LV_RES_INV;
+
+    /*Multiply by the reciprocal instead of dividing. Rounding keeps the constant colors unchanged.*/
+    uint32_t d = r_back + r_front + 1;
+    uint32_t inv = (1 << 16) / d;
+
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        row_read_ext(img, area->x1, y, w, r_back, r_front, buf);
+
+        uint32_t sum_r = 0;
+        uint32_t sum_g = 0;
+        uint32_t sum_b = 0;
+        uint32_t sum_a = 0;
+        uint32_t i;
+        for(i = 0; i < d; i++) {
+            sum_r += buf[i].ch.red;
+            sum_g += buf[i].ch.green;
+            sum_b += buf[i].ch.blue;
+            sum_a += buf[i].ch.alpha;
+        }
+
+        /*The result of a pixel is stored in the place of the leftmost pixel of its window
+         *which is not needed anymore*/
+        lv_color32_t * p = buf;
+        lv_coord_t x;
+        for(x = 0; x < w; x++) {
+            lv_color32_t old = *p;
+            p->ch.red = (sum_r * inv + 0x8000) >> 16;
+            p->ch.green = (sum_g * inv + 0x8000) >> 16;
+            p->ch.blue = (sum_b * inv + 0x8000) >> 16;
+            p->ch.alpha = (sum_a * inv + 0x8000) >> 16;
+
+            if(x < w - 1) {
+                const lv_color32_t * next = p + d;
+                sum_r += next->ch.red - old.ch.red;
+                sum_g += next->ch.green - old.ch.green;
+                sum_b += next->ch.blue - old.ch.blue;
+                sum_a += next->ch.alpha - old.ch.alpha;
+            }
+            p++;
+        }
+
+        row_write(img, area->x1, y, w, buf);
+    }
+
+    lv_mem_buf_release(buf);
+    return LV_RES_OK;
+}
+
+/**
+ * Blur the columns of an area with running sums.
+ * The window of a pixel is `r_back` pixels above it, the pixel and `r_front` pixels below it.
+ * The columns are processed in strips to read and write the memory row by row
+ * and the original of the last `r_back + 1` rows is kept as the rows are overwritten in place.
+ */
+static lv_res_t box_blur_ver(lv_img_dsc_t * img, const lv_area_t * area, uint16_t r_back, uint16_t r_front)
+{
+    uint32_t ring_size = r_back + 1;
+    lv_color32_t * ring = lv_mem_buf_get(STRIP_W * ring_size * sizeof(lv_color32_t));
+    lv_color32_t * buf = lv_mem_buf_get(STRIP_W * sizeof(lv_color32_t));
+    uint32_t * sums = lv_mem_buf_get(STRIP_W * 4 * sizeof(uint32_t));
+    if(ring == NULL || buf == NULL || sums == NULL) {
+        if(ring) lv_mem_buf_release(ring);
+        if(buf) lv_mem_buf_release(buf);
+        if(sums) lv_mem_buf_release(sums);
+        return LV_RES_INV;
+    }
+
+    uint32_t d = r_back + r_front + 1;
+    uint32_t inv = (1 << 16) / d;
+    lv_coord_t y_max = img->header.h - 1;
+
+    lv_coord_t x;
+    for(x = area->x1; x <= area->x2; x += STRIP_W) {
+        lv_coord_t sw = LV_MIN(STRIP_W, area->x2 - x + 1);
+        lv_coord_t i;
+
+        /*The sum of the first window. The rows out of the image are the same as the nearest row.*/
+        lv_memset_00(sums, sw * 4 * sizeof(uint32_t));
+        int32_t k;
+        for(k = -r_back; k <= r_front; k++) {
+            row_read(img, x, LV_CLAMP(0, area->y1 + k, y_max), sw, buf);
+            for(i = 0; i < sw; i++) {
+                sums[i * 4 + 0] += buf[i].ch.red;
+                sums[i * 4 + 1] += buf[i].ch.green;
+                sums[i * 4 + 2] += buf[i].ch.blue;
+                sums[i * 4 + 3] += buf[i].ch.alpha;
+            }
+        }
+
+        lv_coord_t y;
+        for(y = area->y1; y <= area->y2; y++) {
+            /*Save the original row before overwriting it*/
+            row_read(img, x, y, sw, &ring[(y % ring_size) * STRIP_W]);
+
+            for(i = 0; i < sw; i++) {
+                buf[i].ch.red = (sums[i * 4 + 0] * inv + 0x8000) >> 16;
+                buf[i].ch.green = (sums[i * 4 + 1] * inv + 0x8000) >> 16;
+                buf[i].ch.blue = (sums[i * 4 + 2] * inv + 0x8000) >> 16;
+                buf[i].ch.alpha = (sums[i * 4 + 3] * inv + 0x8000) >> 16;
+            }
+            row_write(img, x, y, sw, buf);
+
+            if(y == area->y2) break;
+
+            /*Move the window down. The leaving row is either above the area or already overwritten.*/
+            lv_coord_t y_out = LV_MAX(y - r_back, 0);
+            const lv_color32_t * out;
+            if(y_out >= area->y1) out = &ring[(y_out % ring_size) * STRIP_W];
+            else {
+                row_read(img, x, y_out, sw, buf);
+                out = buf;
+            }
+            for(i = 0; i < sw; i++) {
+                sums[i * 4 + 0] -= out[i].ch.red;
+                sums[i * 4 + 1] -= out[i].ch.green;
+                sums[i * 4 + 2] -= out[i].ch.blue;
+                sums[i * 4 + 3] -= out[i].ch.alpha;
+            }
+
+            row_read(img, x, LV_MIN(y + r_front + 1, y_max), sw, buf);
+            for(i = 0; i < sw; i++) {
+                sums[i * 4 + 0] += buf[i].ch.red;
+                sums[i * 4 + 1] += buf[i].ch.green;
+                sums[i * 4 + 2] += buf[i].ch.blue;
+                sums[i * 4 + 3] += buf[i].ch.alpha;
+            }
+        }
+    }
+
+    lv_mem_buf_release(sums);
+    lv_mem_buf_release(buf);
+    lv_mem_buf_release(ring);
+    return LV_RES_OK;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file lv_img_filter.h
+ *
+ */
+
+#ifndef LV_IMG_FILTER_H
+#define LV_IMG_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_types.h"
+#include "lv_img_buf.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*1.0 in the color matrices*/
+#define LV_IMG_FILTER_MATRIX_ONE    256
+
+/*The largest supported convolution kernel is LV_IMG_FILTER_KERNEL_MAX x LV_IMG_FILTER_KERNEL_MAX*/
+#define LV_IMG_FILTER_KERNEL_MAX    7
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Blur an area of an image in place with a box blur.
+ * The pixels outside of the area are read (but not changed) too to blur the edges of the area.
+ * @param img pointer to an image. `LV_IMG_CF_TRUE_COLOR...` and `LV_IMG_CF_ALPHA_...` formats are supported.
+ * @param area the area to blur relative to the image. NULL to blur the whole image.
+ * @param r_hor horizontal radius: the average of `2 * r_hor + 1` pixels is taken in a row. 0: no horizontal blur.
+ * @param r_ver vertical radius: the average of `2 * r_ver + 1` pixels is taken in a column. 0: no vertical blur.
+ * @return LV_RES_OK: blurred; LV_RES_INV: the color format is not supported or out of memory
+ */
+lv_res_t lv_img_filter_box_blur(lv_img_dsc_t * img, const lv_area_t * area, uint16_t r_hor, uint16_t r_ver);
+
+/**
+ * Blur an area of an image in place with a box blur of a given size.
+ * Unlike with `lv_img_filter_box_blur` the size can be even: then the box has one more pixel
+ * after (right of or below) the blurred pixel than before it.
+ * @param img pointer to an image. See `lv_img_filter_box_blur` for the supported formats.
+ * @param area the area to blur relative to the image. NULL to blur the whole image.
+ * @param size_hor the average of `size_hor` pixels is taken in a row. 0 or 1: no horizontal blur.
+ * @param size_ver the average of `size_ver` pixels is taken in a column. 0 or 1: no vertical blur.
+ * @return LV_RES_OK: blurred; LV_RES_INV: the color format is not supported or out of memory
+ */
+lv_res_t _lv_img_filter_box_blur_size(lv_img_dsc_t * img, const lv_area_t * area, uint16_t size_hor,
+                                      uint16_t size_ver);
+
+/**
+ * Blur an area of an image in place with an approximated Gaussian blur (3 box blurs)
+ * @param img pointer to an image. See `lv_img_filter_box_blur` for the supported formats.
+ * @param area the area to blur relative to the image. NULL to blur the whole image.
+ * @param r radius of the blur. The pixels farther than `r` don't affect a pixel.
+ * @return LV_RES_OK: blurred; LV_RES_INV: the color format is not supported or out of memory
+ */
+lv_res_t lv_img_filter_gauss_blur(lv_img_dsc_t * img, const lv_area_t * area, uint16_t r);
+
+/**
+ * Transform the color channels of an area with a 4x5 matrix.
+ * The red, green, blue and alpha results are the rows of the matrix:
+ * `res = (m[0] * red + m[1] * green + m[2] * blue + m[3] * alpha) / LV_IMG_FILTER_MATRIX_ONE + m[4]`
+ * @param img pointer to an image. See `lv_img_filter_box_blur` for the supported formats.
+ * @param area the area to filter relative to the image. NULL to filter the whole image.
+ * @param matrix 20 coefficients. The first 4 of a row are multipliers (`LV_IMG_FILTER_MATRIX_ONE` is 1.0),
+ *               the 5th is added to the result in the 0..255 range.
+ * @return LV_RES_OK: filtered; LV_RES_INV: the color format is not supported
+ */
+lv_res_t lv_img_filter_color_matrix(lv_img_dsc_t * img, const lv_area_t * area, const int16_t matrix[20]);
+
+/**
+ * Convolve the color channels of an area with a kernel (e.g. to sharpen or detect edges).
+ * The alpha channel is not changed.
+ * @param img pointer to an image. See `lv_img_filter_box_blur` for the supported formats.
+ * @param area the area to filter relative to the image. NULL to filter the whole image.
+ * @param kernel `size * size` weights row by row
+ * @param size size of the kernel. Odd number, at most `LV_IMG_FILTER_KERNEL_MAX`
+ * @param div the weighted sum is divided by it. 0: use the sum of the weights (or 1 if it's 0).
+ * @return LV_RES_OK: filtered; LV_RES_INV: invalid parameter, the color format is not supported or out of memory
+ */
+lv_res_t lv_img_filter_convolve(lv_img_dsc_t * img, const lv_area_t * area, const int16_t * kernel, uint8_t size,
+                                int32_t div);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_IMG_FILTER_H*/
@@ -242,66 +242,66 @@ void lv_obj_set_style_grid_column_dsc_array(lv_obj_t * obj, const lv_coord_t val
 
 void lv_obj_set_style_grid_row_align(lv_obj_t * obj, lv_grid_align_t value, lv_style_selector_t selector)
 {
-    lv_style_value_t v = {
-        .num = (int32_t) value
-    };
+    lv_style_value_t v;
+    lv_memset_00(&v, sizeof(v));
+    v.num = (int32_t)value;
     lv_obj_set_local_style_prop(obj, LV_STYLE_GRID_ROW_ALIGN, v, selector);
 }
 
 void lv_obj_set_style_grid_column_align(lv_obj_t * obj, lv_grid_align_t value, lv_style_selector_t selector)
 {
-    lv_style_value_t v = {
-        .num = (int32_t) value
-    };
+    lv_style_value_t v;
+    lv_memset_00(&v, sizeof(v));
+    v.num = (int32_t)value;
     lv_obj_set_local_style_prop(obj, LV_STYLE_GRID_COLUMN_ALIGN, v, selector);
 }
 
 
 void lv_obj_set_style_grid_cell_column_pos(lv_obj_t * obj, lv_coord_t value, lv_style_selector_t selector)
 {
-    lv_style_value_t v = {
-        .num = value
-    };
+    lv_style_value_t v;
+    lv_memset_00(&v, sizeof(v));
+    v.num = value;
     lv_obj_set_local_style_prop(obj,LV_STYLE_GRID_CELL_COLUMN_POS, v, selector);
 }
 
 void lv_obj_set_style_grid_cell_column_span(lv_obj_t * obj, lv_coord_t value, lv_style_selector_t selector)
 {
-    lv_style_value_t v = {
-        .num = value
-    };
+    lv_style_value_t v;
+    lv_memset_00(&v, sizeof(v));
+    v.num = value;
     lv_obj_set_local_style_prop(obj,LV_STYLE_GRID_CELL_COLUMN_SPAN, v, selector);
 }
 
 void lv_obj_set_style_grid_cell_row_pos(lv_obj_t * obj, lv_coord_t value, lv_style_selector_t selector)
 {
-    lv_style_value_t v = {
-        .num = value
-    };
+    lv_style_value_t v;
+    lv_memset_00(&v, sizeof(v));
+    v.num = value;
     lv_obj_set_local_style_prop(obj,LV_STYLE_GRID_CELL_ROW_POS, v, selector);
 }
 
 void lv_obj_set_style_grid_cell_row_span(lv_obj_t * obj, lv_coord_t value, lv_style_selector_t selector)
 {
-    lv_style_value_t v = {
-        .num = value
-    };
+    lv_style_value_t v;
+    lv_memset_00(&v, sizeof(v));
+    v.num = value;
     lv_obj_set_local_style_prop(obj, LV_STYLE_GRID_CELL_ROW_SPAN, v, selector);
 }
 
 void lv_obj_set_style_grid_cell_x_align(lv_obj_t * obj, lv_coord_t value, lv_style_selector_t selector)
 {
-    lv_style_value_t v = {
-        .num = value
-    };
+    lv_style_value_t v;
+    lv_memset_00(&v, sizeof(v));
+    v.num = value;
     lv_obj_set_local_style_prop(obj, LV_STYLE_GRID_CELL_X_ALIGN, v, selector);
 }
 
 void lv_obj_set_style_grid_cell_y_align(lv_obj_t * obj, lv_coord_t value, lv_style_selector_t selector)
 {
-    lv_style_value_t v = {
-        .num = value
-    };
+    lv_style_value_t v;
+    lv_memset_00(&v, sizeof(v));
+    v.num = value;
     lv_obj_set_local_style_prop(obj, LV_STYLE_GRID_CELL_Y_ALIGN, v, selector);
 }
 
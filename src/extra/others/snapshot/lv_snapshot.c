@@ -10,7 +10,6 @@
 #if LV_USE_SNAPSHOT
 
 #include <stdbool.h>
-#include "../../../core/lv_disp.h"
 #include "../../../core/lv_refr.h"
 /*********************
  *      DEFINES
@@ -46,6 +45,7 @@
 uint32_t lv_snapshot_buf_size_needed(lv_obj_t * obj, lv_img_cf_t cf)
 {
     switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
         case LV_IMG_CF_ALPHA_1BIT:
         case LV_IMG_CF_ALPHA_2BIT:
@@ -82,6 +82,7 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
     LV_ASSERT(buf);
 
     switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
         case LV_IMG_CF_ALPHA_1BIT:
         case LV_IMG_CF_ALPHA_2BIT:
@@ -99,57 +100,14 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
     lv_coord_t w = lv_obj_get_width(obj);
     lv_coord_t h = lv_obj_get_height(obj);
 
-    /*Backup obj original info.*/
-    lv_disp_t * disp_old = lv_obj_get_disp(obj);
-    lv_obj_t * parent_old = lv_obj_get_parent(obj);
-
     lv_memset(buf, 0x00, buff_size);
     lv_memset_00(dsc, sizeof(lv_img_dsc_t));
 
-    /*We are safe to use stack for below variables since disp will be
-     * unregistered when function returns. */
-    lv_disp_t * disp;
-    lv_disp_drv_t driver;
-    lv_disp_draw_buf_t draw_buf;
-
-    lv_disp_draw_buf_init(&draw_buf, buf, NULL, w * h);
-
-    lv_disp_drv_init(&driver);
-    driver.draw_buf = &draw_buf;
-    driver.hor_res = lv_disp_get_hor_res(disp_old);
-    driver.ver_res = lv_disp_get_ver_res(disp_old);
-    lv_disp_drv_use_generic_set_px_cb(&driver, cf);
-
-    disp = lv_disp_drv_register(&driver);
-    if(disp == NULL) {
+    /*Render directly into the buffer. No display is created and the object is not moved.*/
+    if(lv_refr_obj_to_buf(obj, NULL, cf, buf) != LV_RES_OK) {
         return LV_RES_INV;
     }
 
-    /*Make background transparent */
-    lv_disp_set_bg_opa(disp, LV_OPA_TRANSP);
-
-    /*Move obj to newly created disp and refresh it. */
-    lv_obj_t * screen = lv_disp_get_scr_act(disp);
-    lv_obj_remove_style_all(screen);
-    lv_obj_allocate_spec_attr(screen);
-    screen->spec_attr->child_cnt = 1;
-    screen->spec_attr->children = &obj;
-
-    obj->parent = screen;
-
-    disp->inv_p = 0;
-    lv_obj_invalidate(obj);
-
-    /*Don't call lv_refr_now to avoid animation disruption */
-    _lv_disp_refr_timer(disp->refr_timer);
-
-    /*Restore obj original parameters and clean up*/
-    obj->parent = parent_old;
-    screen->spec_attr->child_cnt = 0;
-    screen->spec_attr->children = NULL;
-
-    lv_disp_remove(disp);
-
     dsc->data = buf;
     dsc->header.w = w;
     dsc->header.h = h;
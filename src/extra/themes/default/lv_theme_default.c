@@ -591,6 +591,9 @@ lv_theme_t * lv_theme_default_init(lv_disp_t * disp, lv_color_t color_primary, l
     inited = true;
 
     if(disp == NULL || lv_disp_get_theme(disp) == &theme) lv_obj_report_style_change(NULL);
+#if LV_USE_THEME_COMPILE
+    else _lv_theme_update_compiled(NULL);
+#endif
 
     return (lv_theme_t *)&theme;
 }
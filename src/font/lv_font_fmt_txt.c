@@ -201,6 +201,24 @@ void _lv_font_clean_up_fmt_txt(void)
 #endif
 }
 
+uint32_t _lv_font_fmt_txt_get_glyph_id(const lv_font_t * font, uint32_t letter)
+{
+    return get_glyph_dsc_id(font, letter);
+}
+
+int8_t _lv_font_fmt_txt_get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
+{
+    return get_kern_value(font, gid_left, gid_right);
+}
+
+#if LV_USE_FONT_COMPRESSED
+void _lv_font_fmt_txt_decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp,
+                                 bool prefilter)
+{
+    decompress(in, out, w, h, bpp, prefilter);
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
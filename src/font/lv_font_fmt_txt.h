@@ -225,6 +225,37 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+/**
+ * Get the glyph id of a letter. Used by the fonts which store the glyphs differently but use the same cmaps.
+ * @param font pointer to a font with `lv_font_fmt_txt_dsc_t` descriptor
+ * @param letter an UNICODE letter code
+ * @return the glyph id or 0 if the letter is not in the font
+ */
+uint32_t _lv_font_fmt_txt_get_glyph_id(const lv_font_t * font, uint32_t letter);
+
+/**
+ * Get the kerning value of two glyphs
+ * @param font pointer to a font with `lv_font_fmt_txt_dsc_t` descriptor and kerning data
+ * @param gid_left glyph id of the left letter
+ * @param gid_right glyph id of the right letter
+ * @return the kerning value (to scale with `kern_scale`)
+ */
+int8_t _lv_font_fmt_txt_get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
+
+#if LV_USE_FONT_COMPRESSED
+/**
+ * Decompress a glyph's bitmap
+ * @param in the compressed bitmap
+ * @param out buffer to store the result. 3 bpp bitmaps are stored with 4 bpp.
+ * @param w width of the glyph
+ * @param h height of the glyph
+ * @param bpp bit per pixel
+ * @param prefilter true: the lines are XORed
+ */
+void _lv_font_fmt_txt_decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp,
+                                 bool prefilter);
+#endif
+
 /**********************
  *      MACROS
  **********************/
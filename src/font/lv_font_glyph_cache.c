@@ -0,0 +1,134 @@
+/**
+ * @file lv_font_glyph_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_font_glyph_cache.h"
+#include "../misc/lv_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HASH(gid)   ((gid) & (_LV_FONT_GLYPH_CACHE_HASH_SIZE - 1))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lru_unlink(_lv_font_glyph_cache_t * cache, _lv_font_glyph_cache_entry_t * glyph);
+static void lru_add_first(_lv_font_glyph_cache_t * cache, _lv_font_glyph_cache_entry_t * glyph);
+static void glyph_free(_lv_font_glyph_cache_t * cache, _lv_font_glyph_cache_entry_t * glyph);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_font_glyph_cache_init(_lv_font_glyph_cache_t * cache, uint32_t max_size)
+{
+    lv_memset_00(cache, sizeof(_lv_font_glyph_cache_t));
+    cache->max_size = max_size;
+}
+
+_lv_font_glyph_cache_entry_t * _lv_font_glyph_cache_get(_lv_font_glyph_cache_t * cache, uint32_t gid)
+{
+    if(cache->uncached && cache->uncached->gid == gid) return cache->uncached;
+
+    _lv_font_glyph_cache_entry_t * glyph = cache->hash[HASH(gid)];
+    while(glyph && glyph->gid != gid) glyph = glyph->hash_next;
+    if(glyph == NULL) return NULL;
+
+    if(glyph != cache->lru_first) {
+        lru_unlink(cache, glyph);
+        lru_add_first(cache, glyph);
+    }
+
+    return glyph;
+}
+
+void _lv_font_glyph_cache_add(_lv_font_glyph_cache_t * cache, _lv_font_glyph_cache_entry_t * glyph)
+{
+    glyph->lru_prev = NULL;
+    glyph->lru_next = NULL;
+    glyph->hash_next = NULL;
+
+    /*Don't free all the cached glyphs for a glyph which wouldn't fit anyway*/
+    if(glyph->size > cache->max_size) {
+        if(cache->uncached) lv_mem_free(cache->uncached);
+        cache->uncached = glyph;
+        return;
+    }
+
+    /*Free the least recently used glyphs to make room for the new one*/
+    while(cache->lru_last && cache->size + glyph->size > cache->max_size) {
+        glyph_free(cache, cache->lru_last);
+    }
+
+    glyph->hash_next = cache->hash[HASH(glyph->gid)];
+    cache->hash[HASH(glyph->gid)] = glyph;
+    cache->size += glyph->size;
+    cache->glyph_cnt++;
+    lru_add_first(cache, glyph);
+}
+
+void _lv_font_glyph_cache_clear(_lv_font_glyph_cache_t * cache)
+{
+    while(cache->lru_first) glyph_free(cache, cache->lru_first);
+
+    if(cache->uncached) {
+        lv_mem_free(cache->uncached);
+        cache->uncached = NULL;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void lru_unlink(_lv_font_glyph_cache_t * cache, _lv_font_glyph_cache_entry_t * glyph)
+{
+    if(glyph->lru_prev) glyph->lru_prev->lru_next = glyph->lru_next;
+    else cache->lru_first = glyph->lru_next;
+    if(glyph->lru_next) glyph->lru_next->lru_prev = glyph->lru_prev;
+    else cache->lru_last = glyph->lru_prev;
+}
+
+static void lru_add_first(_lv_font_glyph_cache_t * cache, _lv_font_glyph_cache_entry_t * glyph)
+{
+    glyph->lru_prev = NULL;
+    glyph->lru_next = cache->lru_first;
+    if(cache->lru_first) cache->lru_first->lru_prev = glyph;
+    cache->lru_first = glyph;
+    if(cache->lru_last == NULL) cache->lru_last = glyph;
+}
+
+/**
+ * Remove a glyph from the cache and free it
+ * @param cache pointer to a glyph cache
+ * @param glyph pointer to a cached glyph
+ */
+static void glyph_free(_lv_font_glyph_cache_t * cache, _lv_font_glyph_cache_entry_t * glyph)
+{
+    lru_unlink(cache, glyph);
+
+    _lv_font_glyph_cache_entry_t ** p = &cache->hash[HASH(glyph->gid)];
+    while(*p != glyph) p = &(*p)->hash_next;
+    *p = glyph->hash_next;
+
+    cache->size -= glyph->size;
+    cache->glyph_cnt--;
+    lv_mem_free(glyph);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file lv_font_glyph_cache.h
+ *
+ */
+
+#ifndef LV_FONT_GLYPH_CACHE_H
+#define LV_FONT_GLYPH_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define _LV_FONT_GLYPH_CACHE_HASH_SIZE  64
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Header of a cached glyph. It needs to be the first member of the font engine's glyph type,
+ * and the glyph needs to be allocated with `lv_mem_alloc()` as one block (e.g. with its bitmap).
+ */
+typedef struct __lv_font_glyph_cache_entry_t {
+    struct __lv_font_glyph_cache_entry_t * lru_prev;    /*The more recently used glyph*/
+    struct __lv_font_glyph_cache_entry_t * lru_next;    /*The less recently used glyph*/
+    struct __lv_font_glyph_cache_entry_t * hash_next;   /*The next glyph in the same hash bucket*/
+    uint32_t gid;
+    uint32_t size;                                      /*Allocated size of the glyph*/
+} _lv_font_glyph_cache_entry_t;
+
+/**
+ * Glyphs of a font, looked up by their id and freed in least recently used order
+ * to keep their size under a limit.
+ */
+typedef struct {
+    _lv_font_glyph_cache_entry_t * hash[_LV_FONT_GLYPH_CACHE_HASH_SIZE];
+    _lv_font_glyph_cache_entry_t * lru_first;
+    _lv_font_glyph_cache_entry_t * lru_last;
+    _lv_font_glyph_cache_entry_t * uncached;    /*The last glyph which was bigger than the cache*/
+    uint32_t max_size;                          /*Max. size of the cached glyphs in bytes*/
+    uint32_t size;                              /*Size of the cached glyphs in bytes*/
+    uint32_t glyph_cnt;                         /*Number of cached glyphs*/
+} _lv_font_glyph_cache_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize an empty glyph cache
+ * @param cache     pointer to a glyph cache
+ * @param max_size  max. size of the cached glyphs in bytes
+ */
+void _lv_font_glyph_cache_init(_lv_font_glyph_cache_t * cache, uint32_t max_size);
+
+/**
+ * Find a glyph in the cache and make it the most recently used
+ * @param cache     pointer to a glyph cache
+ * @param gid       id of the glyph
+ * @return          the glyph or NULL if it's not cached
+ */
+_lv_font_glyph_cache_entry_t * _lv_font_glyph_cache_get(_lv_font_glyph_cache_t * cache, uint32_t gid);
+
+/**
+ * Add a new glyph to the cache as the most recently used. The least recently used glyphs are freed
+ * to keep the size of the cache under `max_size`.
+ * A glyph bigger than `max_size` is not cached: it's kept only until the next such glyph is added.
+ * @param cache     pointer to a glyph cache
+ * @param glyph     pointer to a glyph with `gid` and `size` set. The cache owns it from now on.
+ */
+void _lv_font_glyph_cache_add(_lv_font_glyph_cache_t * cache, _lv_font_glyph_cache_entry_t * glyph);
+
+/**
+ * Free all the glyphs of a cache
+ * @param cache     pointer to a glyph cache
+ */
+void _lv_font_glyph_cache_clear(_lv_font_glyph_cache_t * cache);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FONT_GLYPH_CACHE_H*/
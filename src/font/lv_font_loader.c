@@ -13,6 +13,7 @@
 #include "../lvgl.h"
 #include "../misc/lv_fs.h"
 #include "lv_font_loader.h"
+#include "lv_font_glyph_cache.h"
 
 /**********************
  *      TYPEDEFS
@@ -50,6 +51,30 @@ typedef struct font_header_bin {
     uint16_t underline_thickness;
 } font_header_bin_t;
 
+/*A glyph loaded on demand. Its bitmap follows the structure.*/
+typedef struct {
+    _lv_font_glyph_cache_entry_t entry; /*The size of the entry includes the bitmap*/
+    lv_font_fmt_txt_glyph_dsc_t dsc;
+} lazy_glyph_t;
+
+/*Data of the lazy loaded fonts*/
+typedef struct {
+    font_header_bin_t header;
+    uint32_t glyph_start;       /*Position of the `glyf` table in the file*/
+    uint32_t glyph_cnt;         /*Number of glyphs including the glyph 0*/
+    uint32_t * glyph_offset;    /*Offsets of the glyphs in the `glyf` table and the length of the table at the end*/
+    _lv_font_glyph_cache_t cache;
+    uint32_t load_cnt;
+} lazy_font_t;
+
+/*The descriptor allocated by the loader. `dsc` needs to be the first member
+ *as `font->dsc` is also used as `lv_font_fmt_txt_dsc_t`*/
+typedef struct {
+    lv_font_fmt_txt_dsc_t dsc;
+    lv_fs_file_t file;          /*Kept open if `glyph_bitmap` points to the mapped file or the font is lazy loaded*/
+    lazy_font_t * lazy;         /*Not NULL if the glyphs are loaded on demand*/
+} font_loader_dsc_t;
+
 typedef struct cmap_table_bin {
     uint32_t data_offset;
     uint32_t range_start;
@@ -63,8 +88,15 @@ typedef struct cmap_table_bin {
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_font_t * load_font(const char * font_name, uint32_t cache_size, bool lazy);
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool lazy);
+static bool lazy_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
+                               uint32_t unicode_letter_next);
+static const uint8_t * lazy_get_glyph_bitmap(const lv_font_t * font, uint32_t unicode_letter);
+static lazy_glyph_t * lazy_glyph_get(const lv_font_t * font, uint32_t gid);
+static lazy_glyph_t * lazy_glyph_load(font_loader_dsc_t * ldsc, uint32_t gid);
+static uint32_t get_bits_mem(const uint8_t * buf, uint32_t * bit_pos, uint32_t n_bits);
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
@@ -85,29 +117,58 @@ static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res
  */
 lv_font_t * lv_font_load(const char * font_name)
 {
-    lv_fs_file_t file;
-    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
-    if(res != LV_FS_RES_OK)
-        return NULL;
+    return load_font(font_name, 0, false);
+}
 
-    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
-    if(font) {
-        memset(font, 0, sizeof(lv_font_t));
-        if(!lvgl_load_font(&file, font)) {
-            LV_LOG_WARN("Error loading font file: %s\n", font_name);
-            /*
-            * When `lvgl_load_font` fails it can leak some pointers.
-            * All non-null pointers can be assumed as allocated and
-            * `lv_font_free` should free them correctly.
-            */
-            lv_font_free(font);
-            font = NULL;
-        }
-    }
+/**
+ * Open a binary font file and load its glyphs only when they are used.
+ * Only the header, the cmaps, the kerning and the glyph offsets are loaded now.
+ * The glyph descriptors and bitmaps are read from the file on the first use into a cache.
+ * The file remains open until `lv_font_free()`.
+ * @param font_name filename where the font file is located
+ * @param cache_size maximal size of the cached glyphs in bytes.
+ *                   The least recently used glyphs are freed if the cache is full.
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_lazy(const char * font_name, uint32_t cache_size)
+{
+    return load_font(font_name, cache_size, true);
+}
 
-    lv_fs_close(&file);
+/**
+ * Load some glyphs of a lazy loaded font into its cache to avoid reading the file when they are drawn first.
+ * @param font pointer to a font loaded by `lv_font_load_lazy()`
+ * @param letters UTF-8 string with the letters to load
+ */
+void lv_font_lazy_prewarm(lv_font_t * font, const char * letters)
+{
+    font_loader_dsc_t * ldsc = (font_loader_dsc_t *)font->dsc;
+    if(ldsc->lazy == NULL) return;
+
+    uint32_t i = 0;
+    while(letters[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(letters, &i);
+        uint32_t gid = _lv_font_fmt_txt_get_glyph_id(font, letter);
+        if(gid) lazy_glyph_get(font, gid);
+    }
+}
 
-    return font;
+/**
+ * Get the statistics of a lazy loaded font's cache
+ * @param font pointer to a font loaded by `lv_font_load_lazy()`
+ * @param stat store the statistics here. Zeroed if the font is not lazy loaded.
+ */
+void lv_font_lazy_get_stat(const lv_font_t * font, lv_font_lazy_stat_t * stat)
+{
+    font_loader_dsc_t * ldsc = (font_loader_dsc_t *)font->dsc;
+    if(ldsc->lazy) {
+        stat->glyph_cnt = ldsc->lazy->cache.glyph_cnt;
+        stat->cache_used = ldsc->lazy->cache.size;
+        stat->load_cnt = ldsc->lazy->load_cnt;
+    }
+    else {
+        lv_memset_00(stat, sizeof(lv_font_lazy_stat_t));
+    }
 }
 
 /**
@@ -166,7 +227,19 @@ void lv_font_free(lv_font_t * font)
                 lv_mem_free(cmaps);
             }
 
-            if(NULL != dsc->glyph_bitmap) {
+            font_loader_dsc_t * loader_dsc = (font_loader_dsc_t *)dsc;
+            lazy_font_t * lazy = loader_dsc->lazy;
+            if(lazy) {
+                _lv_font_glyph_cache_clear(&lazy->cache);
+                if(lazy->glyph_offset) lv_mem_free(lazy->glyph_offset);
+                lv_mem_free(lazy);
+            }
+
+            if(loader_dsc->file.drv != NULL) {
+                /*The bitmaps are in the mapped file*/
+                lv_fs_close(&loader_dsc->file);
+            }
+            else if(NULL != dsc->glyph_bitmap) {
                 lv_mem_free((void *)dsc->glyph_bitmap);
             }
             if(NULL != dsc->glyph_dsc) {
@@ -182,6 +255,41 @@ void lv_font_free(lv_font_t * font)
  *   STATIC FUNCTIONS
  **********************/
 
+static lv_font_t * load_font(const char * font_name, uint32_t cache_size, bool lazy)
+{
+    lv_fs_file_t file;
+    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
+    if(res != LV_FS_RES_OK)
+        return NULL;
+
+    bool file_kept = false;
+    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
+    if(font) {
+        memset(font, 0, sizeof(lv_font_t));
+        bool loaded = lvgl_load_font(&file, font, lazy);
+
+        font_loader_dsc_t * ldsc = (font_loader_dsc_t *)font->dsc;
+        if(ldsc && ldsc->lazy) _lv_font_glyph_cache_init(&ldsc->lazy->cache, cache_size);
+
+        /*If the bitmaps are used from the mapped file or loaded later the font owns the file*/
+        file_kept = ldsc && ldsc->file.drv != NULL;
+        if(!loaded) {
+            LV_LOG_WARN("Error loading font file: %s\n", font_name);
+            /*
+            * When `lvgl_load_font` fails it can leak some pointers.
+            * All non-null pointers can be assumed as allocated and
+            * `lv_font_free` should free them correctly.
+            */
+            lv_font_free(font);
+            font = NULL;
+        }
+    }
+
+    if(!file_kept) lv_fs_close(&file);
+
+    return font;
+}
+
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp)
 {
     bit_iterator_t it;
@@ -414,6 +522,24 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         }
     }
 
+    /*If the file is mapped and the bitmaps are byte aligned use them directly from the file*/
+    uint32_t file_size;
+    const uint8_t * mapped = lv_fs_map(fp, &file_size);
+    int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+#if LV_FONT_FMT_TXT_LARGE == 0
+    bool index_fits = glyph_length < (1 << 20);
+#else
+    bool index_fits = true;
+#endif
+    if(mapped && nbits % 8 == 0 && index_fits && start + (uint32_t)glyph_length <= file_size) {
+        for(unsigned int i = 1; i < loca_count; ++i) {
+            glyph_dsc[i].bitmap_index = glyph_offset[i] + nbits / 8;
+        }
+        font_dsc->glyph_bitmap = &mapped[start];
+        lv_memcpy_small(&((font_loader_dsc_t *)font_dsc)->file, fp, sizeof(lv_fs_file_t));
+        return glyph_length;
+    }
+
     uint8_t * glyph_bmp = (uint8_t *)lv_mem_alloc(sizeof(uint8_t) * cur_bmp_size);
 
     font_dsc->glyph_bitmap = glyph_bmp;
@@ -427,8 +553,6 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         }
         bit_iterator_t bit_it = init_bit_iterator(fp);
 
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
-
         read_bits(&bit_it, nbits, &res);
         if(res != LV_FS_RES_OK) {
             return -1;
@@ -480,12 +604,12 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
  * `lv_font_free` will assume that all non-null pointers are allocated and
  * should be freed.
  */
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool lazy)
 {
     lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
-                                       lv_mem_alloc(sizeof(lv_font_fmt_txt_dsc_t));
+                                       lv_mem_alloc(sizeof(font_loader_dsc_t));
 
-    memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
+    memset(font_dsc, 0, sizeof(font_loader_dsc_t));
 
     font->dsc = font_dsc;
 
@@ -561,13 +685,37 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 
     /*glyph*/
     uint32_t glyph_start = loca_start + loca_length;
-    int32_t glyph_length = load_glyph(
-                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
+    int32_t glyph_length;
+    if(lazy) {
+        /*Keep only the offsets and load the glyphs when they are used*/
+        font_loader_dsc_t * ldsc = (font_loader_dsc_t *)font_dsc;
+        ldsc->lazy = lv_mem_alloc(sizeof(lazy_font_t));
+        LV_ASSERT_MALLOC(ldsc->lazy);
+        if(ldsc->lazy == NULL) {
+            lv_mem_free(glyph_offset);
+            return false;
+        }
+        lv_memset_00(ldsc->lazy, sizeof(lazy_font_t));
 
-    lv_mem_free(glyph_offset);
+        glyph_length = read_label(fp, glyph_start, "glyf");
+        ldsc->lazy->glyph_offset = glyph_offset;
+        if(glyph_length < 0) return false;
 
-    if(glyph_length < 0) {
-        return false;
+        glyph_offset[loca_count] = glyph_length;
+        ldsc->lazy->header = font_header;
+        ldsc->lazy->glyph_start = glyph_start;
+        ldsc->lazy->glyph_cnt = loca_count;
+        lv_memcpy_small(&ldsc->file, fp, sizeof(lv_fs_file_t));
+
+        font->get_glyph_dsc = lazy_get_glyph_dsc;
+        font->get_glyph_bitmap = lazy_get_glyph_bitmap;
+    }
+    else {
+        glyph_length = load_glyph(fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
+        lv_mem_free(glyph_offset);
+        if(glyph_length < 0) {
+            return false;
+        }
     }
 
     if(font_header.tables_count < 4) {
@@ -679,3 +827,213 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
 
     return kern_length;
 }
+
+/**
+ * Used as `get_glyph_dsc` callback of the lazy loaded fonts. See `lv_font_get_glyph_dsc_fmt_txt()`.
+ */
+static bool lazy_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
+                               uint32_t unicode_letter_next)
+{
+    bool is_tab = false;
+    if(unicode_letter == '\t') {
+        unicode_letter = ' ';
+        is_tab = true;
+    }
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    uint32_t gid = _lv_font_fmt_txt_get_glyph_id(font, unicode_letter);
+    if(!gid) return false;
+
+    int8_t kvalue = 0;
+    if(fdsc->kern_dsc) {
+        uint32_t gid_next = _lv_font_fmt_txt_get_glyph_id(font, unicode_letter_next);
+        if(gid_next) {
+            kvalue = _lv_font_fmt_txt_get_kern_value(font, gid, gid_next);
+        }
+    }
+
+    lazy_glyph_t * glyph = lazy_glyph_get(font, gid);
+    if(glyph == NULL) return false;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &glyph->dsc;
+    int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
+
+    uint32_t adv_w = gdsc->adv_w;
+    if(is_tab) adv_w *= 2;
+
+    adv_w += kv;
+    adv_w  = (adv_w + (1 << 3)) >> 4;
+
+    dsc_out->adv_w = adv_w;
+    dsc_out->box_h = gdsc->box_h;
+    dsc_out->box_w = gdsc->box_w;
+    dsc_out->ofs_x = gdsc->ofs_x;
+    dsc_out->ofs_y = gdsc->ofs_y;
+    dsc_out->bpp   = (uint8_t)fdsc->bpp;
+
+    if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
+
+    return true;
+}
+
+/**
+ * Used as `get_glyph_bitmap` callback of the lazy loaded fonts.
+ * The bitmaps are stored decompressed in the cache.
+ */
+static const uint8_t * lazy_get_glyph_bitmap(const lv_font_t * font, uint32_t unicode_letter)
+{
+    if(unicode_letter == '\t') unicode_letter = ' ';
+
+    uint32_t gid = _lv_font_fmt_txt_get_glyph_id(font, unicode_letter);
+    if(!gid) return NULL;
+
+    lazy_glyph_t * glyph = lazy_glyph_get(font, gid);
+    if(glyph == NULL || glyph->entry.size == sizeof(lazy_glyph_t)) return NULL;
+
+    return (const uint8_t *)(glyph + 1);
+}
+
+/**
+ * Get a glyph from the cache or load it from the file
+ * @param font pointer to a lazy loaded font
+ * @param gid id of the glyph
+ * @return the glyph or NULL on error
+ */
+static lazy_glyph_t * lazy_glyph_get(const lv_font_t * font, uint32_t gid)
+{
+    font_loader_dsc_t * ldsc = (font_loader_dsc_t *)font->dsc;
+    lazy_font_t * lazy = ldsc->lazy;
+    if(gid == 0 || gid >= lazy->glyph_cnt) return NULL;
+
+    lazy_glyph_t * glyph = (lazy_glyph_t *)_lv_font_glyph_cache_get(&lazy->cache, gid);
+    if(glyph) return glyph;
+
+    glyph = lazy_glyph_load(ldsc, gid);
+    if(glyph == NULL) return NULL;
+
+    _lv_font_glyph_cache_add(&lazy->cache, &glyph->entry);
+    return glyph;
+}
+
+/**
+ * Read a glyph's descriptor and bitmap from the file
+ * @param ldsc pointer to the descriptor of a lazy loaded font
+ * @param gid id of the glyph (> 0)
+ * @return the new glyph, not added to the cache yet, or NULL on error
+ */
+static lazy_glyph_t * lazy_glyph_load(font_loader_dsc_t * ldsc, uint32_t gid)
+{
+    lazy_font_t * lazy = ldsc->lazy;
+    const font_header_bin_t * header = &lazy->header;
+    uint32_t data_size = lazy->glyph_offset[gid + 1] - lazy->glyph_offset[gid];
+
+    /*Read the whole glyph at once. +1 byte to read the bits of the last byte with the next one*/
+    uint8_t * data = lv_mem_buf_get(data_size + 1);
+    if(data == NULL) return NULL;
+    data[data_size] = 0;
+
+    if(lv_fs_seek(&ldsc->file, lazy->glyph_start + lazy->glyph_offset[gid], LV_FS_SEEK_SET) != LV_FS_RES_OK ||
+       lv_fs_read(&ldsc->file, data, data_size, NULL) != LV_FS_RES_OK) {
+        LV_LOG_WARN("Error reading glyph %d", gid);
+        lv_mem_buf_release(data);
+        return NULL;
+    }
+
+    lv_font_fmt_txt_glyph_dsc_t gdsc;
+    lv_memset_00(&gdsc, sizeof(gdsc));
+    uint32_t bit_pos = 0;
+    if(header->advance_width_bits == 0) gdsc.adv_w = header->default_advance_width;
+    else gdsc.adv_w = get_bits_mem(data, &bit_pos, header->advance_width_bits);
+    if(header->advance_width_format == 0) gdsc.adv_w *= 16;
+
+    /*Sign extend the offsets*/
+    int32_t ofs_x = get_bits_mem(data, &bit_pos, header->xy_bits);
+    int32_t ofs_y = get_bits_mem(data, &bit_pos, header->xy_bits);
+    if(header->xy_bits && (ofs_x & (1 << (header->xy_bits - 1)))) ofs_x |= ~0u << header->xy_bits;
+    if(header->xy_bits && (ofs_y & (1 << (header->xy_bits - 1)))) ofs_y |= ~0u << header->xy_bits;
+    gdsc.ofs_x = ofs_x;
+    gdsc.ofs_y = ofs_y;
+    gdsc.box_w = get_bits_mem(data, &bit_pos, header->wh_bits);
+    gdsc.box_h = get_bits_mem(data, &bit_pos, header->wh_bits);
+
+    /*The size of the bitmap in the file and in the cache*/
+    uint32_t px_cnt = gdsc.box_w * gdsc.box_h;
+    uint32_t in_size = px_cnt ? data_size - bit_pos / 8 : 0;
+    uint32_t out_size = in_size;
+    if(px_cnt && header->compression_id != LV_FONT_FMT_TXT_PLAIN) {
+#if LV_USE_FONT_COMPRESSED
+        switch(header->bits_per_pixel) {
+            case 1:
+                out_size = (px_cnt + 7) >> 3;
+                break;
+            case 2:
+                out_size = (px_cnt + 3) >> 2;
+                break;
+            case 3:
+            case 4:
+                out_size = (px_cnt + 1) >> 1;
+                break;
+            default:
+                out_size = px_cnt;
+                break;
+        }
+#else
+        LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
+        out_size = 0;
+#endif
+    }
+
+    lazy_glyph_t * glyph = lv_mem_alloc(sizeof(lazy_glyph_t) + out_size);
+    LV_ASSERT_MALLOC(glyph);
+    if(glyph == NULL) {
+        lv_mem_buf_release(data);
+        return NULL;
+    }
+
+    glyph->entry.gid = gid;
+    glyph->entry.size = sizeof(lazy_glyph_t) + out_size;
+    glyph->dsc = gdsc;
+
+    /*The bitmap starts right after the descriptor bits so it might need to be shifted to be byte aligned*/
+    uint8_t * bitmap = (uint8_t *)(glyph + 1);
+    bool compressed = header->compression_id != LV_FONT_FMT_TXT_PLAIN;
+    uint8_t * in = compressed ? data : bitmap;
+    uint32_t shift = bit_pos % 8;
+    uint32_t i;
+    const uint8_t * src = &data[bit_pos / 8];
+    if(out_size) {
+        for(i = 0; i < in_size; i++) {
+            in[i] = shift ? (uint8_t)((src[i] << shift) | (src[i + 1] >> (8 - shift))) : src[i];
+        }
+    }
+
+#if LV_USE_FONT_COMPRESSED
+    if(out_size && compressed) {
+        _lv_font_fmt_txt_decompress(in, bitmap, gdsc.box_w, gdsc.box_h, header->bits_per_pixel,
+                                    header->compression_id == LV_FONT_FMT_TXT_COMPRESSED);
+    }
+#endif
+
+    lv_mem_buf_release(data);
+    lazy->load_cnt++;
+
+    return glyph;
+}
+
+/**
+ * Read bits from a buffer. See `read_bits()`.
+ * @param buf the buffer to read
+ * @param bit_pos index of the first bit to read. Incremented by `n_bits`.
+ * @param n_bits number of bits to read
+ * @return the read value
+ */
+static uint32_t get_bits_mem(const uint8_t * buf, uint32_t * bit_pos, uint32_t n_bits)
+{
+    uint32_t value = 0;
+    while(n_bits--) {
+        uint32_t bit = (buf[*bit_pos >> 3] >> (7 - (*bit_pos & 0x7))) & 0x1;
+        value = (value << 1) | bit;
+        (*bit_pos)++;
+    }
+    return value;
+}
+
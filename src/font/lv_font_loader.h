@@ -22,11 +22,21 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/*Statistics of a lazy loaded font*/
+typedef struct {
+    uint32_t glyph_cnt;     /*Number of glyphs in the cache*/
+    uint32_t cache_used;    /*Size of the cached glyphs in bytes*/
+    uint32_t load_cnt;      /*Number of glyphs read from the file so far*/
+} lv_font_lazy_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 lv_font_t * lv_font_load(const char * fontName);
+lv_font_t * lv_font_load_lazy(const char * font_name, uint32_t cache_size);
+void lv_font_lazy_prewarm(lv_font_t * font, const char * letters);
+void lv_font_lazy_get_stat(const lv_font_t * font, lv_font_lazy_stat_t * stat);
 void lv_font_free(lv_font_t * font);
 
 /**********************
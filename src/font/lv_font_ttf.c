@@ -0,0 +1,997 @@
+/**
+ * @file lv_font_ttf.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_font_ttf.h"
+#if LV_USE_FONT_TTF
+
+#include "lv_font_glyph_cache.h"
+#include "../draw/lv_draw_raster.h"
+#include "../misc/lv_fs.h"
+#include "../misc/lv_mem.h"
+#include "../misc/lv_log.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_math.h"
+
+#if LV_DRAW_COMPLEX == 0
+    #error "LV_USE_FONT_TTF requires LV_DRAW_COMPLEX"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define GLYPH_BPP           4
+#define COMPOSITE_DEPTH_MAX 4   /*Composite glyphs can refer to other composite glyphs*/
+#define CURVE_SEG_MAX       16  /*Max. number of lines to approximate a curve*/
+
+/*Flags of the points of simple glyphs*/
+#define PT_ON_CURVE         0x01
+#define PT_X_SHORT          0x02
+#define PT_Y_SHORT          0x04
+#define PT_REPEAT           0x08
+#define PT_X_SAME_OR_POS    0x10
+#define PT_Y_SAME_OR_POS    0x20
+
+/*Flags of the components of composite glyphs*/
+#define COMP_ARGS_WORDS     0x0001
+#define COMP_ARGS_XY        0x0002
+#define COMP_SCALE          0x0008
+#define COMP_MORE           0x0020
+#define COMP_XY_SCALE       0x0040
+#define COMP_2X2            0x0080
+
+/*1.0 in the transformation matrices (2.14 fixed point as in the composite glyphs)*/
+#define XFORM_ONE           16384
+
+#define TAG(a, b, c, d)     (((uint32_t)(a) << 24) | ((uint32_t)(b) << 16) | ((uint32_t)(c) << 8) | (uint32_t)(d))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*A rasterized glyph. Its 4 bpp bitmap follows the structure.*/
+typedef struct {
+    _lv_font_glyph_cache_entry_t entry; /*The size of the entry includes the bitmap*/
+    uint16_t adv;                       /*Advance width in font units*/
+    uint16_t box_w;
+    uint16_t box_h;
+    int16_t ofs_x;
+    int16_t ofs_y;
+} ttf_glyph_t;
+
+/*Position and transformation of a glyph in a composite glyph. `x' = (xx * x + yx * y) / XFORM_ONE + dx`*/
+typedef struct {
+    int32_t xx;
+    int32_t xy;
+    int32_t yx;
+    int32_t yy;
+    int32_t dx;     /*In font units*/
+    int32_t dy;
+} ttf_xform_t;
+
+/*Vertices of a flattened contour*/
+typedef struct {
+    lv_draw_raster_point_t * buf;
+    uint32_t cnt;
+    uint32_t max;
+} ttf_contour_t;
+
+typedef struct {
+    /*The data of the font is either in the memory or in a file*/
+    const uint8_t * data;
+    uint32_t data_size;
+    lv_fs_file_t file;
+
+    /*Position of the used tables*/
+    uint32_t cmap;              /*The used Unicode subtable*/
+    uint16_t cmap_format;       /*4 or 12*/
+    uint32_t loca;
+    uint32_t glyf;
+    uint32_t hmtx;
+    uint32_t kern_pairs;        /*The pairs of the horizontal format 0 subtable*/
+    uint16_t kern_pair_cnt;
+
+    uint16_t units_per_em;
+    uint16_t glyph_cnt;
+    uint16_t hmetric_cnt;
+    bool loca_long;
+    int16_t ascent;
+    int16_t descent;
+    int16_t underline_position;
+    int16_t underline_thickness;
+
+    lv_coord_t size;
+    uint32_t last_letter;       /*Cache the last glyph id lookup*/
+    uint32_t last_gid;
+
+    _lv_font_glyph_cache_t cache;
+    uint32_t render_cnt;
+} ttf_font_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_font_t * font_create(ttf_font_t * ttf, lv_coord_t size, uint32_t cache_size);
+static void ttf_free(ttf_font_t * ttf);
+static bool parse_tables(ttf_font_t * ttf);
+static bool select_cmap(ttf_font_t * ttf, uint32_t cmap);
+static void select_kern(ttf_font_t * ttf, uint32_t kern);
+static bool get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                          uint32_t letter_next);
+static const uint8_t * get_glyph_bitmap(const lv_font_t * font, uint32_t letter);
+static uint32_t get_glyph_id(ttf_font_t * ttf, uint32_t letter);
+static int16_t get_kern_value(ttf_font_t * ttf, uint32_t gid_left, uint32_t gid_right);
+static ttf_glyph_t * glyph_get(ttf_font_t * ttf, uint32_t gid);
+static ttf_glyph_t * glyph_render(ttf_font_t * ttf, uint32_t gid);
+static bool outline_add(ttf_font_t * ttf, lv_draw_raster_t * raster, uint32_t gid, const ttf_xform_t * xform,
+                        uint32_t depth);
+static bool simple_glyph_add(ttf_font_t * ttf, lv_draw_raster_t * raster, const uint8_t * data, uint32_t len,
+                             const ttf_xform_t * xform);
+static bool composite_glyph_add(ttf_font_t * ttf, lv_draw_raster_t * raster, const uint8_t * data, uint32_t len,
+                                const ttf_xform_t * xform, uint32_t depth);
+static void contour_add(lv_draw_raster_t * raster, const lv_draw_raster_point_t * pts, const uint8_t * flags,
+                        uint32_t pt_cnt, ttf_contour_t * contour);
+static void contour_line(ttf_contour_t * contour, const lv_draw_raster_point_t * p);
+static void contour_curve(ttf_contour_t * contour, const lv_draw_raster_point_t * p0,
+                          const lv_draw_raster_point_t * p1, const lv_draw_raster_point_t * p2);
+static bool ttf_read(ttf_font_t * ttf, uint32_t ofs, void * buf, uint32_t len);
+static uint16_t ttf_u16(ttf_font_t * ttf, uint32_t ofs);
+static uint32_t ttf_u32(ttf_font_t * ttf, uint32_t ofs);
+static int32_t scale_units(const ttf_font_t * ttf, int32_t v, int32_t unit);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+#define BE16(p) ((uint16_t)(((uint16_t)(p)[0] << 8) | (p)[1]))
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_font_t * lv_font_ttf_create_file(const char * path, lv_coord_t size, uint32_t cache_size)
+{
+    ttf_font_t * ttf = lv_mem_alloc(sizeof(ttf_font_t));
+    LV_ASSERT_MALLOC(ttf);
+    if(ttf == NULL) return NULL;
+    lv_memset_00(ttf, sizeof(ttf_font_t));
+
+    if(lv_fs_open(&ttf->file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        LV_LOG_WARN("Can't open %s", path);
+        lv_mem_free(ttf);
+        return NULL;
+    }
+
+    return font_create(ttf, size, cache_size);
+}
+
+lv_font_t * lv_font_ttf_create_data(const void * data, uint32_t data_size, lv_coord_t size, uint32_t cache_size)
+{
+    ttf_font_t * ttf = lv_mem_alloc(sizeof(ttf_font_t));
+    LV_ASSERT_MALLOC(ttf);
+    if(ttf == NULL) return NULL;
+    lv_memset_00(ttf, sizeof(ttf_font_t));
+
+    ttf->data = data;
+    ttf->data_size = data_size;
+
+    return font_create(ttf, size, cache_size);
+}
+
+void lv_font_ttf_set_size(lv_font_t * font, lv_coord_t size)
+{
+    LV_ASSERT_NULL(font);
+    ttf_font_t * ttf = (ttf_font_t *)font->dsc;
+
+    _lv_font_glyph_cache_clear(&ttf->cache);
+    ttf->size = size;
+
+    /*Round the ascent and descent up to fit all the glyphs*/
+    lv_coord_t ascent = (lv_coord_t)(-scale_units(ttf, -ttf->ascent, 1));
+    lv_coord_t descent = (lv_coord_t)(-scale_units(ttf, ttf->descent, 1));
+    font->line_height = ascent + descent;
+    font->base_line = descent;
+    font->underline_position = (int8_t)LV_CLAMP(INT8_MIN, scale_units(ttf, ttf->underline_position, 1), INT8_MAX);
+    font->underline_thickness = (int8_t)LV_CLAMP(1, scale_units(ttf, ttf->underline_thickness, 1), INT8_MAX);
+}
+
+void lv_font_ttf_get_stat(const lv_font_t * font, lv_font_ttf_stat_t * stat)
+{
+    LV_ASSERT_NULL(font);
+    const ttf_font_t * ttf = (const ttf_font_t *)font->dsc;
+    stat->glyph_cnt = ttf->cache.glyph_cnt;
+    stat->cache_used = ttf->cache.size;
+    stat->render_cnt = ttf->render_cnt;
+}
+
+void lv_font_ttf_destroy(lv_font_t * font)
+{
+    if(font == NULL) return;
+
+    ttf_free((ttf_font_t *)font->dsc);
+    lv_mem_free(font);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_font_t * font_create(ttf_font_t * ttf, lv_coord_t size, uint32_t cache_size)
+{
+    if(!parse_tables(ttf)) {
+        LV_LOG_WARN("Not a supported TrueType font");
+        ttf_free(ttf);
+        return NULL;
+    }
+
+    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
+    LV_ASSERT_MALLOC(font);
+    if(font == NULL) {
+        ttf_free(ttf);
+        return NULL;
+    }
+    lv_memset_00(font, sizeof(lv_font_t));
+
+    _lv_font_glyph_cache_init(&ttf->cache, cache_size);
+    font->dsc = ttf;
+    font->get_glyph_dsc = get_glyph_dsc;
+    font->get_glyph_bitmap = get_glyph_bitmap;
+    font->subpx = LV_FONT_SUBPX_NONE;
+    lv_font_ttf_set_size(font, size);
+
+    return font;
+}
+
+static void ttf_free(ttf_font_t * ttf)
+{
+    _lv_font_glyph_cache_clear(&ttf->cache);
+    if(ttf->file.drv) lv_fs_close(&ttf->file);
+    lv_mem_free(ttf);
+}
+
+/**
+ * Find the tables and read the global metrics
+ * @return true: the font can be used; false: a required table is missing or the outlines are not TrueType
+ */
+static bool parse_tables(ttf_font_t * ttf)
+{
+    uint32_t version = ttf_u32(ttf, 0);
+    if(version != 0x00010000 && version != TAG('t', 'r', 'u', 'e')) return false;
+
+    uint32_t head = 0;
+    uint32_t hhea = 0;
+    uint32_t maxp = 0;
+    uint32_t cmap = 0;
+    uint32_t kern = 0;
+    uint32_t post = 0;
+    uint16_t table_cnt = ttf_u16(ttf, 4);
+    uint32_t i;
+    for(i = 0; i < table_cnt; i++) {
+        uint32_t rec = 12 + i * 16;
+        uint32_t tag = ttf_u32(ttf, rec);
+        uint32_t ofs = ttf_u32(ttf, rec + 8);
+        switch(tag) {
+            case TAG('h', 'e', 'a', 'd'):
+                head = ofs;
+                break;
+            case TAG('h', 'h', 'e', 'a'):
+                hhea = ofs;
+                break;
+            case TAG('m', 'a', 'x', 'p'):
+                maxp = ofs;
+                break;
+            case TAG('c', 'm', 'a', 'p'):
+                cmap = ofs;
+                break;
+            case TAG('h', 'm', 't', 'x'):
+                ttf->hmtx = ofs;
+                break;
+            case TAG('l', 'o', 'c', 'a'):
+                ttf->loca = ofs;
+                break;
+            case TAG('g', 'l', 'y', 'f'):
+                ttf->glyf = ofs;
+                break;
+            case TAG('k', 'e', 'r', 'n'):
+                kern = ofs;
+                break;
+            case TAG('p', 'o', 's', 't'):
+                post = ofs;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if(!head || !hhea || !maxp || !cmap || !ttf->hmtx || !ttf->loca || !ttf->glyf) return false;
+
+    ttf->units_per_em = ttf_u16(ttf, head + 18);
+    ttf->loca_long = ttf_u16(ttf, head + 50) != 0;
+    ttf->glyph_cnt = ttf_u16(ttf, maxp + 4);
+    ttf->ascent = (int16_t)ttf_u16(ttf, hhea + 4);
+    ttf->descent = (int16_t)ttf_u16(ttf, hhea + 6);
+    ttf->hmetric_cnt = ttf_u16(ttf, hhea + 34);
+    if(ttf->units_per_em == 0 || ttf->hmetric_cnt == 0) return false;
+
+    if(post) {
+        ttf->underline_position = (int16_t)ttf_u16(ttf, post + 8);
+        ttf->underline_thickness = (int16_t)ttf_u16(ttf, post + 10);
+    }
+
+    if(!select_cmap(ttf, cmap)) return false;
+    if(kern) select_kern(ttf, kern);
+
+    return true;
+}
+
+/**
+ * Find a Unicode subtable of the character map. The full Unicode (format 12) subtables are preferred.
+ * @return true: found; false: there is no supported subtable
+ */
+static bool select_cmap(ttf_font_t * ttf, uint32_t cmap)
+{
+    uint32_t fmt4 = 0;
+    uint32_t fmt12 = 0;
+    uint16_t cnt = ttf_u16(ttf, cmap + 2);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        uint32_t rec = cmap + 4 + i * 8;
+        uint16_t platform = ttf_u16(ttf, rec);
+        uint16_t encoding = ttf_u16(ttf, rec + 2);
+        uint32_t sub = cmap + ttf_u32(ttf, rec + 4);
+        bool unicode = platform == 0 || (platform == 3 && (encoding == 1 || encoding == 10));
+        if(!unicode) continue;
+
+        uint16_t format = ttf_u16(ttf, sub);
+        if(format == 12) fmt12 = sub;
+        else if(format == 4) fmt4 = sub;
+    }
+
+    if(fmt12) {
+        ttf->cmap = fmt12;
+        ttf->cmap_format = 12;
+    }
+    else if(fmt4) {
+        ttf->cmap = fmt4;
+        ttf->cmap_format = 4;
+    }
+    else {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Find the horizontal kerning pairs in the `kern` table
+ */
+static void select_kern(ttf_font_t * ttf, uint32_t kern)
+{
+    /*Only the version 0 (Windows) tables*/
+    if(ttf_u16(ttf, kern) != 0) return;
+
+    uint16_t cnt = ttf_u16(ttf, kern + 2);
+    uint32_t sub = kern + 4;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        uint16_t length = ttf_u16(ttf, sub + 2);
+        uint16_t coverage = ttf_u16(ttf, sub + 4);
+        /*Format 0 with horizontal, not minimum and not cross-stream values*/
+        if((coverage >> 8) == 0 && (coverage & 0x07) == 0x01) {
+            ttf->kern_pair_cnt = ttf_u16(ttf, sub + 6);
+            ttf->kern_pairs = sub + 14;
+            return;
+        }
+        if(length == 0) return;
+        sub += length;
+    }
+}
+
+static bool get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                          uint32_t letter_next)
+{
+    ttf_font_t * ttf = (ttf_font_t *)font->dsc;
+
+    bool is_tab = false;
+    if(letter == '\t') {
+        letter = ' ';
+        is_tab = true;
+    }
+
+    uint32_t gid = get_glyph_id(ttf, letter);
+    if(gid == 0) return false;
+
+    ttf_glyph_t * glyph = glyph_get(ttf, gid);
+    if(glyph == NULL) return false;
+
+    int32_t adv = glyph->adv;
+    if(is_tab) adv *= 2;
+
+    if(ttf->kern_pair_cnt && letter_next) {
+        uint32_t gid_next = get_glyph_id(ttf, letter_next);
+        if(gid_next) adv += get_kern_value(ttf, gid, gid_next);
+    }
+
+    adv = (adv * ttf->size + ttf->units_per_em / 2) / ttf->units_per_em;
+    dsc_out->adv_w = LV_MAX(adv, 0);
+    dsc_out->box_w = glyph->box_w;
+    dsc_out->box_h = glyph->box_h;
+    dsc_out->ofs_x = glyph->ofs_x;
+    dsc_out->ofs_y = glyph->ofs_y;
+    dsc_out->bpp = GLYPH_BPP;
+
+    if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
+
+    return true;
+}
+
+static const uint8_t * get_glyph_bitmap(const lv_font_t * font, uint32_t letter)
+{
+    ttf_font_t * ttf = (ttf_font_t *)font->dsc;
+
+    if(letter == '\t') letter = ' ';
+
+    uint32_t gid = get_glyph_id(ttf, letter);
+    if(gid == 0) return NULL;
+
+    ttf_glyph_t * glyph = glyph_get(ttf, gid);
+    if(glyph == NULL) return NULL;
+
+    return (const uint8_t *)(glyph + 1);
+}
+
+/**
+ * Look up a letter in the character map
+ * @return the glyph id or 0 if the letter is not in the font
+ */
+static uint32_t get_glyph_id(ttf_font_t * ttf, uint32_t letter)
+{
+    if(letter == '\0') return 0;
+    if(letter == ttf->last_letter) return ttf->last_gid;
+
+    uint32_t gid = 0;
+    if(ttf->cmap_format == 4) {
+        if(letter <= 0xFFFF) {
+            /*Binary search for the first segment which ends at or after the letter*/
+            uint32_t seg_cnt = ttf_u16(ttf, ttf->cmap + 6) / 2;
+            uint32_t end_codes = ttf->cmap + 14;
+            uint32_t lo = 0;
+            uint32_t hi = seg_cnt;
+            while(lo < hi) {
+                uint32_t mid = (lo + hi) / 2;
+                if(ttf_u16(ttf, end_codes + mid * 2) < letter) lo = mid + 1;
+                else hi = mid;
+            }
+
+            /*The start codes, deltas and range offsets follow the end codes*/
+            uint32_t start_pos = end_codes + seg_cnt * 2 + 2 + lo * 2;
+            if(lo < seg_cnt && ttf_u16(ttf, start_pos) <= letter) {
+                uint16_t start = ttf_u16(ttf, start_pos);
+                uint16_t delta = ttf_u16(ttf, start_pos + seg_cnt * 2);
+                uint32_t range_pos = start_pos + seg_cnt * 4;
+                uint16_t range_ofs = ttf_u16(ttf, range_pos);
+                if(range_ofs == 0) {
+                    gid = (letter + delta) & 0xFFFF;
+                }
+                else {
+                    gid = ttf_u16(ttf, range_pos + range_ofs + (letter - start) * 2);
+                    if(gid) gid = (gid + delta) & 0xFFFF;
+                }
+            }
+        }
+    }
+    else {
+        /*Binary search for the first group which ends at or after the letter*/
+        uint32_t group_cnt = ttf_u32(ttf, ttf->cmap + 12);
+        uint32_t groups = ttf->cmap + 16;
+        uint32_t lo = 0;
+        uint32_t hi = group_cnt;
+        while(lo < hi) {
+            uint32_t mid = (lo + hi) / 2;
+            if(ttf_u32(ttf, groups + mid * 12 + 4) < letter) lo = mid + 1;
+            else hi = mid;
+        }
+
+        if(lo < group_cnt) {
+            uint32_t start = ttf_u32(ttf, groups + lo * 12);
+            if(start <= letter) gid = ttf_u32(ttf, groups + lo * 12 + 8) + letter - start;
+        }
+    }
+
+    if(gid >= ttf->glyph_cnt) gid = 0;
+
+    ttf->last_letter = letter;
+    ttf->last_gid = gid;
+    return gid;
+}
+
+/**
+ * Get the kerning of a glyph pair from the sorted pairs of the `kern` table
+ * @return the kerning value in font units
+ */
+static int16_t get_kern_value(ttf_font_t * ttf, uint32_t gid_left, uint32_t gid_right)
+{
+    uint32_t key = (gid_left << 16) | gid_right;
+    uint32_t lo = 0;
+    uint32_t hi = ttf->kern_pair_cnt;
+    while(lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        uint32_t pair = ttf->kern_pairs + mid * 6;
+        uint32_t k = ttf_u32(ttf, pair);
+        if(k == key) return (int16_t)ttf_u16(ttf, pair + 4);
+        if(k < key) lo = mid + 1;
+        else hi = mid;
+    }
+
+    return 0;
+}
+
+/**
+ * Get a glyph from the cache or rasterize it and make it the most recently used
+ * @return the glyph or NULL if it couldn't be rasterized
+ */
+static ttf_glyph_t * glyph_get(ttf_font_t * ttf, uint32_t gid)
+{
+    ttf_glyph_t * glyph = (ttf_glyph_t *)_lv_font_glyph_cache_get(&ttf->cache, gid);
+    if(glyph) return glyph;
+
+    glyph = glyph_render(ttf, gid);
+    if(glyph == NULL) return NULL;
+
+    _lv_font_glyph_cache_add(&ttf->cache, &glyph->entry);
+    return glyph;
+}
+
+/**
+ * Rasterize a glyph with the current size
+ * @return the new glyph (not added to the cache yet) or NULL on error
+ */
+static ttf_glyph_t * glyph_render(ttf_font_t * ttf, uint32_t gid)
+{
+    lv_draw_raster_t raster;
+    lv_draw_raster_init(&raster);
+
+    ttf_xform_t xform;
+    lv_memset_00(&xform, sizeof(xform));
+    xform.xx = XFORM_ONE;
+    xform.yy = XFORM_ONE;
+    if(!outline_add(ttf, &raster, gid, &xform, 0)) {
+        LV_LOG_WARN("Invalid outline of glyph %d", gid);
+        lv_draw_raster_free(&raster);
+        return NULL;
+    }
+
+    /*The rasterizer's y coordinates grow downward from the base line*/
+    lv_area_t area;
+    lv_area_set(&area, 0, 0, -1, -1);
+    if(raster.edge_cnt) {
+        area.x1 = raster.x_min >> LV_DRAW_RASTER_SHIFT;
+        area.y1 = raster.y_min >> LV_DRAW_RASTER_SHIFT;
+        area.x2 = (raster.x_max - 1) >> LV_DRAW_RASTER_SHIFT;
+        area.y2 = (raster.y_max - 1) >> LV_DRAW_RASTER_SHIFT;
+    }
+    uint32_t px_cnt = lv_area_get_size(&area);
+    uint32_t bitmap_size = (px_cnt * GLYPH_BPP + 7) / 8;
+
+    ttf_glyph_t * glyph = lv_mem_alloc(sizeof(ttf_glyph_t) + bitmap_size);
+    LV_ASSERT_MALLOC(glyph);
+    if(glyph == NULL) {
+        lv_draw_raster_free(&raster);
+        return NULL;
+    }
+
+    lv_memset_00(glyph, sizeof(ttf_glyph_t));
+    glyph->entry.gid = gid;
+    glyph->entry.size = sizeof(ttf_glyph_t) + bitmap_size;
+    glyph->adv = ttf_u16(ttf, ttf->hmtx + LV_MIN(gid, ttf->hmetric_cnt - 1U) * 4);
+    glyph->box_w = lv_area_get_width(&area);
+    glyph->box_h = lv_area_get_height(&area);
+    glyph->ofs_x = area.x1;
+    glyph->ofs_y = -(area.y2 + 1);
+
+    if(px_cnt) {
+        lv_opa_t * cov = lv_mem_buf_get(px_cnt);
+        if(cov == NULL) {
+            LV_LOG_WARN("Not enough memory to rasterize glyph %d", gid);
+            lv_mem_free(glyph);
+            lv_draw_raster_free(&raster);
+            return NULL;
+        }
+        lv_draw_raster_render(&raster, &area, cov);
+
+        /*Pack to 4 bpp with the first pixel in the upper bits*/
+        uint8_t * bitmap = (uint8_t *)(glyph + 1);
+        lv_memset_00(bitmap, bitmap_size);
+        uint32_t i;
+        for(i = 0; i < px_cnt; i++) {
+            uint8_t v = (cov[i] * 15 + 127) / 255;
+            bitmap[i >> 1] |= (i & 1) ? v : v << 4;
+        }
+        lv_mem_buf_release(cov);
+    }
+
+    lv_draw_raster_free(&raster);
+    ttf->render_cnt++;
+
+    return glyph;
+}
+
+/**
+ * Add the contours of a glyph to the rasterizer
+ * @param ttf pointer to a font
+ * @param raster pointer to a rasterizer
+ * @param gid the glyph id
+ * @param xform the position and transformation of the glyph (the identity if it's not in a composite glyph)
+ * @param depth nesting level in composite glyphs
+ * @return true: the glyph was added (or it's empty); false: invalid glyph or out of memory
+ */
+static bool outline_add(ttf_font_t * ttf, lv_draw_raster_t * raster, uint32_t gid, const ttf_xform_t * xform,
+                        uint32_t depth)
+{
+    uint32_t start;
+    uint32_t end;
+    if(ttf->loca_long) {
+        start = ttf_u32(ttf, ttf->loca + gid * 4);
+        end = ttf_u32(ttf, ttf->loca + gid * 4 + 4);
+    }
+    else {
+        start = ttf_u16(ttf, ttf->loca + gid * 2) * 2;
+        end = ttf_u16(ttf, ttf->loca + gid * 2 + 2) * 2;
+    }
+
+    /*No outline, e.g. space*/
+    if(end <= start) return true;
+
+    uint32_t len = end - start;
+    if(len < 10) return false;
+
+    /*Read the glyph at once*/
+    uint8_t * data = lv_mem_buf_get(len);
+    if(data == NULL) return false;
+
+    bool res = false;
+    if(ttf_read(ttf, ttf->glyf + start, data, len)) {
+        int16_t contour_cnt = (int16_t)BE16(data);
+        if(contour_cnt >= 0) res = simple_glyph_add(ttf, raster, data, len, xform);
+        else if(depth < COMPOSITE_DEPTH_MAX) res = composite_glyph_add(ttf, raster, data, len, xform, depth);
+    }
+
+    lv_mem_buf_release(data);
+    return res;
+}
+
+static bool simple_glyph_add(ttf_font_t * ttf, lv_draw_raster_t * raster, const uint8_t * data, uint32_t len,
+                             const ttf_xform_t * xform)
+{
+    uint32_t contour_cnt = BE16(data);
+    if(contour_cnt == 0) return true;
+
+    /*The header, the end points of the contours and the length of the instructions*/
+    const uint8_t * end_pts = data + 10;
+    const uint8_t * data_end = data + len;
+    if(10 + contour_cnt * 2 + 2 > len) return false;
+    uint32_t pt_cnt = BE16(end_pts + (contour_cnt - 1) * 2) + 1;
+    const uint8_t * p = end_pts + contour_cnt * 2;
+    p += 2 + BE16(p);
+
+    lv_draw_raster_point_t * pts = lv_mem_buf_get(pt_cnt * sizeof(lv_draw_raster_point_t));
+    uint8_t * flags = lv_mem_buf_get(pt_cnt);
+    bool ok = pts && flags;
+
+    /*The flags with repeat counts*/
+    uint32_t i = 0;
+    while(ok && i < pt_cnt) {
+        if(p >= data_end) {
+            ok = false;
+            break;
+        }
+        uint8_t f = *p++;
+        flags[i++] = f;
+        if(f & PT_REPEAT) {
+            if(p >= data_end) {
+                ok = false;
+                break;
+            }
+            uint32_t r = *p++;
+            while(r-- && i < pt_cnt) flags[i++] = f;
+        }
+    }
+
+    /*The x and y coordinates relative to the previous point*/
+    uint32_t axis;
+    for(axis = 0; axis < 2 && ok; axis++) {
+        uint8_t short_flag = axis == 0 ? PT_X_SHORT : PT_Y_SHORT;
+        uint8_t same_flag = axis == 0 ? PT_X_SAME_OR_POS : PT_Y_SAME_OR_POS;
+        int32_t v = 0;
+        for(i = 0; i < pt_cnt; i++) {
+            if(flags[i] & short_flag) {
+                if(p + 1 > data_end) {
+                    ok = false;
+                    break;
+                }
+                v += (flags[i] & same_flag) ? *p : -*p;
+                p++;
+            }
+            else if(!(flags[i] & same_flag)) {
+                if(p + 2 > data_end) {
+                    ok = false;
+                    break;
+                }
+                v += (int16_t)BE16(p);
+                p += 2;
+            }
+            if(axis == 0) pts[i].x = v;
+            else pts[i].y = v;
+        }
+    }
+
+    if(ok) {
+        /*Transform to 1/256 pixels with y growing downward*/
+        for(i = 0; i < pt_cnt; i++) {
+            int32_t x = (xform->xx * pts[i].x + xform->yx * pts[i].y) / XFORM_ONE + xform->dx;
+            int32_t y = (xform->xy * pts[i].x + xform->yy * pts[i].y) / XFORM_ONE + xform->dy;
+            pts[i].x = scale_units(ttf, x, LV_DRAW_RASTER_ONE);
+            pts[i].y = -scale_units(ttf, y, LV_DRAW_RASTER_ONE);
+        }
+
+        ttf_contour_t contour;
+        lv_memset_00(&contour, sizeof(contour));
+        uint32_t first = 0;
+        uint32_t c;
+        for(c = 0; c < contour_cnt; c++) {
+            uint32_t last = BE16(end_pts + c * 2);
+            if(last < first || last >= pt_cnt) {
+                ok = false;
+                break;
+            }
+            contour_add(raster, &pts[first], &flags[first], last - first + 1, &contour);
+            first = last + 1;
+        }
+        if(contour.buf) lv_mem_free(contour.buf);
+    }
+
+    if(flags) lv_mem_buf_release(flags);
+    if(pts) lv_mem_buf_release(pts);
+
+    return ok;
+}
+
+static bool composite_glyph_add(ttf_font_t * ttf, lv_draw_raster_t * raster, const uint8_t * data, uint32_t len,
+                                const ttf_xform_t * xform, uint32_t depth)
+{
+    const uint8_t * p = data + 10;
+    const uint8_t * data_end = data + len;
+    uint16_t comp_flags;
+    do {
+        if(p + 4 > data_end) return false;
+        comp_flags = BE16(p);
+        uint16_t gid = BE16(p + 2);
+        p += 4;
+
+        int32_t arg1;
+        int32_t arg2;
+        if(comp_flags & COMP_ARGS_WORDS) {
+            if(p + 4 > data_end) return false;
+            arg1 = (int16_t)BE16(p);
+            arg2 = (int16_t)BE16(p + 2);
+            p += 4;
+        }
+        else {
+            if(p + 2 > data_end) return false;
+            arg1 = (int8_t)p[0];
+            arg2 = (int8_t)p[1];
+            p += 2;
+        }
+
+        ttf_xform_t local;
+        lv_memset_00(&local, sizeof(local));
+        local.xx = XFORM_ONE;
+        local.yy = XFORM_ONE;
+        /*Aligning matched points is not supported, just place the component to the origin*/
+        if(comp_flags & COMP_ARGS_XY) {
+            local.dx = arg1;
+            local.dy = arg2;
+        }
+
+        if(comp_flags & COMP_SCALE) {
+            if(p + 2 > data_end) return false;
+            local.xx = (int16_t)BE16(p);
+            local.yy = local.xx;
+            p += 2;
+        }
+        else if(comp_flags & COMP_XY_SCALE) {
+            if(p + 4 > data_end) return false;
+            local.xx = (int16_t)BE16(p);
+            local.yy = (int16_t)BE16(p + 2);
+            p += 4;
+        }
+        else if(comp_flags & COMP_2X2) {
+            if(p + 8 > data_end) return false;
+            local.xx = (int16_t)BE16(p);
+            local.xy = (int16_t)BE16(p + 2);
+            local.yx = (int16_t)BE16(p + 4);
+            local.yy = (int16_t)BE16(p + 6);
+            p += 8;
+        }
+
+        /*Apply the component's transformation first and the parent's after it*/
+        ttf_xform_t comb;
+        comb.xx = (xform->xx * local.xx + xform->yx * local.xy) / XFORM_ONE;
+        comb.xy = (xform->xy * local.xx + xform->yy * local.xy) / XFORM_ONE;
+        comb.yx = (xform->xx * local.yx + xform->yx * local.yy) / XFORM_ONE;
+        comb.yy = (xform->xy * local.yx + xform->yy * local.yy) / XFORM_ONE;
+        comb.dx = (xform->xx * local.dx + xform->yx * local.dy) / XFORM_ONE + xform->dx;
+        comb.dy = (xform->xy * local.dx + xform->yy * local.dy) / XFORM_ONE + xform->dy;
+
+        if(gid >= ttf->glyph_cnt) return false;
+        if(!outline_add(ttf, raster, gid, &comb, depth + 1)) return false;
+    } while(comp_flags & COMP_MORE);
+
+    return true;
+}
+
+/**
+ * Flatten a contour with quadratic curves and add it to the rasterizer
+ * @param raster pointer to a rasterizer
+ * @param pts the points of the contour
+ * @param flags the flags of the points. `PT_ON_CURVE` tells whether the point is on the contour or a control point.
+ * @param pt_cnt number of points
+ * @param contour buffer for the vertices. Reused for all the contours of a glyph.
+ */
+static void contour_add(lv_draw_raster_t * raster, const lv_draw_raster_point_t * pts, const uint8_t * flags,
+                        uint32_t pt_cnt, ttf_contour_t * contour)
+{
+    /*Start on a point on the contour. If there is no such point start between the first and last control point.*/
+    lv_draw_raster_point_t start;
+    uint32_t first;
+    uint32_t cnt;
+    if(flags[0] & PT_ON_CURVE) {
+        start = pts[0];
+        first = 1;
+        cnt = pt_cnt - 1;
+    }
+    else if(flags[pt_cnt - 1] & PT_ON_CURVE) {
+        start = pts[pt_cnt - 1];
+        first = 0;
+        cnt = pt_cnt - 1;
+    }
+    else {
+        start.x = (pts[0].x + pts[pt_cnt - 1].x) / 2;
+        start.y = (pts[0].y + pts[pt_cnt - 1].y) / 2;
+        first = 0;
+        cnt = pt_cnt;
+    }
+
+    contour->cnt = 0;
+    contour_line(contour, &start);
+
+    lv_draw_raster_point_t cur = start;
+    lv_draw_raster_point_t ctrl;
+    bool has_ctrl = false;
+    uint32_t i;
+    for(i = first; i < first + cnt; i++) {
+        const lv_draw_raster_point_t * p = &pts[i];
+        if(flags[i] & PT_ON_CURVE) {
+            if(has_ctrl) contour_curve(contour, &cur, &ctrl, p);
+            else contour_line(contour, p);
+            cur = *p;
+            has_ctrl = false;
+        }
+        else {
+            /*There is an implied point on the contour between two control points*/
+            if(has_ctrl) {
+                lv_draw_raster_point_t mid;
+                mid.x = (ctrl.x + p->x) / 2;
+                mid.y = (ctrl.y + p->y) / 2;
+                contour_curve(contour, &cur, &ctrl, &mid);
+                cur = mid;
+            }
+            ctrl = *p;
+            has_ctrl = true;
+        }
+    }
+
+    /*Close the contour*/
+    if(has_ctrl) contour_curve(contour, &cur, &ctrl, &start);
+
+    lv_draw_raster_add_contour(raster, contour->buf, contour->cnt);
+}
+
+static void contour_line(ttf_contour_t * contour, const lv_draw_raster_point_t * p)
+{
+    if(contour->cnt == contour->max) {
+        uint32_t new_max = contour->max ? contour->max * 2 : 64;
+        lv_draw_raster_point_t * buf = lv_mem_realloc(contour->buf, new_max * sizeof(lv_draw_raster_point_t));
+        LV_ASSERT_MALLOC(buf);
+        if(buf == NULL) return;
+        contour->buf = buf;
+        contour->max = new_max;
+    }
+
+    contour->buf[contour->cnt] = *p;
+    contour->cnt++;
+}
+
+/**
+ * Approximate a quadratic Bézier curve with lines. The start point is already in the contour.
+ */
+static void contour_curve(ttf_contour_t * contour, const lv_draw_raster_point_t * p0,
+                          const lv_draw_raster_point_t * p1, const lv_draw_raster_point_t * p2)
+{
+    /*The error of `n` lines is about 1/8 of the deviation of the control point divided by `n^2`.
+     *Keep it below 1/8 pixel.*/
+    int32_t dev = LV_ABS(p0->x - 2 * p1->x + p2->x) + LV_ABS(p0->y - 2 * p1->y + p2->y);
+    int32_t n = 1;
+    while(n < CURVE_SEG_MAX && dev > n * n * LV_DRAW_RASTER_ONE) n++;
+
+    int32_t i;
+    for(i = 1; i <= n; i++) {
+        int32_t a = (n - i) * (n - i);
+        int32_t b = 2 * i * (n - i);
+        int32_t c = i * i;
+        lv_draw_raster_point_t p;
+        p.x = (int32_t)(((int64_t)a * p0->x + (int64_t)b * p1->x + (int64_t)c * p2->x) / (n * n));
+        p.y = (int32_t)(((int64_t)a * p0->y + (int64_t)b * p1->y + (int64_t)c * p2->y) / (n * n));
+        contour_line(contour, &p);
+    }
+}
+
+/**
+ * Read from the font's data
+ * @return true: `len` bytes are read; false: out of the data or file error
+ */
+static bool ttf_read(ttf_font_t * ttf, uint32_t ofs, void * buf, uint32_t len)
+{
+    if(ttf->data) {
+        if(ofs > ttf->data_size || len > ttf->data_size - ofs) return false;
+        lv_memcpy(buf, ttf->data + ofs, len);
+        return true;
+    }
+
+    uint32_t br;
+    if(lv_fs_seek(&ttf->file, ofs, LV_FS_SEEK_SET) != LV_FS_RES_OK) return false;
+    if(lv_fs_read(&ttf->file, buf, len, &br) != LV_FS_RES_OK) return false;
+    return br == len;
+}
+
+/**
+ * Read a big endian 16 bit value. 0 if it can't be read.
+ */
+static uint16_t ttf_u16(ttf_font_t * ttf, uint32_t ofs)
+{
+    uint8_t b[2];
+    if(!ttf_read(ttf, ofs, b, 2)) return 0;
+    return BE16(b);
+}
+
+/**
+ * Read a big endian 32 bit value. 0 if it can't be read.
+ */
+static uint32_t ttf_u32(ttf_font_t * ttf, uint32_t ofs)
+{
+    uint8_t b[4];
+    if(!ttf_read(ttf, ofs, b, 4)) return 0;
+    return ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 8) | b[3];
+}
+
+/**
+ * Convert font units to pixels with the current size
+ * @param v a value in font units
+ * @param unit the result is in 1/`unit` pixels
+ * @return the value in 1/`unit` pixels rounded down
+ */
+static int32_t scale_units(const ttf_font_t * ttf, int32_t v, int32_t unit)
+{
+    int64_t num = (int64_t)v * ttf->size * unit;
+    int64_t res = num / ttf->units_per_em;
+    if(num < 0 && res * ttf->units_per_em != num) res--;
+    return (int32_t)res;
+}
+
+#endif /*LV_USE_FONT_TTF*/
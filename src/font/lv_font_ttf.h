@@ -0,0 +1,92 @@
+/**
+ * @file lv_font_ttf.h
+ * Render TrueType (.ttf) fonts at runtime in any size.
+ * The glyphs are rasterized when they are used first and kept in a cache with limited size.
+ */
+
+#ifndef LV_FONT_TTF_H
+#define LV_FONT_TTF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_font.h"
+
+#if LV_USE_FONT_TTF
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Statistics of a TrueType font*/
+typedef struct {
+    uint32_t glyph_cnt;     /*Number of glyphs in the cache*/
+    uint32_t cache_used;    /*Size of the cached glyphs in bytes*/
+    uint32_t render_cnt;    /*Number of glyphs rasterized so far*/
+} lv_font_ttf_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a font from a TrueType file. The file remains open until `lv_font_ttf_destroy()`.
+ * The outlines are read from the file only when a glyph is rasterized.
+ * @param path          path to the file, e.g. "S:fonts/my_font.ttf"
+ * @param size          size of the font in pixels (the height of the em square)
+ * @param cache_size    maximal size of the rasterized glyphs in bytes.
+ *                      The least recently used glyphs are freed if the cache is full.
+ * @return              pointer to the new font or NULL if the file can't be opened or is not a supported font
+ */
+lv_font_t * lv_font_ttf_create_file(const char * path, lv_coord_t size, uint32_t cache_size);
+
+/**
+ * Create a font from TrueType data in the memory (e.g. a C array in flash)
+ * @param data          pointer to the content of a .ttf file. It's not copied so it needs to be valid while the font is used.
+ * @param data_size     size of `data` in bytes
+ * @param size          size of the font in pixels (the height of the em square)
+ * @param cache_size    maximal size of the rasterized glyphs in bytes
+ * @return              pointer to the new font or NULL if `data` is not a supported font
+ */
+lv_font_t * lv_font_ttf_create_data(const void * data, uint32_t data_size, lv_coord_t size, uint32_t cache_size);
+
+/**
+ * Change the size of a TrueType font. The cached glyphs are freed.
+ * The objects using the font need to be refreshed (e.g. with `lv_obj_report_style_change(NULL)`).
+ * @param font          pointer to a font created with `lv_font_ttf_create_...()`
+ * @param size          the new size in pixels
+ */
+void lv_font_ttf_set_size(lv_font_t * font, lv_coord_t size);
+
+/**
+ * Get the statistics of a TrueType font's cache
+ * @param font          pointer to a font created with `lv_font_ttf_create_...()`
+ * @param stat          store the statistics here
+ */
+void lv_font_ttf_get_stat(const lv_font_t * font, lv_font_ttf_stat_t * stat);
+
+/**
+ * Close the file and free the cache of a TrueType font
+ * @param font          pointer to a font created with `lv_font_ttf_create_...()`
+ */
+void lv_font_ttf_destroy(lv_font_t * font);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_FONT_TTF*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FONT_TTF_H*/
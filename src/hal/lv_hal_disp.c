@@ -106,6 +106,65 @@ void lv_disp_draw_buf_init(lv_disp_draw_buf_t * draw_buf, void * buf1, void * bu
     draw_buf->buf2    = buf2;
     draw_buf->buf_act = draw_buf->buf1;
     draw_buf->size    = size_in_px_cnt;
+
+    draw_buf->bufs[0] = buf1;
+    draw_buf->bufs[1] = buf2;
+    draw_buf->buf_cnt = buf2 ? 2 : 1;
+}
+
+/**
+ * Initialize a display buffer with a swap chain of any number of buffers.
+ * The rendered buffers are queued and passed to `flush_cb` one by one, in order,
+ * so LVGL can render the next parts while the previous ones are waiting or being flushed.
+ * Rendering is blocked only if all the buffers are rendered but not flushed yet.
+ * The swap chain is used only with partial refresh (not with `full_refresh` or `direct_mode`),
+ * else only the first two buffers are used.
+ * @param draw_buf pointer `lv_disp_draw_buf_t` variable to initialize
+ * @param bufs array of buffers. The array is copied but the buffers need to remain valid.
+ * @param buf_cnt number of buffers in `bufs`. 1 .. `LV_DISP_DRAW_BUF_MAX_NUM`
+ * @param size_in_px_cnt size of each buffer in pixel count.
+ */
+void lv_disp_draw_buf_init_chain(lv_disp_draw_buf_t * draw_buf, void * bufs[], uint32_t buf_cnt,
+                                 uint32_t size_in_px_cnt)
+{
+    LV_ASSERT_NULL(bufs);
+    LV_ASSERT(buf_cnt > 0);
+
+    if(buf_cnt > LV_DISP_DRAW_BUF_MAX_NUM) {
+        LV_LOG_WARN("only the first %d buffers are used", LV_DISP_DRAW_BUF_MAX_NUM);
+        buf_cnt = LV_DISP_DRAW_BUF_MAX_NUM;
+    }
+
+    lv_disp_draw_buf_init(draw_buf, bufs[0], buf_cnt > 1 ? bufs[1] : NULL, size_in_px_cnt);
+
+    uint32_t i;
+    for(i = 0; i < buf_cnt; i++) {
+        LV_ASSERT_NULL(bufs[i]);
+        draw_buf->bufs[i] = bufs[i];
+    }
+    draw_buf->buf_cnt = buf_cnt;
+}
+
+/**
+ * Get the size of a pixel in a color format.
+ * @param cf a color format from `lv_disp_color_format_t`
+ * @return size of a pixel in bytes
+ */
+uint8_t lv_disp_color_format_get_size(lv_disp_color_format_t cf)
+{
+    switch(cf) {
+        case LV_DISP_COLOR_FORMAT_RGB565:
+        case LV_DISP_COLOR_FORMAT_RGB565_SWAP:
+            return 2;
+        case LV_DISP_COLOR_FORMAT_RGB888:
+            return 3;
+        case LV_DISP_COLOR_FORMAT_ARGB8888:
+            return 4;
+        case LV_DISP_COLOR_FORMAT_L8:
+            return 1;
+        default:
+            return sizeof(lv_color_t);
+    }
 }
 
 /**
@@ -137,9 +196,18 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
         return NULL;
     }
 
-    if(driver->full_refresh && driver->draw_buf->size < (uint32_t)driver->hor_res * driver->ver_res) {
+    /*The timer runs only while a frame is requested. Check the vsync often in this time to start the frame right after it.*/
+    if(driver->vsync) {
+        disp->refr_period_saved = LV_DISP_DEF_REFR_PERIOD;
+        disp->vsync_en = 1;
+        lv_timer_set_period(disp->refr_timer, 1);
+    }
+
+    if((driver->full_refresh || driver->direct_mode) &&
+       driver->draw_buf->size < (uint32_t)driver->hor_res * driver->ver_res) {
         driver->full_refresh = 0;
-        LV_LOG_WARN("full_refresh requires at least screen sized draw buffer(s)")
+        driver->direct_mode = 0;
+        LV_LOG_WARN("full_refresh and direct_mode require at least screen sized draw buffer(s)")
     }
 
     disp->bg_color = lv_color_white();
@@ -185,9 +253,24 @@ void lv_disp_drv_update(lv_disp_t * disp, lv_disp_drv_t * new_drv)
 {
     disp->driver = new_drv;
 
-    if(disp->driver->full_refresh && disp->driver->draw_buf->size < (uint32_t)disp->driver->hor_res * disp->driver->ver_res) {
+    /*Change the period only if vsync was enabled or disabled to keep the period set by the application*/
+    if(disp->driver->vsync != disp->vsync_en) {
+        if(disp->driver->vsync) {
+            disp->refr_period_saved = disp->refr_timer->period;
+            lv_timer_set_period(disp->refr_timer, 1);
+        }
+        else {
+            lv_timer_set_period(disp->refr_timer, disp->refr_period_saved);
+        }
+        disp->vsync_en = disp->driver->vsync;
+    }
+    disp->vsync_armed = 0;
+
+    if((disp->driver->full_refresh || disp->driver->direct_mode) &&
+       disp->driver->draw_buf->size < (uint32_t)disp->driver->hor_res * disp->driver->ver_res) {
         disp->driver->full_refresh = 0;
-        LV_LOG_WARN("full_refresh requires at least screen sized draw buffer(s)")
+        disp->driver->direct_mode = 0;
+        LV_LOG_WARN("full_refresh and direct_mode require at least screen sized draw buffer(s)")
     }
 
     lv_coord_t w = lv_disp_get_hor_res(disp);
@@ -209,7 +292,9 @@ void lv_disp_drv_update(lv_disp_t * disp, lv_disp_drv_t * new_drv)
      */
     lv_memset_00(disp->inv_areas, sizeof(disp->inv_areas));
     lv_memset_00(disp->inv_area_joined, sizeof(disp->inv_area_joined));
+    lv_memset_00(disp->inv_area_owners, sizeof(disp->inv_area_owners));
     disp->inv_p = 0;
+    disp->inv_p_prev = 0;
     if(disp->act_scr != NULL) lv_obj_invalidate(disp->act_scr);
 
     lv_obj_tree_walk(NULL, invalidate_layout_cb, NULL);
@@ -352,7 +437,8 @@ LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv)
 {
     /*If the screen is transparent initialize it when the flushing is ready*/
 #if LV_COLOR_SCREEN_TRANSP
-    if(disp_drv->screen_transp) {
+    /*In direct mode the buffers keep their content and only the redrawn areas are cleared*/
+    if(disp_drv->screen_transp && disp_drv->direct_mode == 0) {
         lv_memset_00(disp_drv->draw_buf->buf_act, disp_drv->draw_buf->size * sizeof(lv_color32_t));
     }
 #endif
@@ -372,6 +458,16 @@ LV_ATTRIBUTE_FLUSH_READY bool lv_disp_flush_is_last(lv_disp_drv_t * disp_drv)
     return disp_drv->draw_buf->flushing_last;
 }
 
+/**
+ * Call in the vsync (or tearing effect) interrupt of the display if `disp_drv->vsync` is enabled.
+ * The frames are started only after this signal and animations, layout and rendering are done together.
+ * @param disp_drv pointer to display driver
+ */
+LV_ATTRIBUTE_FLUSH_READY void lv_disp_vsync_ready(lv_disp_drv_t * disp_drv)
+{
+    disp_drv->vsync_cnt++;
+}
+
 /**
  * Get the next display.
  * @param disp pointer to the current display. NULL to initialize.
@@ -31,6 +31,14 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas*/
 #endif
 
+#ifndef LV_DISP_DRAW_BUF_MAX_NUM
+#define LV_DISP_DRAW_BUF_MAX_NUM 4 /*Maximal number of buffers in a swap chain*/
+#endif
+
+#ifndef LV_DISP_FRAME_TIME_CNT
+#define LV_DISP_FRAME_TIME_CNT 32 /*Number of recent frame times to calculate the percentiles from*/
+#endif
+
 #ifndef LV_ATTRIBUTE_FLUSH_READY
 #define LV_ATTRIBUTE_FLUSH_READY
 #endif
@@ -50,6 +58,8 @@ struct _lv_theme_t;
 typedef struct _lv_disp_draw_buf_t{
     void * buf1; /**< First display buffer.*/
     void * buf2; /**< Second display buffer.*/
+    void * bufs[LV_DISP_DRAW_BUF_MAX_NUM]; /**< All the buffers. See `lv_disp_draw_buf_init_chain()`*/
+    uint32_t buf_cnt;                       /**< Number of buffers*/
 
     /*Internal, used by the library*/
     void * buf_act;
@@ -61,6 +71,14 @@ typedef struct _lv_disp_draw_buf_t{
     volatile int flushing_last;
     volatile uint32_t last_area         : 1; /*1: the last area is being rendered*/
     volatile uint32_t last_part         : 1; /*1: the last part of the current area is being rendered*/
+
+    /*Swap chain with more than 2 buffers. The buffers are used in order:
+     *the one being flushed, then the queued ones from `flush_id`, finally `buf_act`*/
+    uint32_t buf_act_id;                        /*Index of `buf_act` in `bufs`*/
+    uint32_t flush_id;                          /*Index of the oldest rendered buffer waiting to be flushed*/
+    uint32_t queue_cnt;                         /*Number of rendered buffers waiting to be flushed*/
+    lv_area_t queue_areas[LV_DISP_DRAW_BUF_MAX_NUM]; /*The area rendered into each buffer*/
+    uint8_t queue_last[LV_DISP_DRAW_BUF_MAX_NUM];    /*1: the buffer has the last part of the frame*/
 } lv_disp_draw_buf_t;
 
 typedef enum {
@@ -70,6 +88,19 @@ typedef enum {
     LV_DISP_ROT_270
 } lv_disp_rot_t;
 
+/**
+ * Color format of the display's pixels.
+ * LVGL renders with `LV_COLOR_DEPTH` and converts the pixels to this format right before flushing.
+ */
+typedef enum {
+    LV_DISP_COLOR_FORMAT_NATIVE = 0,    /**< The format of `lv_color_t`, no conversion*/
+    LV_DISP_COLOR_FORMAT_RGB565,        /**< 16 bit RGB565*/
+    LV_DISP_COLOR_FORMAT_RGB565_SWAP,   /**< 16 bit RGB565 with swapped bytes (e.g. for SPI)*/
+    LV_DISP_COLOR_FORMAT_RGB888,        /**< 24 bit RGB in B, G, R byte order*/
+    LV_DISP_COLOR_FORMAT_ARGB8888,      /**< 32 bit ARGB in B, G, R, A byte order. Alpha is always 0xFF*/
+    LV_DISP_COLOR_FORMAT_L8,            /**< 8 bit luminance (grayscale)*/
+} lv_disp_color_format_t;
+
 /**
  * Display Driver structure to be registered by HAL.
  * Only its pointer will be saved in `lv_disp_t` so it should be declared as
@@ -85,11 +116,14 @@ typedef struct _lv_disp_drv_t {
     lv_disp_draw_buf_t * draw_buf;
 
     uint32_t full_refresh : 1;       /**< 1: Always make the whole screen redrawn*/
+    uint32_t direct_mode : 1;        /**< 1: Use screen sized buffer(s) and redraw only the invalidated areas in absolute coordinates*/
     uint32_t sw_rotate : 1;          /**< 1: use software rotation (slower)*/
     uint32_t antialiasing : 1;       /**< 1: anti-aliasing is enabled on this display.*/
     uint32_t rotated : 2;            /**< 1: turn the display by 90 degree. @warning Does not update coordinates for you!*/
     uint32_t screen_transp : 1;      /**Handle if the screen doesn't have a solid (opa == LV_OPA_COVER) background.
                                        * Use only if required because it's slower.*/
+    uint32_t vsync : 1;              /**< 1: start the frames on the vsync signal. Call `lv_disp_vsync_ready()` on each vsync*/
+    uint32_t color_format : 3;       /**< Color format of the display from `lv_disp_color_format_t`. Not used with `set_px_cb`*/
 
     uint32_t dpi : 10;              /** DPI (dot per inch) of the display. Default value is `LV_DPI_DEF`.*/
 
@@ -137,8 +171,44 @@ typedef struct _lv_disp_drv_t {
     void * user_data; /**< Custom display driver user data*/
 #endif
 
+    /*Internal: number of vsync signals. (It can't be a bit field because it's set from IRQ)*/
+    volatile uint32_t vsync_cnt;
+
 } lv_disp_drv_t;
 
+/**
+ * Statistics about the invalidations of a display. See `lv_refr_get_inv_stat()`.
+ */
+typedef struct {
+    uint32_t raw_cnt;           /**< Number of visible areas invalidated*/
+    uint32_t coalesced_cnt;     /**< Number of areas merged into an already saved area instead of adding a new one*/
+    uint32_t refr_area_cnt;     /**< Number of areas redrawn after joining them*/
+    uint32_t frame_cnt;         /**< Number of refreshes which redrew something*/
+} lv_disp_inv_stat_t;
+
+/**
+ * Statistics about waiting for the display driver. See `lv_refr_get_flush_stat()`.
+ */
+typedef struct {
+    uint32_t flush_cnt;         /**< Number of times `flush_cb` was called*/
+    uint32_t wait_cnt;          /**< Number of times rendering was blocked until a flush was ready*/
+    uint32_t wait_time;         /**< Total time of the blocking in milliseconds*/
+    uint32_t queue_max;         /**< Maximal number of rendered buffers waiting to be flushed in a swap chain*/
+} lv_disp_flush_stat_t;
+
+/**
+ * Statistics about the timing of the frames. See `lv_refr_get_frame_stat()`.
+ */
+typedef struct {
+    uint32_t frame_cnt;         /**< Number of frames which redrew something*/
+    uint32_t missed_cnt;        /**< Number of frames not ready until the next vsync (or in the refresh period without vsync)*/
+    uint32_t dropped_cnt;       /**< Number of vsyncs passed without starting a frame while there was something to redraw*/
+    uint32_t time_p50;          /**< Median of the recent frame times in milliseconds*/
+    uint32_t time_p90;          /**< 90th percentile of the recent frame times in milliseconds*/
+    uint32_t time_p99;          /**< 99th percentile of the recent frame times in milliseconds*/
+    uint32_t time_max;          /**< Longest recent frame time in milliseconds*/
+} lv_disp_frame_stat_t;
+
 /**
  * Display structure.
  * @note `lv_disp_drv_t` should be the first member of the structure.
@@ -170,8 +240,29 @@ typedef struct _lv_disp_t {
     /** Invalidated (marked to redraw) areas*/
     lv_area_t inv_areas[LV_INV_BUF_SIZE];
     uint8_t inv_area_joined[LV_INV_BUF_SIZE];
+    const void * inv_area_owners[LV_INV_BUF_SIZE];  /**< The object whose area was saved. Its next areas are merged into it.*/
     uint16_t inv_p;
 
+    /** Statistics about the invalidated areas*/
+    lv_disp_inv_stat_t inv_stat;
+
+    /** Statistics about waiting for the flushing*/
+    lv_disp_flush_stat_t flush_stat;
+
+    /** Timing of the frames. The percentiles are calculated from `frame_times` only when they are queried.*/
+    lv_disp_frame_stat_t frame_stat;
+    uint16_t frame_times[LV_DISP_FRAME_TIME_CNT];
+    uint16_t frame_time_p;          /**< Index to save the next frame time*/
+    uint16_t frame_time_cnt;        /**< Number of valid values in `frame_times`*/
+    uint32_t vsync_seen;            /**< `vsync_cnt` of the driver when a frame was requested*/
+    uint8_t vsync_armed : 1;        /**< 1: `vsync_seen` is saved, start the frame on the next vsync*/
+    uint8_t vsync_en : 1;           /**< `driver->vsync` the refresh timer's period is set for*/
+    uint32_t refr_period_saved;     /**< Period of the refresh timer to restore when vsync is disabled*/
+
+    /** Areas redrawn in the last frame. In `direct_mode` with two buffers they are copied to the other buffer*/
+    lv_area_t inv_areas_prev[LV_INV_BUF_SIZE];
+    uint16_t inv_p_prev;
+
     /*Miscellaneous data*/
     uint32_t last_activity_time;        /**< Last time when there was activity on this display*/
 } lv_disp_t;
@@ -205,6 +296,30 @@ void lv_disp_drv_init(lv_disp_drv_t * driver);
  */
 void lv_disp_draw_buf_init(lv_disp_draw_buf_t * draw_buf, void * buf1, void * buf2, uint32_t size_in_px_cnt);
 
+/**
+ * Initialize a display buffer with a swap chain of any number of buffers.
+ * The rendered buffers are queued and passed to `flush_cb` one by one, in order,
+ * so LVGL can render the next parts while the previous ones are waiting or being flushed.
+ * Rendering is blocked only if all the buffers are rendered but not flushed yet.
+ * The swap chain is used only with partial refresh (not with `full_refresh` or `direct_mode`),
+ * else only the first two buffers are used.
+ * @param draw_buf pointer `lv_disp_draw_buf_t` variable to initialize
+ * @param bufs array of buffers. The array is copied but the buffers need to remain valid.
+ * @param buf_cnt number of buffers in `bufs`. 1 .. `LV_DISP_DRAW_BUF_MAX_NUM`
+ * @param size_in_px_cnt size of each buffer in pixel count.
+ */
+void lv_disp_draw_buf_init_chain(lv_disp_draw_buf_t * draw_buf, void * bufs[], uint32_t buf_cnt,
+                                 uint32_t size_in_px_cnt);
+
+/**
+ * Get the size of a pixel in a color format.
+ * Useful to allocate the draw buffers: with a color format larger than `lv_color_t`
+ * LVGL renders fewer pixels into the buffers to have space for the conversion.
+ * @param cf a color format from `lv_disp_color_format_t`
+ * @return size of a pixel in bytes
+ */
+uint8_t lv_disp_color_format_get_size(lv_disp_color_format_t cf);
+
 /**
  * Register an initialized display driver.
  * Automatically set the first display as active.
@@ -297,6 +412,13 @@ LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv);
  */
 LV_ATTRIBUTE_FLUSH_READY bool lv_disp_flush_is_last(lv_disp_drv_t * disp_drv);
 
+/**
+ * Call in the vsync (or tearing effect) interrupt of the display if `disp_drv->vsync` is enabled.
+ * The frames are started only after this signal and animations, layout and rendering are done together.
+ * @param disp_drv pointer to display driver
+ */
+LV_ATTRIBUTE_FLUSH_READY void lv_disp_vsync_ready(lv_disp_drv_t * disp_drv);
+
 //! @endcond
 
 /**
@@ -123,6 +123,26 @@
 #    define  LV_MEM_ADR          0     /*0: unused*/
 #  endif
 #endif
+
+/*Size of the memory reserved from `LV_MEM_SIZE` for the pools of small blocks (<= 256 bytes) in bytes.
+ *Small blocks are allocated and freed in constant time without fragmenting the heap. 0: don't use the pools*/
+#ifndef LV_MEM_SMALL_POOL_SIZE
+#  ifdef CONFIG_LV_MEM_SMALL_POOL_SIZE
+#    define LV_MEM_SMALL_POOL_SIZE CONFIG_LV_MEM_SMALL_POOL_SIZE
+#  else
+#    define  LV_MEM_SMALL_POOL_SIZE    (LV_MEM_SIZE / 8)
+#  endif
+#endif
+
+/*1: Enable `lv_mem_free_atomic()` to free memory from other threads without locking. Requires C11 atomics.
+ *The blocks are pushed to a lock-free list and given back to the small pools or the heap in the next `lv_mem_alloc()`*/
+#ifndef LV_MEM_ATOMIC_FREE
+#  ifdef CONFIG_LV_MEM_ATOMIC_FREE
+#    define LV_MEM_ATOMIC_FREE CONFIG_LV_MEM_ATOMIC_FREE
+#  else
+#    define  LV_MEM_ATOMIC_FREE        0
+#  endif
+#endif
 #else       /*LV_MEM_CUSTOM*/
 #ifndef LV_MEM_CUSTOM_INCLUDE
 #  ifdef CONFIG_LV_MEM_CUSTOM_INCLUDE
@@ -278,14 +298,6 @@
 #  endif
 #endif
 
-/*Maximum buffer size to allocate for rotation. Only used if software rotation is enabled in the display driver.*/
-#ifndef LV_DISP_ROT_MAX_BUF
-#  ifdef CONFIG_LV_DISP_ROT_MAX_BUF
-#    define LV_DISP_ROT_MAX_BUF CONFIG_LV_DISP_ROT_MAX_BUF
-#  else
-#    define  LV_DISP_ROT_MAX_BUF         (10*1024)
-#  endif
-#endif
 /*-------------
  * GPU
  *-----------*/
@@ -607,6 +619,59 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #  endif
 #endif
 
+/*1: Enable a queue to update objects from other threads without locking.
+ *The commands are applied at the beginning of `lv_timer_handler()`. Requires C11 atomics.*/
+#ifndef LV_USE_CMD_QUEUE
+#  ifdef CONFIG_LV_USE_CMD_QUEUE
+#    define LV_USE_CMD_QUEUE CONFIG_LV_USE_CMD_QUEUE
+#  else
+#    define  LV_USE_CMD_QUEUE        0
+#  endif
+#endif
+#if LV_USE_CMD_QUEUE
+#ifndef LV_CMD_QUEUE_SIZE
+#  ifdef CONFIG_LV_CMD_QUEUE_SIZE
+#    define LV_CMD_QUEUE_SIZE CONFIG_LV_CMD_QUEUE_SIZE
+#  else
+#    define  LV_CMD_QUEUE_SIZE     64      /*Number of not applied commands. Power of 2*/
+#  endif
+#endif
+#ifndef LV_CMD_QUEUE_BUDGET
+#  ifdef CONFIG_LV_CMD_QUEUE_BUDGET
+#    define LV_CMD_QUEUE_BUDGET CONFIG_LV_CMD_QUEUE_BUDGET
+#  else
+#    define  LV_CMD_QUEUE_BUDGET   32      /*Apply at most this many commands in a `lv_timer_handler()` call*/
+#  endif
+#endif
+#ifndef LV_CMD_QUEUE_TXT_MAX
+#  ifdef CONFIG_LV_CMD_QUEUE_TXT_MAX
+#    define LV_CMD_QUEUE_TXT_MAX CONFIG_LV_CMD_QUEUE_TXT_MAX
+#  else
+#    define  LV_CMD_QUEUE_TXT_MAX  32      /*Texts shorter than this can be sent to labels*/
+#  endif
+#endif
+#endif
+
+/*1: Flatten the styles added by the themes into one constant style per part and state.
+ *The flattened style lists are shared by all the objects which get the same styles from the theme.*/
+#ifndef LV_USE_THEME_COMPILE
+#  ifdef CONFIG_LV_USE_THEME_COMPILE
+#    define LV_USE_THEME_COMPILE CONFIG_LV_USE_THEME_COMPILE
+#  else
+#    define  LV_USE_THEME_COMPILE    0
+#  endif
+#endif
+
+/*1: Store the identical local styles (e.g. set by `lv_obj_set_style_...()`) only once and share them between the objects.
+ *A shared style is copied when an object modifies it.*/
+#ifndef LV_USE_LOCAL_STYLE_SHARE
+#  ifdef CONFIG_LV_USE_LOCAL_STYLE_SHARE
+#    define LV_USE_LOCAL_STYLE_SHARE CONFIG_LV_USE_LOCAL_STYLE_SHARE
+#  else
+#    define  LV_USE_LOCAL_STYLE_SHARE    0
+#  endif
+#endif
+
 /*=====================
  *  COMPILER SETTINGS
  *====================*/
@@ -961,6 +1026,16 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #  endif
 #endif
 
+/*Enable rendering TrueType (.ttf) fonts at runtime in any size. See lv_font_ttf.h
+ *Requires `LV_DRAW_COMPLEX = 1`*/
+#ifndef LV_USE_FONT_TTF
+#  ifdef CONFIG_LV_USE_FONT_TTF
+#    define LV_USE_FONT_TTF CONFIG_LV_USE_FONT_TTF
+#  else
+#    define  LV_USE_FONT_TTF         0
+#  endif
+#endif
+
 /*Enable subpixel rendering*/
 #ifndef LV_USE_FONT_SUBPX
 #  ifdef CONFIG_LV_USE_FONT_SUBPX
@@ -1178,7 +1253,7 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #  ifdef CONFIG_LV_LABEL_LONG_TXT_HINT
 #    define LV_LABEL_LONG_TXT_HINT CONFIG_LV_LABEL_LONG_TXT_HINT
 #  else
-#    define  LV_LABEL_LONG_TXT_HINT    1   /*Store some extra info in labels to speed up drawing of very long texts*/
+#    define  LV_LABEL_LONG_TXT_HINT    1   /*Cache the line breaks of the labels to speed up drawing (especially of very long texts)*/
 #  endif
 #endif
 #endif
@@ -1198,15 +1273,6 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #    define  LV_USE_ROLLER       1   /*Requires: lv_label*/
 #  endif
 #endif
-#if LV_USE_ROLLER
-#ifndef LV_ROLLER_INF_PAGES
-#  ifdef CONFIG_LV_ROLLER_INF_PAGES
-#    define LV_ROLLER_INF_PAGES CONFIG_LV_ROLLER_INF_PAGES
-#  else
-#    define  LV_ROLLER_INF_PAGES       7   /*Number of extra "pages" when the roller is infinite*/
-#  endif
-#endif
-#endif
 
 #ifndef LV_USE_SLIDER
 #  ifdef CONFIG_LV_USE_SLIDER
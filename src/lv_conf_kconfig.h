@@ -32,6 +32,12 @@ extern "C" {
 #endif
 #endif
 
+#ifndef LV_MEM_SMALL_POOL_SIZE
+#if defined (CONFIG_LV_MEM_SMALL_POOL_SIZE_KILOBYTES)
+#define CONFIG_LV_MEM_SMALL_POOL_SIZE    (CONFIG_LV_MEM_SMALL_POOL_SIZE_KILOBYTES * 1024U)
+#endif
+#endif
+
 /*******************
  * LV COLOR CHROMA KEY
  *******************/
@@ -12,6 +12,8 @@
 #include "lv_ll.h"
 #include <string.h>
 #include "lv_gc.h"
+#include "lv_mem.h"
+#include "lv_math.h"
 
 /*********************
  *      DEFINES
@@ -34,6 +36,7 @@
  *  STATIC PROTOTYPES
  **********************/
 static const char * lv_fs_get_real_path(const char * path);
+static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, uint8_t * buf, uint32_t btr, uint32_t * br);
 
 /**********************
  *  STATIC VARIABLES
@@ -99,6 +102,30 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
 
     file_p->drv = drv;
     file_p->file_d = file_d;
+    file_p->cache = NULL;
+
+    if(drv->cache_size == 0 && drv->map_cb == NULL) return LV_FS_RES_OK;
+
+    file_p->cache = lv_mem_alloc(sizeof(lv_fs_file_cache_t));
+    LV_ASSERT_MALLOC(file_p->cache);
+    if(file_p->cache == NULL) {
+        drv->close_cb(drv, file_d);
+        file_p->drv = NULL;
+        file_p->file_d = NULL;
+        return LV_FS_RES_OUT_OF_MEM;
+    }
+    lv_memset_00(file_p->cache, sizeof(lv_fs_file_cache_t));
+
+    /*Only read-only files are mapped as writing would change the content under the mapped memory*/
+    if(drv->map_cb && mode == LV_FS_MODE_RD) {
+        uint32_t size = 0;
+        const void * mapped = drv->map_cb(drv, file_d, &size);
+        if(mapped) {
+            file_p->cache->buffer = mapped;
+            file_p->cache->end = size;
+            file_p->cache->mapped = 1;
+        }
+    }
 
     return LV_FS_RES_OK;
 }
@@ -115,8 +142,14 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
 
     lv_fs_res_t res = file_p->drv->close_cb(file_p->drv, file_p->file_d);
 
+    if(file_p->cache) {
+        if(file_p->cache->mapped == 0) lv_mem_free((void *)file_p->cache->buffer);
+        lv_mem_free(file_p->cache);
+    }
+
     file_p->file_d = NULL;
     file_p->drv    = NULL;
+    file_p->cache  = NULL;
 
     return res;
 }
@@ -128,7 +161,9 @@ lv_fs_res_t lv_fs_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t
     if(file_p->drv->read_cb == NULL) return LV_FS_RES_NOT_IMP;
 
     uint32_t br_tmp = 0;
-    lv_fs_res_t res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, &br_tmp);
+    lv_fs_res_t res;
+    if(file_p->cache) res = lv_fs_read_cached(file_p, buf, btr, &br_tmp);
+    else res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, &br_tmp);
     if(br != NULL) *br = br_tmp;
 
     return res;
@@ -146,9 +181,22 @@ lv_fs_res_t lv_fs_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, u
         return LV_FS_RES_NOT_IMP;
     }
 
+    lv_fs_file_cache_t * cache = file_p->cache;
+    if(cache) {
+        if(cache->mapped) return LV_FS_RES_DENIED;
+
+        /*Drop the cached bytes and continue from the logical position*/
+        cache->start = 0;
+        cache->end = 0;
+        if(file_p->drv->seek_cb == NULL) return LV_FS_RES_NOT_IMP;
+        lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, cache->file_position, LV_FS_SEEK_SET);
+        if(res != LV_FS_RES_OK) return res;
+    }
+
     uint32_t bw_tmp = 0;
     lv_fs_res_t res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
     if(bw != NULL) *bw = bw_tmp;
+    if(cache) cache->file_position += bw_tmp;
 
     return res;
 }
@@ -159,11 +207,44 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
         return LV_FS_RES_INV_PARAM;
     }
 
+    lv_fs_file_cache_t * cache = file_p->cache;
+    if(cache && cache->mapped) {
+        /*Mapped files are handled fully in the memory*/
+        switch(whence) {
+            case LV_FS_SEEK_SET:
+                cache->file_position = pos;
+                break;
+            case LV_FS_SEEK_CUR:
+                cache->file_position += pos;
+                break;
+            case LV_FS_SEEK_END:
+                cache->file_position = cache->end + pos;
+                break;
+        }
+        return LV_FS_RES_OK;
+    }
+
     if(file_p->drv->seek_cb == NULL) {
         return LV_FS_RES_NOT_IMP;
     }
 
-    lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, whence);
+    if(cache == NULL) return file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, whence);
+
+    /*Only the logical position is changed. The driver is seeked when the cache needs to be refilled.*/
+    lv_fs_res_t res = LV_FS_RES_OK;
+    switch(whence) {
+        case LV_FS_SEEK_SET:
+            cache->file_position = pos;
+            break;
+        case LV_FS_SEEK_CUR:
+            cache->file_position += pos;
+            break;
+        case LV_FS_SEEK_END:
+            if(file_p->drv->tell_cb == NULL) return LV_FS_RES_NOT_IMP;
+            res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, whence);
+            if(res == LV_FS_RES_OK) res = file_p->drv->tell_cb(file_p->drv, file_p->file_d, &cache->file_position);
+            break;
+    }
 
     return res;
 }
@@ -175,6 +256,11 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
         return LV_FS_RES_INV_PARAM;
     }
 
+    if(file_p->cache) {
+        *pos = file_p->cache->file_position;
+        return LV_FS_RES_OK;
+    }
+
     if(file_p->drv->tell_cb == NULL) {
         *pos = 0;
         return LV_FS_RES_NOT_IMP;
@@ -185,6 +271,17 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
     return res;
 }
 
+const void * lv_fs_map(lv_fs_file_t * file_p, uint32_t * size)
+{
+    if(file_p->cache == NULL || file_p->cache->mapped == 0) {
+        if(size) *size = 0;
+        return NULL;
+    }
+
+    if(size) *size = file_p->cache->end;
+    return file_p->cache->buffer;
+}
+
 lv_fs_res_t lv_fs_dir_open(lv_fs_dir_t * rddir_p, const char * path)
 {
     if(path == NULL) return LV_FS_RES_INV_PARAM;
@@ -380,3 +477,77 @@ static const char * lv_fs_get_real_path(const char * path)
 
     return path;
 }
+
+/**
+ * Read from a file through its cache. Mapped files are copied from the memory,
+ * else the bytes are served from a `cache_size` sized read ahead block.
+ * @param file_p    pointer to a file with `cache != NULL`
+ * @param buf       pointer to a buffer where the read bytes are stored
+ * @param btr       Bytes To Read
+ * @param br        the number of real read bytes (Bytes Read)
+ * @return          LV_FS_RES_OK or any error from `lv_fs_res_t` enum
+ */
+static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, uint8_t * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_file_cache_t * cache = file_p->cache;
+    uint32_t pos = cache->file_position;
+    *br = 0;
+
+    /*Copy what is already in the memory*/
+    if(pos >= cache->start && pos < cache->end) {
+        uint32_t n = LV_MIN(btr, cache->end - pos);
+        lv_memcpy(buf, cache->buffer + (pos - cache->start), n);
+        buf += n;
+        btr -= n;
+        pos += n;
+        *br = n;
+    }
+
+    /*A mapped file has no more bytes to read. If nothing was copied the position is at the end of the file:
+     *read from the driver to return the same result as without mapping.*/
+    cache->file_position = pos;
+    if(btr == 0 || (cache->mapped && *br > 0)) return LV_FS_RES_OK;
+
+    /*If some bytes were copied from the cache already and the driver can't read more (e.g. at the end of the file)
+     *return them as a short read, like a single read of the driver would do*/
+    bool copied = *br > 0;
+
+    if(file_p->drv->seek_cb == NULL) return copied ? LV_FS_RES_OK : LV_FS_RES_NOT_IMP;
+    lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, LV_FS_SEEK_SET);
+    if(res != LV_FS_RES_OK) return copied ? LV_FS_RES_OK : res;
+
+    uint32_t br_tmp = 0;
+    uint16_t cache_size = file_p->drv->cache_size;
+    if(btr >= cache_size || cache->mapped) {
+        /*Large reads (and the reads at the end of the mapped files) go directly to the destination*/
+        res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, &br_tmp);
+        cache->file_position = pos + br_tmp;
+        *br += br_tmp;
+        return copied ? LV_FS_RES_OK : res;
+    }
+
+    if(cache->buffer == NULL) {
+        cache->buffer = lv_mem_alloc(cache_size);
+        LV_ASSERT_MALLOC(cache->buffer);
+        if(cache->buffer == NULL) return copied ? LV_FS_RES_OK : LV_FS_RES_OUT_OF_MEM;
+    }
+
+    /*Refill the cache with the next block*/
+    uint8_t * cache_buf = (uint8_t *)cache->buffer;
+    res = file_p->drv->read_cb(file_p->drv, file_p->file_d, cache_buf, cache_size, &br_tmp);
+    if(res != LV_FS_RES_OK) {
+        cache->start = 0;
+        cache->end = 0;
+        return copied ? LV_FS_RES_OK : res;
+    }
+
+    cache->start = pos;
+    cache->end = pos + br_tmp;
+
+    uint32_t n = LV_MIN(btr, br_tmp);
+    lv_memcpy(buf, cache_buf, n);
+    cache->file_position = pos + n;
+    *br += n;
+
+    return LV_FS_RES_OK;
+}
@@ -69,6 +69,7 @@ typedef enum {
 
 typedef struct _lv_fs_drv_t {
     char letter;
+    uint16_t cache_size;    /**< Size of the read ahead cache of the files in bytes. 0: read directly with `read_cb`*/
     bool (*ready_cb)(struct _lv_fs_drv_t * drv);
 
     void * (*open_cb)(struct _lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode);
@@ -78,6 +79,11 @@ typedef struct _lv_fs_drv_t {
     lv_fs_res_t (*seek_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
     lv_fs_res_t (*tell_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
 
+    /** OPTIONAL: Give a pointer to the whole content of an opened file (e.g. `mmap` or memory mapped flash)
+     * and store its size in `size`. The content has to remain valid until the file is closed.
+     * Return NULL if the file can't be mapped.*/
+    const void * (*map_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * size);
+
     void * (*dir_open_cb)(struct _lv_fs_drv_t * drv, const char * path);
     lv_fs_res_t (*dir_read_cb)(struct _lv_fs_drv_t * drv, void * rddir_p, char * fn);
     lv_fs_res_t (*dir_close_cb)(struct _lv_fs_drv_t * drv, void * rddir_p);
@@ -87,9 +93,18 @@ typedef struct _lv_fs_drv_t {
 #endif
 } lv_fs_drv_t;
 
+typedef struct {
+    uint32_t start;             /**< File position of the first cached byte*/
+    uint32_t end;               /**< File position after the last cached byte*/
+    uint32_t file_position;     /**< Position of the read write pointer*/
+    const uint8_t * buffer;     /**< The cached bytes or the whole file if it's mapped*/
+    uint8_t mapped : 1;         /**< 1: `buffer` is the content of the file given by `map_cb`*/
+} lv_fs_file_cache_t;
+
 typedef struct {
     void * file_d;
     lv_fs_drv_t * drv;
+    lv_fs_file_cache_t * cache;
 } lv_fs_file_t;
 
 typedef struct {
@@ -190,6 +205,15 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
  */
 lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos);
 
+/**
+ * Get the content of a file if the driver could map it to the memory.
+ * The returned memory is valid until the file is closed.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param size      store the size of the file here. NULL if unused.
+ * @return          pointer to the content of the file or NULL if the file is not mapped
+ */
+const void * lv_fs_map(lv_fs_file_t * file_p, uint32_t * size);
+
 /**
  * Initialize a 'fs_dir_t' variable for directory reading
  * @param rddir_p   pointer to a 'lv_fs_dir_t' variable
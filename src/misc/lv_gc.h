@@ -48,6 +48,7 @@ extern "C" {
     LV_DISPATCH(f, lv_ll_t, _lv_group_ll)                                                   \
     LV_DISPATCH(f, lv_ll_t, _lv_img_decoder_ll)                                             \
     LV_DISPATCH(f, lv_ll_t, _lv_obj_style_trans_ll)                                         \
+    LV_DISPATCH(f, lv_ll_t, _lv_obj_style_batch_ll)                                         \
     LV_DISPATCH(f, lv_layout_dsc_t *, _lv_layout_list)      \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)    \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)    \
@@ -56,6 +57,8 @@ extern "C" {
     LV_DISPATCH_COND(f, _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1)  \
     LV_DISPATCH_COND(f, _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1) \
     LV_DISPATCH(f, void * , _lv_theme_default_styles)                                       \
+    LV_DISPATCH_COND(f, void **, _lv_theme_sheet_buckets, LV_USE_THEME_COMPILE, 1)         \
+    LV_DISPATCH_COND(f, void **, _lv_obj_style_share_buckets, LV_USE_LOCAL_STYLE_SHARE, 1)  \
     LV_DISPATCH_COND(f, uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
@@ -10,6 +10,7 @@
 #include "lv_mem.h"
 #include "lv_tlsf.h"
 #include "lv_gc.h"
+#include "lv_math.h"
 #include "lv_assert.h"
 #include <string.h>
 
@@ -21,6 +22,15 @@
     #include LV_MEM_POOL_INCLUDE
 #endif
 
+#if LV_MEM_CUSTOM == 0
+    #if LV_MEM_ATOMIC_FREE
+        #if defined(__STDC_NO_ATOMICS__) || !defined(__STDC_VERSION__) || __STDC_VERSION__ < 201112L
+            #error "LV_MEM_ATOMIC_FREE requires C11 atomics"
+        #endif
+        #include <stdatomic.h>
+    #endif
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -39,15 +49,65 @@
 
 #define ZERO_MEM_SENTINEL  0xa1b2c3d4
 
+/*The small blocks are allocated from pages of equal sized blocks.
+ *Like the rest of `lv_mem` the pools are not thread safe: LVGL is called from one thread.
+ *Only `lv_mem_free_atomic()` can be called from other threads.*/
+#define SMALL_PAGE_SIZE    512
+#define SMALL_CLASS_CNT    5        /*16, 32, 64, 128 and 256 bytes*/
+#define SMALL_CLASS_MIN    16
+#define SMALL_CLASS_MAX    (SMALL_CLASS_MIN << (SMALL_CLASS_CNT - 1))
+#define SMALL_PAGE_NONE    0xFFFF
+
+#if LV_MEM_CUSTOM == 0
+#  if LV_MEM_SMALL_POOL_SIZE >= SMALL_PAGE_SIZE
+#    define SMALL_POOL     1
+#    define SMALL_PAGE_CNT (LV_MEM_SMALL_POOL_SIZE / SMALL_PAGE_SIZE)
+#  else
+#    define SMALL_POOL     0
+#  endif
+#else
+#  define SMALL_POOL       0
+#endif
+
+#if LV_MEM_CUSTOM == 0
+#  define ATOMIC_FREE      LV_MEM_ATOMIC_FREE
+#else
+#  define ATOMIC_FREE      0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if SMALL_POOL
+typedef struct {
+    void * free_head;       /*List of the freed blocks of the page*/
+    uint16_t prev;          /*Neighbor pages in the list of a size class or of the empty pages*/
+    uint16_t next;
+    uint16_t used_cnt;      /*Number of allocated blocks*/
+    uint16_t bump_cnt;      /*The blocks after the first `bump_cnt` blocks were never allocated*/
+    uint8_t cls;            /*Size class: the blocks are `SMALL_CLASS_MIN << cls` bytes*/
+} small_page_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 #if LV_MEM_CUSTOM == 0
     static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
+    static uint32_t get_free_size(void);
+    static void update_max_used(void);
+#endif
+#if SMALL_POOL
+    static void small_pool_init(void);
+    static void * small_alloc(size_t size);
+    static void small_free(void * p);
+    static bool small_is_pool_block(const void * p);
+    static uint32_t small_block_size(const void * p);
+    static void small_page_link(uint16_t * head, uint16_t id);
+    static void small_page_unlink(uint16_t * head, uint16_t id);
+#endif
+#if ATOMIC_FREE
+    static void atomic_free_flush(void);
 #endif
 
 /**********************
@@ -55,6 +115,22 @@
  **********************/
 #if LV_MEM_CUSTOM == 0
     static lv_tlsf_t tlsf;
+    static uint32_t used_cnt;
+    static uint32_t max_used;
+#endif
+
+#if SMALL_POOL
+    static uint8_t * small_mem;
+    static small_page_t small_pages[SMALL_PAGE_CNT];
+    static uint16_t small_class_pages[SMALL_CLASS_CNT];  /*Pages with free blocks in each size class*/
+    static uint16_t small_empty_pages;
+    static uint32_t small_used_size;
+#endif
+
+#if ATOMIC_FREE
+    /*Blocks freed by `lv_mem_free_atomic()`, linked through their first bytes.
+     *Any thread can push to it and the thread of LVGL takes the whole list at once so there is no ABA problem.*/
+    static _Atomic(void *) atomic_free_head;
 #endif
 
 static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variable if 0 byte should be allocated*/
@@ -96,6 +172,16 @@ void lv_mem_init(void)
 #else
     tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
 #endif
+    used_cnt = 0;
+    max_used = 0;
+#endif
+
+#if SMALL_POOL
+    small_pool_init();
+#endif
+
+#if ATOMIC_FREE
+    atomic_store(&atomic_free_head, NULL);
 #endif
 
 #if LV_MEM_ADD_JUNK
@@ -129,7 +215,20 @@ void * lv_mem_alloc(size_t size)
     }
 
 #if LV_MEM_CUSTOM == 0
-    void * alloc = lv_tlsf_malloc(tlsf, size);
+#if ATOMIC_FREE
+    atomic_free_flush();
+#endif
+    void * alloc = NULL;
+#if SMALL_POOL
+    /*Small blocks come from the pool of their size class. TLSF is used if it's full.*/
+    if(size <= SMALL_CLASS_MAX) alloc = small_alloc(size);
+#endif
+    if(alloc == NULL) alloc = lv_tlsf_malloc(tlsf, size);
+
+    if(alloc != NULL) {
+        used_cnt++;
+        update_max_used();
+    }
 #else
     void * alloc = LV_MEM_CUSTOM_ALLOC(size);
 #endif
@@ -162,6 +261,13 @@ void lv_mem_free(void * data)
     if(data == NULL) return;
 
 #if LV_MEM_CUSTOM == 0
+    used_cnt--;
+#  if SMALL_POOL
+    if(small_is_pool_block(data)) {
+        small_free(data);
+        return;
+    }
+#  endif
 #  if LV_MEM_ADD_JUNK
     lv_memset(data, 0xbb, lv_tlsf_block_size(data));
 #  endif
@@ -171,6 +277,26 @@ void lv_mem_free(void * data)
 #endif
 }
 
+#if ATOMIC_FREE
+/**
+ * Free an allocated data from any thread without locking.
+ * The memory is given back in the next `lv_mem_alloc()` or `lv_mem_monitor()` in the thread of LVGL.
+ * @param data pointer to an allocated memory
+ */
+void lv_mem_free_atomic(void * data)
+{
+    if(data == &zero_mem) return;
+    if(data == NULL) return;
+
+    /*Every block is large enough to store a pointer*/
+    void * head = atomic_load_explicit(&atomic_free_head, memory_order_relaxed);
+    do {
+        *(void **)data = head;
+    } while(!atomic_compare_exchange_weak_explicit(&atomic_free_head, &head, data, memory_order_release,
+                                                   memory_order_relaxed));
+}
+#endif
+
 /**
  * Reallocate a memory with a new size. The old content will be kept.
  * @param data pointer to an allocated memory.
@@ -187,10 +313,24 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
         return &zero_mem;
     }
 
-    if(data_p == &zero_mem) return lv_mem_alloc(new_size);
+    if(data_p == &zero_mem || data_p == NULL) return lv_mem_alloc(new_size);
 
 #if LV_MEM_CUSTOM == 0
+#if SMALL_POOL
+    if(small_is_pool_block(data_p)) {
+        /*Keep the block if the new size belongs to the same size class*/
+        uint32_t block_size = small_block_size(data_p);
+        if(new_size <= block_size && (block_size == SMALL_CLASS_MIN || new_size > block_size / 2)) return data_p;
+
+        void * new_p = lv_mem_alloc(new_size);
+        if(new_p == NULL) return NULL;
+        lv_memcpy(new_p, data_p, LV_MIN(new_size, block_size));
+        lv_mem_free(data_p);
+        return new_p;
+    }
+#endif
     void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
+    if(new_p != NULL) update_max_used();
 #else
     void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
 #endif
@@ -220,6 +360,16 @@ lv_res_t lv_mem_test(void)
         LV_LOG_WARN("pool failed");
         return LV_RES_INV;
     }
+
+    /*The statistics are updated incrementally. Check them by walking the heap.*/
+    lv_mem_monitor_t mon;
+    lv_memset_00(&mon, sizeof(mon));
+    lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, &mon);
+    if(mon.free_size != lv_tlsf_free_size(tlsf) || mon.free_cnt != lv_tlsf_free_cnt(tlsf) ||
+       mon.free_biggest_size != lv_tlsf_free_biggest_size(tlsf)) {
+        LV_LOG_WARN("statistics failed");
+        return LV_RES_INV;
+    }
 #endif
     MEM_TRACE("passed");
     return LV_RES_OK;
@@ -237,12 +387,23 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #if LV_MEM_CUSTOM == 0
     MEM_TRACE("begin");
 
-    lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
+#if ATOMIC_FREE
+    atomic_free_flush();
+#endif
+
+    /*The statistics are updated on every allocation so only the biggest free block is searched (in one free list)*/
+    uint32_t tlsf_free_size = lv_tlsf_free_size(tlsf);
+    mon_p->free_size = get_free_size();
+    mon_p->free_cnt = lv_tlsf_free_cnt(tlsf);
+    mon_p->free_biggest_size = lv_tlsf_free_biggest_size(tlsf);
+    mon_p->used_cnt = used_cnt;
+    mon_p->max_used = max_used;
 
     mon_p->total_size = LV_MEM_SIZE;
     mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
-    if(mon_p->free_size > 0) {
-        mon_p->frag_pct = mon_p->free_biggest_size * 100U / mon_p->free_size;
+    /*The pools of the small blocks are not fragmented by design so consider only the TLSF blocks*/
+    if(tlsf_free_size > 0) {
+        mon_p->frag_pct = mon_p->free_biggest_size * 100U / tlsf_free_size;
         mon_p->frag_pct = 100 - mon_p->frag_pct;
     }
     else {
@@ -547,4 +708,186 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
             mon_p->free_biggest_size = size;
     }
 }
+
+/**
+ * Get the free memory in constant time: the free TLSF blocks and the free space in the small pools
+ * @return the free memory in bytes
+ */
+static uint32_t get_free_size(void)
+{
+    uint32_t free_size = lv_tlsf_free_size(tlsf);
+#if SMALL_POOL
+    if(small_mem) free_size += SMALL_PAGE_CNT * SMALL_PAGE_SIZE - small_used_size;
+#endif
+    return free_size;
+}
+
+/**
+ * Update the maximum of the used memory after an allocation
+ */
+static void update_max_used(void)
+{
+    uint32_t used = LV_MEM_SIZE - get_free_size();
+    if(used > max_used) max_used = used;
+}
+#endif
+
+#if SMALL_POOL
+/**
+ * Reserve the memory of the small pools from TLSF and put all the pages to the list of empty pages
+ */
+static void small_pool_init(void)
+{
+    uint32_t i;
+    for(i = 0; i < SMALL_CLASS_CNT; i++) small_class_pages[i] = SMALL_PAGE_NONE;
+    small_empty_pages = SMALL_PAGE_NONE;
+    small_used_size = 0;
+
+    small_mem = lv_tlsf_malloc(tlsf, SMALL_PAGE_CNT * SMALL_PAGE_SIZE);
+    if(small_mem == NULL) {
+        LV_LOG_WARN("couldn't allocate the small pools (decrease LV_MEM_SMALL_POOL_SIZE)");
+        return;
+    }
+
+    for(i = SMALL_PAGE_CNT; i > 0; i--) small_page_link(&small_empty_pages, i - 1);
+}
+
+/**
+ * Allocate a block from the pool of its size class
+ * @param size the required size, at most `SMALL_CLASS_MAX`
+ * @return pointer to the block or NULL if there are no free pages
+ */
+static void * small_alloc(size_t size)
+{
+    uint32_t cls = 0;
+    while(((size_t)SMALL_CLASS_MIN << cls) < size) cls++;
+
+    uint16_t id = small_class_pages[cls];
+    if(id == SMALL_PAGE_NONE) {
+        /*Give an empty page to the size class*/
+        id = small_empty_pages;
+        if(id == SMALL_PAGE_NONE) return NULL;
+
+        small_page_unlink(&small_empty_pages, id);
+        small_page_t * page = &small_pages[id];
+        page->free_head = NULL;
+        page->used_cnt = 0;
+        page->bump_cnt = 0;
+        page->cls = cls;
+        small_page_link(&small_class_pages[cls], id);
+    }
+
+    small_page_t * page = &small_pages[id];
+    uint32_t block_size = SMALL_CLASS_MIN << cls;
+    void * p;
+    if(page->free_head) {
+        p = page->free_head;
+        page->free_head = *(void **)p;
+    }
+    else {
+        p = &small_mem[id * SMALL_PAGE_SIZE + page->bump_cnt * block_size];
+        page->bump_cnt++;
+    }
+
+    page->used_cnt++;
+    if(page->used_cnt == SMALL_PAGE_SIZE / block_size) small_page_unlink(&small_class_pages[cls], id);
+
+    small_used_size += block_size;
+    return p;
+}
+
+/**
+ * Put back a block to its page
+ * @param p pointer to a block allocated by `small_alloc`
+ */
+static void small_free(void * p)
+{
+    uint16_t id = ((uint8_t *)p - small_mem) / SMALL_PAGE_SIZE;
+    small_page_t * page = &small_pages[id];
+    uint32_t block_size = SMALL_CLASS_MIN << page->cls;
+    bool was_full = page->used_cnt == SMALL_PAGE_SIZE / block_size;
+
+#if LV_MEM_ADD_JUNK
+    lv_memset(p, 0xbb, block_size);
+#endif
+
+    *(void **)p = page->free_head;
+    page->free_head = p;
+    page->used_cnt--;
+    small_used_size -= block_size;
+
+    if(page->used_cnt == 0) {
+        /*Let any size class use the empty page*/
+        if(!was_full) small_page_unlink(&small_class_pages[page->cls], id);
+        small_page_link(&small_empty_pages, id);
+    }
+    else if(was_full) {
+        small_page_link(&small_class_pages[page->cls], id);
+    }
+}
+
+/**
+ * Tell whether a block is allocated from the small pools
+ * @param p pointer to an allocated block
+ * @return true: `p` is in the small pools
+ */
+static bool small_is_pool_block(const void * p)
+{
+    if(small_mem == NULL) return false;
+    return (const uint8_t *)p >= small_mem && (const uint8_t *)p < small_mem + SMALL_PAGE_CNT * SMALL_PAGE_SIZE;
+}
+
+/**
+ * Get the size of a block of the small pools
+ * @param p pointer to a block allocated by `small_alloc`
+ * @return the size of the block's size class
+ */
+static uint32_t small_block_size(const void * p)
+{
+    uint32_t id = ((const uint8_t *)p - small_mem) / SMALL_PAGE_SIZE;
+    return SMALL_CLASS_MIN << small_pages[id].cls;
+}
+
+/**
+ * Add a page to the beginning of a page list
+ * @param head pointer to the first page ID of a list
+ * @param id ID of the page to add
+ */
+static void small_page_link(uint16_t * head, uint16_t id)
+{
+    small_pages[id].prev = SMALL_PAGE_NONE;
+    small_pages[id].next = *head;
+    if(*head != SMALL_PAGE_NONE) small_pages[*head].prev = id;
+    *head = id;
+}
+
+/**
+ * Remove a page from a page list
+ * @param head pointer to the first page ID of the list
+ * @param id ID of the page to remove
+ */
+static void small_page_unlink(uint16_t * head, uint16_t id)
+{
+    small_page_t * page = &small_pages[id];
+    if(page->prev != SMALL_PAGE_NONE) small_pages[page->prev].next = page->next;
+    else *head = page->next;
+    if(page->next != SMALL_PAGE_NONE) small_pages[page->next].prev = page->prev;
+}
+#endif
+
+#if ATOMIC_FREE
+/**
+ * Free the blocks given to `lv_mem_free_atomic()` since the last call
+ */
+static void atomic_free_flush(void)
+{
+    if(atomic_load_explicit(&atomic_free_head, memory_order_relaxed) == NULL) return;
+
+    void * p = atomic_exchange_explicit(&atomic_free_head, NULL, memory_order_acquire);
+    while(p) {
+        void * next = *(void **)p;
+        lv_mem_free(p);
+        p = next;
+    }
+}
 #endif
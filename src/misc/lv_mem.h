@@ -86,6 +86,17 @@ void * lv_mem_alloc(size_t size);
  */
 void lv_mem_free(void * data);
 
+#if LV_MEM_CUSTOM == 0
+#if LV_MEM_ATOMIC_FREE
+/**
+ * Free an allocated data from any thread without locking.
+ * The memory is given back in the next `lv_mem_alloc()` or `lv_mem_monitor()` in the thread of LVGL.
+ * @param data pointer to an allocated memory
+ */
+void lv_mem_free_atomic(void * data);
+#endif
+#endif
+
 /**
  * Reallocate a memory with a new size. The old content will be kept.
  * @param data pointer to an allocated memory.
@@ -8,6 +8,9 @@
  *********************/
 #include "lv_style.h"
 #include "../misc/lv_mem.h"
+#if LV_USE_THEME_COMPILE
+#include "../core/lv_theme.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -60,6 +63,10 @@ void lv_style_reset(lv_style_t * style)
         return;
     }
 
+#if LV_USE_THEME_COMPILE
+    _lv_theme_style_reset(style);
+#endif
+
     if(style->prop_cnt > 1) lv_mem_free(style->v_p.values_and_props);
     lv_memset_00(style, sizeof(lv_style_t));
 #if LV_USE_ASSERT_STYLE
@@ -290,6 +297,32 @@ uint8_t _lv_style_get_prop_group(lv_style_prop_t prop)
     if(group > 7) group = 7;    /*The MSB marks all the custom properties*/
     return (uint8_t)group;
 }
+
+uint32_t _lv_style_get_prop_cnt(const lv_style_t * style)
+{
+    if(style->is_const == 0) return style->prop_cnt;
+
+    uint32_t cnt = 0;
+    while(style->v_p.const_props[cnt].prop != LV_STYLE_PROP_INV) cnt++;
+    return cnt;
+}
+
+void _lv_style_get_prop_at(const lv_style_t * style, uint32_t idx, lv_style_const_prop_t * res)
+{
+    if(style->is_const) {
+        *res = style->v_p.const_props[idx];
+    }
+    else if(style->prop_cnt == 1) {
+        res->prop = style->prop1;
+        res->value = style->v_p.value1;
+    }
+    else {
+        const lv_style_value_t * values = (const lv_style_value_t *)style->v_p.values_and_props;
+        const uint16_t * props = (const uint16_t *)(style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t));
+        res->prop = props[idx];
+        res->value = values[idx];
+    }
+}
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -420,6 +420,21 @@ bool lv_style_is_empty(const lv_style_t * style);
  */
 uint8_t _lv_style_get_prop_group(lv_style_prop_t prop);
 
+/**
+ * Get the number of properties in a style. Constant styles are supported too.
+ * @param style pointer to a style
+ * @return number of properties
+ */
+uint32_t _lv_style_get_prop_cnt(const lv_style_t * style);
+
+/**
+ * Get a property of a style by its index. Constant styles are supported too.
+ * @param style pointer to a style
+ * @param idx index of the property. 0 .. `_lv_style_get_prop_cnt(style) - 1`
+ * @param res store the property and its value here
+ */
+void _lv_style_get_prop_at(const lv_style_t * style, uint32_t idx, lv_style_const_prop_t * res);
+
 #include "lv_style_gen.h"
 
 static inline void lv_style_set_pad_all(lv_style_t * style, lv_coord_t value) {
@@ -34,6 +34,7 @@ static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
 static bool timer_deleted;
 static bool timer_created;
+static void (*handler_start_cb)(void);
 
 /**********************
  *      MACROS
@@ -54,11 +55,21 @@ static bool timer_created;
 void _lv_timer_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+    handler_start_cb = NULL;
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
 }
 
+/**
+ * Set a function to call at the beginning of every `lv_timer_handler()` call, before the timers run.
+ * @param cb the function to call or NULL
+ */
+void _lv_timer_set_handler_start_cb(void (*cb)(void))
+{
+    handler_start_cb = cb;
+}
+
 /**
  * Call it  periodically to handle lv_timers.
  * @return the time after which it must be called again
@@ -83,6 +94,8 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
 
     uint32_t handler_start = lv_tick_get();
 
+    if(handler_start_cb) handler_start_cb();
+
     if(handler_start == 0) {
         static uint32_t run_cnt = 0;
         run_cnt ++;
@@ -60,6 +60,13 @@ typedef struct _lv_timer_t {
  */
 void _lv_timer_core_init(void);
 
+/**
+ * Set a function to call at the beginning of every `lv_timer_handler()` call, before the timers run.
+ * Used by the higher level modules of the library. Cleared by `_lv_timer_core_init()`.
+ * @param cb    the function to call or NULL
+ */
+void _lv_timer_set_handler_start_cb(void (*cb)(void));
+
 //! @cond Doxygen_Suppress
 
 /**
@@ -375,6 +375,10 @@ typedef struct control_t
 
 	/* Head of free lists. */
 	block_header_t* blocks[FL_INDEX_COUNT][SL_INDEX_COUNT];
+
+	/* Statistics of the free lists, kept up to date on insert/remove. */
+	size_t free_size;
+	size_t free_cnt;
 } control_t;
 
 /* A type used for casting when doing pointer arithmetic. */
@@ -604,6 +608,9 @@ static void remove_free_block(control_t* control, block_header_t* block, int fl,
 	next->prev_free = prev;
 	prev->next_free = next;
 
+	control->free_size -= block_size(block);
+	control->free_cnt--;
+
 	/* If this block is the head of the free list, set new head. */
 	if (control->blocks[fl][sl] == block)
 	{
@@ -642,6 +649,9 @@ static void insert_free_block(control_t* control, block_header_t* block, int fl,
 	control->blocks[fl][sl] = block;
 	control->fl_bitmap |= (1U << fl);
 	control->sl_bitmap[fl] |= (1U << sl);
+
+	control->free_size += block_size(block);
+	control->free_cnt++;
 }
 
 /* Remove a given block from the free list. */
@@ -824,6 +834,8 @@ static void control_constructor(control_t* control)
 	control->block_null.prev_free = &control->block_null;
 
 	control->fl_bitmap = 0;
+	control->free_size = 0;
+	control->free_cnt = 0;
 	for (i = 0; i < FL_INDEX_COUNT; ++i)
 	{
 		control->sl_bitmap[i] = 0;
@@ -951,6 +963,37 @@ size_t lv_tlsf_block_size(void* ptr)
 	return size;
 }
 
+size_t lv_tlsf_free_size(lv_tlsf_t tlsf)
+{
+	const control_t* control = tlsf_cast(const control_t*, tlsf);
+	return control->free_size;
+}
+
+size_t lv_tlsf_free_cnt(lv_tlsf_t tlsf)
+{
+	const control_t* control = tlsf_cast(const control_t*, tlsf);
+	return control->free_cnt;
+}
+
+size_t lv_tlsf_free_biggest_size(lv_tlsf_t tlsf)
+{
+	const control_t* control = tlsf_cast(const control_t*, tlsf);
+	size_t biggest = 0;
+	if (control->fl_bitmap)
+	{
+		/* Only the list of the highest size class can contain the biggest block. */
+		const int fl = tlsf_fls(control->fl_bitmap);
+		const int sl = tlsf_fls(control->sl_bitmap[fl]);
+		const block_header_t* block = control->blocks[fl][sl];
+		while (block != &control->block_null)
+		{
+			if (block_size(block) > biggest) biggest = block_size(block);
+			block = block->next_free;
+		}
+	}
+	return biggest;
+}
+
 int lv_tlsf_check_pool(lv_pool_t pool)
 {
 	/* Check that the blocks are physically correct. */
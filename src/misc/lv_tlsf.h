@@ -71,6 +71,13 @@ void lv_tlsf_free(lv_tlsf_t tlsf, void* ptr);
 /* Returns internal block size, not original request size */
 size_t lv_tlsf_block_size(void* ptr);
 
+/* Statistics of the free blocks. The free size and count are kept up to date
+** on insert/remove, the biggest free block is searched in the list of the
+** highest non-empty size class. */
+size_t lv_tlsf_free_size(lv_tlsf_t tlsf);
+size_t lv_tlsf_free_cnt(lv_tlsf_t tlsf);
+size_t lv_tlsf_free_biggest_size(lv_tlsf_t tlsf);
+
 /* Overheads/limits of internal structures. */
 size_t lv_tlsf_size(void);
 size_t lv_tlsf_align_size(void);
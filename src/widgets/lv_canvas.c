@@ -28,6 +28,12 @@
  **********************/
 static void lv_canvas_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_canvas_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static lv_res_t target_init(lv_obj_t * obj, lv_refr_target_t * target);
+static lv_refr_target_t * draw_prepare(lv_obj_t * obj, lv_refr_target_t * tmp, bool antialias);
+static void draw_finish(lv_obj_t * obj, lv_refr_target_t * target, const lv_area_t * area);
+static bool is_chroma_key(const lv_img_dsc_t * dsc, lv_color_t color);
+static void get_rect_draw_area(const lv_area_t * coords, const lv_draw_rect_dsc_t * dsc, lv_area_t * res);
+static void invalidate_area(lv_obj_t * obj, const lv_area_t * area);
 
 /**********************
  *  STATIC VARIABLES
@@ -72,6 +78,12 @@ void lv_canvas_set_buffer(lv_obj_t * obj, void * buf, lv_coord_t w, lv_coord_t h
     canvas->dsc.data      = buf;
 
     lv_img_set_src(obj, &canvas->dsc);
+
+    /*Keep drawing to the new buffer if a batch is in progress*/
+    if(canvas->target && target_init(obj, canvas->target) != LV_RES_OK) {
+        lv_mem_free(canvas->target);
+        canvas->target = NULL;
+    }
 }
 
 void lv_canvas_set_px(lv_obj_t * obj, lv_coord_t x, lv_coord_t y, lv_color_t c)
@@ -81,7 +93,10 @@ void lv_canvas_set_px(lv_obj_t * obj, lv_coord_t x, lv_coord_t y, lv_color_t c)
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
 
     lv_img_buf_set_px_color(&canvas->dsc, x, y, c);
-    lv_obj_invalidate(obj);
+
+    lv_area_t a;
+    lv_area_set(&a, x, y, x, y);
+    invalidate_area(obj, &a);
 }
 
 void lv_canvas_set_palette(lv_obj_t * obj, uint8_t id, lv_color_t c)
@@ -91,7 +106,7 @@ void lv_canvas_set_palette(lv_obj_t * obj, uint8_t id, lv_color_t c)
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
 
     lv_img_buf_set_palette(&canvas->dsc, id, c);
-    lv_obj_invalidate(obj);
+    invalidate_area(obj, NULL);
 }
 
 /*=====================
@@ -120,6 +135,43 @@ lv_img_dsc_t * lv_canvas_get_img(lv_obj_t * obj)
  * Other functions
  *====================*/
 
+void lv_canvas_draw_begin(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
+    if(canvas->target) {
+        LV_LOG_WARN("lv_canvas_draw_begin: already started");
+        return;
+    }
+
+    /*If the target can't be created the draw functions create their own*/
+    canvas->target = lv_mem_alloc(sizeof(lv_refr_target_t));
+    LV_ASSERT_MALLOC(canvas->target);
+    if(canvas->target == NULL) return;
+
+    if(target_init(obj, canvas->target) != LV_RES_OK) {
+        lv_mem_free(canvas->target);
+        canvas->target = NULL;
+    }
+}
+
+void lv_canvas_draw_end(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
+    if(canvas->target) {
+        lv_mem_free(canvas->target);
+        canvas->target = NULL;
+    }
+
+    if(canvas->inv_area_valid) {
+        canvas->inv_area_valid = 0;
+        invalidate_area(obj, &canvas->inv_area);
+    }
+}
+
 void lv_canvas_copy_buf(lv_obj_t * obj, const void * to_copy, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
@@ -141,6 +193,10 @@ void lv_canvas_copy_buf(lv_obj_t * obj, const void * to_copy, lv_coord_t x, lv_c
         px += canvas->dsc.header.w * px_size;
         to_copy8 += w * px_size;
     }
+
+    lv_area_t a;
+    lv_area_set(&a, x, y, x + w - 1, y + h - 1);
+    invalidate_area(obj, &a);
 }
 
 void lv_canvas_transform(lv_obj_t * obj, lv_img_dsc_t * img, int16_t angle, uint16_t zoom, lv_coord_t offset_x,
@@ -231,7 +287,7 @@ void lv_canvas_transform(lv_obj_t * obj, lv_img_dsc_t * img, int16_t angle, uint
         }
     }
 
-    lv_obj_invalidate(obj);
+    invalidate_area(obj, NULL);
 #else
     LV_UNUSED(obj);
     LV_UNUSED(img);
@@ -269,109 +325,10 @@ void lv_canvas_blur_hor(lv_obj_t * obj, const lv_area_t * area, uint16_t r)
         a.y2 = canvas->dsc.header.h - 1;
     }
 
-    lv_color_t color = lv_obj_get_style_img_recolor(obj, LV_PART_MAIN);
-
-    uint16_t r_back = r / 2;
-    uint16_t r_front = r / 2;
-
-    if((r & 0x1) == 0) r_back--;
-
-    bool has_alpha = lv_img_cf_has_alpha(canvas->dsc.header.cf);
-
-    lv_coord_t line_w = lv_img_buf_get_img_size(canvas->dsc.header.w, 1, canvas->dsc.header.cf);
-    uint8_t * line_buf = lv_mem_buf_get(line_w);
-
-    lv_img_dsc_t line_img;
-    line_img.data = line_buf;
-    line_img.header.always_zero = 0;
-    line_img.header.w = canvas->dsc.header.w;
-    line_img.header.h = 1;
-    line_img.header.cf = canvas->dsc.header.cf;
-
-    lv_coord_t x;
-    lv_coord_t y;
-    lv_coord_t x_safe;
-
-    for(y = a.y1; y <= a.y2; y++) {
-        uint32_t asum = 0;
-        uint32_t rsum = 0;
-        uint32_t gsum = 0;
-        uint32_t bsum = 0;
-
-        lv_color_t c;
-        lv_opa_t opa = LV_OPA_TRANSP;
-        lv_memcpy(line_buf, &canvas->dsc.data[y * line_w], line_w);
-
-        for(x = a.x1 - r_back; x <= a.x1 + r_front; x++) {
-            x_safe = x < 0 ? 0 : x;
-            x_safe = x_safe > canvas->dsc.header.w - 1 ? canvas->dsc.header.w - 1 : x_safe;
-
-            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
-
-            rsum += c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum += (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum += c.ch.green;
-#endif
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-
-        /*Just to indicate that the px is visible*/
-        if(has_alpha == false) asum = LV_OPA_COVER;
-
-        for(x = a.x1; x <= a.x2; x++) {
-
-            if(asum) {
-                c.ch.red = rsum / r;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-                uint8_t gtmp = gsum / r;
-                c.ch.green_h = gtmp >> 3;
-                c.ch.green_l = gtmp & 0x7;
-#else
-                c.ch.green = gsum / r;
-#endif
-                c.ch.blue = bsum / r;
-                if(has_alpha) opa = asum / r;
-
-                lv_img_buf_set_px_color(&canvas->dsc, x, y, c);
-            }
-            if(has_alpha) lv_img_buf_set_px_alpha(&canvas->dsc, x, y, opa);
-
-            x_safe = x - r_back;
-            x_safe = x_safe < 0 ? 0 : x_safe;
-            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
-
-            rsum -= c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum -= (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum -= c.ch.green;
-#endif
-            bsum -= c.ch.blue;
-            if(has_alpha) asum -= opa;
-
-            x_safe = x + 1 + r_front;
-            x_safe = x_safe > canvas->dsc.header.w - 1 ? canvas->dsc.header.w - 1 : x_safe;
-            c = lv_img_buf_get_px_color(&line_img, x_safe, 0, lv_color_white());
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, x_safe, 0);
-
-            rsum += c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum += (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum += c.ch.green;
-#endif
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-    }
-    lv_obj_invalidate(obj);
+    /*The window of the blur is `r` pixels wide*/
+    _lv_img_filter_box_blur_size(&canvas->dsc, &a, r, 0);
 
-    lv_mem_buf_release(line_buf);
+    invalidate_area(obj, &a);
 }
 
 void lv_canvas_blur_ver(lv_obj_t * obj, const lv_area_t * area, uint16_t r)
@@ -397,114 +354,10 @@ void lv_canvas_blur_ver(lv_obj_t * obj, const lv_area_t * area, uint16_t r)
         a.y2 = canvas->dsc.header.h - 1;
     }
 
-    lv_color_t color = lv_obj_get_style_img_recolor(obj, LV_PART_MAIN);
-
-    uint16_t r_back = r / 2;
-    uint16_t r_front = r / 2;
-
-    if((r & 0x1) == 0) r_back--;
-
-    bool has_alpha = lv_img_cf_has_alpha(canvas->dsc.header.cf);
-    lv_coord_t col_w = lv_img_buf_get_img_size(1, canvas->dsc.header.h, canvas->dsc.header.cf);
-    uint8_t * col_buf = lv_mem_buf_get(col_w);
-    lv_img_dsc_t line_img;
-
-    line_img.data = col_buf;
-    line_img.header.always_zero = 0;
-    line_img.header.w = 1;
-    line_img.header.h = canvas->dsc.header.h;
-    line_img.header.cf = canvas->dsc.header.cf;
-
-    lv_coord_t x;
-    lv_coord_t y;
-    lv_coord_t y_safe;
-
-    for(x = a.x1; x <= a.x2; x++) {
-        uint32_t asum = 0;
-        uint32_t rsum = 0;
-        uint32_t gsum = 0;
-        uint32_t bsum = 0;
-
-        lv_color_t c;
-        lv_opa_t opa = LV_OPA_COVER;
-
-        for(y = a.y1 - r_back; y <= a.y1 + r_front; y++) {
-            y_safe = y < 0 ? 0 : y;
-            y_safe = y_safe > canvas->dsc.header.h - 1 ? canvas->dsc.header.h - 1 : y_safe;
-
-            c = lv_img_buf_get_px_color(&canvas->dsc, x, y_safe, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&canvas->dsc, x, y_safe);
-
-            lv_img_buf_set_px_color(&line_img, 0, y_safe, c);
-            if(has_alpha) lv_img_buf_set_px_alpha(&line_img, 0, y_safe, opa);
-
-            rsum += c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum += (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum += c.ch.green;
-#endif
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-
-        /*Just to indicate that the px is visible*/
-        if(has_alpha == false) asum = LV_OPA_COVER;
-
-        for(y = a.y1; y <= a.y2; y++) {
-            if(asum) {
-                c.ch.red = rsum / r;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-                uint8_t gtmp = gsum / r;
-                c.ch.green_h = gtmp >> 3;
-                c.ch.green_l = gtmp & 0x7;
-#else
-                c.ch.green = gsum / r;
-#endif
-                c.ch.blue = bsum / r;
-                if(has_alpha) opa = asum / r;
+    /*The window of the blur is `r` pixels high*/
+    _lv_img_filter_box_blur_size(&canvas->dsc, &a, 0, r);
 
-                lv_img_buf_set_px_color(&canvas->dsc, x, y, c);
-            }
-            if(has_alpha) lv_img_buf_set_px_alpha(&canvas->dsc, x, y, opa);
-
-            y_safe = y - r_back;
-            y_safe = y_safe < 0 ? 0 : y_safe;
-            c = lv_img_buf_get_px_color(&line_img, 0, y_safe, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&line_img, 0, y_safe);
-
-            rsum -= c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum -= (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum -= c.ch.green;
-#endif
-            bsum -= c.ch.blue;
-            if(has_alpha) asum -= opa;
-
-            y_safe = y + 1 + r_front;
-            y_safe = y_safe > canvas->dsc.header.h - 1 ? canvas->dsc.header.h - 1 : y_safe;
-
-            c = lv_img_buf_get_px_color(&canvas->dsc, x, y_safe, color);
-            if(has_alpha) opa = lv_img_buf_get_px_alpha(&canvas->dsc, x, y_safe);
-
-            lv_img_buf_set_px_color(&line_img, 0, y_safe, c);
-            if(has_alpha) lv_img_buf_set_px_alpha(&line_img, 0, y_safe, opa);
-
-            rsum += c.ch.red;
-#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
-            gsum += (c.ch.green_h << 3) + c.ch.green_l;
-#else
-            gsum += c.ch.green;
-#endif
-            bsum += c.ch.blue;
-            if(has_alpha) asum += opa;
-        }
-    }
-
-    lv_obj_invalidate(obj);
-
-    lv_mem_buf_release(col_buf);
+    invalidate_area(obj, &a);
 }
 
 void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color, lv_opa_t opa)
@@ -533,7 +386,7 @@ void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color, lv_opa_t opa)
         }
     }
 
-    lv_obj_invalidate(canvas);
+    invalidate_area(canvas, NULL);
 }
 
 void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h,
@@ -548,53 +401,22 @@ void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
     lv_area_t coords;
     coords.x1 = x;
     coords.y1 = y;
     coords.x2 = x + w - 1;
     coords.y2 = y + h - 1;
 
-    lv_disp_t disp;
-    /*Allocate the fake driver on the stack as the entire display doesn't outlive this function*/
-    lv_disp_drv_t driver;
-    lv_memset_00(&disp, sizeof(lv_disp_t));
-    disp.driver = &driver;
-
-    lv_disp_draw_buf_t draw_buf;
-    lv_disp_draw_buf_init(&draw_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&draw_buf.area, &mask);
-
-    lv_disp_drv_init(disp.driver);
-
-    disp.driver->draw_buf = &draw_buf;
-    disp.driver->hor_res = dsc->header.w;
-    disp.driver->ver_res = dsc->header.h;
-
-    lv_disp_drv_use_generic_set_px_cb(disp.driver, dsc->header.cf);
-
     /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_CHROMA_KEY;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       draw_dsc->bg_color.full == ctransp.full) {
-        disp.driver->antialiasing = 0;
-    }
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
-
-    lv_draw_rect(&coords, &mask, draw_dsc);
+    lv_refr_target_t tmp;
+    lv_refr_target_t * target = draw_prepare(canvas, &tmp, !is_chroma_key(dsc, draw_dsc->bg_color));
+    if(target == NULL) return;
 
-    _lv_refr_set_disp_refreshing(refr_ori);
+    lv_draw_rect(&coords, &target->draw_buf.area, draw_dsc);
 
-    lv_obj_invalidate(canvas);
+    lv_area_t draw_area;
+    get_rect_draw_area(&coords, draw_dsc, &draw_area);
+    draw_finish(canvas, target, &draw_area);
 }
 
 void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
@@ -609,46 +431,19 @@ void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
     lv_area_t coords;
     coords.x1 = x;
     coords.y1 = y;
     coords.x2 = x + max_w - 1;
     coords.y2 = dsc->header.h - 1;
 
-    lv_disp_t disp;
-    /*Allocate the fake driver on the stack as the entire display doesn't outlive this function*/
-    lv_disp_drv_t driver;
-    lv_memset_00(&disp, sizeof(lv_disp_t));
-    disp.driver = &driver;
-
-    lv_disp_draw_buf_t draw_buf;
-    lv_disp_draw_buf_init(&draw_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&draw_buf.area, &mask);
-
-    lv_disp_drv_init(disp.driver);
-
-    disp.driver->draw_buf = &draw_buf;
-    disp.driver->hor_res = dsc->header.w;
-    disp.driver->ver_res = dsc->header.h;
-
-    lv_disp_drv_use_generic_set_px_cb(disp.driver, dsc->header.cf);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
-
-    lv_draw_label(&coords, &mask, draw_dsc, txt, NULL);
+    lv_refr_target_t tmp;
+    lv_refr_target_t * target = draw_prepare(canvas, &tmp, true);
+    if(target == NULL) return;
 
-    _lv_refr_set_disp_refreshing(refr_ori);
+    lv_draw_label(&coords, &target->draw_buf.area, draw_dsc, txt, NULL);
 
-    lv_obj_invalidate(canvas);
+    draw_finish(canvas, target, &coords);
 }
 
 void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const void * src,
@@ -663,14 +458,6 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
     lv_img_header_t header;
     lv_res_t res = lv_img_decoder_get_info(src, &header);
     if(res != LV_RES_OK) {
@@ -684,32 +471,22 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
     coords.x2 = x + header.w - 1;
     coords.y2 = y + header.h - 1;
 
-    lv_disp_t disp;
-    /*Allocate the fake driver on the stack as the entire display doesn't outlive this function*/
-    lv_disp_drv_t driver;
-    lv_memset_00(&disp, sizeof(lv_disp_t));
-    disp.driver = &driver;
-
-    lv_disp_draw_buf_t draw_buf;
-    lv_disp_draw_buf_init(&draw_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&draw_buf.area, &mask);
-
-    lv_disp_drv_init(disp.driver);
-
-    disp.driver->draw_buf = &draw_buf;
-    disp.driver->hor_res = dsc->header.w;
-    disp.driver->ver_res = dsc->header.h;
-
-    lv_disp_drv_use_generic_set_px_cb(disp.driver, dsc->header.cf);
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
+    lv_refr_target_t tmp;
+    lv_refr_target_t * target = draw_prepare(canvas, &tmp, true);
+    if(target == NULL) return;
 
-    lv_draw_img(&coords, &mask, src, draw_dsc);
+    lv_draw_img(&coords, &target->draw_buf.area, src, draw_dsc);
 
-    _lv_refr_set_disp_refreshing(refr_ori);
-
-    lv_obj_invalidate(canvas);
+    lv_area_t draw_area;
+    if(draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
+        _lv_img_buf_get_transformed_area(&draw_area, header.w, header.h, draw_dsc->angle, draw_dsc->zoom,
+                                         &draw_dsc->pivot);
+        lv_area_move(&draw_area, x, y);
+    }
+    else {
+        lv_area_copy(&draw_area, &coords);
+    }
+    draw_finish(canvas, target, &draw_area);
 }
 
 void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t points[], uint32_t point_cnt,
@@ -723,50 +500,26 @@ void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t points[], uint32_t
         LV_LOG_WARN("lv_canvas_draw_line: can't draw to LV_IMG_CF_INDEXED canvas");
         return;
     }
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
-    lv_disp_t disp;
-    /*Allocate the fake driver on the stack as the entire display doesn't outlive this function*/
-    lv_disp_drv_t driver;
-    lv_memset_00(&disp, sizeof(lv_disp_t));
-    disp.driver = &driver;
-
-    lv_disp_draw_buf_t draw_buf;
-    lv_disp_draw_buf_init(&draw_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&draw_buf.area, &mask);
-
-    lv_disp_drv_init(disp.driver);
-
-    disp.driver->draw_buf = &draw_buf;
-    disp.driver->hor_res = dsc->header.w;
-    disp.driver->ver_res = dsc->header.h;
-
-    lv_disp_drv_use_generic_set_px_cb(disp.driver, dsc->header.cf);
+    if(point_cnt < 2) return;
 
     /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_CHROMA_KEY;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       draw_dsc->color.full == ctransp.full) {
-        disp.driver->antialiasing = 0;
-    }
+    lv_refr_target_t tmp;
+    lv_refr_target_t * target = draw_prepare(canvas, &tmp, !is_chroma_key(dsc, draw_dsc->color));
+    if(target == NULL) return;
 
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
+    lv_draw_polyline(points, point_cnt, &target->draw_buf.area, draw_dsc);
 
+    lv_area_t draw_area;
+    lv_area_set(&draw_area, points[0].x, points[0].y, points[0].x, points[0].y);
     uint32_t i;
-    for(i = 0; i < point_cnt - 1; i++) {
-        lv_draw_line(&points[i], &points[i + 1], &mask, draw_dsc);
+    for(i = 1; i < point_cnt; i++) {
+        draw_area.x1 = LV_MIN(draw_area.x1, points[i].x);
+        draw_area.y1 = LV_MIN(draw_area.y1, points[i].y);
+        draw_area.x2 = LV_MAX(draw_area.x2, points[i].x);
+        draw_area.y2 = LV_MAX(draw_area.y2, points[i].y);
     }
-
-    _lv_refr_set_disp_refreshing(refr_ori);
-
-    lv_obj_invalidate(canvas);
+    lv_area_increase(&draw_area, draw_dsc->width / 2 + 1, draw_dsc->width / 2 + 1);
+    draw_finish(canvas, target, &draw_area);
 }
 
 void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t points[], uint32_t point_cnt,
@@ -780,48 +533,27 @@ void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t points[], uint32
         LV_LOG_WARN("lv_canvas_draw_polygon: can't draw to LV_IMG_CF_INDEXED canvas");
         return;
     }
-
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
-    lv_disp_t disp;
-    /*Allocate the fake driver on the stack as the entire display doesn't outlive this function*/
-    lv_disp_drv_t driver;
-    lv_memset_00(&disp, sizeof(lv_disp_t));
-    disp.driver = &driver;
-
-    lv_disp_draw_buf_t draw_buf;
-    lv_disp_draw_buf_init(&draw_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&draw_buf.area, &mask);
-
-    lv_disp_drv_init(disp.driver);
-
-    disp.driver->draw_buf = &draw_buf;
-    disp.driver->hor_res = dsc->header.w;
-    disp.driver->ver_res = dsc->header.h;
-
-    lv_disp_drv_use_generic_set_px_cb(disp.driver, dsc->header.cf);
+    if(point_cnt < 3) return;
 
     /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_CHROMA_KEY;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       draw_dsc->bg_color.full == ctransp.full) {
-        disp.driver->antialiasing = 0;
-    }
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
-
-    lv_draw_polygon(points, point_cnt, &mask, draw_dsc);
+    lv_refr_target_t tmp;
+    lv_refr_target_t * target = draw_prepare(canvas, &tmp, !is_chroma_key(dsc, draw_dsc->bg_color));
+    if(target == NULL) return;
 
-    _lv_refr_set_disp_refreshing(refr_ori);
+    lv_draw_polygon(points, point_cnt, &target->draw_buf.area, draw_dsc);
 
-    lv_obj_invalidate(canvas);
+    lv_area_t coords;
+    lv_area_set(&coords, points[0].x, points[0].y, points[0].x, points[0].y);
+    uint32_t i;
+    for(i = 1; i < point_cnt; i++) {
+        coords.x1 = LV_MIN(coords.x1, points[i].x);
+        coords.y1 = LV_MIN(coords.y1, points[i].y);
+        coords.x2 = LV_MAX(coords.x2, points[i].x);
+        coords.y2 = LV_MAX(coords.y2, points[i].y);
+    }
+    lv_area_t draw_area;
+    get_rect_draw_area(&coords, draw_dsc, &draw_area);
+    draw_finish(canvas, target, &draw_area);
 }
 
 void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_t r, int32_t start_angle,
@@ -837,47 +569,16 @@ void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_
         return;
     }
 
-    /*Create a dummy display to fool the lv_draw function.
-     *It will think it draws to real screen.*/
-    lv_area_t mask;
-    mask.x1 = 0;
-    mask.x2 = dsc->header.w - 1;
-    mask.y1 = 0;
-    mask.y2 = dsc->header.h - 1;
-
-    lv_disp_t disp;
-    /*Allocate the fake driver on the stack as the entire display doesn't outlive this function*/
-    lv_disp_drv_t driver;
-    lv_memset_00(&disp, sizeof(lv_disp_t));
-    disp.driver = &driver;
-
-    lv_disp_draw_buf_t draw_buf;
-    lv_disp_draw_buf_init(&draw_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
-    lv_area_copy(&draw_buf.area, &mask);
-
-    lv_disp_drv_init(disp.driver);
-
-    disp.driver->draw_buf = &draw_buf;
-    disp.driver->hor_res = dsc->header.w;
-    disp.driver->ver_res = dsc->header.h;
-
-    lv_disp_drv_use_generic_set_px_cb(disp.driver, dsc->header.cf);
-
     /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
-    lv_color_t ctransp = LV_COLOR_CHROMA_KEY;
-    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
-       draw_dsc->color.full == ctransp.full) {
-        disp.driver->antialiasing = 0;
-    }
-
-    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
-    _lv_refr_set_disp_refreshing(&disp);
+    lv_refr_target_t tmp;
+    lv_refr_target_t * target = draw_prepare(canvas, &tmp, !is_chroma_key(dsc, draw_dsc->color));
+    if(target == NULL) return;
 
-    lv_draw_arc(x, y, r,  start_angle, end_angle, &mask, draw_dsc);
+    lv_draw_arc(x, y, r,  start_angle, end_angle, &target->draw_buf.area, draw_dsc);
 
-    _lv_refr_set_disp_refreshing(refr_ori);
-
-    lv_obj_invalidate(canvas);
+    lv_area_t draw_area;
+    lv_area_set(&draw_area, x - r, y - r, x + r, y + r);
+    draw_finish(canvas, target, &draw_area);
 #else
     LV_UNUSED(canvas);
     LV_UNUSED(x);
@@ -920,6 +621,134 @@ static void lv_canvas_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
     lv_img_cache_invalidate_src(&canvas->dsc);
+
+    if(canvas->target) {
+        lv_mem_free(canvas->target);
+        canvas->target = NULL;
+    }
+}
+
+/**
+ * Initialize a render target on the buffer of the canvas.
+ * `LV_IMG_CF_TRUE_COLOR` canvases are drawn with the normal blend functions, not pixel by pixel.
+ * @param obj pointer to a canvas object
+ * @param target pointer to a render target to initialize
+ * @return LV_RES_OK: initialized; LV_RES_INV: the color format of the canvas is not supported
+ */
+static lv_res_t target_init(lv_obj_t * obj, lv_refr_target_t * target)
+{
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
+
+    lv_area_t buf_area;
+    lv_area_set(&buf_area, 0, 0, canvas->dsc.header.w - 1, canvas->dsc.header.h - 1);
+    lv_res_t res = lv_refr_target_init(target, (void *)canvas->dsc.data, &buf_area, canvas->dsc.header.cf);
+    if(res != LV_RES_OK) return res;
+
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(disp) target->driver.dpi = disp->driver->dpi;
+
+    return LV_RES_OK;
+}
+
+/**
+ * Get the render target for a draw call and redirect the drawing into it
+ * @param obj pointer to a canvas object
+ * @param tmp a render target to initialize if there is no batch in progress
+ * @param antialias false: disable anti-aliasing for this draw call
+ * @return the render target or NULL on error
+ */
+static lv_refr_target_t * draw_prepare(lv_obj_t * obj, lv_refr_target_t * tmp, bool antialias)
+{
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
+    lv_refr_target_t * target = canvas->target;
+    if(target == NULL) {
+        if(target_init(obj, tmp) != LV_RES_OK) return NULL;
+        target = tmp;
+    }
+
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    target->driver.antialiasing = antialias && disp && disp->driver->antialiasing ? 1 : 0;
+
+    lv_refr_target_begin(target);
+    return target;
+}
+
+/**
+ * Restore the drawing after a draw call and invalidate the changed area
+ * @param obj pointer to a canvas object
+ * @param target the render target returned by `draw_prepare`
+ * @param area the area changed by the draw call on the canvas
+ */
+static void draw_finish(lv_obj_t * obj, lv_refr_target_t * target, const lv_area_t * area)
+{
+    lv_refr_target_end(target);
+    invalidate_area(obj, area);
+}
+
+static bool is_chroma_key(const lv_img_dsc_t * dsc, lv_color_t color)
+{
+    lv_color_t ctransp = LV_COLOR_CHROMA_KEY;
+    return dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED && color.full == ctransp.full;
+}
+
+/**
+ * Get the area affected by drawing a rectangle, including its outline and shadow
+ * @param coords coordinates of the rectangle
+ * @param dsc the draw descriptor of the rectangle
+ * @param res store the result area here
+ */
+static void get_rect_draw_area(const lv_area_t * coords, const lv_draw_rect_dsc_t * dsc, lv_area_t * res)
+{
+    lv_coord_t ext = 0;
+    if(dsc->outline_width && dsc->outline_opa > LV_OPA_MIN) {
+        ext = LV_MAX(ext, dsc->outline_width + dsc->outline_pad);
+    }
+
+    if(dsc->shadow_width && dsc->shadow_opa > LV_OPA_MIN) {
+        lv_coord_t sh = dsc->shadow_width / 2 + 1 + dsc->shadow_spread;
+        sh += LV_MAX(LV_ABS(dsc->shadow_ofs_x), LV_ABS(dsc->shadow_ofs_y));
+        ext = LV_MAX(ext, sh);
+    }
+
+    lv_area_copy(res, coords);
+    lv_area_increase(res, ext, ext);
+}
+
+/**
+ * Invalidate an area of the canvas or save it for `lv_canvas_draw_end` if a batch is in progress
+ * @param obj pointer to a canvas object
+ * @param area the area relative to the canvas. NULL to invalidate the whole canvas.
+ */
+static void invalidate_area(lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_canvas_t * canvas = (lv_canvas_t *)obj;
+
+    lv_area_t a;
+    lv_area_t canvas_area;
+    lv_area_set(&canvas_area, 0, 0, canvas->dsc.header.w - 1, canvas->dsc.header.h - 1);
+    if(area == NULL) lv_area_copy(&a, &canvas_area);
+    else if(!_lv_area_intersect(&a, area, &canvas_area)) return;
+
+    if(canvas->target) {
+        if(canvas->inv_area_valid) _lv_area_join(&canvas->inv_area, &canvas->inv_area, &a);
+        else lv_area_copy(&canvas->inv_area, &a);
+        canvas->inv_area_valid = 1;
+        return;
+    }
+
+    /*The area can be mapped to the screen only if the canvas is drawn once at the object's coordinates*/
+    lv_img_t * img = (lv_img_t *)obj;
+    if(img->angle || img->zoom != LV_IMG_ZOOM_NONE || img->offset.x || img->offset.y ||
+       lv_obj_get_style_transform_angle(obj, LV_PART_MAIN) ||
+       lv_obj_get_style_transform_zoom(obj, LV_PART_MAIN) != LV_IMG_ZOOM_NONE ||
+       lv_obj_get_width(obj) != lv_area_get_width(&canvas_area) ||
+       lv_obj_get_height(obj) != lv_area_get_height(&canvas_area)) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    lv_area_move(&a, obj->coords.x1, obj->coords.y1);
+    lv_obj_invalidate_area(obj, &a);
 }
 
 #endif
@@ -20,6 +20,7 @@ extern "C" {
 #include "../core/lv_obj.h"
 #include "../widgets/lv_img.h"
 #include "../draw/lv_draw_img.h"
+#include "../core/lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -34,6 +35,9 @@ extern const lv_obj_class_t lv_canvas_class;
 typedef struct {
     lv_img_t img;
     lv_img_dsc_t dsc;
+    lv_refr_target_t * target;      /*Render target shared by the draw calls between `lv_canvas_draw_begin/end`*/
+    lv_area_t inv_area;             /*The area changed since `lv_canvas_draw_begin`*/
+    uint8_t inv_area_valid : 1;     /*1: `inv_area` is set*/
 } lv_canvas_t;
 
 /**********************
@@ -110,6 +114,20 @@ lv_img_dsc_t * lv_canvas_get_img(lv_obj_t * canvas);
  * Other functions
  *====================*/
 
+/**
+ * Start a batch of drawing on the canvas.
+ * The draw calls until `lv_canvas_draw_end` share one render target
+ * and only the union of the changed areas is invalidated at the end.
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_draw_begin(lv_obj_t * canvas);
+
+/**
+ * Finish a batch of drawing and invalidate the changed area
+ * @param canvas pointer to a canvas object
+ */
+void lv_canvas_draw_end(lv_obj_t * canvas);
+
 /**
  * Copy a buffer to the canvas
  * @param canvas pointer to a canvas object
@@ -26,7 +26,6 @@
 #define LV_LABEL_DEF_SCROLL_SPEED   (lv_disp_get_dpi(lv_obj_get_disp(obj)) / 3)
 #define LV_LABEL_SCROLL_DELAY       300
 #define LV_LABEL_DOT_END_INV 0xFFFFFFFF
-#define LV_LABEL_HINT_HEIGHT_LIMIT 1024 /*Enable "hint" to buffer info about labels larger than this. (Speed up drawing)*/
 
 /**********************
  *      TYPEDEFS
@@ -41,6 +40,12 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_main(lv_event_t * e);
 
 static void lv_label_refr_text(lv_obj_t * obj);
+static void lv_label_refr_size(lv_obj_t * obj);
+static lv_text_flag_t get_txt_flag(const lv_obj_t * obj);
+static void get_txt_size(const lv_obj_t * obj, lv_coord_t max_w, lv_text_flag_t flag, lv_point_t * size);
+#if LV_LABEL_LONG_TXT_HINT
+static const lv_draw_label_line_t * get_layout(const lv_obj_t * obj, lv_coord_t max_w, lv_text_flag_t flag);
+#endif
 static void lv_label_revert_dots(lv_obj_t * label);
 
 static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
@@ -104,8 +109,10 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
 
         _lv_txt_ap_proc(label->text, label->text);
 #else
-        label->text = lv_mem_realloc(label->text, strlen(label->text) + 1);
+        size_t len = strlen(label->text) + 1;
+        label->text = lv_mem_realloc(label->text, len);
 #endif
+        label->text_size = len;
 
         LV_ASSERT_MALLOC(label->text);
         if(label->text == NULL) return;
@@ -136,6 +143,7 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
         if(label->text == NULL) return;
         strcpy(label->text, text);
 #endif
+        label->text_size = len;
 
         /*Now the text is dynamically allocated*/
         label->static_txt = 0;
@@ -168,6 +176,7 @@ LV_FORMAT_ATTRIBUTE(2, 3) void lv_label_set_text_fmt(lv_obj_t * obj, const char
     label->text = _lv_txt_set_text_vfmt(fmt, args);
     va_end(args);
     label->static_txt = 0; /*Now the text is dynamically allocated*/
+    label->text_size = label->text ? strlen(label->text) + 1 : 0;
 
     lv_label_refr_text(obj);
 }
@@ -185,6 +194,7 @@ void lv_label_set_text_static(lv_obj_t * obj, const char * text)
     if(text != NULL) {
         label->static_txt = 1;
         label->text       = (char *)text;
+        label->text_size  = 0;
     }
 
     lv_label_refr_text(obj);
@@ -319,22 +329,38 @@ void lv_label_get_letter_pos(const lv_obj_t * obj, uint32_t char_id, lv_point_t
     lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
     lv_coord_t letter_height    = lv_font_get_line_height(font);
     lv_coord_t y             = 0;
-    lv_text_flag_t flag       = LV_TEXT_FLAG_NONE;
-
-    if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
-    if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
-    if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
+    lv_text_flag_t flag       = get_txt_flag(obj);
 
     uint32_t byte_id = _lv_txt_encoded_get_byte_id(txt, char_id);
 
-    /*Search the line of the index letter*/;
-    while(txt[new_line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
-        if(byte_id < new_line_start || txt[new_line_start] == '\0')
-            break; /*The line of 'index' letter begins at 'line_start'*/
+#if LV_LABEL_LONG_TXT_HINT
+    /*Find the line in the cached layout*/
+    const lv_draw_label_line_t * lines = get_layout(obj, max_w, flag);
+    if(lines) {
+        uint32_t line_cnt = label->hint.line_cnt;
+        uint32_t line_id = 0;
+        uint32_t max = line_cnt;
+        while(line_id + 1 < max) {
+            uint32_t mid = (line_id + max) / 2;
+            if(lines[mid].start <= byte_id) line_id = mid;
+            else max = mid;
+        }
+        line_start = lines[line_id].start;
+        new_line_start = lines[line_id + 1].start;
+        y = line_id * (letter_height + line_space);
+    }
+    else
+#endif
+    {
+        /*Search the line of the index letter*/;
+        while(txt[new_line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
 
-        y += letter_height + line_space;
-        line_start = new_line_start;
+            y += letter_height + line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*If the last character is line break then go to the next line*/
@@ -415,16 +441,24 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * obj, lv_point_t * pos_in)
     lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
     lv_coord_t letter_height    = lv_font_get_line_height(font);
     lv_coord_t y             = 0;
-    lv_text_flag_t flag       = LV_TEXT_FLAG_NONE;
+    lv_text_flag_t flag       = get_txt_flag(obj);
     uint32_t logical_pos;
     char * bidi_txt;
 
-    if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
-    if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
-    if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
-
     lv_text_align_t align = lv_obj_calculate_style_text_align(obj, LV_PART_MAIN, label->text);
 
+#if LV_LABEL_LONG_TXT_HINT
+    /*Jump to the line in the cached layout*/
+    const lv_draw_label_line_t * lines = get_layout(obj, max_w, flag);
+    if(lines && pos.y > letter_height) {
+        uint32_t line_id = (pos.y - letter_height + letter_height + line_space - 1) / (letter_height + line_space);
+        if(line_id > label->hint.line_cnt) line_id = label->hint.line_cnt;
+        line_start = lines[line_id].start;
+        new_line_start = line_start;
+        y = line_id * (letter_height + line_space);
+    }
+#endif
+
     /*Search the line of the index letter*/;
     while(txt[line_start] != '\0') {
         new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
@@ -537,11 +571,7 @@ bool lv_label_is_char_under_pos(const lv_obj_t * obj, lv_point_t * pos)
     lv_text_align_t align = lv_obj_calculate_style_text_align(obj, LV_PART_MAIN, label->text);
 
     lv_coord_t y             = 0;
-    lv_text_flag_t flag       = LV_TEXT_FLAG_NONE;
-
-    if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
-    if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
-    if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
+    lv_text_flag_t flag       = get_txt_flag(obj);
 
     /*Search the line of the index letter*/;
     while(txt[line_start] != '\0') {
@@ -644,16 +674,24 @@ void lv_label_ins_text(lv_obj_t * obj, uint32_t pos, const char * txt)
 
     lv_obj_invalidate(obj);
 
-    /*Allocate space for the new text*/
+    /*Allocate space for the new text. Reserve some more to insert the next texts without reallocation.*/
     size_t old_len = strlen(label->text);
     size_t ins_len = strlen(txt);
     size_t new_len = ins_len + old_len;
-    label->text        = lv_mem_realloc(label->text, new_len + 1);
-    LV_ASSERT_MALLOC(label->text);
-    if(label->text == NULL) return;
+    if(new_len + 1 > label->text_size) {
+        label->text_size = new_len + 1 + new_len / 4;
+        label->text = lv_mem_realloc(label->text, label->text_size);
+        LV_ASSERT_MALLOC(label->text);
+        if(label->text == NULL) return;
+    }
 
+    uint32_t byte_pos;
     if(pos == LV_LABEL_POS_LAST) {
         pos = _lv_txt_get_encoded_length(label->text);
+        byte_pos = old_len;
+    }
+    else {
+        byte_pos = _lv_txt_encoded_get_byte_id(label->text, pos);
     }
 
 #if LV_USE_BIDI
@@ -668,7 +706,24 @@ void lv_label_ins_text(lv_obj_t * obj, uint32_t pos, const char * txt)
 #else
     _lv_txt_ins(label->text, pos, txt);
 #endif
+
+#if LV_USE_ARABIC_PERSIAN_CHARS
+    /*The whole text needs to be processed again*/
+    LV_UNUSED(byte_pos);
     lv_label_set_text(obj, NULL);
+#elif LV_LABEL_LONG_TXT_HINT
+    /*Calculate only the lines of the changed paragraph again*/
+    if(label->long_mode != LV_LABEL_LONG_DOT) {
+        lv_draw_label_hint_edit(&label->hint, label->text, byte_pos, 0, ins_len);
+        lv_label_refr_size(obj);
+    }
+    else {
+        lv_label_refr_text(obj);
+    }
+#else
+    LV_UNUSED(byte_pos);
+    lv_label_refr_text(obj);
+#endif
 }
 
 void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
@@ -682,10 +737,23 @@ void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
     lv_obj_invalidate(obj);
 
     char * label_txt = lv_label_get_text(obj);
+
+#if LV_LABEL_LONG_TXT_HINT
+    uint32_t byte_pos = _lv_txt_encoded_get_byte_id(label_txt, pos);
+    uint32_t byte_len = _lv_txt_encoded_get_byte_id(&label_txt[byte_pos], cnt);
+#endif
+
     /*Delete the characters*/
     _lv_txt_cut(label_txt, pos, cnt);
 
-    /*Refresh the label*/
+    /*Refresh the label. Calculate only the lines of the changed paragraph again.*/
+#if LV_LABEL_LONG_TXT_HINT
+    if(label->long_mode != LV_LABEL_LONG_DOT) {
+        lv_draw_label_hint_edit(&label->hint, label_txt, byte_pos, byte_len, 0);
+        lv_label_refr_size(obj);
+        return;
+    }
+#endif
     lv_label_refr_text(obj);
 }
 
@@ -701,6 +769,7 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_t * label = (lv_label_t *)obj;
 
     label->text       = NULL;
+    label->text_size  = 0;
     label->static_txt = 0;
     label->recolor    = 0;
     label->dot_end    = LV_LABEL_DOT_END_INV;
@@ -709,9 +778,8 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->offset.y = 0;
 
 #if LV_LABEL_LONG_TXT_HINT
+    lv_memset_00(&label->hint, sizeof(lv_draw_label_hint_t));
     label->hint.line_start = -1;
-    label->hint.coord_y    = 0;
-    label->hint.y          = 0;
 #endif
 
 #if LV_LABEL_TEXT_SELECTION
@@ -737,6 +805,10 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
     if(!label->static_txt) lv_mem_free(label->text);
     label->text = NULL;
+
+#if LV_LABEL_LONG_TXT_HINT
+    lv_draw_label_hint_reset(&label->hint);
+#endif
 }
 
 static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -764,9 +836,6 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
     else if(code == LV_EVENT_GET_SELF_SIZE) {
         lv_point_t size;
         lv_label_t * label = (lv_label_t *)obj;
-        const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
-        lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
-        lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
         lv_text_flag_t flag = LV_TEXT_FLAG_NONE;
         if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
         if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
@@ -775,7 +844,7 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
         if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) w = LV_COORD_MAX;
         else w = lv_obj_get_content_width(obj);
 
-        lv_txt_get_size(&size, label->text, font, letter_space, line_space, w, flag);
+        get_txt_size(obj, w, flag, &size);
 
         lv_point_t * self_size = lv_event_get_param(e);
         self_size->x = LV_MAX(self_size->x, size.x);
@@ -796,10 +865,7 @@ static void draw_main(lv_event_t * e)
     lv_area_t txt_coords;
     lv_obj_get_content_coords(obj, &txt_coords);
 
-    lv_text_flag_t flag = LV_TEXT_FLAG_NONE;
-    if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
-    if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
-    if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
+    lv_text_flag_t flag = get_txt_flag(obj);
 
     lv_draw_label_dsc_t label_draw_dsc;
     lv_draw_label_dsc_init(&label_draw_dsc);
@@ -830,10 +896,8 @@ static void draw_main(lv_event_t * e)
         }
     }
 #if LV_LABEL_LONG_TXT_HINT
+    /*The hint caches the layout of the lines so it's used for every label*/
     lv_draw_label_hint_t * hint = &label->hint;
-    if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR || lv_area_get_height(&txt_coords) < LV_LABEL_HINT_HEIGHT_LIMIT)
-        hint = NULL;
-
 #else
     /*Just for compatibility*/
     lv_draw_label_hint_t * hint = NULL;
@@ -881,12 +945,23 @@ static void draw_main(lv_event_t * e)
  */
 static void lv_label_refr_text(lv_obj_t * obj)
 {
-    lv_label_t * label = (lv_label_t *)obj;
-    if(label->text == NULL) return;
 #if LV_LABEL_LONG_TXT_HINT
-    label->hint.line_start = -1; /*The hint is invalid if the text changes*/
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_draw_label_hint_reset(&label->hint); /*The hint is invalid if the text changes*/
 #endif
 
+    lv_label_refr_size(obj);
+}
+
+/**
+ * Refresh the size and the long mode of the label. The cached layout of the lines is kept.
+ * @param label pointer to a label object
+ */
+static void lv_label_refr_size(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    if(label->text == NULL) return;
+
     lv_area_t txt_coords;
     lv_obj_get_content_coords(obj, &txt_coords);
     lv_coord_t max_w         = lv_area_get_width(&txt_coords);
@@ -896,12 +971,7 @@ static void lv_label_refr_text(lv_obj_t * obj)
 
     /*Calc. the height and longest line*/
     lv_point_t size;
-    lv_text_flag_t flag = LV_TEXT_FLAG_NONE;
-    if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
-    if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
-    if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
-
-    lv_txt_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    get_txt_size(obj, max_w, get_txt_flag(obj), &size);
 
     lv_obj_refresh_self_size(obj);
 
@@ -1224,6 +1294,97 @@ static void lv_label_dot_tmp_free(lv_obj_t * obj)
 }
 
 
+/**
+ * Get the text flags of the label from its attributes and styles
+ * @param obj pointer to a label object
+ * @return the text flags to measure and draw the text with
+ */
+static lv_text_flag_t get_txt_flag(const lv_obj_t * obj)
+{
+    const lv_label_t * label = (const lv_label_t *)obj;
+    lv_text_flag_t flag = LV_TEXT_FLAG_NONE;
+    if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
+    if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
+    if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
+    return flag;
+}
+
+/**
+ * Get the size of the label's text. The cached layout is used if it has the same parameters.
+ * @param obj pointer to a label object
+ * @param max_w the available width
+ * @param flag the text flags
+ * @param size store the size of the text here
+ */
+static void get_txt_size(const lv_obj_t * obj, lv_coord_t max_w, lv_text_flag_t flag, lv_point_t * size)
+{
+    const lv_label_t * label = (const lv_label_t *)obj;
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+
+#if LV_LABEL_LONG_TXT_HINT
+    const lv_draw_label_line_t * lines = get_layout(obj, max_w, flag);
+    if(lines) {
+        lv_coord_t letter_height = lv_font_get_line_height(font);
+        uint32_t line_cnt = label->hint.line_cnt;
+        uint32_t len = lines[line_cnt].start;
+        lv_coord_t w = 0;
+        uint32_t i;
+        for(i = 0; i < line_cnt; i++) w = LV_MAX(w, lines[i].width);
+
+        /*The same as `lv_txt_get_size`*/
+        int32_t h = (int32_t)line_cnt * (letter_height + line_space);
+        if(len > 0 && (label->text[len - 1] == '\n' || label->text[len - 1] == '\r')) h += letter_height + line_space;
+        if(h == 0) h = letter_height;
+        else h -= line_space;
+
+        if(h <= LV_COORD_MAX) {
+            size->x = w;
+            size->y = h;
+            return;
+        }
+    }
+#endif
+
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    lv_txt_get_size(size, label->text, font, letter_space, line_space, max_w, flag);
+}
+
+#if LV_LABEL_LONG_TXT_HINT
+/**
+ * Get the layout of the lines cached in the hint of the label.
+ * It's the same layout which is used to draw the label.
+ * @param obj pointer to a label object
+ * @param max_w the available width
+ * @param flag the text flags
+ * @return the lines of the text or NULL if the label is not drawn with these parameters
+ */
+static const lv_draw_label_line_t * get_layout(const lv_obj_t * obj, lv_coord_t max_w, lv_text_flag_t flag)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    if(label->text == NULL) return NULL;
+
+    /*The text is changed temporarily in dot mode*/
+    if(label->long_mode == LV_LABEL_LONG_DOT) return NULL;
+
+    /*The text is drawn only with these parameters*/
+    if(max_w != lv_obj_get_content_width(obj) || flag != get_txt_flag(obj)) return NULL;
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    dsc.letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    dsc.line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+    dsc.align = lv_obj_get_style_text_align(obj, LV_PART_MAIN);
+    dsc.bidi_dir = lv_obj_get_style_base_dir(obj, LV_PART_MAIN);
+    dsc.flag = flag;
+
+    const lv_draw_label_line_t * lines = lv_draw_label_hint_get_layout(&label->hint, label->text, &dsc, max_w);
+    if(lines == NULL || label->hint.line_cnt == 0) return NULL;
+    return lines;
+}
+#endif
+
 static void set_ofs_x_anim(void * obj, int32_t v)
 {
     lv_label_t * label = (lv_label_t *)obj;
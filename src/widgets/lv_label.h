@@ -58,6 +58,7 @@ typedef struct {
         char tmp[LV_LABEL_DOT_NUM + 1]; /*Directly store the characters if <=4 characters*/
     } dot;
     uint32_t dot_end;  /*The real text length, used in dot mode*/
+    uint32_t text_size; /*Allocated size of a not static text. Might be larger than the text to insert without reallocation*/
 
 #if LV_LABEL_LONG_TXT_HINT
     lv_draw_label_hint_t hint;
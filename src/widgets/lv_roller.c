@@ -29,17 +29,22 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_roller_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_roller_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_roller_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void lv_roller_label_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_main(lv_event_t * e);
 static void draw_label(lv_event_t * e);
+static void draw_options(lv_obj_t * obj, const lv_area_t * coords, const lv_area_t * clip_area,
+                         lv_draw_label_dsc_t * dsc);
 static void get_sel_area(lv_obj_t * obj, lv_area_t * sel_area);
 static void refr_position(lv_obj_t * obj, lv_anim_enable_t animen);
 static lv_res_t release_handler(lv_obj_t * obj);
-static void inf_normalize(lv_obj_t * obj_scrl);
+static void set_label_y(lv_obj_t * obj, int32_t y);
+static uint16_t inf_wrap(lv_obj_t * obj, int32_t id);
+static int32_t floor_div(int32_t a, int32_t b);
+static lv_coord_t get_row_height(const lv_obj_t * obj);
 static lv_obj_t * get_label(const lv_obj_t * obj);
 static lv_coord_t get_selected_label_width(const lv_obj_t * obj);
-static void scroll_anim_ready_cb(lv_anim_t * a);
 static void set_y_anim(void * obj, int32_t v);
 
 /**********************
@@ -47,6 +52,7 @@ static void set_y_anim(void * obj, int32_t v);
  **********************/
 const lv_obj_class_t lv_roller_class = {
         .constructor_cb = lv_roller_constructor,
+        .destructor_cb = lv_roller_destructor,
         .event_cb = lv_roller_event,
         .width_def = LV_SIZE_CONTENT,
         .height_def = LV_DPI_DEF,
@@ -103,6 +109,7 @@ void lv_roller_set_options(lv_obj_t * obj, const char * options, lv_roller_mode_
 
     roller->sel_opt_id     = 0;
     roller->sel_opt_id_ori = 0;
+    roller->inf_base       = 0;
 
     /*Count the '\n'-s to determine the number of options*/
     roller->option_cnt = 0;
@@ -112,31 +119,25 @@ void lv_roller_set_options(lv_obj_t * obj, const char * options, lv_roller_mode_
     }
     roller->option_cnt++; /*Last option has no `\n`*/
 
-    if(mode == LV_ROLLER_MODE_NORMAL) {
-        roller->mode = LV_ROLLER_MODE_NORMAL;
-        lv_label_set_text(label, options);
-    }
-    else {
-        roller->mode = LV_ROLLER_MODE_INFINITE;
-
-        size_t opt_len = strlen(options) + 1; /*+1 to add '\n' after option lists*/
-        char * opt_extra = lv_mem_buf_get(opt_len * LV_ROLLER_INF_PAGES);
-        uint8_t i;
-        for(i = 0; i < LV_ROLLER_INF_PAGES; i++) {
-            strcpy(&opt_extra[opt_len * i], options);
-            opt_extra[opt_len * (i + 1) - 1] = '\n';
-        }
-        opt_extra[opt_len * LV_ROLLER_INF_PAGES - 1] = '\0';
-        lv_label_set_text(label, opt_extra);
-        lv_mem_buf_release(opt_extra);
-
-        roller->sel_opt_id     = ((LV_ROLLER_INF_PAGES / 2) + 0) * roller->option_cnt;
+    /*Save where the options start to find them without counting the lines
+     *(in infinite mode the options are shown from anywhere)*/
+    roller->opt_ofs = lv_mem_realloc(roller->opt_ofs, roller->option_cnt * sizeof(roller->opt_ofs[0]));
+    LV_ASSERT_MALLOC(roller->opt_ofs);
+    if(roller->opt_ofs == NULL) return;
 
-        roller->option_cnt = roller->option_cnt * LV_ROLLER_INF_PAGES;
-        inf_normalize(obj);
+    uint16_t opt = 0;
+    roller->opt_ofs[opt++] = 0;
+    for(cnt = 0; options[cnt] != '\0'; cnt++) {
+        if(options[cnt] == '\n') roller->opt_ofs[opt++] = cnt + 1;
     }
 
-    roller->sel_opt_id_ori = roller->sel_opt_id;
+    /*The options are stored only once. In infinite mode they are drawn repeatedly, and the label
+     *is as high as the roller and moved by whole rows to keep it in place.*/
+    roller->mode = mode == LV_ROLLER_MODE_NORMAL ? LV_ROLLER_MODE_NORMAL : LV_ROLLER_MODE_INFINITE;
+    if(roller->mode == LV_ROLLER_MODE_NORMAL) lv_obj_set_height(label, LV_SIZE_CONTENT);
+    lv_label_set_text(label, options);
+
+    refr_position(obj, LV_ANIM_OFF);
 
     /*If the selected text has larger font the label needs some extra draw padding to draw it.*/
     lv_obj_refresh_ext_draw_size(label);
@@ -159,21 +160,6 @@ void lv_roller_set_selected(lv_obj_t * obj, uint16_t sel_opt, lv_anim_enable_t a
 
     lv_roller_t * roller = (lv_roller_t*)obj;
 
-    /*In infinite mode interpret the new ID relative to the currently visible "page"*/
-    if(roller->mode == LV_ROLLER_MODE_INFINITE) {
-        int32_t sel_opt_signed = sel_opt;
-        uint16_t page = roller->sel_opt_id / LV_ROLLER_INF_PAGES;
-
-        /*`sel_opt` should be less than the number of options set by the user.
-         *If it's more then probably it's a reference from not the first page
-         *so normalize `sel_opt`*/
-        if(page != 0) {
-            sel_opt_signed -= page * LV_ROLLER_INF_PAGES;
-        }
-
-        sel_opt = page * LV_ROLLER_INF_PAGES + sel_opt_signed;
-    }
-
     roller->sel_opt_id     = sel_opt < roller->option_cnt ? sel_opt : roller->option_cnt - 1;
     roller->sel_opt_id_ori = roller->sel_opt_id;
 
@@ -209,13 +195,7 @@ uint16_t lv_roller_get_selected(const lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
     lv_roller_t * roller = (lv_roller_t*)obj;
-    if(roller->mode == LV_ROLLER_MODE_INFINITE) {
-        uint16_t real_id_cnt = roller->option_cnt / LV_ROLLER_INF_PAGES;
-        return roller->sel_opt_id % real_id_cnt;
-    }
-    else {
-        return roller->sel_opt_id;
-    }
+    return roller->sel_opt_id;
 }
 
 /**
@@ -230,17 +210,11 @@ void lv_roller_get_selected_str(const lv_obj_t * obj, char * buf, uint32_t buf_s
 
     lv_roller_t * roller = (lv_roller_t*)obj;
     lv_obj_t * label = get_label(obj);
-    uint32_t i;
-    uint16_t line        = 0;
     const char * opt_txt = lv_label_get_text(label);
-    size_t txt_len     = strlen(opt_txt);
-
-    for(i = 0; i < txt_len && line != roller->sel_opt_id; i++) {
-        if(opt_txt[i] == '\n') line++;
-    }
+    uint32_t i = roller->opt_ofs[roller->sel_opt_id];
 
     uint32_t c;
-    for(c = 0; i < txt_len && opt_txt[i] != '\n'; c++, i++) {
+    for(c = 0; opt_txt[i] != '\0' && opt_txt[i] != '\n'; c++, i++) {
         if(buf_size && c >= buf_size - 1) {
             LV_LOG_WARN("lv_dropdown_get_selected_str: the buffer was too small")
             break;
@@ -275,12 +249,7 @@ uint16_t lv_roller_get_option_cnt(const lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
     lv_roller_t * roller = (lv_roller_t*)obj;
-    if(roller->mode == LV_ROLLER_MODE_INFINITE) {
-        return roller->option_cnt / LV_ROLLER_INF_PAGES;
-    }
-    else {
-        return roller->option_cnt;
-    }
+    return roller->option_cnt;
 }
 
 /**********************
@@ -297,6 +266,8 @@ static void lv_roller_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj
     roller->option_cnt = 0;
     roller->sel_opt_id = 0;
     roller->sel_opt_id_ori = 0;
+    roller->inf_base = 0;
+    roller->opt_ofs = NULL;
 
     lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
     lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLL_CHAIN);
@@ -309,6 +280,15 @@ static void lv_roller_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj
     LV_LOG_TRACE("finshed");
 }
 
+static void lv_roller_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    lv_roller_t * roller = (lv_roller_t*)obj;
+
+    lv_mem_free(roller->opt_ofs);
+    roller->opt_ofs = NULL;
+}
+
 static void lv_roller_event(const lv_obj_class_t * class_p, lv_event_t * e)
 {
     LV_UNUSED(class_p);
@@ -347,7 +327,7 @@ static void lv_roller_event(const lv_obj_class_t * class_p, lv_event_t * e)
         lv_indev_get_vect(indev, &p);
         if(p.y) {
             lv_obj_t * label = get_label(obj);
-            lv_obj_set_y(label, lv_obj_get_y(label) + p.y);
+            set_label_y(obj, lv_obj_get_style_y(label, LV_PART_MAIN) + p.y);
             roller->moved = 1;
         }
     }
@@ -388,17 +368,17 @@ static void lv_roller_event(const lv_obj_class_t * class_p, lv_event_t * e)
     else if(code == LV_EVENT_KEY) {
         char c = *((char *)lv_event_get_param(e));
         if(c == LV_KEY_RIGHT || c == LV_KEY_DOWN) {
-            if(roller->sel_opt_id + 1 < roller->option_cnt) {
+            if(roller->sel_opt_id + 1 < roller->option_cnt || roller->mode == LV_ROLLER_MODE_INFINITE) {
                 uint16_t ori_id = roller->sel_opt_id_ori; /*lv_roller_set_selected will overwrite this*/
-                lv_roller_set_selected(obj, roller->sel_opt_id + 1, true);
+                lv_roller_set_selected(obj, inf_wrap(obj, roller->sel_opt_id + 1), true);
                 roller->sel_opt_id_ori = ori_id;
             }
         }
         else if(c == LV_KEY_LEFT || c == LV_KEY_UP) {
-            if(roller->sel_opt_id > 0) {
+            if(roller->sel_opt_id > 0 || roller->mode == LV_ROLLER_MODE_INFINITE) {
                 uint16_t ori_id = roller->sel_opt_id_ori; /*lv_roller_set_selected will overwrite this*/
 
-                lv_roller_set_selected(obj, roller->sel_opt_id - 1, true);
+                lv_roller_set_selected(obj, inf_wrap(obj, roller->sel_opt_id - 1), true);
                 roller->sel_opt_id_ori = ori_id;
             }
         }
@@ -474,6 +454,29 @@ static void draw_main(lv_event_t * e)
         area_ok = _lv_area_intersect(&mask_sel, clip_area, &sel_area);
         if(area_ok) {
             lv_obj_t * label = get_label(obj);
+            lv_roller_t * roller = (lv_roller_t*)obj;
+
+            lv_coord_t bwidth = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+            lv_coord_t pleft = lv_obj_get_style_pad_left(obj, LV_PART_MAIN);
+            lv_coord_t pright = lv_obj_get_style_pad_right(obj, LV_PART_MAIN);
+
+            lv_area_t label_sel_area;
+            label_sel_area.x1 = obj->coords.x1 + pleft + bwidth;
+            label_sel_area.x2 = obj->coords.x2 - pright - bwidth;
+            label_dsc.flag |= LV_TEXT_FLAG_EXPAND;
+
+            if(roller->mode == LV_ROLLER_MODE_INFINITE) {
+                /*Scale the distance of the rows from the middle line with the height of the selected rows*/
+                const lv_font_t * normal_label_font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+                lv_coord_t font_h = lv_font_get_line_height(normal_label_font);
+                lv_coord_t font_sel_h = lv_font_get_line_height(label_dsc.font);
+                int32_t mid = obj->coords.y1 + lv_obj_get_height(obj) / 2;
+                int32_t dist = label->coords.y1 + font_h / 2 - mid;
+                label_sel_area.y1 = mid + (dist * (font_sel_h + label_dsc.line_space)) / get_row_height(obj) - font_sel_h / 2;
+                label_sel_area.y2 = mask_sel.y2;
+                draw_options(obj, &label_sel_area, &mask_sel, &label_dsc);
+                return;
+            }
 
             /*Get the size of the "selected text"*/
             lv_point_t res_p;
@@ -497,18 +500,10 @@ static void draw_main(lv_event_t * e)
             label_sel_y += (label_y_prop * res_p.y) >> 14;
             label_sel_y -= corr;
 
-            lv_coord_t bwidth = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
-            lv_coord_t pleft = lv_obj_get_style_pad_left(obj, LV_PART_MAIN);
-            lv_coord_t pright = lv_obj_get_style_pad_right(obj, LV_PART_MAIN);
-
             /*Draw the selected text*/
-            lv_area_t label_sel_area;
-            label_sel_area.x1 = obj->coords.x1 + pleft + bwidth;
             label_sel_area.y1 = label_sel_y;
-            label_sel_area.x2 = obj->coords.x2 - pright - bwidth;
             label_sel_area.y2 = label_sel_area.y1 + res_p.y;
 
-            label_dsc.flag |= LV_TEXT_FLAG_EXPAND;
             lv_draw_label(&label_sel_area, &mask_sel, &label_dsc, lv_label_get_text(label), NULL);
         }
     }
@@ -534,7 +529,7 @@ static void draw_label(lv_event_t * e)
     clip2.x2 = label_obj->coords.x2;
     clip2.y2 = sel_area.y1;
     if(_lv_area_intersect(&clip2, clip_area, &clip2)) {
-        lv_draw_label(&label_obj->coords, &clip2, &label_draw_dsc, lv_label_get_text(label_obj), NULL);
+        draw_options(roller, &label_obj->coords, &clip2, &label_draw_dsc);
     }
 
     clip2.x1 = label_obj->coords.x1;
@@ -542,7 +537,42 @@ static void draw_label(lv_event_t * e)
     clip2.x2 = label_obj->coords.x2;
     clip2.y2 = label_obj->coords.y2;
     if(_lv_area_intersect(&clip2, clip_area, &clip2)) {
-        lv_draw_label(&label_obj->coords, &clip2, &label_draw_dsc, lv_label_get_text(label_obj), NULL);
+        draw_options(roller, &label_obj->coords, &clip2, &label_draw_dsc);
+    }
+}
+
+/**
+ * Draw the options of a roller. In infinite mode the options are repeated to fill the clip area.
+ * @param obj pointer to a roller object
+ * @param coords the area of the options. In infinite mode its first row shows the `inf_base` option.
+ * @param clip_area draw only in this area
+ * @param dsc draw descriptor. Its font and line space tell the height of the rows.
+ */
+static void draw_options(lv_obj_t * obj, const lv_area_t * coords, const lv_area_t * clip_area,
+                         lv_draw_label_dsc_t * dsc)
+{
+    lv_roller_t * roller = (lv_roller_t*)obj;
+    const char * txt = lv_label_get_text(get_label(obj));
+
+    if(roller->mode == LV_ROLLER_MODE_NORMAL) {
+        lv_draw_label(coords, clip_area, dsc, txt, NULL);
+        return;
+    }
+
+    /*Draw from the first visible row until the end of the text, then continue with the first option.
+     *The label drawing stops at the bottom of the clip area.*/
+    int32_t row_h = lv_font_get_line_height(dsc->font) + dsc->line_space;
+    int32_t row = floor_div(clip_area->y1 - coords->y1, row_h);
+    lv_area_t a = *coords;
+    while(1) {
+        int32_t y = coords->y1 + row * row_h;
+        if(y > clip_area->y2) break;
+
+        uint16_t opt = inf_wrap(obj, roller->inf_base + row);
+        a.y1 = y;
+        a.y2 = clip_area->y2;
+        lv_draw_label(&a, clip_area, dsc, &txt[roller->opt_ofs[opt]], NULL);
+        row += roller->option_cnt - opt;
     }
 }
 
@@ -591,35 +621,42 @@ static void refr_position(lv_obj_t * obj, lv_anim_enable_t anim_en)
 
     lv_roller_t * roller = (lv_roller_t*)obj;
     const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
-    lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
     lv_coord_t font_h              = lv_font_get_line_height(font);
+    lv_coord_t row_h               = get_row_height(obj);
     lv_coord_t h                   = lv_obj_get_content_height(obj);
     uint16_t anim_time             = lv_obj_get_style_anim_time(obj, LV_PART_MAIN);
 
-    /*Normally the animation's `end_cb` sets correct position of the roller if infinite.
-     *But without animations do it manually*/
-    if(anim_en == LV_ANIM_OFF || anim_time == 0) {
-        inf_normalize(obj);
-    }
-
-    int32_t id = roller->sel_opt_id;
-    lv_coord_t sel_y1 = id * (font_h + line_space);
     lv_coord_t mid_y1 = h / 2 - font_h / 2;
+    int32_t y = lv_obj_get_style_y(label, LV_PART_MAIN);
+    int32_t new_y;
 
-    lv_coord_t new_y = mid_y1 - sel_y1;
+    if(roller->mode == LV_ROLLER_MODE_INFINITE) {
+        /*Cover the roller and two more rows as the label is moved by whole rows and can start up to a row above it*/
+        lv_obj_set_height(label, lv_obj_get_height(obj) + 2 * row_h);
+
+        /*Scroll to the nearest row of the selected option from the row in the middle*/
+        int32_t row_mid = floor_div(mid_y1 - y + row_h / 2, row_h);
+        int32_t d = inf_wrap(obj, (int32_t)roller->sel_opt_id - roller->inf_base - row_mid);
+        if(d > roller->option_cnt / 2) d -= roller->option_cnt;
+        new_y = mid_y1 - (row_mid + d) * row_h;
+    }
+    else {
+        new_y = mid_y1 - (int32_t)roller->sel_opt_id * row_h;
+    }
 
     if(anim_en == LV_ANIM_OFF || anim_time == 0) {
         lv_anim_del(label, set_y_anim);
-        lv_obj_set_y(label, new_y);
+        set_label_y(obj, new_y);
     }
     else {
+        /*Animate the distance because in infinite mode the label is moved back by whole rows while scrolling*/
+        roller->anim_last = 0;
         lv_anim_t a;
         lv_anim_init(&a);
         lv_anim_set_var(&a, label);
         lv_anim_set_exec_cb(&a, set_y_anim);
-        lv_anim_set_values(&a, lv_obj_get_y(label), new_y);
+        lv_anim_set_values(&a, 0, new_y - y);
         lv_anim_set_time(&a, anim_time);
-        lv_anim_set_ready_cb(&a, scroll_anim_ready_cb);
         lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
         lv_anim_start(&a);
     }
@@ -648,8 +685,14 @@ static lv_res_t release_handler(lv_obj_t * obj)
 
     if(lv_indev_get_type(indev) == LV_INDEV_TYPE_POINTER || lv_indev_get_type(indev) == LV_INDEV_TYPE_BUTTON) {
         /*Search the clicked option (For KEYPAD and ENCODER the new value should be already set)*/
-        int16_t new_opt  = -1;
-        if(roller->moved == 0) {
+        int32_t new_opt  = -1;
+        if(roller->moved == 0 && roller->mode == LV_ROLLER_MODE_INFINITE) {
+            /*All rows have the same height so the clicked row can be calculated*/
+            lv_point_t p;
+            lv_indev_get_point(indev, &p);
+            new_opt = inf_wrap(obj, roller->inf_base + floor_div(p.y - label->coords.y1, get_row_height(obj)));
+        }
+        else if(roller->moved == 0) {
             new_opt = 0;
             lv_point_t p;
             lv_indev_get_point(indev, &p);
@@ -672,19 +715,21 @@ static lv_res_t release_handler(lv_obj_t * obj)
             }
         } else {
             /*If dragged then align the list to have an element in the middle*/
-            const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
-            lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
-            lv_coord_t font_h              = lv_font_get_line_height(font);
-
-            lv_coord_t label_unit = font_h + line_space;
+            lv_coord_t label_unit = get_row_height(obj);
             lv_coord_t mid        = obj->coords.y1 + (obj->coords.y2 - obj->coords.y1) / 2;
             lv_coord_t label_y1 = label->coords.y1 + lv_indev_scroll_throw_predict(indev, LV_DIR_VER);
-            int32_t id = (mid - label_y1) / label_unit;
 
-            if(id < 0) id = 0;
-            if(id >= roller->option_cnt) id = roller->option_cnt - 1;
+            if(roller->mode == LV_ROLLER_MODE_INFINITE) {
+                new_opt = inf_wrap(obj, roller->inf_base + floor_div(mid - label_y1, label_unit));
+            }
+            else {
+                int32_t id = (mid - label_y1) / label_unit;
+
+                if(id < 0) id = 0;
+                if(id >= roller->option_cnt) id = roller->option_cnt - 1;
 
-            new_opt = id;
+                new_opt = id;
+            }
         }
 
         if(new_opt >= 0) {
@@ -698,35 +743,67 @@ static lv_res_t release_handler(lv_obj_t * obj)
 }
 
 /**
- * Set the middle page for the roller if infinite is enabled
- * @param roller pointer to a roller object
+ * Set the y position of the label.
+ * In infinite mode the label is moved by whole rows to the top of the roller and
+ * `inf_base` is changed to show the same options at the same place.
+ * @param obj pointer to a roller object
+ * @param y the new y coordinate of the label
  */
-static void inf_normalize(lv_obj_t * obj)
+static void set_label_y(lv_obj_t * obj, int32_t y)
 {
     lv_roller_t * roller = (lv_roller_t*)obj;
+    lv_obj_t * label = get_label(obj);
 
     if(roller->mode == LV_ROLLER_MODE_INFINITE) {
-        uint16_t real_id_cnt = roller->option_cnt / LV_ROLLER_INF_PAGES;
-        roller->sel_opt_id = roller->sel_opt_id % real_id_cnt;
-        roller->sel_opt_id += (LV_ROLLER_INF_PAGES / 2) * real_id_cnt; /*Select the middle page*/
-
-        roller->sel_opt_id_ori = roller->sel_opt_id % real_id_cnt;
-        roller->sel_opt_id_ori += (LV_ROLLER_INF_PAGES / 2) * real_id_cnt; /*Select the middle page*/
+        int32_t row_h = get_row_height(obj);
+        int32_t top = -lv_obj_get_style_pad_top(obj, LV_PART_MAIN) - lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+        int32_t row_diff = floor_div(top - y, row_h);
+        y += row_diff * row_h;
+
+        uint16_t base = inf_wrap(obj, roller->inf_base + row_diff % roller->option_cnt);
+        if(base != roller->inf_base) {
+            roller->inf_base = base;
+            lv_obj_invalidate(label);
+        }
+    }
 
-        /*Move to the new id*/
-        const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
-        lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
-        lv_coord_t font_h              = lv_font_get_line_height(font);
-        lv_coord_t h                   = lv_obj_get_content_height(obj);
+    lv_obj_set_y(label, y);
+}
 
-        lv_obj_t * label = get_label(obj);
+/**
+ * Convert an option index to the `0 ... option_cnt - 1` range in infinite mode
+ * @param obj pointer to a roller object
+ * @param id an option index, might be negative or larger than the number of options
+ * @return the index of the option
+ */
+static uint16_t inf_wrap(lv_obj_t * obj, int32_t id)
+{
+    lv_roller_t * roller = (lv_roller_t*)obj;
+    id = id % roller->option_cnt;
+    if(id < 0) id += roller->option_cnt;
+    return id;
+}
 
+/**
+ * Divide and round towards negative infinity
+ */
+static int32_t floor_div(int32_t a, int32_t b)
+{
+    int32_t q = a / b;
+    if((a % b != 0) && ((a < 0) != (b < 0))) q--;
+    return q;
+}
 
-        lv_coord_t sel_y1 = roller->sel_opt_id * (font_h + line_space);
-        lv_coord_t mid_y1 = h / 2 - font_h / 2;
-        lv_coord_t new_y = mid_y1 - sel_y1;
-        lv_obj_set_y(label, new_y);
-    }
+/**
+ * Get the distance of the options on the label
+ * @param obj pointer to a roller object
+ * @return the line height of the font plus the line space
+ */
+static lv_coord_t get_row_height(const lv_obj_t * obj)
+{
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+    return lv_font_get_line_height(font) + line_space;
 }
 
 static lv_obj_t * get_label(const lv_obj_t * obj)
@@ -748,16 +825,12 @@ static lv_coord_t get_selected_label_width(const lv_obj_t * obj)
     return size.x;
 }
 
-static void scroll_anim_ready_cb(lv_anim_t * a)
-{
-    lv_obj_t * obj = lv_obj_get_parent(a->var); /*The label is animated*/
-    inf_normalize(obj);
-}
-
-
 static void set_y_anim(void * obj, int32_t v)
 {
-    lv_obj_set_y(obj, v);
+    lv_obj_t * roller_obj = lv_obj_get_parent(obj); /*The label is animated*/
+    lv_roller_t * roller = (lv_roller_t*)roller_obj;
+    set_label_y(roller_obj, lv_obj_get_style_y(obj, LV_PART_MAIN) + v - roller->anim_last);
+    roller->anim_last = v;
 }
 
 #endif
@@ -41,6 +41,9 @@ typedef struct {
   uint16_t option_cnt;          /**< Number of options*/
   uint16_t sel_opt_id;          /**< Index of the current option*/
   uint16_t sel_opt_id_ori;      /**< Store the original index on focus*/
+  uint16_t inf_base;            /**< Index of the option in the first row of the label in infinite mode*/
+  uint32_t * opt_ofs;           /**< Index of the first character of the options in the text. `option_cnt` elements*/
+  int32_t anim_last;            /**< The last value of the scroll animation. The label is moved by the difference.*/
   lv_roller_mode_t mode : 1;
   uint32_t moved : 1;
 }lv_roller_t;
@@ -20,6 +20,7 @@
 /*********************
  *      DEFINES
  *********************/
+#define TXT_H_INVALID   (-1)
 #define MY_CLASS &lv_table_class
 
 /**********************
@@ -37,6 +38,10 @@ static lv_coord_t get_row_height(lv_obj_t * obj, uint16_t row_id, const lv_font_
                                  lv_coord_t letter_space, lv_coord_t line_space,
                                  lv_coord_t cell_left, lv_coord_t cell_right, lv_coord_t cell_top, lv_coord_t cell_bottom);
 static void refr_size(lv_obj_t * obj, uint32_t strat_row);
+static void refr_row_size(lv_obj_t * obj, uint16_t row);
+static void refr_row_pos(lv_obj_t * obj, uint32_t start_row);
+static void invalidate_txt_h(lv_obj_t * obj, uint32_t start_cell, uint32_t cnt);
+static uint16_t get_row_at(lv_obj_t * obj, lv_coord_t y);
 static lv_res_t get_pressed_cell(lv_obj_t * obj, uint16_t * row, uint16_t * col);
 
 /**********************
@@ -106,7 +111,8 @@ void lv_table_set_cell_value(lv_obj_t * obj, uint16_t row, uint16_t col, const c
 #endif
 
     table->cell_data[cell][0] = ctrl;
-    refr_size(obj, row);
+    table->cell_txt_h[cell] = TXT_H_INVALID;
+    refr_row_size(obj, row);
 
     lv_obj_invalidate(obj);
 }
@@ -181,23 +187,8 @@ void lv_table_set_cell_value_fmt(lv_obj_t * obj, uint16_t row, uint16_t col, con
     table->cell_data[cell][0] = ctrl;
 
     /*Refresh the row height*/
-    lv_coord_t cell_left = lv_obj_get_style_pad_left(obj, LV_PART_ITEMS);
-    lv_coord_t cell_right = lv_obj_get_style_pad_right(obj, LV_PART_ITEMS);
-    lv_coord_t cell_top = lv_obj_get_style_pad_top(obj, LV_PART_ITEMS);
-    lv_coord_t cell_bottom = lv_obj_get_style_pad_bottom(obj, LV_PART_ITEMS);
-
-    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_ITEMS);
-    lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_ITEMS);
-    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_ITEMS);
-
-    lv_coord_t h = get_row_height(obj, row, font, letter_space, line_space,
-                                       cell_left, cell_right, cell_top, cell_bottom);
-
-
-    lv_coord_t minh = lv_obj_get_style_min_height(obj, LV_PART_ITEMS);
-    lv_coord_t maxh = lv_obj_get_style_max_height(obj, LV_PART_ITEMS);
-
-    table->row_h[row] = LV_CLAMP(minh, h, maxh);
+    table->cell_txt_h[cell] = TXT_H_INVALID;
+    refr_row_size(obj, row);
 
     lv_obj_invalidate(obj);
 }
@@ -214,6 +205,10 @@ void lv_table_set_row_cnt(lv_obj_t * obj, uint16_t row_cnt)
     LV_ASSERT_MALLOC(table->row_h);
     if(table->row_h == NULL) return;
 
+    table->row_y = lv_mem_realloc(table->row_y, (table->row_cnt + 1) * sizeof(table->row_y[0]));
+    LV_ASSERT_MALLOC(table->row_y);
+    if(table->row_y == NULL) return;
+
     /*Free the unused cells*/
     if(old_row_cnt > row_cnt) {
         uint16_t old_cell_cnt = old_row_cnt * table->col_cnt;
@@ -228,14 +223,20 @@ void lv_table_set_row_cnt(lv_obj_t * obj, uint16_t row_cnt)
     LV_ASSERT_MALLOC(table->cell_data);
     if(table->cell_data == NULL) return;
 
+    table->cell_txt_h = lv_mem_realloc(table->cell_txt_h, table->row_cnt * table->col_cnt * sizeof(lv_coord_t));
+    LV_ASSERT_MALLOC(table->cell_txt_h);
+    if(table->cell_txt_h == NULL) return;
+
     /*Initialize the new fields*/
     if(old_row_cnt < row_cnt) {
         uint32_t old_cell_cnt = old_row_cnt * table->col_cnt;
         uint32_t new_cell_cnt = table->col_cnt * table->row_cnt;
         lv_memset_00(&table->cell_data[old_cell_cnt], (new_cell_cnt - old_cell_cnt) * sizeof(table->cell_data[0]));
+        invalidate_txt_h(obj, old_cell_cnt, new_cell_cnt - old_cell_cnt);
     }
 
-    refr_size(obj, 0) ;
+    /*Only the new rows need to be measured*/
+    refr_size(obj, LV_MIN(old_row_cnt, row_cnt));
 }
 
 void lv_table_set_col_cnt(lv_obj_t * obj, uint16_t col_cnt)
@@ -288,6 +289,11 @@ void lv_table_set_col_cnt(lv_obj_t * obj, uint16_t col_cnt)
     lv_mem_free(table->cell_data);
     table->cell_data = new_cell_data;
 
+    /*The width of the cells might be changed so measure all of them again*/
+    table->cell_txt_h = lv_mem_realloc(table->cell_txt_h, new_cell_cnt * sizeof(lv_coord_t));
+    LV_ASSERT_MALLOC(table->cell_txt_h);
+    if(table->cell_txt_h == NULL) return;
+    invalidate_txt_h(obj, 0, new_cell_cnt);
 
     refr_size(obj, 0) ;
 }
@@ -302,6 +308,7 @@ void lv_table_set_col_width(lv_obj_t * obj, uint16_t col_id, lv_coord_t w)
     if(col_id >= table->col_cnt) lv_table_set_col_cnt(obj, col_id + 1);
 
     table->col_w[col_id] = w;
+    invalidate_txt_h(obj, 0, table->row_cnt * table->col_cnt);
     refr_size(obj, 0) ;
 }
 
@@ -327,6 +334,10 @@ void lv_table_add_cell_ctrl(lv_obj_t * obj, uint16_t row, uint16_t col, lv_table
     }
 
     table->cell_data[cell][0] |= ctrl;
+
+    /*Merging and cropping change the height of the cells*/
+    invalidate_txt_h(obj, row * table->col_cnt, table->col_cnt);
+    refr_row_size(obj, row);
 }
 
 void lv_table_clear_cell_ctrl(lv_obj_t * obj, uint16_t row, uint16_t col, lv_table_cell_ctrl_t ctrl)
@@ -351,6 +362,10 @@ void lv_table_clear_cell_ctrl(lv_obj_t * obj, uint16_t row, uint16_t col, lv_tab
     }
 
     table->cell_data[cell][0] &= (~ctrl);
+
+    /*Merging and cropping change the height of the cells*/
+    invalidate_txt_h(obj, row * table->col_cnt, table->col_cnt);
+    refr_row_size(obj, row);
 }
 
 /*=====================
@@ -442,8 +457,13 @@ static void lv_table_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     table->row_h = lv_mem_alloc(table->row_cnt * sizeof(table->row_h[0]));
     table->col_w[0] = LV_DPI_DEF;
     table->row_h[0] = LV_DPI_DEF;
+    table->row_y = lv_mem_alloc((table->row_cnt + 1) * sizeof(table->row_y[0]));
+    table->row_y[0] = 0;
+    table->row_y[1] = LV_DPI_DEF;
     table->cell_data = lv_mem_realloc(table->cell_data, table->row_cnt * table->col_cnt * sizeof(char *));
     table->cell_data[0] = NULL;
+    table->cell_txt_h = lv_mem_alloc(table->row_cnt * table->col_cnt * sizeof(lv_coord_t));
+    table->cell_txt_h[0] = TXT_H_INVALID;
 
     LV_TRACE_OBJ_CREATE("finished");
 }
@@ -463,6 +483,8 @@ static void lv_table_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     if(table->cell_data) lv_mem_free(table->cell_data);
     if(table->row_h) lv_mem_free(table->row_h);
+    if(table->row_y) lv_mem_free(table->row_y);
+    if(table->cell_txt_h) lv_mem_free(table->cell_txt_h);
 }
 
 static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -480,6 +502,7 @@ static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
     lv_table_t * table = (lv_table_t *)obj;
 
     if(code == LV_EVENT_STYLE_CHANGED) {
+        invalidate_txt_h(obj, 0, table->row_cnt * table->col_cnt);
         refr_size(obj, 0);
     }
     else if(code == LV_EVENT_GET_SELF_SIZE) {
@@ -488,11 +511,8 @@ static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
         lv_coord_t w = 0;
         for(i = 0; i < table->col_cnt; i++) w += table->col_w[i];
 
-        lv_coord_t h = 0;
-        for(i = 0; i < table->row_cnt; i++) h += table->row_h[i];
-
         p->x = w - 1;
-        p->y = h - 1;
+        p->y = table->row_y[table->row_cnt] - 1;
     }
     else if(code == LV_EVENT_PRESSED || code == LV_EVENT_PRESSING) {
         uint16_t col;
@@ -619,9 +639,12 @@ static void draw_main(lv_event_t * e)
 
     uint16_t col;
     uint16_t row;
-    uint16_t cell = 0;
 
-    cell_area.y2 = obj->coords.y1 + bg_top - 1 - lv_obj_get_scroll_y(obj) ;
+    /*Start from the first visible row*/
+    lv_coord_t y_ofs = obj->coords.y1 + bg_top - lv_obj_get_scroll_y(obj);
+    uint16_t row_start = get_row_at(obj, clip_area.y1 - y_ofs);
+    uint32_t cell = (uint32_t)row_start * table->col_cnt;
+    cell_area.y2 = y_ofs + table->row_y[row_start] - 1;
     lv_coord_t scroll_x = lv_obj_get_scroll_x(obj) ;
     bool rtl = lv_obj_get_style_base_dir(obj, LV_PART_MAIN) == LV_BASE_DIR_RTL ? true : false;
 
@@ -634,7 +657,7 @@ static void draw_main(lv_event_t * e)
     part_draw_dsc.rect_dsc = &rect_dsc_act;
     part_draw_dsc.label_dsc = &label_dsc_act;
 
-    for(row = 0; row < table->row_cnt; row++) {
+    for(row = row_start; row < table->row_cnt; row++) {
         lv_coord_t h_row = table->row_h[row];
 
         cell_area.y1 = cell_area.y2 + 1;
@@ -740,9 +763,17 @@ static void draw_main(lv_event_t * e)
                 if(crop) txt_flags = LV_TEXT_FLAG_EXPAND;
                 else txt_flags = LV_TEXT_FLAG_NONE;
 
-                lv_txt_get_size(&txt_size, table->cell_data[cell] + 1, label_dsc_def.font,
-                        label_dsc_act.letter_space, label_dsc_act.line_space,
-                        lv_area_get_width(&txt_area), txt_flags);
+                /*The height of the text is measured with the default style when the row height is calculated*/
+                if(!crop && table->cell_txt_h[cell] != TXT_H_INVALID &&
+                   label_dsc_act.letter_space == label_dsc_def.letter_space &&
+                   label_dsc_act.line_space == label_dsc_def.line_space) {
+                    txt_size.y = table->cell_txt_h[cell];
+                }
+                else {
+                    lv_txt_get_size(&txt_size, table->cell_data[cell] + 1, label_dsc_def.font,
+                                    label_dsc_act.letter_space, label_dsc_act.line_space,
+                                    lv_area_get_width(&txt_area), txt_flags);
+                }
 
                 /*Align the content to the middle if not cropped*/
                 if(!crop) {
@@ -790,9 +821,93 @@ static void refr_size(lv_obj_t * obj, uint32_t strat_row)
         table->row_h[i] = LV_CLAMP(minh, table->row_h[i], maxh);
     }
 
+    refr_row_pos(obj, strat_row);
     lv_obj_refresh_self_size(obj) ;
 }
 
+/**
+ * Refresh the height of a row. Only the cells with invalidated text height are measured.
+ * @param obj pointer to a table object
+ * @param row index of the row
+ */
+static void refr_row_size(lv_obj_t * obj, uint16_t row)
+{
+    lv_table_t * table = (lv_table_t *)obj;
+
+    lv_coord_t cell_left = lv_obj_get_style_pad_left(obj, LV_PART_ITEMS);
+    lv_coord_t cell_right = lv_obj_get_style_pad_right(obj, LV_PART_ITEMS);
+    lv_coord_t cell_top = lv_obj_get_style_pad_top(obj, LV_PART_ITEMS);
+    lv_coord_t cell_bottom = lv_obj_get_style_pad_bottom(obj, LV_PART_ITEMS);
+
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_ITEMS);
+    lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_ITEMS);
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_ITEMS);
+
+    lv_coord_t minh = lv_obj_get_style_min_height(obj, LV_PART_ITEMS);
+    lv_coord_t maxh = lv_obj_get_style_max_height(obj, LV_PART_ITEMS);
+
+    lv_coord_t h = get_row_height(obj, row, font, letter_space, line_space,
+                                  cell_left, cell_right, cell_top, cell_bottom);
+    h = LV_CLAMP(minh, h, maxh);
+    if(h == table->row_h[row]) return;
+
+    table->row_h[row] = h;
+    refr_row_pos(obj, row);
+    lv_obj_refresh_self_size(obj);
+}
+
+/**
+ * Update the position of the rows from the height of the rows
+ * @param obj pointer to a table object
+ * @param start_row the rows before it are unchanged
+ */
+static void refr_row_pos(lv_obj_t * obj, uint32_t start_row)
+{
+    lv_table_t * table = (lv_table_t *)obj;
+
+    uint32_t i;
+    for(i = start_row; i < table->row_cnt; i++) {
+        table->row_y[i + 1] = table->row_y[i] + table->row_h[i];
+    }
+}
+
+/**
+ * Mark the text height of some cells as not measured
+ * @param obj pointer to a table object
+ * @param start_cell index of the first cell
+ * @param cnt number of cells
+ */
+static void invalidate_txt_h(lv_obj_t * obj, uint32_t start_cell, uint32_t cnt)
+{
+    lv_table_t * table = (lv_table_t *)obj;
+
+    uint32_t i;
+    for(i = start_cell; i < start_cell + cnt; i++) {
+        table->cell_txt_h[i] = TXT_H_INVALID;
+    }
+}
+
+/**
+ * Find the row at a y coordinate with binary search
+ * @param obj pointer to a table object
+ * @param y y coordinate relative to the top of the first row
+ * @return index of the row or `row_cnt` if `y` is below the last row
+ */
+static uint16_t get_row_at(lv_obj_t * obj, lv_coord_t y)
+{
+    lv_table_t * table = (lv_table_t *)obj;
+
+    uint32_t min = 0;
+    uint32_t max = table->row_cnt;
+    while(min < max) {
+        uint32_t mid = (min + max) / 2;
+        if(table->row_y[mid + 1] > y) max = mid;
+        else min = mid + 1;
+    }
+
+    return min;
+}
+
 static lv_coord_t get_row_height(lv_obj_t * obj, uint16_t row_id, const lv_font_t * font,
                                  lv_coord_t letter_space, lv_coord_t line_space,
                                  lv_coord_t cell_left, lv_coord_t cell_right, lv_coord_t cell_top, lv_coord_t cell_bottom)
@@ -801,8 +916,8 @@ static lv_coord_t get_row_height(lv_obj_t * obj, uint16_t row_id, const lv_font_
     lv_point_t txt_size;
     lv_coord_t txt_w;
 
-    uint16_t row_start = row_id * table->col_cnt;
-    uint16_t cell;
+    uint32_t row_start = (uint32_t)row_id * table->col_cnt;
+    uint32_t cell;
     uint16_t col;
     lv_coord_t h_max = lv_font_get_line_height(font) + cell_top + cell_bottom;
 
@@ -836,12 +951,15 @@ static lv_coord_t get_row_height(lv_obj_t * obj, uint16_t row_id, const lv_font_
             }
             /*Without text crop calculate the height of the text in the cell*/
             else {
-                txt_w -= cell_left + cell_right;
+                if(table->cell_txt_h[cell] == TXT_H_INVALID) {
+                    txt_w -= cell_left + cell_right;
 
-                lv_txt_get_size(&txt_size, table->cell_data[cell] + 1, font,
-                                 letter_space, line_space, txt_w, LV_TEXT_FLAG_NONE);
+                    lv_txt_get_size(&txt_size, table->cell_data[cell] + 1, font,
+                                     letter_space, line_space, txt_w, LV_TEXT_FLAG_NONE);
+                    table->cell_txt_h[cell] = txt_size.y;
+                }
 
-                h_max = LV_MAX(txt_size.y + cell_top + cell_bottom, h_max);
+                h_max = LV_MAX(table->cell_txt_h[cell] + cell_top + cell_bottom, h_max);
                 cell += col_merge;
                 col += col_merge;
             }
@@ -890,13 +1008,7 @@ static lv_res_t get_pressed_cell(lv_obj_t * obj, uint16_t * row, uint16_t * col)
         y -= obj->coords.y1;
         y -= lv_obj_get_style_pad_top(obj, LV_PART_MAIN);
 
-        *row = 0;
-        tmp = 0;
-
-        for(*row = 0; *row < table->row_cnt; (*row)++) {
-            tmp += table->row_h[*row];
-            if(y < tmp) break;
-        }
+        *row = get_row_at(obj, y);
     }
 
     return LV_RES_OK;
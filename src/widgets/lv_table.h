@@ -54,6 +54,8 @@ typedef struct {
     char ** cell_data;
     lv_coord_t * row_h;
     lv_coord_t * col_w;
+    lv_coord_t * row_y;         /*Top of the rows relative to the first row. `row_cnt + 1` elements, the last is the total height*/
+    lv_coord_t * cell_txt_h;    /*Cached height of the cells' text. -1: not measured yet*/
     uint16_t col_act;
     uint16_t row_act;
 } lv_table_t;
@@ -49,6 +49,7 @@ static void cursor_blink_anim_cb(void * obj, int32_t show);
 static void pwd_char_hider_anim(void * obj, int32_t x);
 static void pwd_char_hider_anim_ready(lv_anim_t * a);
 static void pwd_char_hider(lv_obj_t * obj);
+static bool pwd_tmp_reserve(lv_textarea_t * ta, size_t len);
 static bool char_is_accepted(lv_obj_t * obj, uint32_t c);
 static void start_cursor_blink(lv_obj_t * obj);
 static void refr_cursor_area(lv_obj_t * obj);
@@ -138,9 +139,7 @@ void lv_textarea_add_char(lv_obj_t * obj, uint32_t c)
     lv_textarea_clear_selection(obj);                                                /*Clear selection*/
 
     if(ta->pwd_mode != 0) {
-        ta->pwd_tmp = lv_mem_realloc(ta->pwd_tmp, strlen(ta->pwd_tmp) + strlen(letter_buf) + 1); /*+2: the new char + \0*/
-        LV_ASSERT_MALLOC(ta->pwd_tmp);
-        if(ta->pwd_tmp == NULL) return;
+        if(!pwd_tmp_reserve(ta, strlen(ta->pwd_tmp) + strlen(letter_buf))) return;
 
         _lv_txt_ins(ta->pwd_tmp, ta->cursor.pos, (const char *)letter_buf);
 
@@ -200,9 +199,7 @@ void lv_textarea_add_text(lv_obj_t * obj, const char * txt)
     lv_textarea_clear_selection(obj);
 
     if(ta->pwd_mode != 0) {
-        ta->pwd_tmp = lv_mem_realloc(ta->pwd_tmp, strlen(ta->pwd_tmp) + strlen(txt) + 1);
-        LV_ASSERT_MALLOC(ta->pwd_tmp);
-        if(ta->pwd_tmp == NULL) return;
+        if(!pwd_tmp_reserve(ta, strlen(ta->pwd_tmp) + strlen(txt))) return;
 
         _lv_txt_ins(ta->pwd_tmp, ta->cursor.pos, txt);
 
@@ -243,13 +240,8 @@ void lv_textarea_del_char(lv_obj_t * obj)
     lv_res_t res = insert_handler(obj, del_buf);
     if(res != LV_RES_OK) return;
 
-    char * label_txt = lv_label_get_text(ta->label);
-
-    /*Delete a character*/
-    _lv_txt_cut(label_txt, ta->cursor.pos - 1, 1);
-
-    /*Refresh the label*/
-    lv_label_set_text(ta->label, label_txt);
+    /*Delete a character. The label keeps the allocated space and relayouts only the changed paragraph.*/
+    lv_label_cut_text(ta->label, ta->cursor.pos - 1, 1);
     lv_textarea_clear_selection(obj);
 
     /*If the textarea became empty, invalidate it to hide the placeholder*/
@@ -260,11 +252,8 @@ void lv_textarea_del_char(lv_obj_t * obj)
 
     if(ta->pwd_mode != 0) {
         uint32_t byte_pos = _lv_txt_encoded_get_byte_id(ta->pwd_tmp, ta->cursor.pos - 1);
+        /*Keep the space of the deleted character for the next insert*/
         _lv_txt_cut(ta->pwd_tmp, ta->cursor.pos - 1, _lv_txt_encoded_size(&ta->pwd_tmp[byte_pos]));
-
-        ta->pwd_tmp = lv_mem_realloc(ta->pwd_tmp, strlen(ta->pwd_tmp) + 1);
-        LV_ASSERT_MALLOC(ta->pwd_tmp);
-        if(ta->pwd_tmp == NULL) return;
     }
 
     /*Move the cursor to the place of the deleted character*/
@@ -322,9 +311,7 @@ void lv_textarea_set_text(lv_obj_t * obj, const char * txt)
     }
 
     if(ta->pwd_mode != 0) {
-        ta->pwd_tmp = lv_mem_realloc(ta->pwd_tmp, strlen(txt) + 1);
-        LV_ASSERT_MALLOC(ta->pwd_tmp);
-        if(ta->pwd_tmp == NULL) return;
+        if(!pwd_tmp_reserve(ta, strlen(txt))) return;
         strcpy(ta->pwd_tmp, txt);
 
         /*Auto hide characters*/
@@ -461,6 +448,7 @@ void lv_textarea_set_password_mode(lv_obj_t * obj, bool en)
         ta->pwd_tmp = lv_mem_alloc(len + 1);
         LV_ASSERT_MALLOC(ta->pwd_tmp);
         if(ta->pwd_tmp == NULL) return;
+        ta->pwd_tmp_size = len + 1;
 
         strcpy(ta->pwd_tmp, txt);
 
@@ -474,6 +462,7 @@ void lv_textarea_set_password_mode(lv_obj_t * obj, bool en)
         lv_label_set_text(ta->label, ta->pwd_tmp);
         lv_mem_free(ta->pwd_tmp);
         ta->pwd_tmp = NULL;
+        ta->pwd_tmp_size = 0;
     }
 
     refr_cursor_area(obj);
@@ -805,6 +794,7 @@ static void lv_textarea_constructor(const lv_obj_class_t * class_p, lv_obj_t * o
 
     ta->pwd_mode          = 0;
     ta->pwd_tmp           = NULL;
+    ta->pwd_tmp_size      = 0;
     ta->pwd_show_time     = LV_TEXTAREA_DEF_PWD_SHOW_TIME;
     ta->accepted_chars    = NULL;
     ta->max_length        = 0;
@@ -956,6 +946,28 @@ static void pwd_char_hider_anim_ready(lv_anim_t * a)
     pwd_char_hider(obj);
 }
 
+/**
+ * Make sure the stored password has space for a text with a given length.
+ * Reserve some more to insert the next characters without reallocation.
+ * @param ta pointer to text area object
+ * @param len length of the text in bytes without the closing `\0`
+ * @return true: there is enough space; false: out of memory
+ */
+static bool pwd_tmp_reserve(lv_textarea_t * ta, size_t len)
+{
+    if(len + 1 <= ta->pwd_tmp_size) return true;
+
+    ta->pwd_tmp_size = len + 1 + len / 4;
+    ta->pwd_tmp = lv_mem_realloc(ta->pwd_tmp, ta->pwd_tmp_size);
+    LV_ASSERT_MALLOC(ta->pwd_tmp);
+    if(ta->pwd_tmp == NULL) {
+        ta->pwd_tmp_size = 0;
+        return false;
+    }
+
+    return true;
+}
+
 /**
  * Hide all characters (convert them to '*')
  * @param ta pointer to text area object
@@ -90,6 +90,38 @@ def build_test(defines, test_name):
     subprocess.check_call('./test.bin')
 
 
+def build_perf(defines, perf_name):
+    global base_defines
+    optimization = ['-O2', '-g0']
+
+    print("")
+    print("")
+    print("~~~~~~~~~~~~~~~~~~~~~~~~")
+    print(re.search("/[a-z_]*$", perf_name).group(0)[1:])
+    print("~~~~~~~~~~~~~~~~~~~~~~~~", flush=True)
+
+    d_all = base_defines + zip_defines(defines)
+
+    cmd_env = os.environ.copy()
+    cmd_env['BIN'] = 'test.bin'
+    cmd_env['MAINSRC'] = perf_name + ".c"
+    cmd_env['LVGL_DIR'] = lvgl_parent_dir
+    cmd_env['LVGL_DIR_NAME'] = lvgl_dir_name
+    cmd_env['DEFINES'] = ' '.join(d_all)
+    cmd_env['OPTIMIZATION'] = ' '.join(optimization)
+
+    print("")
+    print("Build")
+    print("-----------------------", flush=True)
+    # -s makes it silence
+    subprocess.check_call(['make', '-s', '--jobs=%d' % os.cpu_count()], env=cmd_env)
+
+    print("")
+    print("Run")
+    print("-----------------------", flush=True)
+    subprocess.check_call('./test.bin')
+
+
 def clean():
     print("")
     print("Clean")
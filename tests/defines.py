@@ -172,6 +172,7 @@ full_32bit = {
   "LV_FONT_UNSCII_16":1,
   "LV_FONT_FMT_TXT_LARGE":1,
   "LV_USE_FONT_COMPRESSED":1,
+  "LV_USE_FONT_TTF":1,
 
   "LV_USE_BIDI": 1,
   "LV_USE_ARABIC_PERSIAN_CHARS":1,
@@ -180,6 +181,11 @@ full_32bit = {
 
   "LV_LABEL_TEXT_SELECTION":1,
 
+  "LV_USE_CMD_QUEUE":1,
+  "LV_MEM_ATOMIC_FREE":1,
+  "LV_USE_THEME_COMPILE":1,
+  "LV_USE_LOCAL_STYLE_SHARE":1,
+
   "LV_BUILD_EXAMPLES":1,
   
   "LV_FONT_DEFAULT":"&lv_font_montserrat_24",
@@ -219,12 +225,18 @@ test = {
   "LV_FONT_UNSCII_16":1,
   "LV_FONT_FMT_TXT_LARGE":1,
   "LV_USE_FONT_COMPRESSED":1,
+  "LV_USE_FONT_TTF":1,
 
   "LV_USE_BIDI": 1,
   "LV_USE_ARABIC_PERSIAN_CHARS":1,
 
   "LV_LABEL_TEXT_SELECTION":1,
 
+  "LV_USE_CMD_QUEUE":1,
+  "LV_MEM_ATOMIC_FREE":1,
+  "LV_USE_THEME_COMPILE":1,
+  "LV_USE_LOCAL_STYLE_SHARE":1,
+
   "LV_BUILD_EXAMPLES":1,
   
   "LV_FONT_DEFAULT":"&lv_font_montserrat_14",
@@ -6,6 +6,7 @@ import shutil
 import test
 import sys
 import os
+import glob
 
 
 def build_conf(title, defs):
@@ -23,6 +24,15 @@ def build_conf(title, defs):
 test_only = "test" in sys.argv
 test_report = "report" in sys.argv
 test_noclean = "noclean" in sys.argv
+test_perf = "perf" in sys.argv
+
+# The performance programs only print timings, run them separately from the tests
+if test_perf:
+    build.clean()
+    for f in sorted(glob.glob("./src/perf_cases/perf_*.c")):
+        build.build_perf(defines.test, f[:-2])
+        build.clean()
+    sys.exit(0)
 
 if not test_only:
     build_conf("Minimal config monochrome", defines.minimal_monochrome)
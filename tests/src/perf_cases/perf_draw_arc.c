@@ -0,0 +1,137 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "lv_test_init.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define ARC_BUF_SIZE    220
+#define DRAW_CNT        1000
+
+typedef struct {
+  lv_coord_t radius;
+  lv_coord_t width;
+  uint16_t start;
+  uint16_t end;
+} arc_case_t;
+
+static lv_color_t arc_buf[ARC_BUF_SIZE * ARC_BUF_SIZE];
+static const arc_case_t * arc_act;
+static bool use_masks;
+
+/*Draw the arc with the masks like `lv_draw_arc` did before the rasterizer*/
+static void draw_arc_masked(lv_coord_t center_x, lv_coord_t center_y, const lv_area_t * clip_area,
+                            const lv_draw_arc_dsc_t * dsc)
+{
+  lv_draw_rect_dsc_t cir_dsc;
+  lv_draw_rect_dsc_init(&cir_dsc);
+  cir_dsc.bg_color = dsc->color;
+  cir_dsc.bg_opa = dsc->opa;
+
+  lv_area_t area_out;
+  area_out.x1 = center_x - arc_act->radius;
+  area_out.y1 = center_y - arc_act->radius;
+  area_out.x2 = center_x + arc_act->radius - 1;
+  area_out.y2 = center_y + arc_act->radius - 1;
+
+  lv_area_t area_in = area_out;
+  area_in.x1 += dsc->width;
+  area_in.y1 += dsc->width;
+  area_in.x2 -= dsc->width;
+  area_in.y2 -= dsc->width;
+
+  lv_draw_mask_radius_param_t mask_in_param;
+  lv_draw_mask_radius_init(&mask_in_param, &area_in, LV_RADIUS_CIRCLE, true);
+  int16_t mask_in_id = lv_draw_mask_add(&mask_in_param, NULL);
+
+  lv_draw_mask_radius_param_t mask_out_param;
+  lv_draw_mask_radius_init(&mask_out_param, &area_out, LV_RADIUS_CIRCLE, false);
+  int16_t mask_out_id = lv_draw_mask_add(&mask_out_param, NULL);
+
+  /*No angle mask for full rings*/
+  lv_draw_mask_angle_param_t mask_angle_param;
+  int16_t mask_angle_id = LV_MASK_ID_INV;
+  if(arc_act->start + 360 != arc_act->end) {
+    lv_draw_mask_angle_init(&mask_angle_param, center_x, center_y, arc_act->start, arc_act->end);
+    mask_angle_id = lv_draw_mask_add(&mask_angle_param, NULL);
+  }
+
+  /*Draw only the bounding box of the arc*/
+  lv_area_t arc_area;
+  lv_draw_arc_get_area(center_x, center_y, arc_act->radius, arc_act->start, arc_act->end, dsc->width, false, &arc_area);
+  if(_lv_area_intersect(&arc_area, &arc_area, clip_area)) {
+    lv_draw_rect(&area_out, &arc_area, &cir_dsc);
+  }
+
+  if(mask_angle_id != LV_MASK_ID_INV) {
+    lv_draw_mask_remove_id(mask_angle_id);
+    lv_draw_mask_free_param(&mask_angle_param);
+  }
+  lv_draw_mask_remove_id(mask_out_id);
+  lv_draw_mask_remove_id(mask_in_id);
+  lv_draw_mask_free_param(&mask_out_param);
+  lv_draw_mask_free_param(&mask_in_param);
+}
+
+/*Draw the arc many times in one refresh to measure only the drawing of the arc*/
+static void draw_cb(lv_event_t * e)
+{
+  const lv_area_t * clip_area = lv_event_get_param(e);
+  lv_obj_t * obj = lv_event_get_target(e);
+
+  lv_draw_arc_dsc_t dsc;
+  lv_draw_arc_dsc_init(&dsc);
+  dsc.width = arc_act->width;
+
+  lv_coord_t center_x = obj->coords.x1 + ARC_BUF_SIZE / 2;
+  lv_coord_t center_y = obj->coords.y1 + ARC_BUF_SIZE / 2;
+  uint32_t i;
+  for(i = 0; i < DRAW_CNT; i++) {
+    if(use_masks) draw_arc_masked(center_x, center_y, clip_area, &dsc);
+    else lv_draw_arc(center_x, center_y, arc_act->radius, arc_act->start, arc_act->end, clip_area, &dsc);
+  }
+}
+
+static uint32_t render_time(lv_obj_t * obj, bool masks)
+{
+  use_masks = masks;
+  clock_t t_start = clock();
+  lv_refr_obj_to_buf(obj, &obj->coords, LV_IMG_CF_TRUE_COLOR, arc_buf);
+  return (uint32_t)((clock() - t_start) * 1000 / CLOCKS_PER_SEC);
+}
+
+int main(void)
+{
+  lv_test_init();
+
+  lv_obj_t * obj = lv_obj_create(lv_scr_act());
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_size(obj, ARC_BUF_SIZE, ARC_BUF_SIZE);
+  lv_obj_set_style_bg_color(obj, lv_color_white(), 0);
+  lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+  lv_obj_add_event_cb(obj, draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+  lv_obj_update_layout(obj);
+
+  static const arc_case_t cases[] = {
+    {10, 3, 0, 90},
+    {45, 6, 30, 300},
+    {100, 15, 30, 300},
+    {100, 15, 0, 360},
+    {100, 40, 200, 250},
+  };
+
+  printf("Arcs drawn %d times: mask path vs. rasterizer\n", DRAW_CNT);
+  uint32_t i;
+  for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    arc_act = &cases[i];
+    uint32_t t_mask = render_time(obj, true);
+    uint32_t t_raster = render_time(obj, false);
+    printf("r=%3d w=%3d %3d..%3d: masks: %5u ms, rasterizer: %5u ms\n", arc_act->radius, arc_act->width,
+           arc_act->start, arc_act->end, t_mask, t_raster);
+  }
+
+  lv_obj_del(obj);
+  return 0;
+}
+
+#endif
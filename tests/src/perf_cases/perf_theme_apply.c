@@ -0,0 +1,85 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "lv_test_init.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define KIND_CNT        5
+#define ROUND_WIDGETS   40      /*Widgets of each kind in a round*/
+#define ROUND_CNT       50
+#define APPLY_CNT       50
+#define REPEAT_CNT      5       /*Report the fastest of the repeats as the timings are noisy*/
+
+static lv_obj_t * widgets[KIND_CNT * ROUND_WIDGETS];
+
+static void create_widgets(lv_obj_t * parent)
+{
+  uint32_t i;
+  for(i = 0; i < ROUND_WIDGETS; i++) {
+    widgets[i * KIND_CNT + 0] = lv_btn_create(parent);
+    widgets[i * KIND_CNT + 1] = lv_label_create(parent);
+    widgets[i * KIND_CNT + 2] = lv_slider_create(parent);
+    widgets[i * KIND_CNT + 3] = lv_checkbox_create(parent);
+    widgets[i * KIND_CNT + 4] = lv_switch_create(parent);
+  }
+}
+
+/*Create and delete the widgets in rounds. The themes add the same styles in every round.*/
+static uint32_t create_time(void)
+{
+  lv_obj_t * cont = lv_obj_create(lv_scr_act());
+  uint32_t t_sum = 0;
+  uint32_t r;
+  for(r = 0; r < ROUND_CNT; r++) {
+    clock_t t_start = clock();
+    create_widgets(cont);
+    t_sum += clock() - t_start;
+    lv_obj_clean(cont);
+  }
+  lv_obj_del(cont);
+  return (uint32_t)((uint64_t)t_sum * 1000000 / CLOCKS_PER_SEC);
+}
+
+/*Apply the theme again on existing widgets*/
+static uint32_t apply_time(void)
+{
+  lv_obj_t * cont = lv_obj_create(lv_scr_act());
+  create_widgets(cont);
+
+  clock_t t_start = clock();
+  uint32_t r;
+  uint32_t i;
+  for(r = 0; r < APPLY_CNT; r++) {
+    for(i = 0; i < KIND_CNT * ROUND_WIDGETS; i++) lv_theme_apply(widgets[i]);
+  }
+  uint32_t t = (uint32_t)((uint64_t)(clock() - t_start) * 1000000 / CLOCKS_PER_SEC);
+  lv_obj_del(cont);
+  return t;
+}
+
+int main(void)
+{
+  lv_test_init();
+
+  uint32_t widget_cnt = KIND_CNT * ROUND_WIDGETS;
+  printf("Theme compile: %s\n", LV_USE_THEME_COMPILE ? "on" : "off");
+
+  uint32_t t_create = UINT32_MAX;
+  uint32_t t_apply = UINT32_MAX;
+  uint32_t i;
+  for(i = 0; i < REPEAT_CNT; i++) {
+    t_create = LV_MIN(t_create, create_time());
+    t_apply = LV_MIN(t_apply, apply_time());
+  }
+
+  printf("Create %u widgets %d times: %u us, %u ns / widget\n", widget_cnt, ROUND_CNT, t_create,
+         t_create * 1000 / (widget_cnt * ROUND_CNT));
+
+  printf("Apply the theme on %u widgets %d times: %u us, %u ns / widget\n", widget_cnt, APPLY_CNT, t_apply,
+         t_apply * 1000 / (widget_cnt * APPLY_CNT));
+
+  return 0;
+}
+
+#endif
@@ -0,0 +1,90 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W 60
+#define CANVAS_H 40
+
+void test_canvas_draw_true_color(void);
+void test_canvas_draw_batch(void);
+
+static lv_color_t canvas_buf[CANVAS_W * CANVAS_H];
+
+static lv_obj_t * canvas_create(void)
+{
+  lv_obj_t * canvas = lv_canvas_create(lv_scr_act());
+  lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+  lv_obj_set_pos(canvas, 10, 20);
+  lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+  lv_refr_now(NULL);
+  return canvas;
+}
+
+static void rect_draw(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_color_t color)
+{
+  lv_draw_rect_dsc_t dsc;
+  lv_draw_rect_dsc_init(&dsc);
+  dsc.bg_color = color;
+  lv_canvas_draw_rect(canvas, x, y, 5, 5, &dsc);
+}
+
+void test_canvas_draw_true_color(void)
+{
+  lv_obj_t * canvas = canvas_create();
+
+  lv_draw_rect_dsc_t dsc;
+  lv_draw_rect_dsc_init(&dsc);
+  dsc.bg_color = lv_color_black();
+  dsc.bg_opa = LV_OPA_50;
+  lv_canvas_draw_rect(canvas, 10, 10, 20, 10, &dsc);
+
+  TEST_ASSERT_EQUAL_COLOR(lv_color_white(), canvas_buf[5 * CANVAS_W + 5]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_mix(lv_color_black(), lv_color_white(), LV_OPA_50),
+                          canvas_buf[15 * CANVAS_W + 15]);
+
+  /*Only the rectangle is invalidated*/
+  lv_disp_t * disp = lv_disp_get_default();
+  TEST_ASSERT_EQUAL(1, disp->inv_p);
+  TEST_ASSERT_EQUAL(20, disp->inv_areas[0].x1);
+  TEST_ASSERT_EQUAL(30, disp->inv_areas[0].y1);
+  TEST_ASSERT_EQUAL(39, disp->inv_areas[0].x2);
+  TEST_ASSERT_EQUAL(39, disp->inv_areas[0].y2);
+
+  lv_obj_del(canvas);
+}
+
+void test_canvas_draw_batch(void)
+{
+  lv_obj_t * canvas = canvas_create();
+  lv_disp_t * disp = lv_disp_get_default();
+
+  lv_canvas_draw_begin(canvas);
+  rect_draw(canvas, 2, 3, lv_color_black());
+  rect_draw(canvas, 30, 20, lv_color_black());
+  lv_canvas_set_px(canvas, 50, 8, lv_color_black());
+
+  /*Nothing is invalidated until the end of the batch*/
+  TEST_ASSERT_EQUAL(0, disp->inv_p);
+  lv_canvas_draw_end(canvas);
+
+  TEST_ASSERT_EQUAL_COLOR(lv_color_black(), canvas_buf[5 * CANVAS_W + 4]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_black(), canvas_buf[22 * CANVAS_W + 32]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_black(), canvas_buf[8 * CANVAS_W + 50]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_white(), canvas_buf[15 * CANVAS_W + 15]);
+
+  /*The union of the drawn areas*/
+  TEST_ASSERT_EQUAL(1, disp->inv_p);
+  TEST_ASSERT_EQUAL(12, disp->inv_areas[0].x1);
+  TEST_ASSERT_EQUAL(23, disp->inv_areas[0].y1);
+  TEST_ASSERT_EQUAL(60, disp->inv_areas[0].x2);
+  TEST_ASSERT_EQUAL(44, disp->inv_areas[0].y2);
+
+  /*The screen shows the canvas after the refresh*/
+  lv_refr_now(NULL);
+  TEST_ASSERT_EQUAL(0, disp->inv_p);
+
+  lv_obj_del(canvas);
+}
+
+#endif
@@ -0,0 +1,162 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include <pthread.h>
+
+#define THREAD_CNT      4
+#define THREAD_CMD_CNT  2000
+
+void test_cmd_queue_coalesce(void);
+void test_cmd_queue_budget(void);
+void test_cmd_queue_del_obj(void);
+void test_cmd_queue_threads(void);
+
+static void add_chart_value_cb(lv_obj_t * obj, void * param, const lv_cmd_value_t * value)
+{
+  lv_chart_set_next_value(obj, param, value->num);
+}
+
+static lv_res_t add_chart_value(lv_obj_t * chart, lv_chart_series_t * ser, int32_t v)
+{
+  lv_cmd_value_t value;
+  value.num = v;
+  return lv_cmd_queue_send(chart, add_chart_value_cb, ser, &value, false);
+}
+
+void test_cmd_queue_coalesce(void)
+{
+  lv_obj_t * label = lv_label_create(lv_scr_act());
+  lv_obj_t * bar = lv_bar_create(lv_scr_act());
+  lv_obj_t * chart = lv_chart_create(lv_scr_act());
+  lv_chart_series_t * ser = lv_chart_add_series(chart, lv_color_black(), LV_CHART_AXIS_PRIMARY_Y);
+  lv_chart_set_point_count(chart, 4);
+
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_cmd_queue_set_text(label, "first"));
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_cmd_queue_set_value(bar, 10));
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_cmd_queue_set_text(label, "second"));
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_cmd_queue_set_value(bar, 20));
+  TEST_ASSERT_EQUAL(LV_RES_OK, add_chart_value(chart, ser, 1));
+  TEST_ASSERT_EQUAL(LV_RES_OK, add_chart_value(chart, ser, 2));
+  TEST_ASSERT_EQUAL(LV_RES_INV, lv_cmd_queue_set_text(label, "a too long text which doesn't fit to the queue"));
+
+  /*Nothing is changed until LVGL's thread applies the commands*/
+  TEST_ASSERT_EQUAL_STRING("Text", lv_label_get_text(label));
+  TEST_ASSERT_EQUAL(0, lv_bar_get_value(bar));
+
+  /*Only the last text and value is applied but every chart point*/
+  lv_timer_handler();
+  TEST_ASSERT_EQUAL_STRING("second", lv_label_get_text(label));
+  TEST_ASSERT_EQUAL(20, lv_bar_get_value(bar));
+  TEST_ASSERT_EQUAL(1, ser->y_points[0]);
+  TEST_ASSERT_EQUAL(2, ser->y_points[1]);
+  TEST_ASSERT_EQUAL(0, lv_cmd_queue_process(100));
+
+  lv_obj_clean(lv_scr_act());
+}
+
+void test_cmd_queue_budget(void)
+{
+  lv_obj_t * bars[LV_CMD_QUEUE_SIZE];
+  uint32_t i;
+  for(i = 0; i < LV_CMD_QUEUE_SIZE; i++) {
+    bars[i] = lv_bar_create(lv_scr_act());
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_cmd_queue_set_value(bars[i], 50));
+  }
+
+  /*The queue is full*/
+  TEST_ASSERT_EQUAL(LV_RES_INV, lv_cmd_queue_set_value(bars[0], 60));
+
+  lv_cmd_queue_set_budget(10);
+  lv_timer_handler();
+  TEST_ASSERT_EQUAL(50, lv_bar_get_value(bars[9]));
+  TEST_ASSERT_EQUAL(0, lv_bar_get_value(bars[10]));
+
+  /*There is space again and the new values are coalesced with the not applied ones*/
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_cmd_queue_set_value(bars[20], 70));
+  TEST_ASSERT_EQUAL(LV_CMD_QUEUE_SIZE - 10, lv_cmd_queue_process(100));
+  TEST_ASSERT_EQUAL(70, lv_bar_get_value(bars[20]));
+  TEST_ASSERT_EQUAL(50, lv_bar_get_value(bars[LV_CMD_QUEUE_SIZE - 1]));
+
+  lv_cmd_queue_set_budget(LV_CMD_QUEUE_BUDGET);
+  lv_obj_clean(lv_scr_act());
+}
+
+void test_cmd_queue_del_obj(void)
+{
+  lv_obj_t * bar1 = lv_bar_create(lv_scr_act());
+  lv_obj_t * bar2 = lv_bar_create(lv_scr_act());
+
+  /*The first commands are taken from the ring but not applied, the next ones remain in the ring*/
+  lv_cmd_queue_set_value(bar1, 10);
+  lv_cmd_queue_set_value(bar2, 10);
+  lv_cmd_queue_process(0);
+  lv_cmd_queue_set_value(bar1, 20);
+  lv_cmd_queue_set_value(bar2, 20);
+
+  lv_obj_del(bar1);
+  TEST_ASSERT_EQUAL(1, lv_cmd_queue_process(100));
+  TEST_ASSERT_EQUAL(20, lv_bar_get_value(bar2));
+
+  lv_obj_clean(lv_scr_act());
+}
+
+static uint32_t applied_cnt[THREAD_CNT];
+static bool out_of_order;
+
+static void count_cb(lv_obj_t * obj, void * param, const lv_cmd_value_t * value)
+{
+  LV_UNUSED(obj);
+  uint32_t id = (uintptr_t)param;
+  if((uint32_t)value->num != applied_cnt[id]) out_of_order = true;
+  applied_cnt[id]++;
+}
+
+/*The target is resolved in the thread of LVGL: the producers don't read LVGL*/
+typedef struct {
+  lv_obj_t * target;
+  uintptr_t id;
+} producer_arg_t;
+
+static void * producer(void * p)
+{
+  const producer_arg_t * arg = p;
+  int32_t i;
+  for(i = 0; i < THREAD_CMD_CNT; i++) {
+    lv_cmd_value_t v;
+    v.num = i;
+    /*Retry if the queue is full*/
+    while(lv_cmd_queue_send(arg->target, count_cb, (void *)arg->id, &v, false) != LV_RES_OK) {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+void test_cmd_queue_threads(void)
+{
+  pthread_t threads[THREAD_CNT];
+  producer_arg_t args[THREAD_CNT];
+  uintptr_t i;
+  for(i = 0; i < THREAD_CNT; i++) {
+    applied_cnt[i] = 0;
+    args[i].target = lv_scr_act();
+    args[i].id = i;
+    pthread_create(&threads[i], NULL, producer, &args[i]);
+  }
+
+  /*Every command of every thread is applied in the order of sending*/
+  uint32_t total = 0;
+  while(total < THREAD_CNT * THREAD_CMD_CNT) {
+    total += lv_cmd_queue_process(LV_CMD_QUEUE_BUDGET);
+  }
+
+  for(i = 0; i < THREAD_CNT; i++) {
+    pthread_join(threads[i], NULL);
+    TEST_ASSERT_EQUAL(THREAD_CMD_CNT, applied_cnt[i]);
+  }
+  TEST_ASSERT_FALSE(out_of_order);
+  TEST_ASSERT_EQUAL(0, lv_cmd_queue_process(100));
+}
+
+#endif
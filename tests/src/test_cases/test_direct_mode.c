@@ -0,0 +1,105 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define DM_HOR_RES 100
+#define DM_VER_RES 80
+
+void test_direct_mode_redraw_only_invalid(void);
+void test_direct_mode_sync_buffers(void);
+
+static lv_color_t dm_buf1[DM_HOR_RES * DM_VER_RES];
+static lv_color_t dm_buf2[DM_HOR_RES * DM_VER_RES];
+static lv_area_t flushed_area;
+static lv_color_t * flushed_buf;
+static uint32_t flush_cnt;
+
+static void dm_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+  lv_area_copy(&flushed_area, area);
+  flushed_buf = color_p;
+  flush_cnt++;
+  lv_disp_flush_ready(disp_drv);
+}
+
+static lv_disp_t * dm_disp_create(void)
+{
+  static lv_disp_draw_buf_t draw_buf;
+  static lv_disp_drv_t disp_drv;
+
+  lv_disp_draw_buf_init(&draw_buf, dm_buf1, dm_buf2, DM_HOR_RES * DM_VER_RES);
+  lv_disp_drv_init(&disp_drv);
+  disp_drv.draw_buf = &draw_buf;
+  disp_drv.flush_cb = dm_flush_cb;
+  disp_drv.hor_res = DM_HOR_RES;
+  disp_drv.ver_res = DM_VER_RES;
+  disp_drv.direct_mode = 1;
+  lv_disp_t * disp = lv_disp_drv_register(&disp_drv);
+
+  lv_obj_t * scr = lv_disp_get_scr_act(disp);
+  lv_obj_remove_style_all(scr);
+  lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
+  lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+  lv_refr_now(disp);
+  lv_refr_now(disp);
+  return disp;
+}
+
+static lv_obj_t * rect_create(lv_disp_t * disp)
+{
+  lv_obj_t * obj = lv_obj_create(lv_disp_get_scr_act(disp));
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_pos(obj, 10, 20);
+  lv_obj_set_size(obj, 30, 10);
+  lv_obj_set_style_bg_color(obj, lv_color_black(), 0);
+  lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+  return obj;
+}
+
+void test_direct_mode_redraw_only_invalid(void)
+{
+  lv_disp_t * disp = dm_disp_create();
+  lv_obj_t * obj = rect_create(disp);
+  lv_refr_now(disp);
+
+  lv_obj_set_style_bg_color(obj, lv_color_black(), 0);
+  flush_cnt = 0;
+  lv_refr_now(disp);
+
+  /*Only one flush with the area of the object and the whole buffer*/
+  TEST_ASSERT_EQUAL(1, flush_cnt);
+  TEST_ASSERT_EQUAL(10, flushed_area.x1);
+  TEST_ASSERT_EQUAL(20, flushed_area.y1);
+  TEST_ASSERT_EQUAL(39, flushed_area.x2);
+  TEST_ASSERT_EQUAL(29, flushed_area.y2);
+  TEST_ASSERT_TRUE(flushed_buf == dm_buf1 || flushed_buf == dm_buf2);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_black(), flushed_buf[25 * DM_HOR_RES + 20]);
+
+  lv_obj_del(obj);
+  lv_disp_remove(disp);
+}
+
+void test_direct_mode_sync_buffers(void)
+{
+  lv_disp_t * disp = dm_disp_create();
+  lv_obj_t * obj = rect_create(disp);
+  lv_refr_now(disp);
+  lv_color_t * first_buf = flushed_buf;
+
+  /*Invalidate an other area. The rectangle has to be copied to the other buffer too.*/
+  lv_obj_t * obj2 = rect_create(disp);
+  lv_obj_set_pos(obj2, 50, 50);
+  lv_refr_now(disp);
+
+  TEST_ASSERT_TRUE(first_buf != flushed_buf);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_black(), flushed_buf[25 * DM_HOR_RES + 20]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_black(), flushed_buf[55 * DM_HOR_RES + 60]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_white(), flushed_buf[5 * DM_HOR_RES + 5]);
+
+  lv_obj_del(obj);
+  lv_obj_del(obj2);
+  lv_disp_remove(disp);
+}
+
+#endif
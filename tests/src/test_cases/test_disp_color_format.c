@@ -0,0 +1,117 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define CF_HOR_RES 30
+#define CF_VER_RES 20
+#define CF_BUF_PX  (CF_HOR_RES * 4)
+
+void test_disp_color_format_convert(void);
+void test_disp_color_format_set_px_cb(void);
+
+static lv_color_t cf_buf[CF_BUF_PX];
+static uint8_t cf_screen[CF_HOR_RES * CF_VER_RES * 4];
+static lv_color_t cf_ref[CF_HOR_RES * CF_VER_RES];
+static lv_disp_drv_t cf_drv;
+
+static void cf_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+  /*The pixels are in the display's color format unless `set_px_cb` is used*/
+  uint8_t px_size = disp_drv->set_px_cb ? sizeof(lv_color_t) : lv_disp_color_format_get_size(disp_drv->color_format);
+  uint32_t w_byte = lv_area_get_width(area) * px_size;
+  const uint8_t * src = (const uint8_t *)color_p;
+  lv_coord_t y;
+  for(y = area->y1; y <= area->y2; y++) {
+    lv_memcpy(&cf_screen[(y * CF_HOR_RES + area->x1) * px_size], src, w_byte);
+    src += w_byte;
+  }
+  lv_disp_flush_ready(disp_drv);
+}
+
+static void cf_set_px_cb(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                         lv_color_t color, lv_opa_t opa)
+{
+  LV_UNUSED(disp_drv);
+  lv_color_t * px = &((lv_color_t *)buf)[y * buf_w + x];
+  *px = lv_color_mix(color, *px, opa);
+}
+
+static void cf_render(lv_disp_color_format_t cf, bool set_px)
+{
+  static lv_disp_draw_buf_t draw_buf;
+  lv_disp_draw_buf_init(&draw_buf, cf_buf, NULL, CF_BUF_PX);
+  lv_disp_drv_init(&cf_drv);
+  cf_drv.draw_buf = &draw_buf;
+  cf_drv.flush_cb = cf_flush_cb;
+  cf_drv.hor_res = CF_HOR_RES;
+  cf_drv.ver_res = CF_VER_RES;
+  cf_drv.color_format = cf;
+  if(set_px) cf_drv.set_px_cb = cf_set_px_cb;
+  lv_disp_t * disp = lv_disp_drv_register(&cf_drv);
+
+  lv_obj_t * scr = lv_disp_get_scr_act(disp);
+  lv_obj_remove_style_all(scr);
+  lv_obj_set_style_bg_color(scr, lv_palette_main(LV_PALETTE_ORANGE), 0);
+  lv_obj_set_style_bg_grad_color(scr, lv_palette_main(LV_PALETTE_INDIGO), 0);
+  lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_HOR, 0);
+  lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+
+  lv_obj_t * label = lv_label_create(scr);
+  lv_label_set_text(label, "Ab");
+
+  lv_memset_00(cf_screen, sizeof(cf_screen));
+  lv_refr_now(disp);
+  lv_disp_remove(disp);
+}
+
+static void cf_render_ref(bool set_px)
+{
+  cf_render(LV_DISP_COLOR_FORMAT_NATIVE, set_px);
+  lv_memcpy(cf_ref, cf_screen, sizeof(cf_ref));
+}
+
+void test_disp_color_format_convert(void)
+{
+  cf_render_ref(false);
+
+  lv_disp_color_format_t cf;
+  for(cf = LV_DISP_COLOR_FORMAT_RGB565; cf <= LV_DISP_COLOR_FORMAT_L8; cf++) {
+    cf_render(cf, false);
+
+    uint32_t i;
+    for(i = 0; i < CF_HOR_RES * CF_VER_RES; i++) {
+      lv_color32_t c32;
+      c32.full = lv_color_to32(cf_ref[i]);
+      uint16_t c16 = (uint16_t)(((c32.ch.red >> 3) << 11) | ((c32.ch.green >> 2) << 5) | (c32.ch.blue >> 3));
+      const uint8_t * px = &cf_screen[i * lv_disp_color_format_get_size(cf)];
+      switch(cf) {
+        case LV_DISP_COLOR_FORMAT_RGB565:
+          TEST_ASSERT_EQUAL_HEX16(c16, px[0] | (px[1] << 8));
+          break;
+        case LV_DISP_COLOR_FORMAT_RGB565_SWAP:
+          TEST_ASSERT_EQUAL_HEX16(c16, px[1] | (px[0] << 8));
+          break;
+        case LV_DISP_COLOR_FORMAT_RGB888:
+          TEST_ASSERT_EQUAL_HEX32(c32.full & 0xFFFFFF, px[0] | (px[1] << 8) | ((uint32_t)px[2] << 16));
+          break;
+        case LV_DISP_COLOR_FORMAT_ARGB8888:
+          TEST_ASSERT_EQUAL_HEX32(c32.full | 0xFF000000, px[0] | (px[1] << 8) | ((uint32_t)px[2] << 16) | ((uint32_t)px[3] << 24));
+          break;
+        default:
+          TEST_ASSERT_EQUAL_HEX8(lv_color_brightness(cf_ref[i]), px[0]);
+          break;
+      }
+    }
+  }
+}
+
+void test_disp_color_format_set_px_cb(void)
+{
+  /*With `set_px_cb` the pixels are not converted*/
+  cf_render_ref(true);
+  cf_render(LV_DISP_COLOR_FORMAT_L8, true);
+  TEST_ASSERT_EQUAL_MEMORY(cf_ref, cf_screen, sizeof(cf_ref));
+}
+
+#endif
@@ -0,0 +1,171 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define ARC_BUF_SIZE    220
+
+void test_draw_arc_same_as_masks(void);
+void test_draw_arc_rounded(void);
+
+static lv_color_t buf_raster[ARC_BUF_SIZE * ARC_BUF_SIZE];
+static lv_color_t buf_mask[ARC_BUF_SIZE * ARC_BUF_SIZE];
+static lv_coord_t arc_radius;
+static lv_coord_t arc_width;
+static uint16_t arc_start;
+static uint16_t arc_end;
+static bool arc_rounded;
+static bool use_masks;
+
+/*Draw the arc with the masks like `lv_draw_arc` did before the rasterizer*/
+static void draw_arc_masked(lv_coord_t center_x, lv_coord_t center_y, const lv_area_t * clip_area,
+                            const lv_draw_arc_dsc_t * dsc)
+{
+  lv_draw_rect_dsc_t cir_dsc;
+  lv_draw_rect_dsc_init(&cir_dsc);
+  cir_dsc.bg_color = dsc->color;
+  cir_dsc.bg_opa = dsc->opa;
+
+  lv_area_t area_out;
+  area_out.x1 = center_x - arc_radius;
+  area_out.y1 = center_y - arc_radius;
+  area_out.x2 = center_x + arc_radius - 1;
+  area_out.y2 = center_y + arc_radius - 1;
+
+  lv_area_t area_in = area_out;
+  area_in.x1 += dsc->width;
+  area_in.y1 += dsc->width;
+  area_in.x2 -= dsc->width;
+  area_in.y2 -= dsc->width;
+
+  lv_draw_mask_radius_param_t mask_in_param;
+  lv_draw_mask_radius_init(&mask_in_param, &area_in, LV_RADIUS_CIRCLE, true);
+  int16_t mask_in_id = lv_draw_mask_add(&mask_in_param, NULL);
+
+  lv_draw_mask_radius_param_t mask_out_param;
+  lv_draw_mask_radius_init(&mask_out_param, &area_out, LV_RADIUS_CIRCLE, false);
+  int16_t mask_out_id = lv_draw_mask_add(&mask_out_param, NULL);
+
+  /*No angle mask for full rings*/
+  lv_draw_mask_angle_param_t mask_angle_param;
+  int16_t mask_angle_id = LV_MASK_ID_INV;
+  if(arc_start + 360 != arc_end) {
+    lv_draw_mask_angle_init(&mask_angle_param, center_x, center_y, arc_start, arc_end);
+    mask_angle_id = lv_draw_mask_add(&mask_angle_param, NULL);
+  }
+
+  /*Draw only the bounding box of the arc*/
+  lv_area_t arc_area;
+  lv_draw_arc_get_area(center_x, center_y, arc_radius, arc_start, arc_end, dsc->width, false, &arc_area);
+  if(_lv_area_intersect(&arc_area, &arc_area, clip_area)) {
+    lv_draw_rect(&area_out, &arc_area, &cir_dsc);
+  }
+
+  if(mask_angle_id != LV_MASK_ID_INV) {
+    lv_draw_mask_remove_id(mask_angle_id);
+    lv_draw_mask_free_param(&mask_angle_param);
+  }
+  lv_draw_mask_remove_id(mask_out_id);
+  lv_draw_mask_remove_id(mask_in_id);
+  lv_draw_mask_free_param(&mask_out_param);
+  lv_draw_mask_free_param(&mask_in_param);
+}
+
+static void draw_cb(lv_event_t * e)
+{
+  const lv_area_t * clip_area = lv_event_get_param(e);
+  lv_obj_t * obj = lv_event_get_target(e);
+
+  lv_draw_arc_dsc_t dsc;
+  lv_draw_arc_dsc_init(&dsc);
+  dsc.width = arc_width;
+  dsc.rounded = arc_rounded;
+
+  lv_coord_t center_x = obj->coords.x1 + ARC_BUF_SIZE / 2;
+  lv_coord_t center_y = obj->coords.y1 + ARC_BUF_SIZE / 2;
+  if(use_masks) draw_arc_masked(center_x, center_y, clip_area, &dsc);
+  else lv_draw_arc(center_x, center_y, arc_radius, arc_start, arc_end, clip_area, &dsc);
+}
+
+static lv_obj_t * arc_obj_create(void)
+{
+  lv_obj_t * obj = lv_obj_create(lv_scr_act());
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_size(obj, ARC_BUF_SIZE, ARC_BUF_SIZE);
+  lv_obj_set_style_bg_color(obj, lv_color_white(), 0);
+  lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+  lv_obj_add_event_cb(obj, draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+  lv_obj_update_layout(obj);
+  return obj;
+}
+
+static void render(lv_obj_t * obj, bool masks, lv_color_t * buf)
+{
+  use_masks = masks;
+  lv_refr_obj_to_buf(obj, &obj->coords, LV_IMG_CF_TRUE_COLOR, buf);
+}
+
+static uint32_t count_diff(void)
+{
+  uint32_t cnt = 0;
+  uint32_t i;
+  for(i = 0; i < ARC_BUF_SIZE * ARC_BUF_SIZE; i++) {
+    if(LV_ABS(buf_raster[i].ch.red - buf_mask[i].ch.red) > 0x40) cnt++;
+  }
+  return cnt;
+}
+
+void test_draw_arc_same_as_masks(void)
+{
+  lv_obj_t * obj = arc_obj_create();
+  static const uint16_t angles[][2] = {{0, 90}, {30, 300}, {135, 45}, {200, 250}, {0, 360}};
+  static const lv_coord_t radii[] = {10, 45, 100};
+  static const lv_coord_t widths[] = {1, 6, 20};
+
+  arc_rounded = false;
+  uint32_t a, r, w;
+  for(a = 0; a < sizeof(angles) / sizeof(angles[0]); a++) {
+    for(r = 0; r < sizeof(radii) / sizeof(radii[0]); r++) {
+      for(w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+        arc_start = angles[a][0];
+        arc_end = angles[a][1];
+        arc_radius = radii[r];
+        arc_width = LV_MIN(widths[w], arc_radius);
+        render(obj, false, buf_raster);
+        render(obj, true, buf_mask);
+
+        /*Only the anti-aliasing can be slightly different*/
+        char msg[64];
+        lv_snprintf(msg, sizeof(msg), "angles: %d..%d, radius: %d, width: %d", arc_start, arc_end, arc_radius, arc_width);
+        TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(arc_radius / 4, count_diff(), msg);
+      }
+    }
+  }
+
+  lv_obj_del(obj);
+}
+
+void test_draw_arc_rounded(void)
+{
+  lv_obj_t * obj = arc_obj_create();
+  arc_start = 0;
+  arc_end = 90;
+  arc_radius = 100;
+  arc_width = 20;
+
+  arc_rounded = false;
+  render(obj, false, buf_mask);
+  arc_rounded = true;
+  render(obj, false, buf_raster);
+
+  /*The round ending is before the start angle, the arc is the same*/
+  lv_coord_t c = ARC_BUF_SIZE / 2;
+  TEST_ASSERT_EQUAL_COLOR(lv_color_white(), buf_mask[(c - 5) * ARC_BUF_SIZE + c + 90]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_black(), buf_raster[(c - 5) * ARC_BUF_SIZE + c + 90]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_black(), buf_raster[(c + 60) * ARC_BUF_SIZE + c + 60]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_white(), buf_raster[(c - 15) * ARC_BUF_SIZE + c + 90]);
+
+  lv_obj_del(obj);
+}
+
+#endif
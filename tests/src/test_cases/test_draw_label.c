@@ -0,0 +1,255 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define BUF_W 300
+#define BUF_H 40
+
+#define GLYPH_W     13      /*Odd width so the rows don't start on byte or nibble boundaries*/
+#define GLYPH_H     7
+#define GLYPH_BUF_W 40
+#define GLYPH_BUF_H 12
+
+void test_draw_label_glyph_run(void);
+void test_draw_label_glyph_run_mask(void);
+void test_draw_label_glyph_bpp(void);
+
+static lv_color_t run_buf[BUF_W * BUF_H];
+static lv_color_t ref_buf[BUF_W * BUF_H];
+
+static const char * txt = "Lorem ipsum dolor sit amet, consectetur adipiscing elit";
+
+static lv_color_t glyph_buf[GLYPH_BUF_W * GLYPH_BUF_H];
+static uint8_t glyph_bitmap[GLYPH_W * GLYPH_H];
+static uint8_t glyph_bpp;
+
+/*Draw the text with the label drawer and letter by letter too*/
+static void draw_both(lv_opa_t opa)
+{
+  lv_area_t buf_area;
+  lv_area_set(&buf_area, 0, 0, BUF_W - 1, BUF_H - 1);
+  lv_area_t coords;
+  lv_area_set(&coords, 3, 5, BUF_W + 100, 30);
+
+  lv_draw_label_dsc_t dsc;
+  lv_draw_label_dsc_init(&dsc);
+  dsc.opa = opa;
+  dsc.font = &lv_font_montserrat_14;
+  dsc.color = lv_color_hex(0x102030);
+  dsc.flag = LV_TEXT_FLAG_EXPAND;
+
+  uint32_t i;
+  for(i = 0; i < BUF_W * BUF_H; i++) {
+    run_buf[i] = lv_color_white();
+    ref_buf[i] = lv_color_white();
+  }
+
+  lv_refr_target_t target;
+  lv_refr_target_init(&target, run_buf, &buf_area, LV_IMG_CF_TRUE_COLOR);
+  lv_refr_target_begin(&target);
+  lv_draw_label(&coords, &buf_area, &dsc, txt, NULL);
+  lv_refr_target_end(&target);
+
+  lv_refr_target_init(&target, ref_buf, &buf_area, LV_IMG_CF_TRUE_COLOR);
+  lv_refr_target_begin(&target);
+  lv_point_t pos = {coords.x1, coords.y1};
+  i = 0;
+  while(txt[i]) {
+    uint32_t letter;
+    uint32_t letter_next;
+    _lv_txt_encoded_letter_next_2(txt, &letter, &letter_next, &i);
+    lv_draw_letter(&pos, &buf_area, dsc.font, letter, dsc.color, opa, dsc.blend_mode);
+    pos.x += lv_font_get_glyph_width(dsc.font, letter, letter_next);
+  }
+  lv_refr_target_end(&target);
+}
+
+static void assert_bufs_near(int32_t tolerance)
+{
+  uint32_t diff_cnt = 0;
+  uint32_t i;
+  for(i = 0; i < BUF_W * BUF_H; i++) {
+    TEST_ASSERT_INT_WITHIN(tolerance, LV_COLOR_GET_R(ref_buf[i]), LV_COLOR_GET_R(run_buf[i]));
+    TEST_ASSERT_INT_WITHIN(tolerance, LV_COLOR_GET_G(ref_buf[i]), LV_COLOR_GET_G(run_buf[i]));
+    TEST_ASSERT_INT_WITHIN(tolerance, LV_COLOR_GET_B(ref_buf[i]), LV_COLOR_GET_B(run_buf[i]));
+    if(ref_buf[i].full != lv_color_white().full) diff_cnt++;
+  }
+
+  /*Something was drawn*/
+  TEST_ASSERT_GREATER_THAN(200, diff_cnt);
+}
+
+void test_draw_label_glyph_run(void)
+{
+  draw_both(LV_OPA_COVER);
+  assert_bufs_near(0);
+
+  draw_both(LV_OPA_60);
+  assert_bufs_near(2);
+}
+
+void test_draw_label_glyph_run_mask(void)
+{
+  lv_area_t mask_area;
+  lv_area_set(&mask_area, 20, 0, 120, 39);
+  lv_draw_mask_radius_param_t param;
+  lv_draw_mask_radius_init(&param, &mask_area, 15, false);
+  int16_t id = lv_draw_mask_add(&param, NULL);
+
+  draw_both(LV_OPA_COVER);
+  lv_draw_mask_remove_id(id);
+  assert_bufs_near(0);
+
+  /*Nothing out of the mask*/
+  TEST_ASSERT_EQUAL_COLOR(lv_color_white(), run_buf[15 * BUF_W + 10]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_white(), run_buf[15 * BUF_W + 200]);
+}
+
+/*A font with a single glyph, 'A', whose bitmap is built by the test*/
+static bool glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * dsc, uint32_t letter, uint32_t letter_next)
+{
+  LV_UNUSED(font);
+  LV_UNUSED(letter_next);
+  if(letter != 'A') return false;
+
+  dsc->adv_w = GLYPH_W + 1;
+  dsc->box_w = GLYPH_W;
+  dsc->box_h = GLYPH_H;
+  dsc->ofs_x = 0;
+  dsc->ofs_y = 0;
+  dsc->bpp = glyph_bpp;
+  return true;
+}
+
+static const uint8_t * glyph_bitmap_cb(const lv_font_t * font, uint32_t letter)
+{
+  LV_UNUSED(font);
+  return letter == 'A' ? glyph_bitmap : NULL;
+}
+
+static lv_font_t glyph_font = {
+  .get_glyph_dsc = glyph_dsc_cb,
+  .get_glyph_bitmap = glyph_bitmap_cb,
+  .line_height = GLYPH_H,
+  .base_line = 0,
+};
+
+/*The raw value of a pixel of the test glyph*/
+static uint32_t glyph_px_value(int32_t x, int32_t y)
+{
+  return (uint32_t)(x * 37 + y * 91 + x * y * 13) & ((1 << glyph_bpp) - 1);
+}
+
+/*Pack the pixels MSB first, the rows following each other without padding*/
+static void glyph_build(uint8_t bpp)
+{
+  glyph_bpp = bpp;
+  lv_memset_00(glyph_bitmap, sizeof(glyph_bitmap));
+
+  uint32_t bit = 0;
+  int32_t x;
+  int32_t y;
+  for(y = 0; y < GLYPH_H; y++) {
+    for(x = 0; x < GLYPH_W; x++) {
+      uint32_t v = glyph_px_value(x, y);
+      uint32_t shift = 8 - bpp - (bit & 7);
+      glyph_bitmap[bit >> 3] |= v << shift;
+      bit += bpp;
+    }
+  }
+}
+
+static void glyph_buf_clear(void)
+{
+  uint32_t i;
+  for(i = 0; i < GLYPH_BUF_W * GLYPH_BUF_H; i++) glyph_buf[i] = lv_color_white();
+}
+
+/*Every pixel is white out of the glyphs, and `255 - opa` in them where opa is the linearly scaled pixel value*/
+static void glyph_buf_check(const lv_area_t * clip, const lv_point_t * pos, uint32_t glyph_cnt)
+{
+  uint32_t max_v = (1 << glyph_bpp) - 1;
+  int32_t x;
+  int32_t y;
+  for(y = 0; y < GLYPH_BUF_H; y++) {
+    for(x = 0; x < GLYPH_BUF_W; x++) {
+      int32_t expected = 255;
+      int32_t gx = x - pos->x;
+      int32_t gy = y - pos->y;
+      bool in_clip = x >= clip->x1 && x <= clip->x2 && y >= clip->y1 && y <= clip->y2;
+      if(in_clip && gx >= 0 && gy >= 0 && gy < GLYPH_H && gx < (int32_t)glyph_cnt * (GLYPH_W + 1)) {
+        gx = gx % (GLYPH_W + 1);
+        if(gx < GLYPH_W) expected = 255 - glyph_px_value(gx, gy) * 255 / max_v;
+      }
+
+      lv_color_t c = glyph_buf[y * GLYPH_BUF_W + x];
+      TEST_ASSERT_INT_WITHIN(1, expected, LV_COLOR_GET_R(c));
+      TEST_ASSERT_INT_WITHIN(1, expected, LV_COLOR_GET_G(c));
+      TEST_ASSERT_INT_WITHIN(1, expected, LV_COLOR_GET_B(c));
+    }
+  }
+}
+
+static void glyph_draw_letter(const lv_area_t * clip, const lv_point_t * pos)
+{
+  lv_area_t buf_area;
+  lv_area_set(&buf_area, 0, 0, GLYPH_BUF_W - 1, GLYPH_BUF_H - 1);
+
+  glyph_buf_clear();
+  lv_refr_target_t target;
+  lv_refr_target_init(&target, glyph_buf, &buf_area, LV_IMG_CF_TRUE_COLOR);
+  lv_refr_target_begin(&target);
+  lv_draw_letter(pos, clip, &glyph_font, 'A', lv_color_black(), LV_OPA_COVER, LV_BLEND_MODE_NORMAL);
+  lv_refr_target_end(&target);
+}
+
+static void glyph_draw_label(const lv_area_t * clip, const lv_point_t * pos)
+{
+  lv_area_t buf_area;
+  lv_area_set(&buf_area, 0, 0, GLYPH_BUF_W - 1, GLYPH_BUF_H - 1);
+  lv_area_t coords;
+  lv_area_set(&coords, pos->x, pos->y, GLYPH_BUF_W + 20, pos->y + GLYPH_H - 1);
+
+  lv_draw_label_dsc_t dsc;
+  lv_draw_label_dsc_init(&dsc);
+  dsc.font = &glyph_font;
+  dsc.color = lv_color_black();
+  dsc.flag = LV_TEXT_FLAG_EXPAND;
+
+  glyph_buf_clear();
+  lv_refr_target_t target;
+  lv_refr_target_init(&target, glyph_buf, &buf_area, LV_IMG_CF_TRUE_COLOR);
+  lv_refr_target_begin(&target);
+  lv_draw_label(&coords, clip, &dsc, "AA", NULL);
+  lv_refr_target_end(&target);
+}
+
+void test_draw_label_glyph_bpp(void)
+{
+  static const uint8_t bpps[] = {1, 2, 4, 8};
+  lv_point_t pos = {2, 3};
+  lv_area_t clip_full;
+  lv_area_set(&clip_full, 0, 0, GLYPH_BUF_W - 1, GLYPH_BUF_H - 1);
+
+  /*Cut into the glyphs to start the rows at every bit offset*/
+  lv_area_t clip_cut;
+  lv_area_set(&clip_cut, pos.x + 5, pos.y + 2, pos.x + GLYPH_W + 9, GLYPH_BUF_H - 1);
+
+  uint32_t i;
+  for(i = 0; i < sizeof(bpps); i++) {
+    glyph_build(bpps[i]);
+
+    glyph_draw_letter(&clip_full, &pos);
+    glyph_buf_check(&clip_full, &pos, 1);
+    glyph_draw_letter(&clip_cut, &pos);
+    glyph_buf_check(&clip_cut, &pos, 1);
+
+    glyph_draw_label(&clip_full, &pos);
+    glyph_buf_check(&clip_full, &pos, 2);
+    glyph_draw_label(&clip_cut, &pos);
+    glyph_buf_check(&clip_cut, &pos, 2);
+  }
+}
+
+#endif
@@ -0,0 +1,129 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void test_draw_raster_polygon(void);
+void test_draw_raster_polyline(void);
+void test_draw_raster_polyline_long(void);
+
+#define ZIGZAG_CNT  13
+
+static lv_color_t buf[100 * 40];
+static lv_coord_t buf_w;
+static lv_point_t points[ZIGZAG_CNT];
+static uint16_t point_cnt;
+static bool polyline;
+
+static void draw_cb(lv_event_t * e)
+{
+  const lv_area_t * clip_area = lv_event_get_param(e);
+  lv_obj_t * obj = lv_event_get_target(e);
+
+  lv_point_t p[ZIGZAG_CNT];
+  uint16_t i;
+  for(i = 0; i < point_cnt; i++) {
+    p[i].x = points[i].x + obj->coords.x1;
+    p[i].y = points[i].y + obj->coords.y1;
+  }
+
+  if(polyline) {
+    lv_draw_line_dsc_t dsc;
+    lv_draw_line_dsc_init(&dsc);
+    dsc.width = 5;
+    dsc.opa = LV_OPA_50;
+    dsc.round_start = 1;
+    dsc.round_end = 1;
+    lv_draw_polyline(p, point_cnt, clip_area, &dsc);
+  }
+  else {
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_black();
+    lv_draw_polygon(p, point_cnt, clip_area, &dsc);
+  }
+}
+
+static void render(void)
+{
+  lv_obj_t * obj = lv_obj_create(lv_scr_act());
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_size(obj, buf_w, 40);
+  lv_obj_set_style_bg_color(obj, lv_color_white(), 0);
+  lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+  lv_obj_add_event_cb(obj, draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+  lv_obj_update_layout(obj);
+
+  lv_refr_obj_to_buf(obj, &obj->coords, LV_IMG_CF_TRUE_COLOR, buf);
+  lv_obj_del(obj);
+}
+
+void test_draw_raster_polygon(void)
+{
+  /*Concave polygon: a square with a notch from the right*/
+  polyline = false;
+  buf_w = 40;
+  point_cnt = 6;
+  points[0] = (lv_point_t){4, 4};
+  points[1] = (lv_point_t){30, 4};
+  points[2] = (lv_point_t){16, 17};
+  points[3] = (lv_point_t){30, 30};
+  points[4] = (lv_point_t){4, 30};
+  points[5] = (lv_point_t){4, 4};
+  render();
+
+  /*Fully covered pixels inside, the edges are on the pixel borders*/
+  TEST_ASSERT_EQUAL_COLOR(lv_color_black(), buf[4 * 40 + 4]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_black(), buf[29 * 40 + 5]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_white(), buf[3 * 40 + 10]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_white(), buf[30 * 40 + 10]);
+
+  /*The notch is empty*/
+  TEST_ASSERT_EQUAL_COLOR(lv_color_white(), buf[17 * 40 + 28]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_black(), buf[17 * 40 + 10]);
+
+  /*Anti-aliased pixel on the skew edge*/
+  lv_color_t c = buf[10 * 40 + 23];
+  TEST_ASSERT_TRUE(c.ch.red > 0 && c.ch.red < 0xff);
+}
+
+void test_draw_raster_polyline(void)
+{
+  /*Semi-transparent lines: the joint shouldn't be darker than the lines*/
+  polyline = true;
+  buf_w = 40;
+  point_cnt = 3;
+  points[0] = (lv_point_t){5, 5};
+  points[1] = (lv_point_t){20, 30};
+  points[2] = (lv_point_t){35, 8};
+  render();
+
+  lv_color_t joint = buf[30 * 40 + 20];
+  lv_color_t line = buf[17 * 40 + 12];
+  TEST_ASSERT_EQUAL_COLOR(line, joint);
+  TEST_ASSERT_TRUE(line.ch.red < 0xff);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_white(), buf[25 * 40 + 5]);
+}
+
+void test_draw_raster_polyline_long(void)
+{
+  /*Many segments with round joints: all the joints are blended only once*/
+  polyline = true;
+  buf_w = 100;
+  point_cnt = ZIGZAG_CNT;
+  uint16_t i;
+  for(i = 0; i < ZIGZAG_CNT; i++) {
+    points[i].x = 4 + i * 7;
+    points[i].y = i % 2 ? 32 : 8;
+  }
+  render();
+
+  /*The middle of the 10th segment*/
+  lv_color_t line = buf[20 * buf_w + 70];
+  TEST_ASSERT_TRUE(line.ch.red < 0xff);
+  for(i = 1; i < ZIGZAG_CNT - 1; i++) {
+    TEST_ASSERT_EQUAL_COLOR(line, buf[points[i].y * buf_w + points[i].x]);
+  }
+}
+
+#endif
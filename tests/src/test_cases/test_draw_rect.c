@@ -0,0 +1,98 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W 60
+#define CANVAS_H 40
+
+void test_draw_rect_radius_corners(void);
+void test_draw_rect_radius_coverage(void);
+
+static lv_color_t canvas_buf[CANVAS_W * CANVAS_H];
+static lv_color_t ref_buf[CANVAS_W * CANVAS_H];
+
+static void rect_draw(lv_obj_t * canvas, lv_coord_t radius, lv_opa_t opa, lv_coord_t border_w, bool mask_stack)
+{
+  lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+  lv_draw_rect_dsc_t dsc;
+  lv_draw_rect_dsc_init(&dsc);
+  dsc.radius = radius;
+  dsc.bg_color = lv_palette_main(LV_PALETTE_BLUE);
+  dsc.bg_opa = opa;
+  dsc.border_width = border_w;
+  dsc.border_color = lv_palette_main(LV_PALETTE_RED);
+  dsc.border_opa = opa;
+
+  /*A mask which keeps every pixel, only to draw the corners with the mask stack*/
+  lv_draw_mask_line_param_t line_mask;
+  int16_t mask_id = LV_MASK_ID_INV;
+  if(mask_stack) {
+    lv_draw_mask_line_points_init(&line_mask, -100, -100, 100, -100, LV_DRAW_MASK_LINE_SIDE_BOTTOM);
+    mask_id = lv_draw_mask_add(&line_mask, NULL);
+  }
+
+  lv_canvas_draw_rect(canvas, 5, 5, 50, 30, &dsc);
+
+  if(mask_stack) {
+    lv_draw_mask_remove_id(mask_id);
+    lv_draw_mask_free_param(&line_mask);
+  }
+}
+
+void test_draw_rect_radius_corners(void)
+{
+  lv_obj_t * canvas = lv_canvas_create(lv_scr_act());
+  lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+
+  static const lv_coord_t radii[] = {1, 3, 8, 14, LV_RADIUS_CIRCLE};
+  static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_50};
+  static const lv_coord_t border_ws[] = {0, 1, 4};
+
+  /*The corners drawn directly are the same as the ones drawn with the mask stack*/
+  uint32_t r;
+  uint32_t o;
+  uint32_t b;
+  for(r = 0; r < sizeof(radii) / sizeof(radii[0]); r++) {
+    for(o = 0; o < sizeof(opas) / sizeof(opas[0]); o++) {
+      for(b = 0; b < sizeof(border_ws) / sizeof(border_ws[0]); b++) {
+        rect_draw(canvas, radii[r], opas[o], border_ws[b], true);
+        lv_memcpy(ref_buf, canvas_buf, sizeof(canvas_buf));
+        rect_draw(canvas, radii[r], opas[o], border_ws[b], false);
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf, canvas_buf, sizeof(canvas_buf));
+      }
+    }
+  }
+
+  lv_obj_del(canvas);
+}
+
+void test_draw_rect_radius_coverage(void)
+{
+  lv_obj_t * canvas = lv_canvas_create(lv_scr_act());
+  lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+
+  rect_draw(canvas, 10, LV_OPA_COVER, 0, false);
+  lv_color_t bg_color = lv_palette_main(LV_PALETTE_BLUE);
+
+  /*The outer corner pixel is not covered and the middle of the edges are fully covered*/
+  TEST_ASSERT_EQUAL_COLOR(lv_color_white(), canvas_buf[5 * CANVAS_W + 5]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_white(), canvas_buf[34 * CANVAS_W + 54]);
+  TEST_ASSERT_EQUAL_COLOR(bg_color, canvas_buf[5 * CANVAS_W + 30]);
+  TEST_ASSERT_EQUAL_COLOR(bg_color, canvas_buf[20 * CANVAS_W + 5]);
+  TEST_ASSERT_EQUAL_COLOR(bg_color, canvas_buf[34 * CANVAS_W + 30]);
+  TEST_ASSERT_EQUAL_COLOR(bg_color, canvas_buf[20 * CANVAS_W + 54]);
+
+  /*The pixels on the arc of the corners are partially covered, the same in all corners*/
+  lv_color_t arc_px = canvas_buf[6 * CANVAS_W + 9];
+  TEST_ASSERT_NOT_EQUAL(lv_color_to32(lv_color_white()), lv_color_to32(arc_px));
+  TEST_ASSERT_NOT_EQUAL(lv_color_to32(bg_color), lv_color_to32(arc_px));
+  TEST_ASSERT_EQUAL_COLOR(arc_px, canvas_buf[6 * CANVAS_W + 50]);
+  TEST_ASSERT_EQUAL_COLOR(arc_px, canvas_buf[33 * CANVAS_W + 9]);
+  TEST_ASSERT_EQUAL_COLOR(arc_px, canvas_buf[33 * CANVAS_W + 50]);
+
+  lv_obj_del(canvas);
+}
+
+#endif
@@ -25,7 +25,9 @@
  **********************/
 
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2);
+static void compare_glyphs(const lv_font_t * f1, const lv_font_t * f2);
 void test_font_loader(void);
+void test_font_loader_lazy(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -58,6 +60,84 @@ void test_font_loader(void)
     lv_font_free(font_3_bin);
 }
 
+void test_font_loader_lazy(void)
+{
+    /*Smaller cache than the glyphs of the fonts*/
+    lv_font_t * font_1_bin = lv_font_load_lazy("F:src/test_fonts/font_1.fnt", 1024);
+    lv_font_t * font_2_bin = lv_font_load_lazy("F:src/test_fonts/font_2.fnt", 1024);
+    lv_font_t * font_3_bin = lv_font_load_lazy("F:src/test_fonts/font_3.fnt", 1024);
+
+    /*Nothing is loaded in advance*/
+    lv_font_lazy_stat_t stat;
+    lv_font_lazy_get_stat(font_3_bin, &stat);
+    TEST_ASSERT_EQUAL(0, stat.load_cnt);
+
+    compare_glyphs(&font_1, font_1_bin);
+    compare_glyphs(&font_2, font_2_bin);
+    compare_glyphs(&font_3, font_3_bin);
+
+    /*The least recently used glyphs were freed*/
+    lv_font_lazy_get_stat(font_3_bin, &stat);
+    TEST_ASSERT_LESS_OR_EQUAL(1024, stat.cache_used);
+    TEST_ASSERT_GREATER_THAN(stat.glyph_cnt, stat.load_cnt);
+
+    lv_font_free(font_1_bin);
+    lv_font_free(font_2_bin);
+    lv_font_free(font_3_bin);
+
+    /*The pre-warmed glyphs are not read again*/
+    font_3_bin = lv_font_load_lazy("F:src/test_fonts/font_3.fnt", 4096);
+    lv_font_lazy_prewarm(font_3_bin, "0123");
+    lv_font_lazy_get_stat(font_3_bin, &stat);
+    TEST_ASSERT_EQUAL(4, stat.glyph_cnt);
+    TEST_ASSERT_EQUAL(4, stat.load_cnt);
+
+    lv_font_glyph_dsc_t g;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font_3_bin, &g, '2', '\0'));
+    TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(font_3_bin, '2'));
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(font_3_bin, &g, 0x4E00, '\0'));
+    lv_font_lazy_get_stat(font_3_bin, &stat);
+    TEST_ASSERT_EQUAL(4, stat.load_cnt);
+
+    lv_font_free(font_3_bin);
+}
+
+static void compare_glyphs(const lv_font_t * f1, const lv_font_t * f2)
+{
+    TEST_ASSERT_NOT_NULL_MESSAGE(f2, "font not null");
+
+    uint32_t letter;
+    /*The ASCII range which is in the binary fonts too*/
+    for(letter = 0x20; letter < 0x7F; letter++) {
+        lv_font_glyph_dsc_t g1;
+        lv_font_glyph_dsc_t g2;
+        /*With kerning*/
+        bool ret1 = lv_font_get_glyph_dsc(f1, &g1, letter, 'A');
+        bool ret2 = lv_font_get_glyph_dsc(f2, &g2, letter, 'A');
+        TEST_ASSERT_EQUAL(ret1, ret2);
+        if(!ret1) continue;
+
+        TEST_ASSERT_EQUAL_INT_MESSAGE(g1.adv_w, g2.adv_w, "adv_w");
+        TEST_ASSERT_EQUAL_INT_MESSAGE(g1.box_w, g2.box_w, "box_w");
+        TEST_ASSERT_EQUAL_INT_MESSAGE(g1.box_h, g2.box_h, "box_h");
+        TEST_ASSERT_EQUAL_INT_MESSAGE(g1.ofs_x, g2.ofs_x, "ofs_x");
+        TEST_ASSERT_EQUAL_INT_MESSAGE(g1.ofs_y, g2.ofs_y, "ofs_y");
+        TEST_ASSERT_EQUAL_INT_MESSAGE(g1.bpp, g2.bpp, "bpp");
+
+        /*The static font decompresses into a shared buffer so copy it*/
+        uint32_t bpp = g1.bpp == 3 ? 4 : g1.bpp;
+        uint32_t size = (g1.box_w * g1.box_h * bpp + 7) / 8;
+        static uint8_t bmp1[2048];
+        TEST_ASSERT_LESS_OR_EQUAL(sizeof(bmp1), size);
+        const uint8_t * p1 = lv_font_get_glyph_bitmap(f1, letter);
+        if(p1) lv_memcpy(bmp1, p1, size);
+        const uint8_t * p2 = lv_font_get_glyph_bitmap(f2, letter);
+        if(size == 0) continue;
+        TEST_ASSERT_EQUAL(p1 == NULL, p2 == NULL);
+        if(p1) TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(bmp1, p2, size, "glyph_bitmap");
+    }
+}
+
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(f1, "font not null");
@@ -0,0 +1,351 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_FONT_TTF
+
+#define KOREAN_TTF  "F:../src/font/korean.ttf"
+
+void test_font_ttf_outlines(void);
+void test_font_ttf_kerning(void);
+void test_font_ttf_file(void);
+void test_font_ttf_cache(void);
+void test_font_ttf_cache_oversize(void);
+
+static uint8_t ttf_buf[512];
+
+static uint32_t put16(uint32_t ofs, uint16_t v)
+{
+  ttf_buf[ofs] = v >> 8;
+  ttf_buf[ofs + 1] = v & 0xff;
+  return ofs + 2;
+}
+
+static uint32_t put32(uint32_t ofs, uint32_t v)
+{
+  ofs = put16(ofs, v >> 16);
+  return put16(ofs, v & 0xffff);
+}
+
+static uint32_t put_table(uint32_t * dir, const char * tag, uint32_t start, uint32_t end)
+{
+  *dir = put32(*dir, ((uint32_t)tag[0] << 24) | ((uint32_t)tag[1] << 16) | ((uint32_t)tag[2] << 8) | tag[3]);
+  *dir = put32(*dir, 0);
+  *dir = put32(*dir, start);
+  *dir = put32(*dir, end - start);
+  return (end + 3) & ~3;
+}
+
+/*Add the flags of a contour with 4 points to a simple glyph*/
+static uint32_t put_flags(uint32_t ofs, uint8_t flag)
+{
+  uint32_t i;
+  for(i = 0; i < 4; i++) ttf_buf[ofs++] = flag;
+  return ofs;
+}
+
+/**
+ * Create a font with 1000 units per em and these glyphs:
+ * 'A': 500x500 square with a 300x300 hole in the middle, 'B': a contour with only control points (circle like),
+ * 'C': composite glyph with two 'A's next to each other. The kerning of "AB" is -100.
+ */
+static uint32_t build_ttf(void)
+{
+  lv_memset_00(ttf_buf, sizeof(ttf_buf));
+  uint32_t dir = put32(0, 0x00010000);
+  dir = put16(dir, 8);
+  dir += 6;
+  uint32_t p = 12 + 8 * 16;
+  uint32_t t;
+
+  t = p;
+  put16(t + 18, 1000);            /*units per em*/
+  put16(t + 50, 0);               /*short loca*/
+  p = put_table(&dir, "head", t, t + 54);
+
+  t = p;
+  put16(t + 4, 800);              /*ascent*/
+  put16(t + 6, (uint16_t) -200);  /*descent*/
+  put16(t + 34, 4);               /*number of h. metrics*/
+  p = put_table(&dir, "hhea", t, t + 36);
+
+  t = p;
+  put32(t, 0x00005000);
+  put16(t + 4, 4);                /*number of glyphs*/
+  p = put_table(&dir, "maxp", t, t + 6);
+
+  /*Format 4 with 'A'..'C' -> 1..3*/
+  t = p;
+  p = put16(t, 0);
+  p = put16(p, 1);
+  p = put16(p, 3);
+  p = put16(p, 1);
+  p = put32(p, 12);
+  p = put16(p, 4);
+  p = put16(p, 32);
+  p = put16(p, 0);
+  p = put16(p, 4);                /*2 segments*/
+  p += 6;
+  p = put16(p, 'C');
+  p = put16(p, 0xFFFF);
+  p += 2;
+  p = put16(p, 'A');
+  p = put16(p, 0xFFFF);
+  p = put16(p, (uint16_t)(1 - 'A'));
+  p = put16(p, 1);
+  p += 4;
+  p = put_table(&dir, "cmap", t, p);
+
+  t = p;
+  p = put32(t, 500 << 16);
+  p = put32(p, 500 << 16);
+  p = put32(p, 600 << 16);
+  p = put32(p, 1200 << 16);
+  p = put_table(&dir, "hmtx", t, p);
+
+  /*Glyphs*/
+  uint32_t glyf = p;
+  uint32_t loca[5];
+  loca[0] = 0;
+  loca[1] = 0;                    /*Glyph 0 is empty*/
+
+  static const int16_t outer[8] = {0, 0, 0, 500, 500, 0, 0, -500};
+  static const int16_t inner[8] = {-400, 100, 300, 0, 0, 300, -300, 0};
+  uint32_t i;
+  p = put16(glyf, 2);
+  p = put16(p + 8, 3);
+  p = put16(p, 7);
+  p = put16(p, 0);
+  p = put_flags(p, 0x01);
+  p = put_flags(p, 0x01);
+  for(i = 0; i < 4; i++) p = put16(p, outer[i * 2]);
+  for(i = 0; i < 4; i++) p = put16(p, inner[i * 2]);
+  for(i = 0; i < 4; i++) p = put16(p, outer[i * 2 + 1]);
+  for(i = 0; i < 4; i++) p = put16(p, inner[i * 2 + 1]);
+  loca[2] = p - glyf;
+
+  p = put16(p, 1);
+  p = put16(p + 8, 3);
+  p = put16(p, 0);
+  p = put_flags(p, 0x00);
+  for(i = 0; i < 4; i++) p = put16(p, outer[i * 2]);
+  for(i = 0; i < 4; i++) p = put16(p, outer[i * 2 + 1]);
+  loca[3] = p - glyf;
+
+  p = put16(p, (uint16_t) -1);
+  p += 8;
+  p = put16(p, 0x0023);           /*Words, x-y values, more components*/
+  p = put16(p, 1);
+  p = put32(p, 0);
+  p = put16(p, 0x0003);
+  p = put16(p, 1);
+  p = put16(p, 600);
+  p = put16(p, 0);
+  loca[4] = p - glyf;
+  p = put_table(&dir, "glyf", glyf, p);
+
+  t = p;
+  for(i = 0; i < 5; i++) p = put16(p, loca[i] / 2);
+  p = put_table(&dir, "loca", t, p);
+
+  t = p;
+  p = put16(t, 0);
+  p = put16(p, 1);
+  p = put16(p, 0);
+  p = put16(p, 20);
+  p = put16(p, 0x0001);           /*Horizontal, format 0*/
+  p = put16(p, 1);
+  p += 6;
+  p = put16(p, 1);
+  p = put16(p, 2);
+  p = put16(p, (uint16_t) -100);
+  p = put_table(&dir, "kern", t, p);
+
+  TEST_ASSERT_LESS_OR_EQUAL(sizeof(ttf_buf), p);
+  return p;
+}
+
+static uint8_t get_px(const uint8_t * bitmap, uint32_t w, uint32_t x, uint32_t y)
+{
+  uint32_t i = y * w + x;
+  return (i & 1) ? bitmap[i >> 1] & 0x0F : bitmap[i >> 1] >> 4;
+}
+
+void test_font_ttf_outlines(void)
+{
+  uint32_t size = build_ttf();
+  lv_font_t * font = lv_font_ttf_create_data(ttf_buf, size, 10, 4096);
+  TEST_ASSERT_NOT_NULL(font);
+  TEST_ASSERT_EQUAL(10, font->line_height);
+  TEST_ASSERT_EQUAL(2, font->base_line);
+
+  /*The square with a hole is on the pixel borders so the coverage is exact*/
+  lv_font_glyph_dsc_t g;
+  TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, 'A', '\0'));
+  TEST_ASSERT_EQUAL(5, g.adv_w);
+  TEST_ASSERT_EQUAL(5, g.box_w);
+  TEST_ASSERT_EQUAL(5, g.box_h);
+  TEST_ASSERT_EQUAL(0, g.ofs_x);
+  TEST_ASSERT_EQUAL(0, g.ofs_y);
+  TEST_ASSERT_EQUAL(4, g.bpp);
+  const uint8_t * bitmap = lv_font_get_glyph_bitmap(font, 'A');
+  uint32_t x;
+  uint32_t y;
+  for(y = 0; y < 5; y++) {
+    for(x = 0; x < 5; x++) {
+      bool hole = x >= 1 && x <= 3 && y >= 1 && y <= 3;
+      TEST_ASSERT_EQUAL(hole ? 0 : 15, get_px(bitmap, 5, x, y));
+    }
+  }
+
+  /*Only control points: the corners are cut*/
+  TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, 'B', '\0'));
+  TEST_ASSERT_EQUAL(5, g.box_w);
+  bitmap = lv_font_get_glyph_bitmap(font, 'B');
+  TEST_ASSERT_EQUAL(15, get_px(bitmap, 5, 2, 2));
+  TEST_ASSERT_LESS_THAN(8, get_px(bitmap, 5, 0, 0));
+  TEST_ASSERT_LESS_THAN(8, get_px(bitmap, 5, 4, 4));
+
+  /*Composite glyph of two squares with 1 px gap*/
+  TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, 'C', '\0'));
+  TEST_ASSERT_EQUAL(12, g.adv_w);
+  TEST_ASSERT_EQUAL(11, g.box_w);
+  TEST_ASSERT_EQUAL(5, g.box_h);
+  bitmap = lv_font_get_glyph_bitmap(font, 'C');
+  TEST_ASSERT_EQUAL(15, get_px(bitmap, 11, 4, 0));
+  TEST_ASSERT_EQUAL(0, get_px(bitmap, 11, 5, 0));
+  TEST_ASSERT_EQUAL(15, get_px(bitmap, 11, 6, 2));
+  TEST_ASSERT_EQUAL(0, get_px(bitmap, 11, 8, 2));
+
+  TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(font, &g, 'D', '\0'));
+  TEST_ASSERT_NULL(lv_font_get_glyph_bitmap(font, 'D'));
+
+  /*Scale up*/
+  lv_font_ttf_set_size(font, 20);
+  TEST_ASSERT_EQUAL(20, font->line_height);
+  TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, 'A', '\0'));
+  TEST_ASSERT_EQUAL(10, g.box_w);
+  bitmap = lv_font_get_glyph_bitmap(font, 'A');
+  TEST_ASSERT_EQUAL(15, get_px(bitmap, 10, 1, 5));
+  TEST_ASSERT_EQUAL(0, get_px(bitmap, 10, 2, 5));
+
+  /*Truncated data*/
+  TEST_ASSERT_NULL(lv_font_ttf_create_data(ttf_buf, 100, 10, 4096));
+
+  lv_font_ttf_destroy(font);
+}
+
+void test_font_ttf_kerning(void)
+{
+  uint32_t size = build_ttf();
+  lv_font_t * font = lv_font_ttf_create_data(ttf_buf, size, 10, 4096);
+
+  TEST_ASSERT_EQUAL(4, lv_font_get_glyph_width(font, 'A', 'B'));
+  TEST_ASSERT_EQUAL(5, lv_font_get_glyph_width(font, 'A', 'C'));
+  TEST_ASSERT_EQUAL(6, lv_font_get_glyph_width(font, 'B', 'A'));
+
+  lv_font_ttf_destroy(font);
+}
+
+void test_font_ttf_file(void)
+{
+  lv_font_t * font = lv_font_ttf_create_file(KOREAN_TTF, 32, 16 * 1024);
+  TEST_ASSERT_NOT_NULL(font);
+
+  /*879 ascent and -145 descent of 1024 units rounded up*/
+  TEST_ASSERT_EQUAL(28 + 5, font->line_height);
+  TEST_ASSERT_EQUAL(5, font->base_line);
+
+  lv_font_glyph_dsc_t g;
+  TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, 0xAC00, '\0'));
+  TEST_ASSERT_GREATER_THAN(16, g.box_w);
+  TEST_ASSERT_GREATER_THAN(16, g.box_h);
+  TEST_ASSERT_LESS_OR_EQUAL(font->line_height, g.box_h);
+
+  /*Some pixels are fully covered*/
+  const uint8_t * bitmap = lv_font_get_glyph_bitmap(font, 0xAC00);
+  uint32_t full = 0;
+  uint32_t i;
+  for(i = 0; i < (uint32_t)g.box_w * g.box_h; i++) {
+    if(get_px(bitmap, g.box_w, i % g.box_w, i / g.box_w) == 15) full++;
+  }
+  TEST_ASSERT_GREATER_THAN(g.box_w, full);
+
+  /*Draw with it*/
+  lv_obj_t * label = lv_label_create(lv_scr_act());
+  lv_obj_set_style_text_font(label, font, 0);
+  lv_label_set_text(label, "Hello 가나다");
+  lv_refr_now(NULL);
+  TEST_ASSERT_GREATER_THAN(100, lv_obj_get_width(label));
+  lv_obj_del(label);
+
+  TEST_ASSERT_NULL(lv_font_ttf_create_file("F:src/test_fonts/font_1.fnt", 32, 1024));
+  TEST_ASSERT_NULL(lv_font_ttf_create_file("F:not_existing.ttf", 32, 1024));
+
+  lv_font_ttf_destroy(font);
+}
+
+void test_font_ttf_cache(void)
+{
+  lv_font_t * font = lv_font_ttf_create_file(KOREAN_TTF, 32, 4096);
+
+  lv_font_glyph_dsc_t g;
+  uint32_t i;
+  for(i = 0; i < 100; i++) {
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, 0xAC00 + i, '\0'));
+  }
+
+  lv_font_ttf_stat_t stat;
+  lv_font_ttf_get_stat(font, &stat);
+  TEST_ASSERT_EQUAL(100, stat.render_cnt);
+  TEST_ASSERT_LESS_OR_EQUAL(4096, stat.cache_used);
+  TEST_ASSERT_LESS_THAN(100, stat.glyph_cnt);
+  TEST_ASSERT_GREATER_THAN(1, stat.glyph_cnt);
+
+  /*The recently used glyph is in the cache but the first was freed*/
+  lv_font_get_glyph_bitmap(font, 0xAC00 + 99);
+  lv_font_get_glyph_dsc(font, &g, 0xAC00 + 99, '\0');
+  lv_font_ttf_get_stat(font, &stat);
+  TEST_ASSERT_EQUAL(100, stat.render_cnt);
+  lv_font_get_glyph_dsc(font, &g, 0xAC00, '\0');
+  lv_font_ttf_get_stat(font, &stat);
+  TEST_ASSERT_EQUAL(101, stat.render_cnt);
+
+  /*A new size drops the glyphs*/
+  lv_font_ttf_set_size(font, 16);
+  lv_font_ttf_get_stat(font, &stat);
+  TEST_ASSERT_EQUAL(0, stat.glyph_cnt);
+  TEST_ASSERT_EQUAL(0, stat.cache_used);
+
+  lv_font_ttf_destroy(font);
+}
+
+void test_font_ttf_cache_oversize(void)
+{
+  /*The glyphs are bigger than the cache*/
+  lv_font_t * font = lv_font_ttf_create_file(KOREAN_TTF, 32, 128);
+
+  lv_font_glyph_dsc_t g;
+  TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, 0xAC00, '\0'));
+  TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(font, 0xAC00));
+
+  /*The last glyph is kept for drawing it but not counted in the cache*/
+  lv_font_ttf_stat_t stat;
+  lv_font_ttf_get_stat(font, &stat);
+  TEST_ASSERT_EQUAL(1, stat.render_cnt);
+  TEST_ASSERT_EQUAL(0, stat.glyph_cnt);
+  TEST_ASSERT_EQUAL(0, stat.cache_used);
+
+  TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, 0xAC01, '\0'));
+  TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, 0xAC00, '\0'));
+  lv_font_ttf_get_stat(font, &stat);
+  TEST_ASSERT_EQUAL(3, stat.render_cnt);
+  TEST_ASSERT_EQUAL(0, stat.cache_used);
+
+  lv_font_ttf_destroy(font);
+}
+
+#endif /*LV_USE_FONT_TTF*/
+
+#endif
@@ -0,0 +1,182 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define FS_HOR_RES 40
+#define FS_VER_RES 30
+
+void test_frame_sched_start_on_vsync(void);
+void test_frame_sched_missed_vsync(void);
+void test_frame_sched_time_percentiles(void);
+void test_frame_sched_drv_update_period(void);
+
+static lv_color_t fs_buf[FS_HOR_RES * FS_VER_RES];
+static lv_disp_drv_t fs_drv;
+static uint32_t flush_cnt;
+static uint32_t flush_vsync_cnt;    /*Simulate vsyncs during flushing*/
+static uint32_t flush_time;         /*Make the flushing slow*/
+
+static void fs_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+  LV_UNUSED(area);
+  LV_UNUSED(color_p);
+  flush_cnt++;
+
+  uint32_t i;
+  for(i = 0; i < flush_vsync_cnt; i++) lv_disp_vsync_ready(disp_drv);
+
+  lv_tick_inc(flush_time);
+
+  lv_disp_flush_ready(disp_drv);
+}
+
+static lv_disp_t * fs_disp_create(bool vsync)
+{
+  static lv_disp_draw_buf_t draw_buf;
+  lv_disp_draw_buf_init(&draw_buf, fs_buf, NULL, FS_HOR_RES * FS_VER_RES);
+  lv_disp_drv_init(&fs_drv);
+  fs_drv.draw_buf = &draw_buf;
+  fs_drv.flush_cb = fs_flush_cb;
+  fs_drv.hor_res = FS_HOR_RES;
+  fs_drv.ver_res = FS_VER_RES;
+  fs_drv.vsync = vsync;
+  lv_disp_t * disp = lv_disp_drv_register(&fs_drv);
+
+  flush_cnt = 0;
+  flush_vsync_cnt = 0;
+  flush_time = 0;
+  return disp;
+}
+
+void test_frame_sched_start_on_vsync(void)
+{
+  lv_disp_t * disp = fs_disp_create(true);
+  lv_timer_t * tmr = disp->refr_timer;
+
+  /*The screen is invalid but the frame waits for a vsync*/
+  _lv_disp_refr_timer(tmr);
+  _lv_disp_refr_timer(tmr);
+  TEST_ASSERT_EQUAL(0, flush_cnt);
+  TEST_ASSERT_FALSE(tmr->paused);
+
+  lv_disp_vsync_ready(&fs_drv);
+  _lv_disp_refr_timer(tmr);
+  TEST_ASSERT_EQUAL(1, flush_cnt);
+
+  /*Idle: the timer doesn't run even if vsyncs come*/
+  TEST_ASSERT_TRUE(tmr->paused);
+  lv_disp_vsync_ready(&fs_drv);
+  lv_disp_vsync_ready(&fs_drv);
+
+  /*The vsyncs while idle don't start the next frame*/
+  lv_obj_invalidate(lv_disp_get_scr_act(disp));
+  TEST_ASSERT_FALSE(tmr->paused);
+  _lv_disp_refr_timer(tmr);
+  TEST_ASSERT_EQUAL(1, flush_cnt);
+
+  /*2 vsyncs passed before the timer could run: one was dropped*/
+  lv_disp_vsync_ready(&fs_drv);
+  lv_disp_vsync_ready(&fs_drv);
+  _lv_disp_refr_timer(tmr);
+  TEST_ASSERT_EQUAL(2, flush_cnt);
+
+  lv_disp_frame_stat_t stat;
+  lv_refr_get_frame_stat(disp, &stat);
+  TEST_ASSERT_EQUAL(2, stat.frame_cnt);
+  TEST_ASSERT_EQUAL(0, stat.missed_cnt);
+  TEST_ASSERT_EQUAL(1, stat.dropped_cnt);
+
+  /*`lv_refr_now()` doesn't wait*/
+  lv_obj_invalidate(lv_disp_get_scr_act(disp));
+  lv_refr_now(disp);
+  TEST_ASSERT_EQUAL(3, flush_cnt);
+
+  lv_disp_remove(disp);
+}
+
+void test_frame_sched_missed_vsync(void)
+{
+  lv_disp_t * disp = fs_disp_create(true);
+  lv_timer_t * tmr = disp->refr_timer;
+  _lv_disp_refr_timer(tmr);
+  lv_disp_vsync_ready(&fs_drv);
+  lv_refr_reset_frame_stat(disp);
+
+  /*2 vsyncs came during the frame*/
+  flush_vsync_cnt = 2;
+  _lv_disp_refr_timer(tmr);
+  TEST_ASSERT_EQUAL(1, flush_cnt);
+
+  lv_disp_frame_stat_t stat;
+  lv_refr_get_frame_stat(disp, &stat);
+  TEST_ASSERT_EQUAL(1, stat.missed_cnt);
+  TEST_ASSERT_EQUAL(2, stat.dropped_cnt);
+
+  /*The next frame waits for a new vsync*/
+  flush_vsync_cnt = 0;
+  lv_obj_invalidate(lv_disp_get_scr_act(disp));
+  _lv_disp_refr_timer(tmr);
+  TEST_ASSERT_EQUAL(1, flush_cnt);
+  lv_disp_vsync_ready(&fs_drv);
+  _lv_disp_refr_timer(tmr);
+  TEST_ASSERT_EQUAL(2, flush_cnt);
+
+  lv_disp_remove(disp);
+}
+
+void test_frame_sched_time_percentiles(void)
+{
+  lv_disp_t * disp = fs_disp_create(false);
+  lv_obj_t * scr = lv_disp_get_scr_act(disp);
+  lv_refr_now(disp);
+  lv_refr_reset_frame_stat(disp);
+
+  /*9 fast frames and a slow one*/
+  uint32_t i;
+  for(i = 0; i < 10; i++) {
+    flush_time = i == 4 ? 5 : 0;
+    lv_obj_invalidate(scr);
+    lv_refr_now(disp);
+  }
+
+  lv_disp_frame_stat_t stat;
+  lv_refr_get_frame_stat(disp, &stat);
+  TEST_ASSERT_EQUAL(10, stat.frame_cnt);
+  TEST_ASSERT_EQUAL(0, stat.time_p50);
+  TEST_ASSERT_EQUAL(0, stat.time_p90);
+  TEST_ASSERT_EQUAL(5, stat.time_p99);
+  TEST_ASSERT_EQUAL(5, stat.time_max);
+
+  lv_refr_reset_frame_stat(disp);
+  lv_refr_get_frame_stat(disp, &stat);
+  TEST_ASSERT_EQUAL(0, stat.frame_cnt);
+  TEST_ASSERT_EQUAL(0, stat.time_max);
+
+  lv_disp_remove(disp);
+}
+
+void test_frame_sched_drv_update_period(void)
+{
+  lv_disp_t * disp = fs_disp_create(false);
+  lv_timer_t * tmr = disp->refr_timer;
+
+  /*Rotating keeps the period set by the application*/
+  lv_timer_set_period(tmr, 50);
+  lv_disp_set_rotation(disp, LV_DISP_ROT_90);
+  TEST_ASSERT_EQUAL(50, tmr->period);
+
+  /*Enabling vsync checks it often and disabling it restores the period*/
+  fs_drv.vsync = 1;
+  lv_disp_drv_update(disp, &fs_drv);
+  TEST_ASSERT_EQUAL(1, tmr->period);
+  lv_disp_set_rotation(disp, LV_DISP_ROT_NONE);
+  TEST_ASSERT_EQUAL(1, tmr->period);
+  fs_drv.vsync = 0;
+  lv_disp_drv_update(disp, &fs_drv);
+  TEST_ASSERT_EQUAL(50, tmr->period);
+
+  lv_disp_remove(disp);
+}
+
+#endif
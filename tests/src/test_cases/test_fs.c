@@ -0,0 +1,271 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FS_TEST_FILE "src/test_fonts/font_1.fnt"
+
+void test_fs_cached_read(void);
+void test_fs_mapped_read(void);
+void test_fs_mapped_font(void);
+
+typedef struct {
+    FILE * fp;
+    uint8_t * content;
+    uint32_t size;
+} test_file_t;
+
+extern lv_font_t font_1;
+
+static void * open_cb(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    (void) drv;
+    (void) mode;
+
+    FILE * fp = fopen(path, "rb");
+    if(fp == NULL) return NULL;
+
+    test_file_t * f = calloc(1, sizeof(test_file_t));
+    f->fp = fp;
+    return f;
+}
+
+static lv_fs_res_t close_cb(lv_fs_drv_t * drv, void * file_p)
+{
+    (void) drv;
+
+    test_file_t * f = file_p;
+    fclose(f->fp);
+    free(f->content);
+    free(f);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    (void) drv;
+
+    test_file_t * f = file_p;
+    *br = fread(buf, 1, btr, f->fp);
+
+    /*Report the end of the file to see that it's returned the same way with and without cache*/
+    if(btr > 0 && *br == 0) return LV_FS_RES_UNKNOWN;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t w)
+{
+    (void) drv;
+
+    test_file_t * f = file_p;
+    int w2 = SEEK_SET;
+    if(w == LV_FS_SEEK_CUR) w2 = SEEK_CUR;
+    else if(w == LV_FS_SEEK_END) w2 = SEEK_END;
+
+    fseek(f->fp, pos, w2);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    (void) drv;
+
+    test_file_t * f = file_p;
+    *pos_p = ftell(f->fp);
+    return LV_FS_RES_OK;
+}
+
+/*Simulate a memory mapped file by reading the whole content*/
+static const void * map_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * size)
+{
+    (void) drv;
+
+    test_file_t * f = file_p;
+    fseek(f->fp, 0, SEEK_END);
+    f->size = ftell(f->fp);
+    f->content = malloc(f->size);
+    fseek(f->fp, 0, SEEK_SET);
+    if(fread(f->content, 1, f->size, f->fp) != f->size) return NULL;
+
+    *size = f->size;
+    return f->content;
+}
+
+static void drv_register(lv_fs_drv_t * drv, char letter, uint16_t cache_size, bool map)
+{
+    if(lv_fs_get_drv(letter)) return;
+
+    lv_fs_drv_init(drv);
+    drv->letter = letter;
+    drv->cache_size = cache_size;
+    drv->open_cb = open_cb;
+    drv->close_cb = close_cb;
+    drv->read_cb = read_cb;
+    drv->seek_cb = seek_cb;
+    drv->tell_cb = tell_cb;
+    if(map) drv->map_cb = map_cb;
+    lv_fs_drv_register(drv);
+}
+
+static uint8_t * file_load(uint32_t * size)
+{
+    FILE * fp = fopen(FS_TEST_FILE, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    fseek(fp, 0, SEEK_END);
+    *size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    uint8_t * content = malloc(*size);
+    TEST_ASSERT_EQUAL(*size, fread(content, 1, *size, fp));
+    fclose(fp);
+    return content;
+}
+
+/*Read at a position and compare the result with a file without cache and mapping*/
+static void check_read_at(lv_fs_file_t * f, uint32_t pos, uint32_t btr)
+{
+    static lv_fs_drv_t drv;
+    drv_register(&drv, 'U', 0, false);
+
+    lv_fs_file_t f_ref;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f_ref, "U:" FS_TEST_FILE, LV_FS_MODE_RD));
+    TEST_ASSERT_NULL(f_ref.cache);
+
+    uint8_t buf_ref[16];
+    uint8_t buf[16];
+    uint32_t br_ref;
+    uint32_t br;
+    lv_fs_seek(&f_ref, pos, LV_FS_SEEK_SET);
+    lv_fs_seek(f, pos, LV_FS_SEEK_SET);
+    TEST_ASSERT_EQUAL(lv_fs_read(&f_ref, buf_ref, btr, &br_ref), lv_fs_read(f, buf, btr, &br));
+    TEST_ASSERT_EQUAL(br_ref, br);
+    if(br) TEST_ASSERT_EQUAL_MEMORY(buf_ref, buf, br);
+
+    uint32_t pos_ref;
+    lv_fs_tell(&f_ref, &pos_ref);
+    lv_fs_tell(f, &pos);
+    TEST_ASSERT_EQUAL(pos_ref, pos);
+
+    lv_fs_close(&f_ref);
+}
+
+static void check_reads(const char * path)
+{
+    uint32_t size;
+    uint8_t * ref = file_load(&size);
+
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD));
+    TEST_ASSERT_NOT_NULL(f.cache);
+
+    /*Small reads in order, served from the cache*/
+    uint8_t buf[300];
+    uint32_t br;
+    uint32_t pos;
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, 3, &br));
+        TEST_ASSERT_EQUAL(3, br);
+        TEST_ASSERT_EQUAL_MEMORY(&ref[i * 3], buf, 3);
+    }
+    lv_fs_tell(&f, &pos);
+    TEST_ASSERT_EQUAL(300, pos);
+
+    /*Seek back into the cached block and read over its end*/
+    lv_fs_seek(&f, 20, LV_FS_SEEK_SET);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, 100, &br));
+    TEST_ASSERT_EQUAL(100, br);
+    TEST_ASSERT_EQUAL_MEMORY(&ref[20], buf, 100);
+
+    /*Read larger than the cache*/
+    lv_fs_seek(&f, 10, LV_FS_SEEK_CUR);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, sizeof(buf), &br));
+    TEST_ASSERT_EQUAL(sizeof(buf), br);
+    TEST_ASSERT_EQUAL_MEMORY(&ref[130], buf, sizeof(buf));
+
+    /*Read over the end of the file*/
+    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    lv_fs_tell(&f, &pos);
+    TEST_ASSERT_EQUAL(size, pos);
+    lv_fs_seek(&f, size - 5, LV_FS_SEEK_SET);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, 10, &br));
+    TEST_ASSERT_EQUAL(5, br);
+    TEST_ASSERT_EQUAL_MEMORY(&ref[size - 5], buf, 5);
+
+    /*Read at and after the end of the file*/
+    check_read_at(&f, size - 5, 10);
+    check_read_at(&f, size, 10);
+    check_read_at(&f, size, 10);
+    check_read_at(&f, size + 10, 10);
+
+    lv_fs_close(&f);
+    TEST_ASSERT_NULL(f.cache);
+    free(ref);
+}
+
+void test_fs_cached_read(void)
+{
+    static lv_fs_drv_t drv;
+    drv_register(&drv, 'C', 64, false);
+
+    check_reads("C:" FS_TEST_FILE);
+
+    lv_fs_file_t f;
+    lv_fs_open(&f, "C:" FS_TEST_FILE, LV_FS_MODE_RD);
+    TEST_ASSERT_NULL(lv_fs_map(&f, NULL));
+    lv_fs_close(&f);
+}
+
+void test_fs_mapped_read(void)
+{
+    static lv_fs_drv_t drv;
+    drv_register(&drv, 'M', 0, true);
+
+    check_reads("M:" FS_TEST_FILE);
+
+    uint32_t size;
+    uint8_t * ref = file_load(&size);
+
+    lv_fs_file_t f;
+    lv_fs_open(&f, "M:" FS_TEST_FILE, LV_FS_MODE_RD);
+    uint32_t map_size;
+    const uint8_t * mapped = lv_fs_map(&f, &map_size);
+    TEST_ASSERT_NOT_NULL(mapped);
+    TEST_ASSERT_EQUAL(size, map_size);
+    TEST_ASSERT_EQUAL_MEMORY(ref, mapped, size);
+    lv_fs_close(&f);
+
+    free(ref);
+}
+
+void test_fs_mapped_font(void)
+{
+    static lv_fs_drv_t drv;
+    drv_register(&drv, 'M', 0, true);
+
+    lv_font_t * font = lv_font_load("M:" FS_TEST_FILE);
+    TEST_ASSERT_NOT_NULL(font);
+
+    /*The glyphs has to be the same no matter where the bitmaps are stored*/
+    const char * txt = "AaQ@";
+    uint32_t i;
+    for(i = 0; txt[i]; i++) {
+        lv_font_glyph_dsc_t g_ref;
+        lv_font_glyph_dsc_t g;
+        TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&font_1, &g_ref, txt[i], 0));
+        TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, txt[i], 0));
+        TEST_ASSERT_EQUAL(g_ref.box_w, g.box_w);
+        TEST_ASSERT_EQUAL(g_ref.box_h, g.box_h);
+
+        uint32_t bmp_size = (g.box_w * g.box_h * g.bpp + 7) / 8;
+        const uint8_t * bmp_ref = lv_font_get_glyph_bitmap(&font_1, txt[i]);
+        const uint8_t * bmp = lv_font_get_glyph_bitmap(font, txt[i]);
+        TEST_ASSERT_EQUAL_MEMORY(bmp_ref, bmp, bmp_size);
+    }
+
+    lv_font_free(font);
+}
+
+#endif
@@ -0,0 +1,193 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define IMG_W 50
+#define IMG_H 40
+
+void test_img_filter_box_blur(void);
+void test_img_filter_box_blur_even_size(void);
+void test_img_filter_color_matrix(void);
+void test_img_filter_convolve(void);
+
+static lv_color_t img_buf[IMG_W * IMG_H];
+static lv_color_t ref_buf[IMG_W * IMG_H];
+
+static void img_init(lv_img_dsc_t * img)
+{
+  lv_memset_00(img, sizeof(lv_img_dsc_t));
+  img->header.cf = LV_IMG_CF_TRUE_COLOR;
+  img->header.w = IMG_W;
+  img->header.h = IMG_H;
+  img->data = (const uint8_t *)img_buf;
+  img->data_size = sizeof(img_buf);
+
+  /*Some pattern with different channels*/
+  uint32_t x;
+  uint32_t y;
+  for(y = 0; y < IMG_H; y++) {
+    for(x = 0; x < IMG_W; x++) {
+      img_buf[y * IMG_W + x] = lv_color_make((x * 37 + y * 11) & 0xff, (x * y * 7) & 0xff, (y * 53) & 0xff);
+    }
+  }
+}
+
+/*Box blur with the nearest pixels of the image out of its border*/
+static lv_color_t ref_blur_px(lv_coord_t x, lv_coord_t y, lv_coord_t r_hor, lv_coord_t r_ver)
+{
+  uint32_t sum[3] = {0};
+  lv_coord_t kx;
+  lv_coord_t ky;
+  for(ky = -r_ver; ky <= r_ver; ky++) {
+    for(kx = -r_hor; kx <= r_hor; kx++) {
+      lv_coord_t xs = LV_CLAMP(0, x + kx, IMG_W - 1);
+      lv_coord_t ys = LV_CLAMP(0, y + ky, IMG_H - 1);
+      lv_color_t c = ref_buf[ys * IMG_W + xs];
+      sum[0] += LV_COLOR_GET_R(c);
+      sum[1] += LV_COLOR_GET_G(c);
+      sum[2] += LV_COLOR_GET_B(c);
+    }
+  }
+
+  uint32_t d = (2 * r_hor + 1) * (2 * r_ver + 1);
+  return lv_color_make((sum[0] + d / 2) / d, (sum[1] + d / 2) / d, (sum[2] + d / 2) / d);
+}
+
+static void assert_color_near(lv_color_t exp, lv_color_t act)
+{
+  TEST_ASSERT_INT_WITHIN(1, LV_COLOR_GET_R(exp), LV_COLOR_GET_R(act));
+  TEST_ASSERT_INT_WITHIN(1, LV_COLOR_GET_G(exp), LV_COLOR_GET_G(act));
+  TEST_ASSERT_INT_WITHIN(1, LV_COLOR_GET_B(exp), LV_COLOR_GET_B(act));
+}
+
+void test_img_filter_box_blur(void)
+{
+  lv_img_dsc_t img;
+  img_init(&img);
+  lv_memcpy(ref_buf, img_buf, sizeof(img_buf));
+
+  /*Only a part in the middle. The pixels around are read but not changed.*/
+  lv_area_t a;
+  lv_area_set(&a, 5, 3, 40, 35);
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_filter_box_blur(&img, &a, 0, 4));
+
+  lv_coord_t x;
+  lv_coord_t y;
+  for(y = 0; y < IMG_H; y++) {
+    for(x = 0; x < IMG_W; x++) {
+      bool in_area = x >= a.x1 && x <= a.x2 && y >= a.y1 && y <= a.y2;
+      if(in_area) assert_color_near(ref_blur_px(x, y, 0, 4), img_buf[y * IMG_W + x]);
+      else TEST_ASSERT_EQUAL_COLOR(ref_buf[y * IMG_W + x], img_buf[y * IMG_W + x]);
+    }
+  }
+
+  /*The whole image in both directions*/
+  img_init(&img);
+  lv_memcpy(ref_buf, img_buf, sizeof(img_buf));
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_filter_box_blur(&img, NULL, 3, 2));
+  for(y = 0; y < IMG_H; y++) {
+    for(x = 0; x < IMG_W; x++) {
+      /*Rounded twice so allow 1 more difference*/
+      lv_color_t exp = ref_blur_px(x, y, 3, 2);
+      TEST_ASSERT_INT_WITHIN(2, LV_COLOR_GET_R(exp), LV_COLOR_GET_R(img_buf[y * IMG_W + x]));
+      TEST_ASSERT_INT_WITHIN(2, LV_COLOR_GET_B(exp), LV_COLOR_GET_B(img_buf[y * IMG_W + x]));
+    }
+  }
+
+  /*Not supported format*/
+  img.header.cf = LV_IMG_CF_INDEXED_2BIT;
+  TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_filter_box_blur(&img, NULL, 3, 3));
+}
+
+void test_img_filter_box_blur_even_size(void)
+{
+  lv_img_dsc_t img;
+  lv_coord_t x;
+  lv_coord_t y;
+  lv_coord_t k;
+
+  /*4 pixels in a row: 1 on the left, the pixel and 2 on the right*/
+  img_init(&img);
+  lv_memcpy(ref_buf, img_buf, sizeof(img_buf));
+  TEST_ASSERT_EQUAL(LV_RES_OK, _lv_img_filter_box_blur_size(&img, NULL, 4, 0));
+  for(y = 0; y < IMG_H; y++) {
+    for(x = 0; x < IMG_W; x++) {
+      uint32_t sum = 0;
+      for(k = -1; k <= 2; k++) sum += LV_COLOR_GET_R(ref_buf[y * IMG_W + LV_CLAMP(0, x + k, IMG_W - 1)]);
+      TEST_ASSERT_INT_WITHIN(1, (sum + 2) / 4, LV_COLOR_GET_R(img_buf[y * IMG_W + x]));
+    }
+  }
+
+  /*The same in a column*/
+  img_init(&img);
+  lv_memcpy(ref_buf, img_buf, sizeof(img_buf));
+  TEST_ASSERT_EQUAL(LV_RES_OK, _lv_img_filter_box_blur_size(&img, NULL, 0, 4));
+  for(y = 0; y < IMG_H; y++) {
+    for(x = 0; x < IMG_W; x++) {
+      uint32_t sum = 0;
+      for(k = -1; k <= 2; k++) sum += LV_COLOR_GET_R(ref_buf[LV_CLAMP(0, y + k, IMG_H - 1) * IMG_W + x]);
+      TEST_ASSERT_INT_WITHIN(1, (sum + 2) / 4, LV_COLOR_GET_R(img_buf[y * IMG_W + x]));
+    }
+  }
+
+  /*Odd sizes are the same as the radius*/
+  img_init(&img);
+  TEST_ASSERT_EQUAL(LV_RES_OK, _lv_img_filter_box_blur_size(&img, NULL, 7, 5));
+  lv_memcpy(ref_buf, img_buf, sizeof(img_buf));
+  img_init(&img);
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_filter_box_blur(&img, NULL, 3, 2));
+  TEST_ASSERT_EQUAL_MEMORY(ref_buf, img_buf, sizeof(img_buf));
+}
+
+void test_img_filter_color_matrix(void)
+{
+  lv_img_dsc_t img;
+  img_init(&img);
+  lv_memcpy(ref_buf, img_buf, sizeof(img_buf));
+
+  /*Invert the colors*/
+  static const int16_t invert[20] = {
+    -LV_IMG_FILTER_MATRIX_ONE, 0, 0, 0, 255,
+    0, -LV_IMG_FILTER_MATRIX_ONE, 0, 0, 255,
+    0, 0, -LV_IMG_FILTER_MATRIX_ONE, 0, 255,
+    0, 0, 0, LV_IMG_FILTER_MATRIX_ONE, 0,
+  };
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_filter_color_matrix(&img, NULL, invert));
+
+  uint32_t i;
+  for(i = 0; i < IMG_W * IMG_H; i++) {
+    lv_color_t c = ref_buf[i];
+    lv_color_t exp = lv_color_make(255 - LV_COLOR_GET_R(c), 255 - LV_COLOR_GET_G(c), 255 - LV_COLOR_GET_B(c));
+    TEST_ASSERT_EQUAL_COLOR(exp, img_buf[i]);
+  }
+}
+
+void test_img_filter_convolve(void)
+{
+  lv_img_dsc_t img;
+  img_init(&img);
+  lv_memcpy(ref_buf, img_buf, sizeof(img_buf));
+
+  /*3x3 box blur as convolution*/
+  static const int16_t box[9] = {1, 1, 1, 1, 1, 1, 1, 1, 1};
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_filter_convolve(&img, NULL, box, 3, 0));
+
+  lv_coord_t x;
+  lv_coord_t y;
+  for(y = 0; y < IMG_H; y++) {
+    for(x = 0; x < IMG_W; x++) {
+      assert_color_near(ref_blur_px(x, y, 1, 1), img_buf[y * IMG_W + x]);
+    }
+  }
+
+  /*Sharpening doesn't change a flat area*/
+  static const int16_t sharpen[9] = {0, -1, 0, -1, 5, -1, 0, -1, 0};
+  for(x = 0; x < IMG_W * IMG_H; x++) img_buf[x] = lv_color_hex(0x406080);
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_filter_convolve(&img, NULL, sharpen, 3, 0));
+  TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x406080), img_buf[IMG_W * 10 + 10]);
+
+  TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_filter_convolve(&img, NULL, sharpen, 4, 0));
+}
+
+#endif
@@ -0,0 +1,81 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void test_inv_area_coalesce_obj(void);
+void test_inv_area_separate_objs(void);
+
+void test_inv_area_coalesce_obj(void)
+{
+  lv_obj_t * bar = lv_bar_create(lv_scr_act());
+  lv_obj_set_pos(bar, 10, 10);
+  lv_obj_set_size(bar, 200, 20);
+  lv_refr_now(NULL);
+  lv_refr_reset_inv_stat(NULL);
+
+  /*Many updates in one frame take only one area*/
+  int32_t i;
+  for(i = 1; i <= 50; i++) {
+    lv_bar_set_value(bar, i, LV_ANIM_OFF);
+  }
+
+  lv_disp_t * disp = lv_disp_get_default();
+  lv_disp_inv_stat_t stat;
+  lv_refr_get_inv_stat(NULL, &stat);
+  TEST_ASSERT_EQUAL(1, disp->inv_p);
+  TEST_ASSERT_EQUAL(50, stat.raw_cnt);
+  TEST_ASSERT_EQUAL(49, stat.coalesced_cnt);
+
+  /*The merged area covers every change*/
+  lv_area_t a = disp->inv_areas[0];
+  TEST_ASSERT_TRUE(a.x1 >= bar->coords.x1 - _lv_obj_get_ext_draw_size(bar));
+  TEST_ASSERT_TRUE(a.x2 <= bar->coords.x2 + _lv_obj_get_ext_draw_size(bar));
+  TEST_ASSERT_TRUE(a.x2 - a.x1 + 1 >= (lv_obj_get_content_width(bar) * 49) / 100);
+
+  lv_refr_now(NULL);
+  lv_refr_get_inv_stat(NULL, &stat);
+  TEST_ASSERT_EQUAL(1, stat.frame_cnt);
+  TEST_ASSERT_EQUAL(1, stat.refr_area_cnt);
+
+  /*The next frame starts again*/
+  lv_refr_reset_inv_stat(NULL);
+  lv_obj_invalidate(bar);
+  lv_refr_get_inv_stat(NULL, &stat);
+  TEST_ASSERT_EQUAL(1, disp->inv_p);
+  TEST_ASSERT_EQUAL(0, stat.coalesced_cnt);
+
+  lv_obj_del(bar);
+  lv_refr_now(NULL);
+}
+
+void test_inv_area_separate_objs(void)
+{
+  lv_obj_t * obj1 = lv_obj_create(lv_scr_act());
+  lv_obj_set_pos(obj1, 10, 10);
+  lv_obj_set_size(obj1, 50, 50);
+  lv_obj_t * obj2 = lv_obj_create(lv_scr_act());
+  lv_obj_set_pos(obj2, 300, 300);
+  lv_obj_set_size(obj2, 50, 50);
+  lv_refr_now(NULL);
+
+  /*The far objects are not merged, only the areas of the same object*/
+  lv_obj_invalidate(obj1);
+  lv_obj_invalidate(obj2);
+  lv_obj_set_x(obj1, 12);
+  lv_obj_set_x(obj2, 302);
+  lv_obj_update_layout(lv_scr_act());
+
+  /*The old and the new position is merged*/
+  lv_disp_t * disp = lv_disp_get_default();
+  lv_coord_t ext = _lv_obj_get_ext_draw_size(obj1);
+  TEST_ASSERT_EQUAL(2, disp->inv_p);
+  TEST_ASSERT_EQUAL(10 - ext, disp->inv_areas[0].x1);
+  TEST_ASSERT_EQUAL(12 + 49 + ext, disp->inv_areas[0].x2);
+
+  lv_obj_del(obj1);
+  lv_obj_del(obj2);
+  lv_refr_now(NULL);
+}
+
+#endif
@@ -0,0 +1,125 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void test_label_layout_cache(void);
+void test_label_layout_cache_invalidate(void);
+void test_label_edit_relayout(void);
+
+void test_label_layout_cache(void)
+{
+  lv_obj_t * label = lv_label_create(lv_scr_act());
+  lv_label_set_text(label, "first\nsecond\nthird");
+  lv_refr_now(NULL);
+
+  lv_label_t * l = (lv_label_t *)label;
+  TEST_ASSERT_NOT_NULL(l->hint.lines);
+  TEST_ASSERT_EQUAL(3, l->hint.line_cnt);
+  TEST_ASSERT_EQUAL(0, l->hint.lines[0].start);
+  TEST_ASSERT_EQUAL(6, l->hint.lines[1].start);
+  TEST_ASSERT_EQUAL(13, l->hint.lines[2].start);
+  TEST_ASSERT_EQUAL(18, l->hint.lines[3].start);
+
+  const lv_font_t * font = lv_obj_get_style_text_font(label, LV_PART_MAIN);
+  TEST_ASSERT_EQUAL(lv_txt_get_width("second", 6, font, 0, LV_TEXT_FLAG_NONE), l->hint.lines[1].width);
+
+  /*Redrawing keeps the same layout*/
+  const lv_draw_label_line_t * lines = l->hint.lines;
+  lv_obj_invalidate(label);
+  lv_refr_now(NULL);
+  TEST_ASSERT_EQUAL_PTR(lines, l->hint.lines);
+
+  lv_obj_del(label);
+}
+
+void test_label_layout_cache_invalidate(void)
+{
+  lv_obj_t * label = lv_label_create(lv_scr_act());
+  lv_label_set_text(label, "aaa bbb ccc ddd");
+  lv_refr_now(NULL);
+
+  lv_label_t * l = (lv_label_t *)label;
+  TEST_ASSERT_EQUAL(1, l->hint.line_cnt);
+
+  /*Narrower width wraps the text*/
+  const lv_font_t * font = lv_obj_get_style_text_font(label, LV_PART_MAIN);
+  lv_obj_set_width(label, lv_txt_get_width("aaa bbb cc", 10, font, 0, LV_TEXT_FLAG_NONE));
+  lv_refr_now(NULL);
+  TEST_ASSERT_EQUAL(2, l->hint.line_cnt);
+
+  /*New text. The label is measured with the new layout already.*/
+  lv_label_set_text(label, "aaa");
+  TEST_ASSERT_EQUAL(1, l->hint.line_cnt);
+  TEST_ASSERT_EQUAL(3, l->hint.lines[1].start);
+  lv_refr_now(NULL);
+  TEST_ASSERT_EQUAL(1, l->hint.line_cnt);
+
+  lv_obj_del(label);
+}
+
+/*The edited label has the same layout, size and letter positions as a newly set text*/
+static void assert_same_layout(lv_obj_t * label, lv_obj_t * ref)
+{
+  lv_label_set_text(ref, lv_label_get_text(label));
+  lv_refr_now(NULL);
+
+  lv_label_t * l = (lv_label_t *)label;
+  lv_label_t * r = (lv_label_t *)ref;
+  TEST_ASSERT_NOT_NULL(l->hint.lines);
+  TEST_ASSERT_EQUAL(r->hint.line_cnt, l->hint.line_cnt);
+  uint32_t i;
+  for(i = 0; i <= r->hint.line_cnt; i++) {
+    TEST_ASSERT_EQUAL(r->hint.lines[i].start, l->hint.lines[i].start);
+    TEST_ASSERT_EQUAL(r->hint.lines[i].width, l->hint.lines[i].width);
+  }
+
+  TEST_ASSERT_EQUAL(lv_obj_get_height(ref), lv_obj_get_height(label));
+
+  uint32_t len = _lv_txt_get_encoded_length(lv_label_get_text(label));
+  for(i = 0; i <= len; i++) {
+    lv_point_t p1;
+    lv_point_t p2;
+    lv_label_get_letter_pos(label, i, &p1);
+    lv_label_get_letter_pos(ref, i, &p2);
+    TEST_ASSERT_EQUAL(p2.x, p1.x);
+    TEST_ASSERT_EQUAL(p2.y, p1.y);
+
+    p2.x += 1;
+    p2.y += 1;
+    TEST_ASSERT_EQUAL(lv_label_get_letter_on(ref, &p2), lv_label_get_letter_on(label, &p2));
+  }
+}
+
+void test_label_edit_relayout(void)
+{
+  lv_obj_t * label = lv_label_create(lv_scr_act());
+  lv_obj_t * ref = lv_label_create(lv_scr_act());
+  lv_obj_set_width(label, 100);
+  lv_obj_set_width(ref, 100);
+  lv_label_set_text(label, "Lorem ipsum dolor sit amet\nconsectetur\n\nadipiscing elit sed do eiusmod");
+  lv_refr_now(NULL);
+
+  /*Typing at the end*/
+  lv_label_ins_text(label, LV_LABEL_POS_LAST, " tempor");
+  assert_same_layout(label, ref);
+  lv_label_ins_text(label, LV_LABEL_POS_LAST, "\n");
+  assert_same_layout(label, ref);
+
+  /*Words can move to the previous line when a long word is shortened*/
+  lv_label_ins_text(label, 6, "and some more words ");
+  assert_same_layout(label, ref);
+  lv_label_cut_text(label, 0, 10);
+  assert_same_layout(label, ref);
+
+  /*Join and split paragraphs*/
+  lv_label_cut_text(label, 40, 3);
+  assert_same_layout(label, ref);
+  lv_label_ins_text(label, 20, "x\ny\nz");
+  assert_same_layout(label, ref);
+
+  lv_obj_del(label);
+  lv_obj_del(ref);
+}
+
+#endif
@@ -0,0 +1,155 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_LOCAL_STYLE_SHARE
+
+void test_local_style_share_identical(void);
+void test_local_style_share_copy_on_write(void);
+void test_local_style_share_monitor(void);
+void test_local_style_share_value_bytes(void);
+
+#define ROW_CNT 10
+
+static lv_obj_t * rows[ROW_CNT];
+
+static lv_style_t * get_local_style(lv_obj_t * obj)
+{
+  uint32_t i;
+  for(i = 0; i < obj->style_cnt; i++) {
+    if(obj->styles[i].is_local) return obj->styles[i].style;
+  }
+  return NULL;
+}
+
+static void create_rows(void)
+{
+  uint32_t i;
+  for(i = 0; i < ROW_CNT; i++) {
+    rows[i] = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(rows[i]);
+    /*The order of the properties doesn't matter*/
+    if(i % 2) {
+      lv_obj_set_style_bg_color(rows[i], lv_palette_main(LV_PALETTE_RED), 0);
+      lv_obj_set_style_radius(rows[i], 5, 0);
+      lv_obj_set_style_pad_all(rows[i], 3, 0);
+    }
+    else {
+      lv_obj_set_style_pad_all(rows[i], 3, 0);
+      lv_obj_set_style_radius(rows[i], 5, 0);
+      lv_obj_set_style_bg_color(rows[i], lv_palette_main(LV_PALETTE_RED), 0);
+    }
+  }
+}
+
+static void del_rows(void)
+{
+  uint32_t i;
+  for(i = 0; i < ROW_CNT; i++) lv_obj_del(rows[i]);
+}
+
+void test_local_style_share_identical(void)
+{
+  create_rows();
+
+  uint32_t i;
+  for(i = 1; i < ROW_CNT; i++) {
+    TEST_ASSERT_EQUAL_PTR(get_local_style(rows[0]), get_local_style(rows[i]));
+  }
+
+  del_rows();
+}
+
+void test_local_style_share_copy_on_write(void)
+{
+  create_rows();
+
+  /*Only the modified object gets a new style*/
+  lv_style_t * shared = get_local_style(rows[1]);
+  lv_obj_set_style_radius(rows[0], 10, 0);
+  TEST_ASSERT_NOT_EQUAL(shared, get_local_style(rows[0]));
+  TEST_ASSERT_EQUAL_PTR(shared, get_local_style(rows[1]));
+  TEST_ASSERT_EQUAL(10, lv_obj_get_style_radius(rows[0], LV_PART_MAIN));
+  TEST_ASSERT_EQUAL(5, lv_obj_get_style_radius(rows[1], LV_PART_MAIN));
+
+  /*Shared again when it's identical again*/
+  lv_obj_set_style_radius(rows[0], 5, 0);
+  TEST_ASSERT_EQUAL_PTR(shared, get_local_style(rows[0]));
+
+  TEST_ASSERT_TRUE(lv_obj_remove_local_style_prop(rows[0], LV_STYLE_RADIUS, 0));
+  TEST_ASSERT_NOT_EQUAL(shared, get_local_style(rows[0]));
+  TEST_ASSERT_EQUAL(0, lv_obj_get_style_radius(rows[0], LV_PART_MAIN));
+  TEST_ASSERT_EQUAL(5, lv_obj_get_style_radius(rows[1], LV_PART_MAIN));
+
+  del_rows();
+}
+
+void test_local_style_share_monitor(void)
+{
+  lv_obj_local_style_monitor_t mon_start;
+  lv_obj_local_style_monitor(&mon_start);
+
+  create_rows();
+  lv_obj_set_style_radius(rows[0], 10, 0);
+
+  lv_obj_local_style_monitor_t mon;
+  lv_obj_local_style_monitor(&mon);
+  TEST_ASSERT_EQUAL(mon_start.total_cnt + ROW_CNT, mon.total_cnt);
+  TEST_ASSERT_EQUAL(mon_start.unique_cnt + 2, mon.unique_cnt);
+  TEST_ASSERT_TRUE(mon.unique_size - mon_start.unique_size < mon.total_size - mon_start.total_size);
+
+  del_rows();
+
+  /*All the local styles are freed with the objects*/
+  lv_obj_local_style_monitor(&mon);
+  TEST_ASSERT_EQUAL(mon_start.total_cnt, mon.total_cnt);
+  TEST_ASSERT_EQUAL(mon_start.unique_cnt, mon.unique_cnt);
+}
+
+/*Set the same values as `set_values_2` but with other leftover bytes around the used union members,
+ *like in different stack frames*/
+static void set_values_1(lv_obj_t * obj)
+{
+  lv_style_value_t v;
+  lv_memset(&v, 0xaa, sizeof(v));
+  v.num = 12;
+  lv_obj_set_local_style_prop(obj, LV_STYLE_RADIUS, v, 0);
+  lv_memset(&v, 0xaa, sizeof(v));
+  v.color = lv_palette_main(LV_PALETTE_RED);
+  lv_obj_set_local_style_prop(obj, LV_STYLE_BG_COLOR, v, 0);
+  lv_obj_set_style_flex_grow(obj, 2, 0);
+}
+
+static void set_values_2(lv_obj_t * obj)
+{
+  lv_obj_set_style_flex_grow(obj, 2, 0);
+  lv_style_value_t v;
+  lv_memset(&v, 0x55, sizeof(v));
+  v.color = lv_palette_main(LV_PALETTE_RED);
+  lv_obj_set_local_style_prop(obj, LV_STYLE_BG_COLOR, v, 0);
+  lv_memset(&v, 0x55, sizeof(v));
+  v.num = 12;
+  lv_obj_set_local_style_prop(obj, LV_STYLE_RADIUS, v, 0);
+}
+
+void test_local_style_share_value_bytes(void)
+{
+  lv_obj_t * obj1 = lv_obj_create(lv_scr_act());
+  lv_obj_t * obj2 = lv_obj_create(lv_scr_act());
+  lv_obj_remove_style_all(obj1);
+  lv_obj_remove_style_all(obj2);
+
+  /*Only the bytes of the used member of the values matter*/
+  set_values_1(obj1);
+  set_values_2(obj2);
+  TEST_ASSERT_EQUAL_PTR(get_local_style(obj1), get_local_style(obj2));
+  TEST_ASSERT_EQUAL(12, lv_obj_get_style_radius(obj2, LV_PART_MAIN));
+
+  lv_obj_del(obj1);
+  lv_obj_del(obj2);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,126 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include <pthread.h>
+
+#define FREE_THREAD_CNT     4
+#define FREE_BLOCK_CNT      64
+
+void test_mem_small_blocks(void);
+void test_mem_monitor(void);
+void test_mem_free_atomic(void);
+
+void test_mem_small_blocks(void)
+{
+  /*Alloc, grow and shrink across the size classes*/
+  uint8_t * p = lv_mem_alloc(10);
+  TEST_ASSERT_NOT_NULL(p);
+  lv_memset(p, 0x5a, 10);
+
+  p = lv_mem_realloc(p, 200);
+  TEST_ASSERT_NOT_NULL(p);
+  TEST_ASSERT_EACH_EQUAL_UINT8(0x5a, p, 10);
+  lv_memset(p, 0x3c, 200);
+
+  p = lv_mem_realloc(p, 2000);
+  TEST_ASSERT_NOT_NULL(p);
+  TEST_ASSERT_EACH_EQUAL_UINT8(0x3c, p, 200);
+
+  p = lv_mem_realloc(p, 40);
+  TEST_ASSERT_NOT_NULL(p);
+  TEST_ASSERT_EACH_EQUAL_UINT8(0x3c, p, 40);
+
+  p = lv_mem_realloc(p, 20);
+  TEST_ASSERT_NOT_NULL(p);
+  TEST_ASSERT_EACH_EQUAL_UINT8(0x3c, p, 20);
+  lv_mem_free(p);
+
+  /*More small blocks than fit to the pools*/
+  static void * blocks[1024];
+  uint32_t i;
+  for(i = 0; i < 1024; i++) {
+    blocks[i] = lv_mem_alloc(16 + (i % 5) * 50);
+    TEST_ASSERT_NOT_NULL(blocks[i]);
+    lv_memset(blocks[i], i & 0xff, 16);
+  }
+
+  for(i = 0; i < 1024; i += 2) lv_mem_free(blocks[i]);
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+  for(i = 1; i < 1024; i += 2) TEST_ASSERT_EACH_EQUAL_UINT8(i & 0xff, blocks[i], 16);
+  for(i = 1; i < 1024; i += 2) lv_mem_free(blocks[i]);
+
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+}
+
+void test_mem_monitor(void)
+{
+#if LV_MEM_CUSTOM == 0
+  lv_mem_monitor_t m1;
+  lv_mem_monitor(&m1);
+
+  void * p1 = lv_mem_alloc(24);
+  void * p2 = lv_mem_alloc(3000);
+
+  lv_mem_monitor_t m2;
+  lv_mem_monitor(&m2);
+  TEST_ASSERT_EQUAL(m1.used_cnt + 2, m2.used_cnt);
+  TEST_ASSERT_UINT32_WITHIN(64, 3024, m1.free_size - m2.free_size);
+  TEST_ASSERT_GREATER_OR_EQUAL(m1.total_size - m2.free_size, m2.max_used);
+
+  lv_mem_free(p1);
+  lv_mem_free(p2);
+
+  lv_mem_monitor_t m3;
+  lv_mem_monitor(&m3);
+  TEST_ASSERT_EQUAL(m1.used_cnt, m3.used_cnt);
+  TEST_ASSERT_EQUAL(m1.free_size, m3.free_size);
+  TEST_ASSERT_EQUAL(m1.free_cnt, m3.free_cnt);
+  TEST_ASSERT_EQUAL(m2.max_used, m3.max_used);
+#endif
+}
+
+static void * free_blocks[FREE_THREAD_CNT][FREE_BLOCK_CNT];
+
+static void * free_thread(void * p)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_ATOMIC_FREE
+  void ** blocks = p;
+  uint32_t i;
+  for(i = 0; i < FREE_BLOCK_CNT; i++) lv_mem_free_atomic(blocks[i]);
+#else
+  LV_UNUSED(p);
+#endif
+  return NULL;
+}
+
+void test_mem_free_atomic(void)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_ATOMIC_FREE
+  lv_mem_monitor_t m1;
+  lv_mem_monitor(&m1);
+
+  /*Small blocks from the pools and larger ones from TLSF*/
+  uint32_t t;
+  uint32_t i;
+  for(t = 0; t < FREE_THREAD_CNT; t++) {
+    for(i = 0; i < FREE_BLOCK_CNT; i++) {
+      free_blocks[t][i] = lv_mem_alloc(i % 4 == 0 ? 1000 : 8 + i);
+      TEST_ASSERT_NOT_NULL(free_blocks[t][i]);
+    }
+  }
+
+  pthread_t threads[FREE_THREAD_CNT];
+  for(t = 0; t < FREE_THREAD_CNT; t++) pthread_create(&threads[t], NULL, free_thread, free_blocks[t]);
+  for(t = 0; t < FREE_THREAD_CNT; t++) pthread_join(threads[t], NULL);
+
+  /*The blocks are given back when LVGL uses the memory again*/
+  lv_mem_monitor_t m2;
+  lv_mem_monitor(&m2);
+  TEST_ASSERT_EQUAL(m1.used_cnt, m2.used_cnt);
+  TEST_ASSERT_EQUAL(m1.free_size, m2.free_size);
+  TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+#endif
+}
+
+#endif
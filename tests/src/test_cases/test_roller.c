@@ -0,0 +1,98 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void test_roller_infinite_options(void);
+void test_roller_infinite_keys(void);
+void test_roller_infinite_draw(void);
+
+static char opts[2000];
+
+static const char * opts_create(uint32_t cnt)
+{
+  uint32_t i;
+  char * p = opts;
+  for(i = 0; i < cnt; i++) {
+    p += lv_snprintf(p, sizeof(opts) - (p - opts), i == 0 ? "%d" : "\n%d", i);
+  }
+  return opts;
+}
+
+void test_roller_infinite_options(void)
+{
+  lv_obj_t * roller = lv_roller_create(lv_scr_act());
+  const char * o = opts_create(300);
+  lv_roller_set_options(roller, o, LV_ROLLER_MODE_INFINITE);
+
+  /*The options are stored only once*/
+  TEST_ASSERT_EQUAL(300, lv_roller_get_option_cnt(roller));
+  TEST_ASSERT_EQUAL_STRING(o, lv_roller_get_options(roller));
+
+  char buf[16];
+  lv_roller_set_selected(roller, 123, LV_ANIM_OFF);
+  TEST_ASSERT_EQUAL(123, lv_roller_get_selected(roller));
+  lv_roller_get_selected_str(roller, buf, sizeof(buf));
+  TEST_ASSERT_EQUAL_STRING("123", buf);
+
+  lv_roller_set_selected(roller, 299, LV_ANIM_ON);
+  lv_roller_get_selected_str(roller, buf, sizeof(buf));
+  TEST_ASSERT_EQUAL_STRING("299", buf);
+  lv_refr_now(NULL);
+
+  lv_obj_del(roller);
+}
+
+void test_roller_infinite_keys(void)
+{
+  lv_obj_t * roller = lv_roller_create(lv_scr_act());
+  lv_roller_set_options(roller, "a\nb\nc", LV_ROLLER_MODE_INFINITE);
+  lv_roller_set_selected(roller, 2, LV_ANIM_OFF);
+
+  /*Going down from the last option starts from the first again*/
+  uint32_t key = LV_KEY_DOWN;
+  lv_event_send(roller, LV_EVENT_KEY, &key);
+  TEST_ASSERT_EQUAL(0, lv_roller_get_selected(roller));
+
+  key = LV_KEY_UP;
+  lv_event_send(roller, LV_EVENT_KEY, &key);
+  lv_event_send(roller, LV_EVENT_KEY, &key);
+  TEST_ASSERT_EQUAL(1, lv_roller_get_selected(roller));
+  lv_refr_now(NULL);
+
+  /*In normal mode the first option is kept*/
+  lv_roller_set_options(roller, "a\nb\nc", LV_ROLLER_MODE_NORMAL);
+  lv_event_send(roller, LV_EVENT_KEY, &key);
+  TEST_ASSERT_EQUAL(0, lv_roller_get_selected(roller));
+
+  lv_obj_del(roller);
+}
+
+/*In the middle of the options the infinite roller looks the same as the normal*/
+void test_roller_infinite_draw(void)
+{
+  static lv_color_t buf_normal[100 * 120];
+  static lv_color_t buf_inf[100 * 120];
+
+  lv_obj_t * roller = lv_roller_create(lv_scr_act());
+  lv_obj_set_size(roller, 100, 120);
+  const char * o = opts_create(20);
+
+  lv_roller_set_options(roller, o, LV_ROLLER_MODE_NORMAL);
+  lv_roller_set_selected(roller, 10, LV_ANIM_OFF);
+  lv_obj_update_layout(roller);
+  lv_memset_00(buf_normal, sizeof(buf_normal));
+  lv_refr_obj_to_buf(roller, NULL, LV_IMG_CF_TRUE_COLOR, buf_normal);
+
+  lv_roller_set_options(roller, o, LV_ROLLER_MODE_INFINITE);
+  lv_roller_set_selected(roller, 10, LV_ANIM_OFF);
+  lv_obj_update_layout(roller);
+  lv_memset_00(buf_inf, sizeof(buf_inf));
+  lv_refr_obj_to_buf(roller, NULL, LV_IMG_CF_TRUE_COLOR, buf_inf);
+
+  TEST_ASSERT_EQUAL_MEMORY(buf_normal, buf_inf, sizeof(buf_normal));
+
+  lv_obj_del(roller);
+}
+
+#endif
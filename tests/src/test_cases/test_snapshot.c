@@ -0,0 +1,51 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void test_snapshot_true_color(void);
+void test_snapshot_no_display(void);
+
+void test_snapshot_true_color(void)
+{
+  lv_obj_t * obj = lv_obj_create(lv_scr_act());
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_pos(obj, 10, 20);
+  lv_obj_set_size(obj, 40, 30);
+  lv_obj_set_style_bg_color(obj, lv_color_hex(0x112233), 0);
+  lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+
+  lv_img_dsc_t * snapshot = lv_snapshot_take(obj, LV_IMG_CF_TRUE_COLOR);
+  TEST_ASSERT_NOT_NULL(snapshot);
+  TEST_ASSERT_EQUAL(40, snapshot->header.w);
+  TEST_ASSERT_EQUAL(30, snapshot->header.h);
+
+  const lv_color_t * px = (const lv_color_t *)snapshot->data;
+  TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x112233), px[0]);
+  TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x112233), px[40 * 30 - 1]);
+
+  lv_snapshot_free(snapshot);
+  lv_obj_del(obj);
+}
+
+void test_snapshot_no_display(void)
+{
+  lv_obj_t * obj = lv_obj_create(lv_scr_act());
+  lv_obj_set_size(obj, 50, 50);
+
+  lv_disp_t * disp = lv_disp_get_default();
+  lv_disp_t * disp_refr = _lv_refr_get_disp_refreshing();
+  lv_img_dsc_t * snapshot = lv_snapshot_take(obj, LV_IMG_CF_TRUE_COLOR_ALPHA);
+  TEST_ASSERT_NOT_NULL(snapshot);
+
+  /*The object stays on its screen and no other display was registered*/
+  TEST_ASSERT_EQUAL_PTR(lv_scr_act(), lv_obj_get_parent(obj));
+  TEST_ASSERT_EQUAL_PTR(disp, lv_disp_get_default());
+  TEST_ASSERT_NULL(lv_disp_get_next(disp));
+  TEST_ASSERT_EQUAL_PTR(disp_refr, _lv_refr_get_disp_refreshing());
+
+  lv_snapshot_free(snapshot);
+  lv_obj_del(obj);
+}
+
+#endif
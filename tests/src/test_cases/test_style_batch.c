@@ -0,0 +1,90 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void test_style_batch_single_refresh(void);
+void test_style_batch_frame_start(void);
+void test_style_batch_deleted_obj(void);
+
+static uint32_t style_changed_cnt;
+
+static void style_changed_cb(lv_event_t * e)
+{
+  LV_UNUSED(e);
+  style_changed_cnt++;
+}
+
+static lv_obj_t * create_parent_with_child(void)
+{
+  lv_obj_t * parent = lv_obj_create(lv_scr_act());
+  lv_obj_t * child = lv_obj_create(parent);
+  lv_obj_add_event_cb(child, style_changed_cb, LV_EVENT_STYLE_CHANGED, NULL);
+  style_changed_cnt = 0;
+  return parent;
+}
+
+void test_style_batch_single_refresh(void)
+{
+  lv_obj_t * parent = create_parent_with_child();
+
+  /*Every inherited property refreshes the children without a batch*/
+  lv_obj_set_style_text_letter_space(parent, 1, 0);
+  lv_obj_set_style_text_line_space(parent, 1, 0);
+  TEST_ASSERT_EQUAL(2, style_changed_cnt);
+
+  style_changed_cnt = 0;
+  lv_obj_style_batch_begin();
+  lv_obj_set_style_text_letter_space(parent, 2, 0);
+  lv_obj_set_style_text_line_space(parent, 2, 0);
+  lv_obj_set_style_bg_color(parent, lv_palette_main(LV_PALETTE_RED), 0);
+
+  /*Nested batches don't refresh*/
+  lv_obj_style_batch_begin();
+  lv_obj_set_style_text_color(parent, lv_palette_main(LV_PALETTE_RED), 0);
+  lv_obj_style_batch_end();
+  TEST_ASSERT_EQUAL(0, style_changed_cnt);
+  TEST_ASSERT_TRUE(parent->style_batched);
+
+  lv_obj_style_batch_end();
+  TEST_ASSERT_EQUAL(1, style_changed_cnt);
+  TEST_ASSERT_FALSE(parent->style_batched);
+
+  lv_obj_del(parent);
+}
+
+void test_style_batch_frame_start(void)
+{
+  lv_obj_t * parent = create_parent_with_child();
+
+  lv_obj_style_batch_begin();
+  lv_obj_set_style_text_letter_space(parent, 2, 0);
+  lv_obj_set_style_text_line_space(parent, 2, 0);
+
+  /*The recorded refreshes are applied before rendering*/
+  lv_refr_now(NULL);
+  TEST_ASSERT_EQUAL(1, style_changed_cnt);
+
+  lv_obj_style_batch_end();
+  TEST_ASSERT_EQUAL(1, style_changed_cnt);
+
+  lv_obj_del(parent);
+}
+
+void test_style_batch_deleted_obj(void)
+{
+  lv_obj_t * parent = create_parent_with_child();
+  lv_obj_t * obj = lv_obj_create(lv_scr_act());
+
+  lv_obj_style_batch_begin();
+  lv_obj_set_style_text_letter_space(obj, 2, 0);
+  lv_obj_set_style_text_letter_space(parent, 2, 0);
+  lv_obj_del(obj);
+  lv_obj_style_batch_end();
+
+  TEST_ASSERT_EQUAL(1, style_changed_cnt);
+
+  lv_obj_del(parent);
+}
+
+#endif
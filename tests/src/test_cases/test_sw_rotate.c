@@ -0,0 +1,120 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+/*Logical resolution, i.e. as the UI sees the display*/
+#define SR_HOR_RES 40
+#define SR_VER_RES 30
+#define SR_BUF_PX  (SR_HOR_RES * 5)
+
+void test_sw_rotate_90(void);
+void test_sw_rotate_180(void);
+void test_sw_rotate_270(void);
+
+static lv_color_t sr_buf[SR_BUF_PX];
+static lv_color_t sr_screen[SR_HOR_RES * SR_VER_RES];
+static lv_color_t sr_ref[SR_HOR_RES * SR_VER_RES];
+static lv_disp_drv_t sr_drv;
+
+static void sr_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+  /*The area and the buffer are in the native orientation*/
+  lv_coord_t w = lv_area_get_width(area);
+  lv_coord_t y;
+  for(y = area->y1; y <= area->y2; y++) {
+    lv_memcpy(&sr_screen[y * disp_drv->hor_res + area->x1], color_p, w * sizeof(lv_color_t));
+    color_p += w;
+  }
+  lv_disp_flush_ready(disp_drv);
+}
+
+static void sr_render(lv_disp_rot_t rot)
+{
+  static lv_disp_draw_buf_t draw_buf;
+  lv_disp_draw_buf_init(&draw_buf, sr_buf, NULL, SR_BUF_PX);
+  lv_disp_drv_init(&sr_drv);
+  sr_drv.draw_buf = &draw_buf;
+  sr_drv.flush_cb = sr_flush_cb;
+  sr_drv.sw_rotate = 1;
+  sr_drv.rotated = rot;
+  /*The driver's resolution is the native one*/
+  bool swap = rot == LV_DISP_ROT_90 || rot == LV_DISP_ROT_270;
+  sr_drv.hor_res = swap ? SR_VER_RES : SR_HOR_RES;
+  sr_drv.ver_res = swap ? SR_HOR_RES : SR_VER_RES;
+  lv_disp_t * disp = lv_disp_drv_register(&sr_drv);
+
+  /*Rectangles, masks, images and text to involve all the blending paths*/
+  lv_obj_t * scr = lv_disp_get_scr_act(disp);
+  lv_obj_remove_style_all(scr);
+  lv_obj_set_style_bg_color(scr, lv_palette_main(LV_PALETTE_RED), 0);
+  lv_obj_set_style_bg_grad_color(scr, lv_palette_main(LV_PALETTE_BLUE), 0);
+  lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_HOR, 0);
+  lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+
+  lv_obj_t * obj = lv_obj_create(scr);
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_pos(obj, 3, 2);
+  lv_obj_set_size(obj, 25, 20);
+  lv_obj_set_style_radius(obj, 8, 0);
+  lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_GREEN), 0);
+  lv_obj_set_style_bg_opa(obj, LV_OPA_70, 0);
+  lv_obj_set_style_border_width(obj, 2, 0);
+  lv_obj_set_style_border_color(obj, lv_color_white(), 0);
+  lv_obj_set_style_border_opa(obj, LV_OPA_COVER, 0);
+
+  lv_obj_t * label = lv_label_create(scr);
+  lv_label_set_text(label, "Ag");
+  lv_obj_set_pos(label, 20, 10);
+
+  lv_refr_now(disp);
+  lv_disp_remove(disp);
+}
+
+static void sr_test(lv_disp_rot_t rot)
+{
+  /*Reference without rotation*/
+  sr_render(LV_DISP_ROT_NONE);
+  lv_memcpy(sr_ref, sr_screen, sizeof(sr_ref));
+
+  lv_memset_00(sr_screen, sizeof(sr_screen));
+  sr_render(rot);
+
+  /*Every pixel has to be at its rotated place with the same color*/
+  lv_coord_t x;
+  lv_coord_t y;
+  for(y = 0; y < SR_VER_RES; y++) {
+    for(x = 0; x < SR_HOR_RES; x++) {
+      uint32_t i;
+      switch(rot) {
+        case LV_DISP_ROT_90:
+          i = (SR_HOR_RES - 1 - x) * SR_VER_RES + y;
+          break;
+        case LV_DISP_ROT_180:
+          i = (SR_VER_RES - 1 - y) * SR_HOR_RES + (SR_HOR_RES - 1 - x);
+          break;
+        default:
+          i = x * SR_VER_RES + (SR_VER_RES - 1 - y);
+          break;
+      }
+      TEST_ASSERT_EQUAL_HEX32(lv_color_to32(sr_ref[y * SR_HOR_RES + x]), lv_color_to32(sr_screen[i]));
+    }
+  }
+}
+
+void test_sw_rotate_90(void)
+{
+  sr_test(LV_DISP_ROT_90);
+}
+
+void test_sw_rotate_180(void)
+{
+  sr_test(LV_DISP_ROT_180);
+}
+
+void test_sw_rotate_270(void)
+{
+  sr_test(LV_DISP_ROT_270);
+}
+
+#endif
@@ -0,0 +1,143 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define SC_HOR_RES 40
+#define SC_VER_RES 40
+#define SC_BUF_PX  (SC_HOR_RES * 5)
+
+void test_swap_chain_queue_parts(void);
+void test_swap_chain_sync_flush(void);
+
+static lv_color_t sc_bufs[3][SC_BUF_PX];
+static lv_color_t sc_screen[SC_HOR_RES * SC_VER_RES];
+static lv_color_t sc_ref[SC_HOR_RES * SC_VER_RES];
+static lv_disp_drv_t sc_drv;
+static lv_disp_draw_buf_t sc_draw_buf;
+
+/*The flush in progress, finished only in `wait_cb` to simulate a slow DMA*/
+static const lv_area_t * pending_area;
+static lv_color_t * pending_buf;
+static bool sync_flush;
+static uint32_t flush_cnt;
+static lv_coord_t flushed_y[16];
+static uint32_t last_cnt;
+
+static void flush_finish(lv_disp_drv_t * disp_drv)
+{
+  if(pending_area == NULL) return;
+
+  lv_coord_t w = lv_area_get_width(pending_area);
+  lv_coord_t y;
+  for(y = pending_area->y1; y <= pending_area->y2; y++) {
+    lv_memcpy(&sc_screen[y * SC_HOR_RES + pending_area->x1], pending_buf, w * sizeof(lv_color_t));
+    pending_buf += w;
+  }
+  pending_area = NULL;
+  lv_disp_flush_ready(disp_drv);
+}
+
+static void sc_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+  /*Only one flush at a time*/
+  TEST_ASSERT_NULL(pending_area);
+
+  if(flush_cnt < 16) flushed_y[flush_cnt] = area->y1;
+  flush_cnt++;
+  if(lv_disp_flush_is_last(disp_drv)) last_cnt++;
+
+  pending_area = area;
+  pending_buf = color_p;
+  if(sync_flush) flush_finish(disp_drv);
+}
+
+static void sc_wait_cb(lv_disp_drv_t * disp_drv)
+{
+  flush_finish(disp_drv);
+}
+
+static lv_disp_t * sc_disp_create(uint32_t buf_cnt)
+{
+  void * bufs[3] = {sc_bufs[0], sc_bufs[1], sc_bufs[2]};
+  lv_disp_draw_buf_init_chain(&sc_draw_buf, bufs, buf_cnt, SC_BUF_PX);
+  lv_disp_drv_init(&sc_drv);
+  sc_drv.draw_buf = &sc_draw_buf;
+  sc_drv.flush_cb = sc_flush_cb;
+  sc_drv.wait_cb = sc_wait_cb;
+  sc_drv.hor_res = SC_HOR_RES;
+  sc_drv.ver_res = SC_VER_RES;
+  lv_disp_t * disp = lv_disp_drv_register(&sc_drv);
+
+  /*A gradient to make all the parts different*/
+  lv_obj_t * scr = lv_disp_get_scr_act(disp);
+  lv_obj_remove_style_all(scr);
+  lv_obj_set_style_bg_color(scr, lv_palette_main(LV_PALETTE_RED), 0);
+  lv_obj_set_style_bg_grad_color(scr, lv_palette_main(LV_PALETTE_BLUE), 0);
+  lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+  lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+
+  flush_cnt = 0;
+  last_cnt = 0;
+  lv_refr_now(disp);
+  flush_finish(&sc_drv);
+  return disp;
+}
+
+void test_swap_chain_queue_parts(void)
+{
+  /*Reference with one buffer*/
+  sync_flush = true;
+  lv_disp_t * disp = sc_disp_create(1);
+  lv_memcpy(sc_ref, sc_screen, sizeof(sc_ref));
+  lv_disp_remove(disp);
+
+  sync_flush = false;
+  lv_memset_00(sc_screen, sizeof(sc_screen));
+  disp = sc_disp_create(3);
+  lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp);
+  TEST_ASSERT_EQUAL(3, draw_buf->buf_cnt);
+
+  /*Flushed in order and only the very last part is the last*/
+  TEST_ASSERT_EQUAL(SC_VER_RES / 5, flush_cnt);
+  uint32_t i;
+  for(i = 0; i < flush_cnt; i++) {
+    TEST_ASSERT_EQUAL(i * 5, flushed_y[i]);
+  }
+  TEST_ASSERT_EQUAL(1, last_cnt);
+
+  /*The queued parts were not overwritten before flushing*/
+  TEST_ASSERT_EQUAL_MEMORY(sc_ref, sc_screen, sizeof(sc_ref));
+
+  /*2 parts were waiting while the third was rendered*/
+  lv_disp_flush_stat_t stat;
+  lv_refr_get_flush_stat(disp, &stat);
+  TEST_ASSERT_EQUAL(SC_VER_RES / 5, stat.flush_cnt);
+  TEST_ASSERT_EQUAL(2, stat.queue_max);
+  TEST_ASSERT_TRUE(stat.wait_cnt > 0);
+  TEST_ASSERT_EQUAL(0, draw_buf->queue_cnt);
+
+  lv_refr_reset_flush_stat(disp);
+  lv_refr_get_flush_stat(disp, &stat);
+  TEST_ASSERT_EQUAL(0, stat.flush_cnt);
+
+  lv_disp_remove(disp);
+}
+
+void test_swap_chain_sync_flush(void)
+{
+  /*If `flush_cb` is ready immediately rendering never waits*/
+  sync_flush = true;
+  lv_disp_t * disp = sc_disp_create(3);
+
+  lv_disp_flush_stat_t stat;
+  lv_refr_get_flush_stat(disp, &stat);
+  TEST_ASSERT_EQUAL(SC_VER_RES / 5, stat.flush_cnt);
+  TEST_ASSERT_EQUAL(0, stat.wait_cnt);
+  TEST_ASSERT_EQUAL(0, stat.queue_max);
+  TEST_ASSERT_EQUAL(1, last_cnt);
+
+  lv_disp_remove(disp);
+}
+
+#endif
@@ -0,0 +1,75 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void test_table_row_height(void);
+void test_table_many_rows(void);
+
+void test_table_row_height(void)
+{
+  lv_obj_t * table = lv_table_create(lv_scr_act());
+  lv_table_set_col_width(table, 0, 100);
+  lv_table_set_cell_value(table, 0, 0, "a");
+  lv_table_set_cell_value(table, 1, 0, "b");
+  lv_obj_update_layout(table);
+
+  lv_coord_t h1 = lv_obj_get_self_height(table);
+
+  /*A multi line text makes only its row taller*/
+  lv_table_set_cell_value(table, 0, 0, "a\nb\nc");
+  lv_obj_update_layout(table);
+  lv_coord_t h3 = lv_obj_get_self_height(table);
+  TEST_ASSERT_GREATER_THAN(h1, h3);
+
+  /*The same height again with a single line*/
+  lv_table_set_cell_value_fmt(table, 0, 0, "%d", 1);
+  lv_obj_update_layout(table);
+  TEST_ASSERT_EQUAL(h1, lv_obj_get_self_height(table));
+
+  /*Cropping makes the row single line again*/
+  lv_table_set_cell_value(table, 0, 0, "a\nb\nc");
+  lv_table_add_cell_ctrl(table, 0, 0, LV_TABLE_CELL_CTRL_TEXT_CROP);
+  lv_obj_update_layout(table);
+  TEST_ASSERT_EQUAL(h1, lv_obj_get_self_height(table));
+
+  lv_table_clear_cell_ctrl(table, 0, 0, LV_TABLE_CELL_CTRL_TEXT_CROP);
+  lv_obj_update_layout(table);
+  TEST_ASSERT_EQUAL(h3, lv_obj_get_self_height(table));
+
+  lv_obj_del(table);
+}
+
+void test_table_many_rows(void)
+{
+  lv_obj_t * table = lv_table_create(lv_scr_act());
+  lv_obj_set_size(table, 200, 150);
+  lv_table_set_col_cnt(table, 2);
+
+  /*The rows are added one by one*/
+  uint32_t i;
+  for(i = 0; i < 500; i++) {
+    lv_table_set_cell_value_fmt(table, i, 0, "%d", i);
+    lv_table_set_cell_value(table, i, 1, "x");
+  }
+
+  TEST_ASSERT_EQUAL(500, lv_table_get_row_cnt(table));
+  lv_obj_update_layout(table);
+
+  /*All the rows have the same height*/
+  lv_coord_t h_row = (lv_obj_get_self_height(table) + 1) / 500;
+  TEST_ASSERT_EQUAL(h_row * 500, lv_obj_get_self_height(table) + 1);
+
+  /*Scroll to the end and draw only the visible rows*/
+  lv_obj_scroll_to_y(table, LV_COORD_MAX, LV_ANIM_OFF);
+  lv_refr_now(NULL);
+
+  /*Shrinking keeps the height of the remaining rows*/
+  lv_table_set_row_cnt(table, 10);
+  lv_obj_update_layout(table);
+  TEST_ASSERT_EQUAL(h_row * 10, lv_obj_get_self_height(table) + 1);
+
+  lv_obj_del(table);
+}
+
+#endif
@@ -0,0 +1,39 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void test_textarea_password_edit(void);
+
+void test_textarea_password_edit(void)
+{
+  lv_obj_t * ta = lv_textarea_create(lv_scr_act());
+  lv_textarea_set_password_show_time(ta, 0);
+  lv_textarea_set_password_mode(ta, true);
+
+  lv_textarea_t * ta_p = (lv_textarea_t *)ta;
+  uint32_t i;
+  for(i = 0; i < 20; i++) lv_textarea_add_char(ta, 'a' + i);
+  TEST_ASSERT_EQUAL_STRING("abcdefghijklmnopqrst", lv_textarea_get_text(ta));
+  TEST_ASSERT_NOT_EQUAL(0, strcmp(lv_textarea_get_text(ta), lv_label_get_text(ta_p->label)));
+
+  /*Deleting and typing again reuses the space of the password*/
+  char * pwd = ta_p->pwd_tmp;
+  lv_textarea_del_char(ta);
+  lv_textarea_del_char(ta);
+  lv_textarea_add_char(ta, 'x');
+  lv_textarea_add_char(ta, 'y');
+  TEST_ASSERT_EQUAL_PTR(pwd, ta_p->pwd_tmp);
+  TEST_ASSERT_EQUAL_STRING("abcdefghijklmnopqrxy", lv_textarea_get_text(ta));
+
+  lv_textarea_set_cursor_pos(ta, 0);
+  lv_textarea_add_text(ta, "12");
+  TEST_ASSERT_EQUAL_STRING("12abcdefghijklmnopqrxy", lv_textarea_get_text(ta));
+
+  lv_textarea_set_password_mode(ta, false);
+  TEST_ASSERT_EQUAL_STRING("12abcdefghijklmnopqrxy", lv_label_get_text(ta_p->label));
+
+  lv_obj_del(ta);
+}
+
+#endif
@@ -0,0 +1,214 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_THEME_COMPILE
+
+void test_theme_compile_shared_list(void);
+void test_theme_compile_unshare(void);
+void test_theme_compile_update(void);
+void test_theme_compile_free(void);
+void test_theme_compile_style_reset(void);
+void test_theme_compile_remove_style(void);
+
+static lv_theme_t theme_extra;
+static lv_theme_t * theme_ori;
+static lv_style_t * style_extra;
+
+static uint32_t count_selectors(lv_obj_t * obj)
+{
+  uint32_t cnt = 0;
+  uint32_t i;
+  uint32_t j;
+  for(i = 0; i < obj->style_cnt; i++) {
+    for(j = 0; j < i; j++) {
+      if(obj->styles[j].selector == obj->styles[i].selector) break;
+    }
+    if(j == i) cnt++;
+  }
+  return cnt;
+}
+
+/*Add one more style to the buttons on top of the default theme*/
+static void extra_apply_cb(lv_theme_t * th, lv_obj_t * obj)
+{
+  LV_UNUSED(th);
+  if(lv_obj_check_type(obj, &lv_btn_class)) lv_obj_add_style(obj, style_extra, 0);
+}
+
+static void extra_theme_set(lv_color_t color)
+{
+  style_extra = lv_mem_alloc(sizeof(lv_style_t));
+  lv_style_init(style_extra);
+  lv_style_set_bg_color(style_extra, color);
+
+  theme_ori = lv_disp_get_theme(NULL);
+  theme_extra = *theme_ori;
+  lv_theme_set_parent(&theme_extra, theme_ori);
+  lv_theme_set_apply_cb(&theme_extra, extra_apply_cb);
+  lv_disp_set_theme(NULL, &theme_extra);
+}
+
+static void extra_theme_remove(void)
+{
+  lv_disp_set_theme(NULL, theme_ori);
+  lv_style_reset(style_extra);
+  lv_mem_free(style_extra);
+  style_extra = NULL;
+}
+
+static uint32_t bg_color32(lv_obj_t * obj)
+{
+  return lv_color_to32(lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+}
+
+void test_theme_compile_shared_list(void)
+{
+  lv_obj_t * btn1 = lv_btn_create(lv_scr_act());
+  lv_obj_t * btn2 = lv_btn_create(lv_scr_act());
+
+  /*The same list with one constant style per selector*/
+  TEST_ASSERT_TRUE(btn1->styles_shared);
+  TEST_ASSERT_EQUAL_PTR(btn1->styles, btn2->styles);
+  TEST_ASSERT_EQUAL(count_selectors(btn1), btn1->style_cnt);
+  uint32_t i;
+  for(i = 0; i < btn1->style_cnt; i++) {
+    TEST_ASSERT_TRUE(btn1->styles[i].style->is_const);
+  }
+
+  /*The properties of the theme are kept*/
+  TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_theme_get_color_primary(btn1)),
+                          lv_color_to32(lv_obj_get_style_bg_color(btn1, LV_PART_MAIN)));
+  TEST_ASSERT_EQUAL(LV_OPA_COVER, lv_obj_get_style_bg_opa(btn1, LV_PART_MAIN));
+
+  lv_obj_del(btn1);
+  lv_obj_del(btn2);
+}
+
+void test_theme_compile_unshare(void)
+{
+  lv_obj_t * btn1 = lv_btn_create(lv_scr_act());
+  lv_obj_t * btn2 = lv_btn_create(lv_scr_act());
+  _lv_obj_style_t * shared = btn2->styles;
+
+  /*Only the modified object gets its own list*/
+  lv_obj_set_style_bg_color(btn1, lv_palette_main(LV_PALETTE_RED), 0);
+  TEST_ASSERT_FALSE(btn1->styles_shared);
+  TEST_ASSERT_TRUE(btn2->styles_shared);
+  TEST_ASSERT_EQUAL_PTR(shared, btn2->styles);
+
+  TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_palette_main(LV_PALETTE_RED)),
+                          lv_color_to32(lv_obj_get_style_bg_color(btn1, LV_PART_MAIN)));
+  TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_theme_get_color_primary(btn2)),
+                          lv_color_to32(lv_obj_get_style_bg_color(btn2, LV_PART_MAIN)));
+
+  lv_obj_remove_style_all(btn2);
+  TEST_ASSERT_FALSE(btn2->styles_shared);
+  TEST_ASSERT_EQUAL(0, btn2->style_cnt);
+
+  lv_obj_del(btn1);
+  lv_obj_del(btn2);
+}
+
+void test_theme_compile_update(void)
+{
+  lv_disp_t * disp = lv_disp_get_default();
+  lv_theme_t * th = lv_disp_get_theme(disp);
+  lv_color_t primary = th->color_primary;
+  lv_obj_t * btn = lv_btn_create(lv_scr_act());
+
+  /*Initializing the theme again updates the compiled styles too*/
+  lv_theme_default_init(disp, lv_palette_main(LV_PALETTE_GREEN), th->color_secondary,
+                        LV_THEME_DEFAULT_DARK, th->font_normal);
+  TEST_ASSERT_TRUE(btn->styles_shared);
+  TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_palette_main(LV_PALETTE_GREEN)),
+                          lv_color_to32(lv_obj_get_style_bg_color(btn, LV_PART_MAIN)));
+
+  lv_theme_default_init(disp, primary, th->color_secondary,
+                        LV_THEME_DEFAULT_DARK, th->font_normal);
+  lv_obj_del(btn);
+}
+
+void test_theme_compile_free(void)
+{
+#if LV_MEM_CUSTOM == 0
+  extra_theme_set(lv_palette_main(LV_PALETTE_RED));
+  lv_mem_monitor_t m1;
+  lv_mem_monitor(&m1);
+
+  /*The list compiled for these buttons is freed with the last of them*/
+  lv_obj_t * btn1 = lv_btn_create(lv_scr_act());
+  lv_obj_t * btn2 = lv_btn_create(lv_scr_act());
+  TEST_ASSERT_EQUAL_PTR(btn1->styles, btn2->styles);
+  lv_obj_del(btn1);
+  lv_obj_del(btn2);
+
+  lv_mem_monitor_t m2;
+  lv_mem_monitor(&m2);
+  TEST_ASSERT_EQUAL(m1.used_cnt, m2.used_cnt);
+  TEST_ASSERT_EQUAL(m1.free_size, m2.free_size);
+
+  extra_theme_remove();
+#endif
+}
+
+void test_theme_compile_style_reset(void)
+{
+  extra_theme_set(lv_palette_main(LV_PALETTE_RED));
+#if LV_MEM_CUSTOM == 0
+  lv_mem_monitor_t m1;
+  lv_mem_monitor(&m1);
+#endif
+
+  lv_obj_t * btn1 = lv_btn_create(lv_scr_act());
+  TEST_ASSERT_TRUE(btn1->styles_shared);
+  TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_palette_main(LV_PALETTE_RED)), bg_color32(btn1));
+
+  /*Like a new style at the address of a freed one*/
+  lv_style_reset(style_extra);
+  lv_style_set_bg_color(style_extra, lv_palette_main(LV_PALETTE_GREEN));
+
+  /*The old list is not found anymore, but it's still used and updated*/
+  lv_obj_t * btn2 = lv_btn_create(lv_scr_act());
+  TEST_ASSERT_TRUE(btn2->styles_shared);
+  TEST_ASSERT_NOT_EQUAL(btn1->styles, btn2->styles);
+  TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_palette_main(LV_PALETTE_GREEN)), bg_color32(btn2));
+
+  lv_obj_report_style_change(style_extra);
+  TEST_ASSERT_TRUE(btn1->styles_shared);
+  TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_palette_main(LV_PALETTE_GREEN)), bg_color32(btn1));
+
+  lv_obj_del(btn1);
+  lv_obj_del(btn2);
+
+#if LV_MEM_CUSTOM == 0
+  lv_mem_monitor_t m2;
+  lv_mem_monitor(&m2);
+  TEST_ASSERT_EQUAL(m1.used_cnt, m2.used_cnt);
+#endif
+  extra_theme_remove();
+}
+
+void test_theme_compile_remove_style(void)
+{
+  extra_theme_set(lv_palette_main(LV_PALETTE_RED));
+  lv_obj_t * btn1 = lv_btn_create(lv_scr_act());
+  lv_obj_t * btn2 = lv_btn_create(lv_scr_act());
+
+  /*The styles added by the theme can be removed one by one*/
+  lv_obj_remove_style(btn1, style_extra, 0);
+  TEST_ASSERT_FALSE(btn1->styles_shared);
+  TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_theme_get_color_primary(btn1)), bg_color32(btn1));
+
+  TEST_ASSERT_TRUE(btn2->styles_shared);
+  TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_palette_main(LV_PALETTE_RED)), bg_color32(btn2));
+
+  lv_obj_del(btn1);
+  lv_obj_del(btn2);
+  extra_theme_remove();
+}
+
+#endif
+
+#endif